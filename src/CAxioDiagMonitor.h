@@ -0,0 +1,285 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CAxioDiagMonitor.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef CAXIODIAGMONITOR_H_
+#define CAXIODIAGMONITOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include "RuntimeMetrics.h"
+
+#define AXIODIAG_HEALTHY_DIVIDER	10		// a healthy bus is read every n-th cycle, a faulted bus in every cycle
+#define AXIODIAG_QUEUE_SIZE			64		// max. events between two dispatches, power of 2
+#define AXIODIAG_DISPATCH_INTERVAL	10		// interval of the dispatcher in the event loop in ms
+
+///	flags of the AXIO_DIAG_STATUS_REG, see "UM EN AXL F SYS DIAG"
+enum AXIODIAGFLAG
+{
+    AXIODIAG_PW = 0,	// periphery warning
+    AXIODIAG_PF,		// periphery fault
+    AXIODIAG_BUS,		// bus error
+    AXIODIAG_RUN,		// bus is running
+    AXIODIAG_ACT,		// bus is active
+    AXIODIAG_RDY,		// bus master is ready
+    AXIODIAG_SYSFAIL,	// system failure
+    AXIODIAG_FLAGS
+};
+
+///	kind of an event of the AXIO diagnosis
+enum AXIODIAGEVENTKIND
+{
+    AXIODIAGEVENT_SET = 0,		// a flag was set
+    AXIODIAGEVENT_CLEARED,		// a flag was cleared
+    AXIODIAGEVENT_PARAM			// the AXIO_DIAG_PARAM_REG changed, e.g. the number of a faulty module
+};
+
+///	structure with one event of the AXIO diagnosis
+struct AXIODIAGEVENT
+{
+    AXIODIAGEVENTKIND zKind = AXIODIAGEVENT_SET;
+    AXIODIAGFLAG zFlag = AXIODIAG_PW;	// not used for AXIODIAGEVENT_PARAM
+    uint16_t uStatus = 0;				// AXIO_DIAG_STATUS_REG after the change
+    uint16_t uParam = 0;				// AXIO_DIAG_PARAM_REG after the change
+    uint64_t uTimeNs = 0;				// CLOCK_MONOTONIC of the read of the registers
+};
+
+/// @brief	event-driven decoding of the diagnosis registers of the AXIO bus master. The realtime
+/// 		thread compares the status and the parameter register with the last read. Only on a
+/// 		change, the flags are decoded with the bit offsets of the GDS variables
+/// 		AXIO_DIAG_STATUS_REG_PW etc. and each changed flag is pushed as typed event into a
+/// 		wait-free queue. The event loop takes the events out and reports them, the realtime
+/// 		thread never waits for it; if the queue is full, the event is counted as lost.
+///
+/// 		The bus is faulted if PF, BUS or SYSFAIL is set or RUN is cleared. A healthy bus is read
+/// 		every AXIODIAG_HEALTHY_DIVIDER cycles, a faulted bus and a cycle without a fresh input
+/// 		frame in every cycle, so the logic reacts on a fault in the same cycle as it is read.
+///
+/// 		The layout is set while the realtime thread is not inside its cycle. IsDue, Sample and
+/// 		IsFaulted are only called by the realtime thread, Pop only by the event loop.
+class CAxioDiagMonitor
+{
+public:
+    CAxioDiagMonitor()
+        : m_pMetrics(NULL),
+          m_uHead(0),
+          m_uTail(0)
+    {
+        Clear();
+    }
+
+    /// @brief			set the metrics
+    /// @param pMetrics	metrics for the reads, events and the status
+    void Init(RUNTIMEMETRICS* pMetrics)
+    {
+        m_pMetrics = pMetrics;
+    }
+
+    /// @brief	forget the layout and the state, the next sample reports all set flags
+    void Clear()
+    {
+        m_nStatusOffset = SIZE_MAX;
+        m_nParamOffset = SIZE_MAX;
+        for(int nFlag = 0; nFlag < AXIODIAG_FLAGS; nFlag++)
+        {
+            m_nFlagOffset[nFlag] = 0;
+            m_ucFlagMask[nFlag] = 0;
+        }
+        m_bSampled = false;
+        m_bFaulted = false;
+        m_uStatus = 0;
+        m_uParam = 0;
+        m_uFlags = 0;
+        m_uSkipped = 0;
+    }
+
+    /// @brief				set the offsets of the registers, big endian 16 bit values in the diag frame
+    /// @param nStatus		offset of the AXIO_DIAG_STATUS_REG, SIZE_MAX if it does not exist
+    /// @param nParam		offset of the AXIO_DIAG_PARAM_REG, SIZE_MAX if it does not exist
+    void SetRegisters(size_t nStatus, size_t nParam)
+    {
+        m_nStatusOffset = nStatus;
+        m_nParamOffset = nParam;
+    }
+
+    /// @brief				set the position of a flag in the diag frame
+    /// @param zFlag		flag
+    /// @param nOffset		byte offset
+    /// @param ucMask		bit mask, 0: the flag does not exist and is never set
+    void SetFlag(AXIODIAGFLAG zFlag, size_t nOffset, uint8_t ucMask)
+    {
+        m_nFlagOffset[zFlag] = nOffset;
+        m_ucFlagMask[zFlag] = ucMask;
+    }
+
+    /// @brief				called once per cycle, decides if the diag frame is read in this cycle
+    /// @param bInputsFresh	the input frame of this cycle was valid
+    /// @return				true: read the diag frame and call Sample
+    bool IsDue(bool bInputsFresh)
+    {
+        if((m_bSampled == false) || m_bFaulted || (bInputsFresh == false) || (++m_uSkipped >= AXIODIAG_HEALTHY_DIVIDER))
+        {
+            m_uSkipped = 0;
+            return(true);
+        }
+        return(false);
+    }
+
+    /// @brief			compare the registers with the last read and push the changed flags as events
+    /// @param pFrame	diag frame, only valid inside of ArpPlcGds_BeginRead
+    /// @param uTimeNs	time of the read
+    void Sample(const char* pFrame, uint64_t uTimeNs)
+    {
+        uint16_t uStatus = ReadRegister(pFrame, m_nStatusOffset);
+        uint16_t uParam = ReadRegister(pFrame, m_nParamOffset);
+
+        if(m_pMetrics != NULL)
+        {
+            IncrementMetric(m_pMetrics->uAxioDiagReads);
+        }
+
+        // in the healthy state only the two registers are compared
+        if(m_bSampled && (uStatus == m_uStatus) && (uParam == m_uParam))
+        {
+            return;
+        }
+
+        uint32_t uFlags = 0;
+        for(int nFlag = 0; nFlag < AXIODIAG_FLAGS; nFlag++)
+        {
+            if((m_ucFlagMask[nFlag] != 0) && ((pFrame[m_nFlagOffset[nFlag]] & m_ucFlagMask[nFlag]) != 0))
+            {
+                uFlags |= (1u << nFlag);
+            }
+        }
+
+        uint32_t uChanged = uFlags ^ m_uFlags;
+        for(int nFlag = 0; nFlag < AXIODIAG_FLAGS; nFlag++)
+        {
+            if(uChanged & (1u << nFlag))
+            {
+                Push((uFlags & (1u << nFlag)) ? AXIODIAGEVENT_SET : AXIODIAGEVENT_CLEARED, (AXIODIAGFLAG)nFlag, uStatus, uParam, uTimeNs);
+            }
+        }
+        if(uParam != m_uParam)
+        {
+            Push(AXIODIAGEVENT_PARAM, AXIODIAG_PW, uStatus, uParam, uTimeNs);
+        }
+
+        // RUN can only be evaluated, if the firmware has the flag
+        bool bRunMissing = (m_ucFlagMask[AXIODIAG_RUN] != 0) && ((uFlags & (1u << AXIODIAG_RUN)) == 0);
+        m_bFaulted = bRunMissing || ((uFlags & ((1u << AXIODIAG_PF) | (1u << AXIODIAG_BUS) | (1u << AXIODIAG_SYSFAIL))) != 0);
+
+        m_bSampled = true;
+        m_uStatus = uStatus;
+        m_uParam = uParam;
+        m_uFlags = uFlags;
+
+        if(m_pMetrics != NULL)
+        {
+            m_pMetrics->uAxioDiagStatus.store(uStatus, std::memory_order_relaxed);
+        }
+    }
+
+    /// @brief	state of the bus from the last read
+    /// @return	true: PF, BUS or SYSFAIL set or RUN cleared
+    bool IsFaulted() const
+    {
+        return(m_bFaulted);
+    }
+
+    /// @brief			take the oldest event out of the queue, only called by the event loop
+    /// @param zEvent	event
+    /// @return			true: event returned, false: queue is empty
+    bool Pop(AXIODIAGEVENT& zEvent)
+    {
+        // acquire: the realtime thread has written the event before it published the head
+        uint64_t uTail = m_uTail.load(std::memory_order_relaxed);
+        if(uTail == m_uHead.load(std::memory_order_acquire))
+        {
+            return(false);
+        }
+        zEvent = m_zQueue[uTail % AXIODIAG_QUEUE_SIZE];
+        m_uTail.store(uTail + 1, std::memory_order_release);
+        return(true);
+    }
+
+    /// @brief			name of a flag for logging
+    /// @param zFlag	flag
+    /// @return			name
+    static const char* GetFlagName(AXIODIAGFLAG zFlag)
+    {
+        static const char* s_szNames[AXIODIAG_FLAGS] = { "PW", "PF", "BUS", "RUN", "ACT", "RDY", "SYSFAIL" };
+        return((zFlag < AXIODIAG_FLAGS) ? s_szNames[zFlag] : "?");
+    }
+
+private:
+    RUNTIMEMETRICS* m_pMetrics;
+
+    // layout
+    size_t m_nStatusOffset;
+    size_t m_nParamOffset;
+    size_t m_nFlagOffset[AXIODIAG_FLAGS];
+    uint8_t m_ucFlagMask[AXIODIAG_FLAGS];
+
+    // state of the last read, only used by the realtime thread
+    bool m_bSampled;
+    bool m_bFaulted;
+    uint16_t m_uStatus;
+    uint16_t m_uParam;
+    uint32_t m_uFlags;		// bit n: flag n is set
+    uint32_t m_uSkipped;	// cycles since the last read
+
+    // queue from the realtime thread to the event loop
+    AXIODIAGEVENT m_zQueue[AXIODIAG_QUEUE_SIZE];
+    std::atomic<uint64_t> m_uHead;		// written by the realtime thread
+    std::atomic<uint64_t> m_uTail;		// written by the event loop
+
+    static uint16_t ReadRegister(const char* pFrame, size_t nOffset)
+    {
+        if(nOffset == SIZE_MAX)
+        {
+            return(0);
+        }
+        return((uint16_t)(((uint8_t)pFrame[nOffset] << 8) | (uint8_t)pFrame[nOffset + 1]));
+    }
+
+    void Push(AXIODIAGEVENTKIND zKind, AXIODIAGFLAG zFlag, uint16_t uStatus, uint16_t uParam, uint64_t uTimeNs)
+    {
+        uint64_t uHead = m_uHead.load(std::memory_order_relaxed);
+        if(uHead - m_uTail.load(std::memory_order_acquire) >= AXIODIAG_QUEUE_SIZE)
+        {
+            if(m_pMetrics != NULL)
+            {
+                IncrementMetric(m_pMetrics->uAxioDiagLost);
+            }
+            return;
+        }
+
+        AXIODIAGEVENT& zEvent = m_zQueue[uHead % AXIODIAG_QUEUE_SIZE];
+        zEvent.zKind = zKind;
+        zEvent.zFlag = zFlag;
+        zEvent.uStatus = uStatus;
+        zEvent.uParam = uParam;
+        zEvent.uTimeNs = uTimeNs;
+
+        // release: the event loop sees the event before the new head
+        m_uHead.store(uHead + 1, std::memory_order_release);
+
+        if(m_pMetrics != NULL)
+        {
+            IncrementMetric(m_pMetrics->uAxioDiagEvents);
+        }
+    }
+};
+
+#endif /* CAXIODIAGMONITOR_H_ */
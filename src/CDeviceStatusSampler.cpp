@@ -0,0 +1,160 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CDeviceStatusSampler.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#include "CDeviceStatusSampler.h"
+
+CDeviceStatusSampler::CDeviceStatusSampler()
+                    : m_bInitialized(false),
+                      m_uSampleIntervalMs(DEVICESTATUS_SAMPLE_INTERVAL),
+                      m_zCpuLevel(THROTTLE_NONE),
+                      m_zTempLevel(THROTTLE_NONE)
+{
+}
+
+CDeviceStatusSampler::~CDeviceStatusSampler()
+{
+}
+
+/// @brief						Init and start the sampling in the event loop
+/// @param pDeviceStatusService	device status service, acquired by the init pipeline
+/// @param pEventLoop			event loop for the sampling timer
+/// @param uSampleIntervalMs	interval for sampling the device status in ms
+/// @return						true: success, false: failure
+bool CDeviceStatusSampler::Init(IDeviceStatusService::Ptr pDeviceStatusService, CEventLoop* pEventLoop, uint32 uSampleIntervalMs)
+{
+    if(m_bInitialized)
+    {
+        // already initialized
+        return(true);
+    }
+
+    Log::Info("Call of CDeviceStatusSampler::Init");
+
+    bool bRet = false;
+
+    m_uSampleIntervalMs = (uSampleIntervalMs > 0) ? uSampleIntervalMs : DEVICESTATUS_SAMPLE_INTERVAL;
+    m_pDeviceStatusService = pDeviceStatusService;
+
+    if((m_pDeviceStatusService != NULL) && (pEventLoop != NULL))
+    {
+        // the first sample is taken before any other thread uses the status
+        Sample();
+
+        // the device status does not depend on the PLCnext Engineer program, so the sampler runs all the time
+        if(pEventLoop->AddTimer("device status sampler", m_uSampleIntervalMs, [this]() { Sample(); }))
+        {
+            m_bInitialized = true;
+            bRet = true;
+        }
+    }
+    else
+    {
+        Log::Error("Missing service (device status sampler)");
+    }
+
+    return(bRet);
+}
+
+/// @brief	status block for all threads, valid for the lifetime of the sampler
+/// @return	pointer to status block
+const DEVICESTATUS* CDeviceStatusSampler::GetStatus() const
+{
+    return(&m_zStatus);
+}
+
+/// @brief		read the dynamic values of the device status service and update the throttle level
+/// @return		true: success, false: failure
+bool CDeviceStatusSampler::Sample()
+{
+    bool bRet = false;
+
+    try
+    {
+        Arp::byte byCpuLoad = (Arp::byte)0;
+        Arp::byte byMemoryUsage = (Arp::byte)0;
+        int8 i8BoardTemp = 0;
+
+        RscVariant<512> rscValue = m_pDeviceStatusService->GetItem("Status.Cpu.0.Load.Percent");
+        rscValue.CopyTo(byCpuLoad);
+        rscValue = m_pDeviceStatusService->GetItem("Status.Memory.Usage.Percent");
+        rscValue.CopyTo(byMemoryUsage);
+        rscValue = m_pDeviceStatusService->GetItem("Status.Board.Temperature.Centigrade");
+        rscValue.CopyTo(i8BoardTemp);
+
+        m_zStatus.uCpuLoad.store((uint8_t)byCpuLoad, std::memory_order_relaxed);
+        m_zStatus.uMemoryUsage.store((uint8_t)byMemoryUsage, std::memory_order_relaxed);
+        m_zStatus.i8BoardTemp.store(i8BoardTemp, std::memory_order_relaxed);
+        m_zStatus.uSamples.fetch_add(1, std::memory_order_release);
+
+        // each signal keeps its own level with hysteresis, the higher level of both is used. So a
+        // signal near its threshold does not hold a level which only the other signal has raised
+        m_zCpuLevel = GetLevel((int)byCpuLoad, THROTTLE_CPU_REDUCED, THROTTLE_CPU_MINIMAL, m_zCpuLevel);
+        m_zTempLevel = GetLevel((int)i8BoardTemp, THROTTLE_TEMP_REDUCED, THROTTLE_TEMP_MINIMAL, m_zTempLevel);
+        THROTTLELEVEL zCurrent = m_zStatus.GetThrottleLevel();
+        THROTTLELEVEL zLevel = (m_zCpuLevel > m_zTempLevel) ? m_zCpuLevel : m_zTempLevel;
+
+        if(zLevel != zCurrent)
+        {
+            m_zStatus.uThrottleLevel.store(zLevel, std::memory_order_relaxed);
+            Log::Info("Device status: throttle level {0} -> {1} (CPU load {2} %, board temperature {3} C)",
+                      (int)zCurrent, (int)zLevel, (int)byCpuLoad, (int)i8BoardTemp);
+        }
+
+        bRet = true;
+    }
+    catch(Arp::Exception &e)
+    {
+        Log::Error("Sample - Arp Exception! {0}", e);
+    }
+    catch(...)
+    {
+        Log::Error("Sample - Unknown Exception occured");
+    }
+
+    return(bRet);
+}
+
+/// @brief				throttle level for a value without hysteresis
+/// @param nValue		current value
+/// @param nReduced		threshold for THROTTLE_REDUCED
+/// @param nMinimal		threshold for THROTTLE_MINIMAL
+/// @return				throttle level
+THROTTLELEVEL CDeviceStatusSampler::GetLevel(int nValue, int nReduced, int nMinimal)
+{
+    if(nValue >= nMinimal)
+    {
+        return(THROTTLE_MINIMAL);
+    }
+    if(nValue >= nReduced)
+    {
+        return(THROTTLE_REDUCED);
+    }
+    return(THROTTLE_NONE);
+}
+
+/// @brief				throttle level for a value, the current level is only lowered if the value
+/// 					is below the threshold minus THROTTLE_HYSTERESIS
+/// @param nValue		current value
+/// @param nReduced		threshold for THROTTLE_REDUCED
+/// @param nMinimal		threshold for THROTTLE_MINIMAL
+/// @param zCurrent		current throttle level of this value
+/// @return				throttle level
+THROTTLELEVEL CDeviceStatusSampler::GetLevel(int nValue, int nReduced, int nMinimal, THROTTLELEVEL zCurrent)
+{
+    THROTTLELEVEL zLevel = GetLevel(nValue, nReduced, nMinimal);
+    if(zLevel < zCurrent)
+    {
+        THROTTLELEVEL zHysteresisLevel = GetLevel(nValue + THROTTLE_HYSTERESIS, nReduced, nMinimal);
+        zLevel = (zHysteresisLevel < zCurrent) ? zHysteresisLevel : zCurrent;
+    }
+    return(zLevel);
+}
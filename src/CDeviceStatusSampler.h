@@ -0,0 +1,63 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CDeviceStatusSampler.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef CDEVICESTATUSSAMPLER_H_
+#define CDEVICESTATUSSAMPLER_H_
+
+#include "Arp/Device/Interface/Services/IDeviceStatusService.hpp"
+#include "Arp/System/Commons/Logging.h"
+#include "DeviceStatus.h"
+#include "CEventLoop.h"
+#include "Utility.h"
+
+using namespace std;
+using namespace Arp;
+using namespace Arp::Device::Interface::Services;
+
+#define DEVICESTATUS_SAMPLE_INTERVAL	1000	// default interval for sampling the device status in ms
+
+// thresholds for throttling of non-realtime work
+#define THROTTLE_CPU_REDUCED			70		// CPU load in percent
+#define THROTTLE_CPU_MINIMAL			90
+#define THROTTLE_TEMP_REDUCED			70		// board temperature in degrees centigrade
+#define THROTTLE_TEMP_MINIMAL			85
+#define THROTTLE_HYSTERESIS				5		// the level is lowered only below threshold - hysteresis
+
+class CDeviceStatusSampler
+{
+public:
+    CDeviceStatusSampler();
+    virtual ~CDeviceStatusSampler();
+
+    bool Init(IDeviceStatusService::Ptr pDeviceStatusService, CEventLoop* pEventLoop, uint32 uSampleIntervalMs = DEVICESTATUS_SAMPLE_INTERVAL);
+
+    // status block for all threads, valid for the lifetime of the sampler
+    const DEVICESTATUS* GetStatus() const;
+
+private:
+    bool m_bInitialized;		// class already initialized?
+    uint32 m_uSampleIntervalMs;	// interval for sampling
+
+    IDeviceStatusService::Ptr m_pDeviceStatusService;
+
+    DEVICESTATUS m_zStatus;
+
+    // the hysteresis is applied to each signal on its own, only the sampler uses these levels
+    THROTTLELEVEL m_zCpuLevel;
+    THROTTLELEVEL m_zTempLevel;
+
+    bool Sample();
+    static THROTTLELEVEL GetLevel(int nValue, int nReduced, int nMinimal);
+    static THROTTLELEVEL GetLevel(int nValue, int nReduced, int nMinimal, THROTTLELEVEL zCurrent);
+};
+
+#endif /* CDEVICESTATUSSAMPLER_H_ */
@@ -0,0 +1,250 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CEventLoop.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#include "CEventLoop.h"
+
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+
+CEventLoop g_zEventLoop;
+
+CEventLoop::CEventLoop()
+          : m_nEpoll(-1)
+{
+    pthread_mutex_init(&m_zMutex, NULL);
+}
+
+CEventLoop::~CEventLoop()
+{
+    for(map<int, EVENTSOURCE*>::iterator it = m_zSources.begin(); it != m_zSources.end(); it++)
+    {
+        if(it->second->bTimer)
+        {
+            close(it->first);
+        }
+        delete it->second;
+    }
+    if(m_nEpoll >= 0)
+    {
+        close(m_nEpoll);
+    }
+    pthread_mutex_destroy(&m_zMutex);
+}
+
+/// @brief	create the epoll instance, must be called before any timer or file descriptor is added
+/// @return	true: success, false: failure
+bool CEventLoop::Init()
+{
+    if(m_nEpoll >= 0)
+    {
+        // already initialized
+        return(true);
+    }
+
+    m_nEpoll = epoll_create1(EPOLL_CLOEXEC);
+
+    return(m_nEpoll >= 0);
+}
+
+/// @brief				add a periodic timer. If the loop was too busy to handle some expirations,
+/// 					the callback is called only once for all of them
+/// @param szName		name for logging, must be a literal
+/// @param uIntervalMs	interval in ms
+/// @param fnCallback	function to call in the loop thread
+/// @return				true: success, false: failure
+bool CEventLoop::AddTimer(const char* szName, uint32 uIntervalMs, const TIMERCALLBACK& fnCallback)
+{
+    bool bRet = false;
+
+    int nFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if(nFd >= 0)
+    {
+        itimerspec zTimer;
+        zTimer.it_interval.tv_sec = uIntervalMs / 1000;
+        zTimer.it_interval.tv_nsec = (uIntervalMs % 1000) * 1000000;
+        zTimer.it_value = zTimer.it_interval;
+
+        if(timerfd_settime(nFd, 0, &zTimer, NULL) == 0)
+        {
+            EVENTSOURCE* pSource = new EVENTSOURCE;
+            pSource->szName = szName;
+            pSource->nFd = nFd;
+            pSource->bTimer = true;
+            pSource->fnTimer = fnCallback;
+
+            bRet = AddSource(pSource, EPOLLIN);
+        }
+        else
+        {
+            Log::Error("Event loop: timerfd_settime failed for {0}", szName);
+        }
+
+        if(bRet == false)
+        {
+            close(nFd);
+        }
+    }
+    else
+    {
+        Log::Error("Event loop: timerfd_create failed for {0}", szName);
+    }
+
+    return(bRet);
+}
+
+/// @brief				add a file descriptor, e.g. a socket. The file descriptor stays owned by the caller
+/// @param szName		name for logging, must be a literal
+/// @param nFd			file descriptor
+/// @param uEvents		epoll events, e.g. EPOLLIN
+/// @param fnCallback	function to call in the loop thread with the received events
+/// @return				true: success, false: failure
+bool CEventLoop::AddFd(const char* szName, int nFd, uint32 uEvents, const FDCALLBACK& fnCallback)
+{
+    EVENTSOURCE* pSource = new EVENTSOURCE;
+    pSource->szName = szName;
+    pSource->nFd = nFd;
+    pSource->fnFd = fnCallback;
+
+    return(AddSource(pSource, uEvents));
+}
+
+/// @brief		remove a file descriptor before it is closed, only from a callback of the loop thread
+/// @param nFd	file descriptor
+/// @return		true: success, false: not registered
+bool CEventLoop::RemoveFd(int nFd)
+{
+    bool bRet = false;
+
+    pthread_mutex_lock(&m_zMutex);
+    map<int, EVENTSOURCE*>::iterator it = m_zSources.find(nFd);
+    if((it != m_zSources.end()) && (it->second->bTimer == false))
+    {
+        epoll_ctl(m_nEpoll, EPOLL_CTL_DEL, nFd, NULL);
+
+        // other events of the current dispatch may still point to the source
+        it->second->bRemoved = true;
+        m_zRemoved.push_back(it->second);
+        m_zSources.erase(it);
+        bRet = true;
+    }
+    pthread_mutex_unlock(&m_zMutex);
+
+    return(bRet);
+}
+
+/// @brief			register a source at epoll
+/// @param pSource	source, owned by the loop afterwards
+/// @param uEvents	epoll events
+/// @return			true: success, false: failure
+bool CEventLoop::AddSource(EVENTSOURCE* pSource, uint32 uEvents)
+{
+    bool bRet = false;
+
+    epoll_event zEvent;
+    zEvent.events = uEvents;
+    zEvent.data.ptr = pSource;
+
+    // the map is updated first, so the source is known when the first event arrives
+    pthread_mutex_lock(&m_zMutex);
+    if((m_nEpoll >= 0) && (m_zSources.find(pSource->nFd) == m_zSources.end()))
+    {
+        m_zSources[pSource->nFd] = pSource;
+        if(epoll_ctl(m_nEpoll, EPOLL_CTL_ADD, pSource->nFd, &zEvent) == 0)
+        {
+            bRet = true;
+        }
+        else
+        {
+            m_zSources.erase(pSource->nFd);
+        }
+    }
+    pthread_mutex_unlock(&m_zMutex);
+
+    if(bRet == false)
+    {
+        Log::Error("Event loop: adding {0} failed", pSource->szName);
+        delete pSource;
+    }
+
+    return(bRet);
+}
+
+/// @brief	wait for events and call the callbacks, does not return
+void CEventLoop::Run()
+{
+    Log::Info("Call of CEventLoop::Run");
+
+    epoll_event zEvents[EVENTLOOP_MAX_EVENTS];
+
+    while(true)
+    {
+        int nEvents = epoll_wait(m_nEpoll, zEvents, EVENTLOOP_MAX_EVENTS, -1);
+        if(nEvents < 0)
+        {
+            if(errno != EINTR)
+            {
+                Log::Error("Event loop: epoll_wait failed");
+                WAIT100ms
+            }
+            continue;
+        }
+
+        for(int nCount = 0; nCount < nEvents; nCount++)
+        {
+            Dispatch((EVENTSOURCE*)zEvents[nCount].data.ptr, zEvents[nCount].events);
+        }
+
+        // free the sources which were removed by the callbacks
+        pthread_mutex_lock(&m_zMutex);
+        for(size_t nCount = 0; nCount < m_zRemoved.size(); nCount++)
+        {
+            delete m_zRemoved[nCount];
+        }
+        m_zRemoved.clear();
+        pthread_mutex_unlock(&m_zMutex);
+    }
+}
+
+/// @brief			call the callback of a source
+/// @param pSource	source
+/// @param uEvents	received epoll events
+void CEventLoop::Dispatch(EVENTSOURCE* pSource, uint32 uEvents)
+{
+    if(pSource->bRemoved)
+    {
+        return;
+    }
+
+    uint64 uStartNs = GetMonotonicTimeNs();
+
+    if(pSource->bTimer)
+    {
+        // number of expirations, the timer is re-armed by reading
+        uint64 uExpirations = 0;
+        if(read(pSource->nFd, &uExpirations, sizeof(uExpirations)) == sizeof(uExpirations))
+        {
+            pSource->fnTimer();
+        }
+    }
+    else
+    {
+        pSource->fnFd(uEvents);
+    }
+
+    uint64 uDurationMs = (GetMonotonicTimeNs() - uStartNs) / 1000000;
+    if(uDurationMs > EVENTLOOP_SLOW_CALLBACK)
+    {
+        Log::Info("Event loop: {0} took {1} ms, other callbacks were delayed", pSource->szName, uDurationMs);
+    }
+}
@@ -0,0 +1,78 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CEventLoop.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef CEVENTLOOP_H_
+#define CEVENTLOOP_H_
+
+#include <pthread.h>
+#include <functional>
+#include <map>
+#include <vector>
+#include "Arp/System/Core/Arp.h"
+#include "Arp/System/Commons/Logging.h"
+#include "Utility.h"
+
+using namespace std;
+using namespace Arp;
+
+#define EVENTLOOP_MAX_EVENTS		16		// max. number of events handled per wakeup
+#define EVENTLOOP_SLOW_CALLBACK		50		// callbacks which take longer are logged, in ms
+
+typedef function<void()> TIMERCALLBACK;
+typedef function<void(uint32 uEvents)> FDCALLBACK;
+
+/// @brief	event loop for all periodic non-realtime work and I/O of the application, based on
+/// 		epoll and timerfd. It runs in the main thread, so the timers and sockets of all
+/// 		objects share one thread which only wakes up when there is something to do.
+/// 		The timers are periodic with absolute expiration times, so they do not drift like
+/// 		a loop with usleep. A callback must not block for a long time, because all other
+/// 		callbacks are delayed meanwhile.
+///
+/// 		Timers and file descriptors can be added from any thread, e.g. by the init pipeline.
+/// 		File descriptors can only be removed by callbacks in the loop thread.
+class CEventLoop
+{
+public:
+    CEventLoop();
+    virtual ~CEventLoop();
+
+    bool Init();
+    void Run();
+
+    bool AddTimer(const char* szName, uint32 uIntervalMs, const TIMERCALLBACK& fnCallback);
+    bool AddFd(const char* szName, int nFd, uint32 uEvents, const FDCALLBACK& fnCallback);
+    bool RemoveFd(int nFd);
+
+private:
+    ///	structure for a registered timer or file descriptor, its address is the user data of epoll
+    struct EVENTSOURCE
+    {
+        const char* szName = NULL;		// name for logging, must be a literal
+        int nFd = -1;
+        bool bTimer = false;			// timerfd owned by the loop
+        bool bRemoved = false;			// removed in the current dispatch, do not call again
+        TIMERCALLBACK fnTimer;
+        FDCALLBACK fnFd;
+    };
+
+    int m_nEpoll;
+    pthread_mutex_t m_zMutex;				// protects the maps of sources
+    map<int, EVENTSOURCE*> m_zSources;		// all registered sources by file descriptor
+    vector<EVENTSOURCE*> m_zRemoved;		// removed in the current dispatch, freed afterwards
+
+    bool AddSource(EVENTSOURCE* pSource, uint32 uEvents);
+    void Dispatch(EVENTSOURCE* pSource, uint32 uEvents);
+};
+
+extern CEventLoop g_zEventLoop;		// global, so it can run in the main thread
+
+#endif /* CEVENTLOOP_H_ */
@@ -0,0 +1,381 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CFrameRecorder.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#include "CFrameRecorder.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#define FNV_OFFSET	0xcbf29ce484222325ULL
+#define FNV_PRIME	0x100000001b3ULL
+
+/// @brief			FNV-1a hash
+/// @param uHash	hash of the previous data
+/// @param pData	data
+/// @param nSize	size of data in bytes
+/// @return			hash
+static uint64 HashFnv(uint64 uHash, const void* pData, size_t nSize)
+{
+    const unsigned char* pByte = (const unsigned char*)pData;
+    for(size_t nCount = 0; nCount < nSize; nCount++)
+    {
+        uHash ^= pByte[nCount];
+        uHash *= FNV_PRIME;
+    }
+    return(uHash);
+}
+
+#ifdef FRAME_RECORDER
+/// @brief			round up to 8 bytes
+/// @param nValue	value
+/// @return			aligned value
+static size_t AlignUp(size_t nValue)
+{
+    return((nValue + 7) & ~(size_t)7);
+}
+#endif
+
+CFrameRecorder::CFrameRecorder()
+              : m_nSetpointOffset(0),
+                m_nRecordSize(0),
+                m_uHead(0),
+                m_uTail(0),
+                m_uDropped(0),
+                m_pRecord(NULL),
+                m_uCycle(0),
+                m_bGap(false),
+                m_nFd(-1)
+{
+    for(int nArea = 0; nArea < PROCESSIMAGE_AREAS; nArea++)
+    {
+        m_nFrameOffset[nArea] = 0;
+        m_nSize[nArea] = 0;
+        m_nRecordOffset[nArea] = 0;
+    }
+    memset(&m_zHeader, 0, sizeof(m_zHeader));
+    pthread_mutex_init(&m_zMutex, NULL);
+}
+
+CFrameRecorder::~CFrameRecorder()
+{
+    Close();
+    pthread_mutex_destroy(&m_zMutex);
+}
+
+/// @brief	remove all I/Os of the layout, the file has to be closed before
+void CFrameRecorder::Clear()
+{
+    m_zEntries.clear();
+}
+
+/// @brief				add an I/O to the layout
+/// @param zArea		area of I/O
+/// @param strID		ID of I/O
+/// @param nFrameOffset	offset in bus-frame in byte
+/// @param nSize		data size in bytes
+/// @param ucBitMask	bitmask in case of a boolean value, 0 otherwise
+void CFrameRecorder::AddEntry(PROCESSIMAGEAREA zArea, const string& strID, size_t nFrameOffset, size_t nSize, unsigned char ucBitMask)
+{
+    PENDINGENTRY zEntry;
+    zEntry.zArea = zArea;
+    zEntry.strID = strID;
+    zEntry.nFrameOffset = nFrameOffset;
+    zEntry.nSize = (nSize > 0) ? nSize : 1;
+    zEntry.ucBitMask = ucBitMask;
+    m_zEntries.push_back(zEntry);
+}
+
+/// @brief	hash of the IDs, areas, offsets and sizes of all I/Os, a recording is only replayed
+/// 		with the same layout
+/// @return	hash
+uint64 CFrameRecorder::GetLayoutHash() const
+{
+    uint64 uHash = FNV_OFFSET;
+    for(const PENDINGENTRY& zEntry : m_zEntries)
+    {
+        uint64 uValues[4] = { (uint64)zEntry.zArea, zEntry.nFrameOffset, zEntry.nSize, zEntry.ucBitMask };
+        uHash = HashFnv(uHash, zEntry.strID.c_str(), zEntry.strID.size() + 1);
+        uHash = HashFnv(uHash, uValues, sizeof(uValues));
+    }
+    return(uHash);
+}
+
+/// @brief				create the ring file with the current layout, an existing file is kept as backup
+/// @param uCycleTimeUs	cycle time of the realtime thread in us, for the replay
+/// @param szFile		path of the file
+/// @return				true: success, false: failure, the frames are not recorded
+bool CFrameRecorder::Open(uint32 uCycleTimeUs, const char* szFile)
+{
+    Close();
+
+#ifdef FRAME_RECORDER
+    bool bRet = false;
+
+    // the part of the frame with all I/Os of an area
+    size_t nFrameEnd[PROCESSIMAGE_AREAS];
+    for(int nArea = 0; nArea < PROCESSIMAGE_AREAS; nArea++)
+    {
+        m_nFrameOffset[nArea] = SIZE_MAX;
+        nFrameEnd[nArea] = 0;
+    }
+    for(const PENDINGENTRY& zEntry : m_zEntries)
+    {
+        m_nFrameOffset[zEntry.zArea] = min(m_nFrameOffset[zEntry.zArea], zEntry.nFrameOffset);
+        nFrameEnd[zEntry.zArea] = max(nFrameEnd[zEntry.zArea], zEntry.nFrameOffset + zEntry.nSize);
+    }
+
+    // a record is the FRAMERECORD, the areas and the setpoints without any padding in between
+    size_t nOffset = sizeof(FRAMERECORD);
+    for(int nArea = 0; nArea < PROCESSIMAGE_AREAS; nArea++)
+    {
+        if(nFrameEnd[nArea] == 0)
+        {
+            m_nFrameOffset[nArea] = 0;
+        }
+        m_nSize[nArea] = nFrameEnd[nArea] - m_nFrameOffset[nArea];
+        m_nRecordOffset[nArea] = nOffset;
+        nOffset += m_nSize[nArea];
+    }
+    m_nSetpointOffset = nOffset;
+    m_nRecordSize = AlignUp(nOffset + sizeof(GDSSETPOINTS));
+
+    size_t nEntryOffset = AlignUp(sizeof(FRAMERECORDHEADER));
+    size_t nRecordOffset = AlignUp(nEntryOffset + m_zEntries.size() * sizeof(PROCESSIMAGEENTRY));
+
+    memset(&m_zHeader, 0, sizeof(m_zHeader));
+    m_zHeader.uMagic = FRAMERECORD_MAGIC;
+    m_zHeader.uVersion = FRAMERECORD_VERSION;
+    m_zHeader.uHeaderSize = sizeof(FRAMERECORDHEADER);
+    m_zHeader.uEntryOffset = nEntryOffset;
+    m_zHeader.uEntryCount = m_zEntries.size();
+    m_zHeader.uRecordOffset = nRecordOffset;
+    m_zHeader.uRecordSize = m_nRecordSize;
+    m_zHeader.uCapacity = FRAMERECORD_CAPACITY;
+    m_zHeader.uCycleTimeUs = uCycleTimeUs;
+    for(int nArea = 0; nArea < PROCESSIMAGE_AREAS; nArea++)
+    {
+        m_zHeader.uFrameOffset[nArea] = m_nFrameOffset[nArea];
+        m_zHeader.zAreas[nArea].uOffset = m_nRecordOffset[nArea];
+        m_zHeader.zAreas[nArea].uSize = m_nSize[nArea];
+    }
+    m_zHeader.zSetpoints.uOffset = m_nSetpointOffset;
+    m_zHeader.zSetpoints.uSize = sizeof(GDSSETPOINTS);
+    m_zHeader.uLayoutHash = GetLayoutHash();
+
+    // layout descriptor, the offsets of the values are relative to the start of a record
+    vector<PROCESSIMAGEENTRY> zFileEntries(m_zEntries.size());
+    for(size_t nCount = 0; nCount < m_zEntries.size(); nCount++)
+    {
+        const PENDINGENTRY& zEntry = m_zEntries[nCount];
+        PROCESSIMAGEENTRY& zFileEntry = zFileEntries[nCount];
+        memset(&zFileEntry, 0, sizeof(zFileEntry));
+        strncpy(zFileEntry.szID, zEntry.strID.c_str(), PROCESSIMAGE_IDLENGTH - 1);
+        zFileEntry.uOffset = m_nRecordOffset[zEntry.zArea] + (zEntry.nFrameOffset - m_nFrameOffset[zEntry.zArea]);
+        zFileEntry.uSize = zEntry.nSize;
+        zFileEntry.uBitMask = zEntry.ucBitMask;
+        zFileEntry.uArea = zEntry.zArea;
+    }
+
+    // the queue is touched now, so the realtime thread never gets a page fault
+    m_zQueue.assign(FRAMERECORD_QUEUE * m_nRecordSize, 0);
+    m_uHead.store(0, std::memory_order_relaxed);
+    m_uTail.store(0, std::memory_order_relaxed);
+    m_uDropped.store(0, std::memory_order_relaxed);
+    m_pRecord = NULL;
+    m_uCycle = 0;
+    m_bGap = false;
+
+    pthread_mutex_lock(&m_zMutex);
+
+    mkdir("logs", 0755);
+    string strOld = string(szFile) + ".old";
+    rename(szFile, strOld.c_str());
+
+    int nFd = open(szFile, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if(nFd >= 0)
+    {
+        size_t nEntrySize = zFileEntries.size() * sizeof(PROCESSIMAGEENTRY);
+        if((ftruncate(nFd, nRecordOffset + (size_t)FRAMERECORD_CAPACITY * m_nRecordSize) == 0) &&
+           (pwrite(nFd, zFileEntries.data(), nEntrySize, nEntryOffset) == (ssize_t)nEntrySize) &&
+           (pwrite(nFd, &m_zHeader, sizeof(m_zHeader), 0) == (ssize_t)sizeof(m_zHeader)))
+        {
+            m_nFd = nFd;
+            bRet = true;
+
+            Log::Info("Frame recorder: {0} I/Os, {1} bytes per cycle, {2} cycles in {3}", m_zEntries.size(), m_nRecordSize, FRAMERECORD_CAPACITY, szFile);
+        }
+        else
+        {
+            Log::Error("Frame recorder: writing the layout to {0} failed", szFile);
+            close(nFd);
+        }
+    }
+    else
+    {
+        Log::Error("Frame recorder: open of {0} failed", szFile);
+    }
+
+    pthread_mutex_unlock(&m_zMutex);
+
+    return(bRet);
+#else
+    (void)uCycleTimeUs;
+    (void)szFile;
+    return(false);
+#endif
+}
+
+/// @brief	write the queued records and close the file, the realtime thread must not record
+void CFrameRecorder::Close()
+{
+    Flush();
+
+    pthread_mutex_lock(&m_zMutex);
+    if(m_nFd >= 0)
+    {
+        fdatasync(m_nFd);
+        close(m_nFd);
+        m_nFd = -1;
+
+        Log::Info("Frame recorder: {0} cycles recorded, {1} dropped", m_zHeader.uRecords, m_zHeader.uDropped);
+    }
+    pthread_mutex_unlock(&m_zMutex);
+}
+
+/// @brief	take a record of the queue for the current cycle, if it is not full
+void CFrameRecorder::BeginRecord()
+{
+    // the file is not opened or closed while the realtime thread is inside its cycle
+    m_pRecord = NULL;
+    if(m_nFd < 0)
+    {
+        return;
+    }
+
+    // acquire: the event loop has written the record to the file before it released it
+    uint64 uHead = m_uHead.load(std::memory_order_relaxed);
+    if(uHead - m_uTail.load(std::memory_order_acquire) < FRAMERECORD_QUEUE)
+    {
+        m_pRecord = &m_zQueue[(uHead % FRAMERECORD_QUEUE) * m_nRecordSize];
+
+        FRAMERECORD* pRecord = (FRAMERECORD*)m_pRecord;
+        pRecord->uCycle = m_uCycle;
+        pRecord->uTimeNs = GetMonotonicTimeNs();
+        pRecord->uFlags = m_bGap ? FRAMERECORD_GAP : 0;
+    }
+}
+
+/// @brief			copy the part of the bus frame with the I/Os of an area
+/// @param zArea	area
+/// @param pFrame	pointer to bus frame, only valid inside of ArpPlcGds_BeginRead/BeginWrite
+void CFrameRecorder::CopyArea(PROCESSIMAGEAREA zArea, const char* pFrame)
+{
+    if(m_pRecord != NULL)
+    {
+        memcpy(m_pRecord + m_nRecordOffset[zArea], pFrame + m_nFrameOffset[zArea], m_nSize[zArea]);
+
+        // FRAMERECORD_INPUTS, FRAMERECORD_OUTPUTS and FRAMERECORD_DIAG are in the order of the areas
+        ((FRAMERECORD*)m_pRecord)->uFlags |= (FRAMERECORD_INPUTS << zArea);
+    }
+}
+
+/// @brief				hand the record of the cycle over to the event loop
+/// @param bValid		inputs and outputs of the cycle were valid
+/// @param zSetpoints	setpoints of the IEC program used by the logic in this cycle
+void CFrameRecorder::EndRecord(bool bValid, const GDSSETPOINTS& zSetpoints)
+{
+    if(m_nFd < 0)
+    {
+        return;
+    }
+
+    if(m_pRecord != NULL)
+    {
+        if(bValid)
+        {
+            ((FRAMERECORD*)m_pRecord)->uFlags |= FRAMERECORD_VALID;
+        }
+        memcpy(m_pRecord + m_nSetpointOffset, &zSetpoints, sizeof(GDSSETPOINTS));
+        m_pRecord = NULL;
+        m_bGap = false;
+
+        m_uHead.store(m_uHead.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+    else
+    {
+        // the event loop did not keep up, the replay sees the gap
+        m_uDropped.store(m_uDropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        m_bGap = true;
+    }
+
+    m_uCycle++;
+}
+
+/// @brief	write the queued records to the ring of the file and update the header
+/// @return	true: success or nothing to do, false: no file or write error
+bool CFrameRecorder::Flush()
+{
+    bool bRet = false;
+
+    pthread_mutex_lock(&m_zMutex);
+    if(m_nFd >= 0)
+    {
+        uint64 uTail = m_uTail.load(std::memory_order_relaxed);
+        uint64 uHead = m_uHead.load(std::memory_order_acquire);
+        uint64 uDropped = m_uDropped.load(std::memory_order_relaxed);
+        bool bChanged = (uTail != uHead) || (uDropped != m_zHeader.uDropped);
+        bRet = true;
+
+        while(bRet && (uTail != uHead))
+        {
+            // one write for the records which are contiguous in the queue and in the ring of the file
+            uint64 uCount = min(uHead - uTail, (uint64)FRAMERECORD_QUEUE - (uTail % FRAMERECORD_QUEUE));
+            uint64 uIndex = m_zHeader.uRecords % m_zHeader.uCapacity;
+            uCount = min(uCount, m_zHeader.uCapacity - uIndex);
+
+            size_t nSize = uCount * m_nRecordSize;
+            off_t nOffset = m_zHeader.uRecordOffset + uIndex * m_nRecordSize;
+            if(pwrite(m_nFd, &m_zQueue[(uTail % FRAMERECORD_QUEUE) * m_nRecordSize], nSize, nOffset) == (ssize_t)nSize)
+            {
+                uTail += uCount;
+                m_zHeader.uRecords += uCount;
+            }
+            else
+            {
+                bRet = false;
+            }
+        }
+
+        // release: the records can be used again by the realtime thread
+        m_uTail.store(uTail, std::memory_order_release);
+
+        if(bChanged)
+        {
+            m_zHeader.uDropped = uDropped;
+            if(pwrite(m_nFd, &m_zHeader, sizeof(m_zHeader), 0) != (ssize_t)sizeof(m_zHeader))
+            {
+                bRet = false;
+            }
+        }
+
+        if(bRet == false)
+        {
+            Log::Error("Frame recorder: write to file failed, cycles are dropped");
+        }
+    }
+    pthread_mutex_unlock(&m_zMutex);
+
+    return(bRet);
+}
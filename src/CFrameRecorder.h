@@ -0,0 +1,98 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CFrameRecorder.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef CFRAMERECORDER_H_
+#define CFRAMERECORDER_H_
+
+#include <pthread.h>
+#include <atomic>
+#include <string>
+#include <vector>
+#include "Arp/System/Core/Arp.h"
+#include "Arp/System/Commons/Logging.h"
+#include "FrameRecordFormat.h"
+#include "ProcessData.h"
+#include "Utility.h"
+
+using namespace Arp;
+using namespace std;
+
+// record the frames of every cycle for a replay on a host, uncomment to enable. The file is
+// written continuously (about 40 kB/s for the sample), so it is not enabled on the flash by default
+//#define FRAME_RECORDER
+
+#define FRAMERECORD_FILE			"logs/FrameRecord.bin"	// the previous file is kept as FrameRecord.bin.old
+#define FRAMERECORD_CAPACITY		60000		// records in the ring file, 60 s with a cycle time of 1 ms
+#define FRAMERECORD_QUEUE			1024		// records between realtime thread and event loop, power of 2
+#define FRAMERECORD_FLUSH_INTERVAL	100			// interval for writing the queued records to the file in ms
+#define FRAMERECORD_THROTTLE_REDUCED	2		// multiple of the flush interval on THROTTLE_REDUCED
+#define FRAMERECORD_THROTTLE_MINIMAL	5		// multiple of the flush interval on THROTTLE_MINIMAL, FRAMERECORD_QUEUE must hold its records
+
+/// @brief	records the input, output and diag frames of the realtime thread in a ring file, see
+/// 		FrameRecordFormat.h. The realtime thread copies one area per frame into a queue in
+/// 		normal memory without a system call or a lock. The event loop writes the queued
+/// 		records to the file. If the queue is full, the cycle is not recorded and counted.
+class CFrameRecorder
+{
+public:
+    CFrameRecorder();
+    virtual ~CFrameRecorder();
+
+    // layout, must not be called while the realtime thread records
+    void Clear();
+    void AddEntry(PROCESSIMAGEAREA zArea, const string& strID, size_t nFrameOffset, size_t nSize, unsigned char ucBitMask);
+    uint64 GetLayoutHash() const;
+    bool Open(uint32 uCycleTimeUs, const char* szFile = FRAMERECORD_FILE);
+    void Close();
+
+    // called by the realtime thread in every cycle
+    void BeginRecord();
+    void CopyArea(PROCESSIMAGEAREA zArea, const char* pFrame);
+    void EndRecord(bool bValid, const GDSSETPOINTS& zSetpoints);
+
+    // called by a non-realtime thread
+    bool Flush();
+
+private:
+    ///	structure to handle an I/O until the file is opened
+    struct PENDINGENTRY
+    {
+        PROCESSIMAGEAREA zArea;
+        string strID;
+        size_t nFrameOffset;		// offset in bus-frame in byte
+        size_t nSize;				// data size in bytes
+        unsigned char ucBitMask;	// bitmask in case of a boolean value
+    };
+    vector<PENDINGENTRY> m_zEntries;
+
+    // part of the bus frame which is copied for each area and its offset in a record
+    size_t m_nFrameOffset[PROCESSIMAGE_AREAS];
+    size_t m_nSize[PROCESSIMAGE_AREAS];
+    size_t m_nRecordOffset[PROCESSIMAGE_AREAS];
+    size_t m_nSetpointOffset;
+    size_t m_nRecordSize;
+
+    // queue between realtime thread and event loop
+    vector<unsigned char> m_zQueue;
+    std::atomic<uint64> m_uHead;		// next record of the realtime thread
+    std::atomic<uint64> m_uTail;		// next record of the event loop
+    std::atomic<uint64> m_uDropped;		// cycles which were not recorded
+    unsigned char* m_pRecord;			// record of the current cycle, NULL if the queue is full
+    uint64 m_uCycle;
+    bool m_bGap;
+
+    pthread_mutex_t m_zMutex;	// protects the file against a flush during open and close
+    int m_nFd;					// -1, if there is no file
+    FRAMERECORDHEADER m_zHeader;
+};
+
+#endif /* CFRAMERECORDER_H_ */
@@ -0,0 +1,324 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CGdsWriter.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#include "CGdsWriter.h"
+
+#define GDSWRITER_MAX_ERRORLOGS		10		// max. number of logged errors per flush to avoid flooding the log
+
+CGdsWriter::CGdsWriter()
+          : m_bInitialized(false),
+            m_bDoCycle(false),
+            m_uFlushIntervalMs(GDSWRITER_FLUSH_INTERVAL)
+{
+    pthread_mutex_init(&m_zMutex, NULL);
+    pthread_mutex_init(&m_zBatchMutex, NULL);
+}
+
+CGdsWriter::~CGdsWriter()
+{
+    pthread_mutex_destroy(&m_zBatchMutex);
+    pthread_mutex_destroy(&m_zMutex);
+}
+
+/// @brief						Init and start the writing in the event loop
+/// @param pDataAccessService	data access service, acquired by the init pipeline
+/// @param pEventLoop			event loop for the flush timer
+/// @param uFlushIntervalMs		interval for writing the queued values in ms
+/// @return						true: success, false: failure
+bool CGdsWriter::Init(IDataAccessService::Ptr pDataAccessService, CEventLoop* pEventLoop, uint32 uFlushIntervalMs)
+{
+    if(m_bInitialized)
+    {
+        // already initialized
+        return(true);
+    }
+
+    Log::Info("Call of CGdsWriter::Init");
+
+    bool bRet = false;
+
+    m_uFlushIntervalMs = (uFlushIntervalMs > 0) ? uFlushIntervalMs : GDSWRITER_FLUSH_INTERVAL;
+
+    m_pDataAccessService = pDataAccessService;
+
+    if((m_pDataAccessService != NULL) && (pEventLoop != NULL))
+    {
+        if(pEventLoop->AddTimer("GDS writer", m_uFlushIntervalMs, [this]() { Cycle(); }))
+        {
+            m_bInitialized = true;
+            bRet = true;
+        }
+    }
+    else
+    {
+        Log::Error("Missing service (GDS writer)");
+    }
+
+    return(bRet);
+}
+
+/// @brief	The thread will run continuously after creation but the writing of
+/// 		values can be started and stopped e.g. if a new PLCnext Engineer Program was loaded
+/// @return	true: success, false: failure
+bool CGdsWriter::StartProcessing()
+{
+    Log::Info("GDS writer: Start processing");
+
+    m_bDoCycle = true;
+
+    return(true);
+}
+
+/// @brief	Stop writing and drop all queued values, they might not fit to the next program.
+/// 		A batch which is already written is finished before, no batch is written after
+/// @return	true: success, false: failure
+bool CGdsWriter::StopProcessing()
+{
+    Log::Info("GDS writer: Stop processing");
+
+    pthread_mutex_lock(&m_zMutex);
+    m_bDoCycle = false;
+    size_t nDiscarded = m_zQueue.size();
+    m_zStats.uDiscarded += nDiscarded;
+    m_zQueue.clear();
+    pthread_mutex_unlock(&m_zMutex);
+
+    // a running flush checks the flag before its next batch, wait for the end of the current one
+    pthread_mutex_lock(&m_zBatchMutex);
+    pthread_mutex_unlock(&m_zBatchMutex);
+
+    if(nDiscarded > 0)
+    {
+        Log::Info("GDS writer: {0} queued values discarded", nDiscarded);
+    }
+
+    return(true);
+}
+
+/// @brief				queue a value for a GDS variable. If there is already a queued value for
+/// 					the same variable, it is replaced, so only the newest value is written.
+/// 					Do not call this from the realtime thread, use a mailbox instead
+/// @param strPortName	name of GDS variable
+/// @param zValue		new value
+/// @return				true: queued, false: processing is stopped
+bool CGdsWriter::Write(const string& strPortName, const RscVariant<512>& zValue)
+{
+    bool bRet = false;
+
+    pthread_mutex_lock(&m_zMutex);
+    if(m_bDoCycle)
+    {
+        m_zStats.uRequests++;
+
+        map<string, GDSWRITE>::iterator it = m_zQueue.find(strPortName);
+        if(it != m_zQueue.end())
+        {
+            // keep the queue time of the older request for the latency
+            it->second.zValue = zValue;
+            m_zStats.uCoalesced++;
+        }
+        else
+        {
+            GDSWRITE& zWrite = m_zQueue[strPortName];
+            zWrite.zValue = zValue;
+            zWrite.uQueueTimeNs = GetMonotonicTimeNs();
+        }
+        bRet = true;
+    }
+    pthread_mutex_unlock(&m_zMutex);
+
+    return(bRet);
+}
+
+/// @brief	number of variables which wait for writing
+/// @return	number of queued values
+size_t CGdsWriter::GetQueueDepth()
+{
+    pthread_mutex_lock(&m_zMutex);
+    size_t nDepth = m_zQueue.size();
+    pthread_mutex_unlock(&m_zMutex);
+
+    return(nDepth);
+}
+
+/// @brief	copy of the current statistics
+/// @return	statistics
+GDSWRITERSTATS CGdsWriter::GetStatistics()
+{
+    pthread_mutex_lock(&m_zMutex);
+    GDSWRITERSTATS zStats = m_zStats;
+    pthread_mutex_unlock(&m_zMutex);
+
+    return(zStats);
+}
+
+/// @brief		write the queued values, called by the event loop with the configured rate
+void CGdsWriter::Cycle()
+{
+    if(m_bDoCycle)
+    {
+        Flush();
+    }
+}
+
+/// @brief		write all queued values with as few RSC calls as possible
+/// @return		true: success, false: at least one value could not be written
+bool CGdsWriter::Flush()
+{
+    bool bRet = true;
+
+    // take over the queue, so new values can be queued while the RSC calls are running
+    map<string, GDSWRITE> zQueue;
+    pthread_mutex_lock(&m_zMutex);
+    zQueue.swap(m_zQueue);
+    pthread_mutex_unlock(&m_zMutex);
+
+    if(zQueue.empty())
+    {
+        return(bRet);
+    }
+
+    vector<map<string, GDSWRITE>::const_iterator> zBatch;
+    zBatch.reserve(min(zQueue.size(), (size_t)GDSWRITER_MAX_BATCH));
+
+    for(map<string, GDSWRITE>::const_iterator it = zQueue.begin(); it != zQueue.end(); it++)
+    {
+        zBatch.push_back(it);
+        if(zBatch.size() == GDSWRITER_MAX_BATCH)
+        {
+            if(WriteBatch(zBatch) == false)
+            {
+                bRet = false;
+            }
+            zBatch.clear();
+        }
+    }
+
+    if(zBatch.empty() == false)
+    {
+        if(WriteBatch(zBatch) == false)
+        {
+            bRet = false;
+        }
+    }
+
+    return(bRet);
+}
+
+/// @brief			write one batch of values with a single RSC call and evaluate the result of each value.
+/// 				After StopProcessing the batch is discarded
+/// @param zBatch	queued values
+/// @return			true: success, false: at least one value could not be written
+bool CGdsWriter::WriteBatch(vector<map<string, GDSWRITE>::const_iterator>& zBatch)
+{
+    bool bRet = true;
+
+    size_t nResults = 0;
+    size_t nErrors = 0;
+
+    // the flush took over the queue before, processing might have been stopped meanwhile
+    pthread_mutex_lock(&m_zBatchMutex);
+    pthread_mutex_lock(&m_zMutex);
+    bool bDoCycle = m_bDoCycle;
+    if(bDoCycle == false)
+    {
+        m_zStats.uDiscarded += zBatch.size();
+    }
+    pthread_mutex_unlock(&m_zMutex);
+
+    if(bDoCycle == false)
+    {
+        pthread_mutex_unlock(&m_zBatchMutex);
+        return(false);
+    }
+
+    try
+    {
+        IDataAccessService::WriteDataDelegate writeDataDelegate =
+            IDataAccessService::WriteDataDelegate::create([&](IRscWriteEnumerator<WriteItem>& writeEnumerator)
+        {
+            writeEnumerator.BeginWrite(zBatch.size());
+
+            WriteItem current;
+            for(size_t i = 0; i < zBatch.size(); i++)
+            {
+                current.PortName = zBatch[i]->first.c_str();
+                current.Value = zBatch[i]->second.zValue;
+                writeEnumerator.WriteNext(current);
+            }
+            writeEnumerator.EndWrite();
+        });
+
+        // the results have the same order as the written values
+        IDataAccessService::WriteReturnValueDelegate writeResultDelegate =
+            IDataAccessService::WriteReturnValueDelegate::create([&](IRscReadEnumerator<DataAccessError>& readEnumerator)
+        {
+            size_t valueCount = readEnumerator.BeginRead();
+
+            DataAccessError current;
+            for(size_t i = 0; i < valueCount; i++)
+            {
+                readEnumerator.ReadNext(current);
+                if(current != DataAccessError::None)
+                {
+                    if((nErrors < GDSWRITER_MAX_ERRORLOGS) && (i < zBatch.size()))
+                    {
+                        Log::Error("GDS writer: writing {0} returned error {1}", zBatch[i]->first, current);
+                    }
+                    nErrors++;
+                }
+            }
+            nResults = valueCount;
+            readEnumerator.EndRead();
+        });
+
+        m_pDataAccessService->Write(writeDataDelegate, writeResultDelegate);
+    }
+    catch(Arp::Exception &e)
+    {
+        Log::Error("WriteBatch - Arp Exception! {0}", e);
+    }
+    catch(...)
+    {
+        Log::Error("WriteBatch - Unknown Exception occured");
+    }
+
+    // values without a result were not written at all
+    if(nResults < zBatch.size())
+    {
+        nErrors += zBatch.size() - nResults;
+    }
+    if(nErrors > 0)
+    {
+        Log::Error("GDS writer: {0} of {1} values could not be written", nErrors, zBatch.size());
+        bRet = false;
+    }
+
+    // latency of the oldest request in this batch
+    uint64 uNow = GetMonotonicTimeNs();
+    uint64 uLatencyUs = 0;
+    for(size_t i = 0; i < zBatch.size(); i++)
+    {
+        uLatencyUs = max(uLatencyUs, (uNow - zBatch[i]->second.uQueueTimeNs) / 1000);
+    }
+
+    pthread_mutex_lock(&m_zMutex);
+    m_zStats.uBatches++;
+    m_zStats.uWritten += zBatch.size() - nErrors;
+    m_zStats.uErrors += nErrors;
+    m_zStats.uLastLatencyUs = uLatencyUs;
+    m_zStats.uMaxLatencyUs = max(m_zStats.uMaxLatencyUs, uLatencyUs);
+    pthread_mutex_unlock(&m_zMutex);
+    pthread_mutex_unlock(&m_zBatchMutex);
+
+    return(bRet);
+}
@@ -0,0 +1,87 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CGdsWriter.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef CGDSWRITER_H_
+#define CGDSWRITER_H_
+
+#include <pthread.h>
+#include <atomic>
+#include <map>
+#include <string>
+#include "Arp/Plc/Gds/Services/IDataAccessService.hpp"
+#include "Arp/System/Commons/Logging.h"
+#include "Utility.h"
+#include "CEventLoop.h"
+
+using namespace std;
+using namespace Arp;
+using namespace Arp::Plc::Gds::Services;
+
+#define GDSWRITER_FLUSH_INTERVAL	100		// default interval for writing the queued values in ms
+#define GDSWRITER_MAX_BATCH			1000	// max. number of values in one RSC call
+
+///	structure to handle a queued value for a GDS variable
+struct GDSWRITE
+{
+    RscVariant<512> zValue;		// newest value, older values of the same variable are overwritten
+    uint64 uQueueTimeNs = 0;	// time of the oldest not yet written request
+};
+
+///	structure with statistics of the writer
+struct GDSWRITERSTATS
+{
+    uint64 uRequests = 0;		// calls of Write()
+    uint64 uCoalesced = 0;		// requests which replaced a queued value of the same variable
+    uint64 uWritten = 0;		// values written without error
+    uint64 uErrors = 0;			// values rejected by the data access service
+    uint64 uDiscarded = 0;		// values dropped on stop of processing
+    uint64 uBatches = 0;		// calls of IDataAccessService::Write
+    uint64 uLastLatencyUs = 0;	// time from queueing to written of the last flush
+    uint64 uMaxLatencyUs = 0;
+};
+
+class CGdsWriter
+{
+public:
+    CGdsWriter();
+    virtual ~CGdsWriter();
+
+    bool Init(IDataAccessService::Ptr pDataAccessService, CEventLoop* pEventLoop, uint32 uFlushIntervalMs = GDSWRITER_FLUSH_INTERVAL);
+    void Cycle();
+
+    // start and stop our own processing
+    bool StartProcessing();
+    bool StopProcessing();
+
+    // queue a value, can be called from any non-realtime thread
+    bool Write(const string& strPortName, const RscVariant<512>& zValue);
+    size_t GetQueueDepth();
+    GDSWRITERSTATS GetStatistics();
+
+private:
+    pthread_mutex_t m_zMutex;		// protects queue and statistics
+    pthread_mutex_t m_zBatchMutex;	// held while a batch is written, StopProcessing waits for it
+
+    bool m_bInitialized;			// class already initialized?
+    std::atomic<bool> m_bDoCycle;	// shall the writer cycle run? Only cleared under m_zMutex
+    uint32 m_uFlushIntervalMs;	// interval for writing the queue
+
+    IDataAccessService::Ptr m_pDataAccessService;
+
+    map<string, GDSWRITE> m_zQueue;	// one entry per variable, so repeated writes are merged
+    GDSWRITERSTATS m_zStats;
+
+    bool Flush();
+    bool WriteBatch(vector<map<string, GDSWRITE>::const_iterator>& zBatch);
+};
+
+#endif /* CGDSWRITER_H_ */
@@ -0,0 +1,309 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CIOLogger.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#include "CIOLogger.h"
+
+#include <string.h>
+
+CIOLogger::CIOLogger()
+         : m_zMode(IOLOG_MODE),
+           m_uIntervalMs(IOLOG_INTERVAL),
+           m_uNowNs(0),
+           m_uLastIntervalNs(0),
+           m_bIntervalDue(false),
+           m_uChangedPoints(0),
+           m_uChanges(0),
+           m_pFile(NULL),
+           m_uFileStartNs(0),
+           m_nFileSize(0)
+{
+}
+
+CIOLogger::~CIOLogger()
+{
+    CloseFile();
+}
+
+/// @brief				set the mode of the logging
+/// @param zMode		mode of the logging
+/// @param uIntervalMs	interval of summary and sampled mode in ms
+/// @param bBinary		true: write a binary file, false: write to the text log
+/// @return				true: success, false: binary file cannot be created, the text log is used
+bool CIOLogger::Init(IOLOGMODE zMode, uint32 uIntervalMs, bool bBinary)
+{
+    bool bRet = true;
+
+    m_zMode = zMode;
+    m_uIntervalMs = (uIntervalMs > 0) ? uIntervalMs : IOLOG_INTERVAL;
+    m_uLastIntervalNs = GetMonotonicTimeNs();
+
+    CloseFile();
+    if(bBinary)
+    {
+        bRet = OpenFile();
+    }
+
+    Log::Info("I/O logging: mode {0}, interval {1} ms, {2}", (int)m_zMode, m_uIntervalMs, (m_pFile != NULL) ? IOLOG_BINARY_FILE : "text log");
+
+    return(bRet);
+}
+
+/// @brief			forget the state of all I/Os, e.g. if the I/O plans were compiled again
+/// @param nPoints	number of I/Os
+void CIOLogger::Reset(size_t nPoints)
+{
+    m_zPoints.assign(nPoints, IOLOGPOINT());
+    m_uChangedPoints = 0;
+    m_uChanges = 0;
+}
+
+/// @brief	start a logging cycle
+void CIOLogger::BeginCycle()
+{
+    m_uNowNs = GetMonotonicTimeNs();
+    m_bIntervalDue = ((m_uNowNs - m_uLastIntervalNs) >= (uint64)m_uIntervalMs * 1000000);
+    if(m_bIntervalDue)
+    {
+        m_uLastIntervalNs = m_uNowNs;
+    }
+}
+
+/// @brief			hand over the current value of an I/O
+/// @param nIndex	index of I/O, see Reset()
+/// @param strID	ID of I/O
+/// @param bIsBool	true, if it is a boolean
+/// @param nSize	data size in bytes
+/// @param uValue	current value, max. the first 8 bytes
+void CIOLogger::LogPoint(size_t nIndex, const string& strID, bool bIsBool, size_t nSize, uint64 uValue)
+{
+    if(nIndex >= m_zPoints.size())
+    {
+        return;
+    }
+
+    IOLOGPOINT& zPoint = m_zPoints[nIndex];
+    bool bFirst = (zPoint.bSeen == false);
+    if(bFirst || (zPoint.uValue != uValue))
+    {
+        if(bFirst == false)
+        {
+            zPoint.uChanges++;
+        }
+        zPoint.uValue = uValue;
+        zPoint.bSeen = true;
+    }
+
+    switch(m_zMode)
+    {
+        case IOLOG_ALL:
+            WritePoint(nIndex, strID, bIsBool, nSize, uValue, 0, IOLOGRECORD_VALUE);
+            zPoint.uChanges = 0;
+            break;
+
+        case IOLOG_CHANGES:
+            // the initial value is always logged. If a point changes faster than its rate limit,
+            // the newest value is logged when the limit elapsed, together with the number of skipped changes
+            if(bFirst || ((zPoint.uChanges > 0) && ((m_uNowNs - zPoint.uLastLogNs) >= (uint64)IOLOG_POINT_INTERVAL * 1000000)))
+            {
+                WritePoint(nIndex, strID, bIsBool, nSize, uValue, (zPoint.uChanges > 0) ? zPoint.uChanges - 1 : 0, IOLOGRECORD_VALUE);
+                zPoint.uChanges = 0;
+                zPoint.uLastLogNs = m_uNowNs;
+            }
+            break;
+
+        case IOLOG_SUMMARY:
+            if(m_bIntervalDue && (zPoint.uChanges > 0))
+            {
+                WritePoint(nIndex, strID, bIsBool, nSize, uValue, zPoint.uChanges, IOLOGRECORD_SUMMARY);
+                m_uChangedPoints++;
+                m_uChanges += zPoint.uChanges;
+                zPoint.uChanges = 0;
+            }
+            break;
+
+        case IOLOG_SAMPLED:
+            if(bFirst || m_bIntervalDue)
+            {
+                WritePoint(nIndex, strID, bIsBool, nSize, uValue, zPoint.uChanges, IOLOGRECORD_VALUE);
+                zPoint.uChanges = 0;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/// @brief	end a logging cycle
+void CIOLogger::EndCycle()
+{
+    if((m_zMode == IOLOG_SUMMARY) && m_bIntervalDue)
+    {
+        Log::Info("I/O summary: {0} of {1} I/Os changed {2} times in {3} ms", m_uChangedPoints, m_zPoints.size(), m_uChanges, m_uIntervalMs);
+        m_uChangedPoints = 0;
+        m_uChanges = 0;
+    }
+
+    if(m_pFile != NULL)
+    {
+        fflush(m_pFile);
+    }
+}
+
+/// @brief			write the value of an I/O to the binary file or the text log
+/// @param nIndex	index of I/O
+/// @param strID	ID of I/O
+/// @param bIsBool	true, if it is a boolean
+/// @param nSize	data size in bytes
+/// @param uValue	value
+/// @param uCount	suppressed changes or changes in the summary interval
+/// @param zType	IOLOGRECORD_VALUE or IOLOGRECORD_SUMMARY
+void CIOLogger::WritePoint(size_t nIndex, const string& strID, bool bIsBool, size_t nSize, uint64 uValue, uint32 uCount, IOLOGRECORDTYPE zType)
+{
+    // rotate the file before the records of this value are written, so the name of the I/O is not lost
+    if((m_pFile != NULL) &&
+       ((m_nFileSize + 2 * sizeof(IOLOGRECORDHEADER) + sizeof(IOLOGPOINTDEF) + strID.size() + sizeof(IOLOGVALUE)) > IOLOG_BINARY_MAXSIZE))
+    {
+        CloseFile();
+        OpenFile();
+    }
+
+    if(m_pFile != NULL)
+    {
+        IOLOGPOINT& zPoint = m_zPoints[nIndex];
+        if(zPoint.bDefined == false)
+        {
+            IOLOGPOINTDEF zDef;
+            zDef.bIsBool = bIsBool ? 1 : 0;
+            zDef.uSize = (nSize < sizeof(uint64)) ? nSize : sizeof(uint64);
+            zDef.uReserved = 0;
+            zPoint.bDefined = WriteRecord(IOLOGRECORD_POINT, nIndex, &zDef, sizeof(zDef), strID.c_str(), strID.size());
+        }
+
+        IOLOGVALUE zValue;
+        zValue.uTimeMs = (uint32)((m_uNowNs - m_uFileStartNs) / 1000000);
+        zValue.uCount = uCount;
+        zValue.uValue = uValue;
+        WriteRecord(zType, nIndex, &zValue, sizeof(zValue));
+        return;
+    }
+
+    // if you are wondering about the formatting syntax of the Log-Class, check
+    // http://fmtlib.net/latest/syntax.html
+    if(bIsBool)
+    {
+        Log::Info("{0}: {1} ({2})", strID, (uValue != 0), uCount);
+    }
+    else if(nSize == 1)
+    {
+        Log::Info("{0}: {1:#04x} ({2})", strID, uValue, uCount);
+    }
+    else if(nSize == 2)
+    {
+        Log::Info("{0}: {1:#06x} ({2})", strID, uValue, uCount);
+    }
+    else if(nSize <= 4)
+    {
+        Log::Info("{0}: {1:#010x} ({2})", strID, uValue, uCount);
+    }
+    else
+    {
+        Log::Info("{0}: {1:#018x} ({2})", strID, uValue, uCount);
+    }
+}
+
+/// @brief	create a new binary file, an existing file is kept as backup
+/// @return	true: success, false: failure
+bool CIOLogger::OpenFile()
+{
+    bool bRet = false;
+
+    string strOld = string(IOLOG_BINARY_FILE) + ".old";
+    rename(IOLOG_BINARY_FILE, strOld.c_str());
+
+    m_pFile = fopen(IOLOG_BINARY_FILE, "wb");
+    if(m_pFile != NULL)
+    {
+        timespec zTime;
+        clock_gettime(CLOCK_REALTIME, &zTime);
+        m_uFileStartNs = GetMonotonicTimeNs();
+
+        IOLOGFILEHEADER zHeader;
+        zHeader.uMagic = IOLOG_MAGIC;
+        zHeader.uVersion = IOLOG_VERSION;
+        zHeader.uHeaderSize = sizeof(IOLOGFILEHEADER);
+        zHeader.uStartTimeNs = (uint64)zTime.tv_sec * 1000000000ULL + (uint64)zTime.tv_nsec;
+
+        if(fwrite(&zHeader, sizeof(zHeader), 1, m_pFile) == 1)
+        {
+            m_nFileSize = sizeof(zHeader);
+
+            // the names of the I/Os are written again to the new file
+            for(IOLOGPOINT& zPoint : m_zPoints)
+            {
+                zPoint.bDefined = false;
+            }
+            bRet = true;
+        }
+        else
+        {
+            CloseFile();
+        }
+    }
+
+    if(bRet == false)
+    {
+        Log::Error("I/O logging: cannot create {0}, the text log is used", IOLOG_BINARY_FILE);
+    }
+
+    return(bRet);
+}
+
+/// @brief	close the binary file
+void CIOLogger::CloseFile()
+{
+    if(m_pFile != NULL)
+    {
+        fclose(m_pFile);
+        m_pFile = NULL;
+    }
+}
+
+/// @brief				write one record to the binary file
+/// @param zType		type of record
+/// @param uIndex		index of I/O
+/// @param pPayload		payload
+/// @param nLength		size of payload
+/// @param pExtra		optional data after the payload, e.g. the name of an I/O
+/// @param nExtraLength	size of optional data
+/// @return				true: success, false: failure
+bool CIOLogger::WriteRecord(IOLOGRECORDTYPE zType, uint32 uIndex, const void* pPayload, size_t nLength, const void* pExtra, size_t nExtraLength)
+{
+    if((nLength + nExtraLength) > UINT16_MAX)
+    {
+        return(false);
+    }
+
+    IOLOGRECORDHEADER zHeader;
+    zHeader.uType = (uint8)zType;
+    zHeader.uReserved = 0;
+    zHeader.uLength = (uint16)(nLength + nExtraLength);
+    zHeader.uIndex = uIndex;
+
+    bool bRet = (fwrite(&zHeader, sizeof(zHeader), 1, m_pFile) == 1) &&
+                (fwrite(pPayload, nLength, 1, m_pFile) == 1) &&
+                ((nExtraLength == 0) || (fwrite(pExtra, nExtraLength, 1, m_pFile) == 1));
+
+    m_nFileSize += sizeof(zHeader) + nLength + nExtraLength;
+
+    return(bRet);
+}
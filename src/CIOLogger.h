@@ -0,0 +1,96 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CIOLogger.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef CIOLOGGER_H_
+#define CIOLOGGER_H_
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "Arp/System/Core/Arp.h"
+#include "Arp/System/Commons/Logging.h"
+#include "IOLogFormat.h"
+#include "Utility.h"
+
+using namespace Arp;
+using namespace std;
+
+///	modes of the I/O logging
+enum IOLOGMODE
+{
+    IOLOG_ALL = 0,		// every I/O in every logging cycle
+    IOLOG_CHANGES,		// an I/O is logged when it changed, at most once per IOLOG_POINT_INTERVAL
+    IOLOG_SUMMARY,		// every IOLOG_INTERVAL the I/Os which changed, with the number of changes
+    IOLOG_SAMPLED		// every I/O once per IOLOG_INTERVAL
+};
+
+#define IOLOG_MODE				IOLOG_CHANGES		// mode of the I/O logging
+#define IOLOG_INTERVAL			10000				// interval of summary and sampled mode in ms
+#define IOLOG_POINT_INTERVAL	1000				// min. interval between two logs of the same I/O in ms
+
+// write the I/O log to a compact binary file instead of the text log, use tools/IOLogDecoder to read it
+//#define IOLOG_BINARY
+#define IOLOG_BINARY_FILE		"logs/IOLog.bin"	// the previous file is kept as IOLog.bin.old
+#define IOLOG_BINARY_MAXSIZE	(16 * 1024 * 1024)	// max. size of file in bytes, then it is rotated
+
+/// @brief	change-driven and rate-limited logging of I/O values. The logging cycle in the event loop
+/// 		hands over the value of every I/O each time it runs, the logger decides which values are
+/// 		written to the text log or to a binary file. Changes between two logging cycles are not
+/// 		detected.
+class CIOLogger
+{
+public:
+    CIOLogger();
+    virtual ~CIOLogger();
+
+    bool Init(IOLOGMODE zMode = IOLOG_MODE, uint32 uIntervalMs = IOLOG_INTERVAL, bool bBinary = false);
+    void Reset(size_t nPoints);
+
+    // called by the logging cycle
+    void BeginCycle();
+    void LogPoint(size_t nIndex, const string& strID, bool bIsBool, size_t nSize, uint64 uValue);
+    void EndCycle();
+
+private:
+    ///	structure to handle the state of one I/O
+    struct IOLOGPOINT
+    {
+        uint64 uValue = 0;			// last seen value
+        uint64 uLastLogNs = 0;		// time of last log
+        uint32 uChanges = 0;		// changes since the last log
+        bool bSeen = false;			// value was handed over at least once
+        bool bDefined = false;		// name was written to the binary file
+    };
+
+    IOLOGMODE m_zMode;
+    uint32 m_uIntervalMs;
+    vector<IOLOGPOINT> m_zPoints;
+
+    // state of the current logging cycle
+    uint64 m_uNowNs;
+    uint64 m_uLastIntervalNs;	// start of current summary or sample interval
+    bool m_bIntervalDue;		// summary or sample interval elapsed in this cycle
+    uint32 m_uChangedPoints;	// summary: I/Os which changed in the interval
+    uint32 m_uChanges;			// summary: changes of all I/Os in the interval
+
+    // binary file
+    FILE* m_pFile;
+    uint64 m_uFileStartNs;		// monotonic time of creation of file
+    size_t m_nFileSize;
+    bool OpenFile();
+    void CloseFile();
+    bool WriteRecord(IOLOGRECORDTYPE zType, uint32 uIndex, const void* pPayload, size_t nLength, const void* pExtra = NULL, size_t nExtraLength = 0);
+
+    void WritePoint(size_t nIndex, const string& strID, bool bIsBool, size_t nSize, uint64 uValue, uint32 uCount, IOLOGRECORDTYPE zType);
+};
+
+#endif /* CIOLOGGER_H_ */
@@ -0,0 +1,302 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CMetricsServer.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#include "CMetricsServer.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+
+CMetricsServer::CMetricsServer()
+              : m_bInitialized(false),
+                m_nSocket(-1),
+                m_pEventLoop(NULL),
+                m_pMetrics(NULL),
+                m_pGdsWriter(NULL),
+                m_pDeviceStatus(NULL)
+{
+}
+
+CMetricsServer::~CMetricsServer()
+{
+    for(map<int, uint64>::iterator it = m_zClients.begin(); it != m_zClients.end(); it++)
+    {
+        close(it->first);
+    }
+    if(m_nSocket >= 0)
+    {
+        close(m_nSocket);
+        unlink(METRICS_SOCKET_PATH);
+    }
+}
+
+/// @brief					create the socket and register it at the event loop
+/// @param pMetrics			metrics of the runtime
+/// @param pGdsWriter		writer for the queue depth and statistics
+/// @param pDeviceStatus	status of the device
+/// @param pEventLoop		event loop for the sockets
+/// @return					true: success, false: failure
+bool CMetricsServer::Init(const RUNTIMEMETRICS* pMetrics, CGdsWriter* pGdsWriter, const DEVICESTATUS* pDeviceStatus, CEventLoop* pEventLoop)
+{
+    if(m_bInitialized)
+    {
+        // already initialized
+        return(true);
+    }
+
+    Log::Info("Call of CMetricsServer::Init");
+
+    bool bRet = false;
+
+    if((pMetrics == NULL) || (pGdsWriter == NULL) || (pDeviceStatus == NULL) || (pEventLoop == NULL))
+    {
+        Log::Error("Null pointer in CMetricsServer::Init");
+        return(false);
+    }
+    m_pMetrics = pMetrics;
+    m_pGdsWriter = pGdsWriter;
+    m_pDeviceStatus = pDeviceStatus;
+    m_pEventLoop = pEventLoop;
+
+    sockaddr_un zAddress;
+    memset(&zAddress, 0, sizeof(zAddress));
+    zAddress.sun_family = AF_UNIX;
+    strncpy(zAddress.sun_path, METRICS_SOCKET_PATH, sizeof(zAddress.sun_path) - 1);
+
+    // a socket file of a previous run would make bind fail
+    unlink(METRICS_SOCKET_PATH);
+
+    m_nSocket = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if(m_nSocket >= 0)
+    {
+        if((bind(m_nSocket, (sockaddr*)&zAddress, sizeof(zAddress)) == 0) && (listen(m_nSocket, 4) == 0))
+        {
+            // clients which do not send a request get the metrics after the timeout
+            if(m_pEventLoop->AddFd("metrics server", m_nSocket, EPOLLIN, [this](uint32) { Accept(); }) &&
+               m_pEventLoop->AddTimer("metrics timeout", METRICS_RECEIVE_TIMEOUT, [this]() { CheckTimeouts(); }))
+            {
+                Log::Info("Metrics endpoint: {0}", METRICS_SOCKET_PATH);
+                m_bInitialized = true;
+                bRet = true;
+            }
+        }
+        else
+        {
+            Log::Error("Error binding metrics socket {0}", METRICS_SOCKET_PATH);
+        }
+
+        if(bRet == false)
+        {
+            close(m_nSocket);
+            m_nSocket = -1;
+        }
+    }
+    else
+    {
+        Log::Error("Error creating metrics socket");
+    }
+
+    return(bRet);
+}
+
+/// @brief	accept all waiting clients, called by the event loop
+void CMetricsServer::Accept()
+{
+    while(true)
+    {
+        int nClient = accept4(m_nSocket, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if(nClient < 0)
+        {
+            break;
+        }
+
+        if((m_zClients.size() >= METRICS_MAX_CLIENTS) ||
+           (m_pEventLoop->AddFd("metrics client", nClient, EPOLLIN | EPOLLRDHUP, [this, nClient](uint32) { HandleClient(nClient, true); }) == false))
+        {
+            close(nClient);
+            continue;
+        }
+        m_zClients[nClient] = GetMonotonicTimeNs();
+    }
+}
+
+/// @brief	answer the clients which did not send a request within METRICS_RECEIVE_TIMEOUT
+void CMetricsServer::CheckTimeouts()
+{
+    uint64 uNow = GetMonotonicTimeNs();
+
+    vector<int> zExpired;
+    for(map<int, uint64>::iterator it = m_zClients.begin(); it != m_zClients.end(); it++)
+    {
+        if(uNow - it->second >= (uint64)METRICS_RECEIVE_TIMEOUT * 1000000)
+        {
+            zExpired.push_back(it->first);
+        }
+    }
+
+    for(size_t nCount = 0; nCount < zExpired.size(); nCount++)
+    {
+        HandleClient(zExpired[nCount], false);
+    }
+}
+
+/// @brief			answer the request of a client and close the connection
+/// @param nClient	socket of client
+/// @param bReceive	true: the request can be received, false: answer without request
+void CMetricsServer::HandleClient(int nClient, bool bReceive)
+{
+    m_pEventLoop->RemoveFd(nClient);
+    m_zClients.erase(nClient);
+
+    char szRequest[1024];
+    ssize_t nReceived = bReceive ? recv(nClient, szRequest, sizeof(szRequest) - 1, 0) : 0;
+    bool bHttp = (nReceived >= 4) && (strncmp(szRequest, "GET ", 4) == 0);
+
+    string strBody;
+    FormatMetrics(strBody);
+
+    string strResponse;
+    if(bHttp)
+    {
+        char szHeader[128];
+        snprintf(szHeader, sizeof(szHeader),
+                 "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: %zu\r\n\r\n", strBody.size());
+        strResponse = szHeader;
+    }
+    strResponse += strBody;
+
+    // the answer fits into the socket buffer, the event loop must not wait for a slow client
+    send(nClient, strResponse.data(), strResponse.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+
+    close(nClient);
+}
+
+/// @brief			create the text of all metrics
+/// @param strText	text in Prometheus format
+void CMetricsServer::FormatMetrics(string& strText)
+{
+    strText.reserve(8192);
+
+    // realtime thread
+    FormatSummary(strText, "rt_cycle_duration_seconds", "Processing time of the realtime cycle", NULL, m_pMetrics->zRTCycleDuration);
+    FormatSummary(strText, "rt_wakeup_latency_seconds", "Time from planned to actual start of the realtime cycle", NULL, m_pMetrics->zRTWakeupLatency);
+    FormatValue(strText, "rt_cycles_total", "counter", "Processed realtime cycles", m_pMetrics->uRTCycles.load(std::memory_order_relaxed));
+    FormatValue(strText, "rt_overruns_total", "counter", "Realtime violations", m_pMetrics->uRTOverruns.load(std::memory_order_relaxed));
+    FormatSummary(strText, "rt_wakeup_spin_seconds", "Busy-polling before the start of the realtime cycle", NULL, m_pMetrics->zRTSpinTime);
+    FormatValue(strText, "rt_wakeup_guard_seconds", "gauge", "Guard interval of the sleep before the realtime cycle", m_pMetrics->uRTWakeupGuardNs.load(std::memory_order_relaxed) / 1e9);
+    FormatValue(strText, "rt_late_wakeups_total", "counter", "Wakeups after the guard interval", m_pMetrics->uRTLateWakeups.load(std::memory_order_relaxed));
+    FormatValue(strText, "rt_stale_cycles_total", "counter", "Realtime cycles without a fresh input frame", m_pMetrics->uRTStaleCycles.load(std::memory_order_relaxed));
+    FormatValue(strText, "rt_input_age_seconds", "gauge", "Time since the last fresh input frame", m_pMetrics->uRTInputAgeUs.load(std::memory_order_relaxed) / 1e6);
+    FormatValue(strText, "rt_phase_lag_seconds", "gauge", "Measured time from the update of the input frame to the start of the realtime cycle", m_pMetrics->uRTPhaseLagNs.load(std::memory_order_relaxed) / 1e9);
+    FormatValue(strText, "rt_phase_corrections_total", "counter", "Shifts of the phase of the realtime cycle", m_pMetrics->uRTPhaseCorrections.load(std::memory_order_relaxed));
+    FormatValue(strText, "rt_phase_misses_total", "counter", "Measurements of the phase without enough changes of the inputs", m_pMetrics->uRTPhaseMisses.load(std::memory_order_relaxed));
+    FormatValue(strText, "axio_diag_reads_total", "counter", "Reads of the diagnosis registers of the AXIO bus", m_pMetrics->uAxioDiagReads.load(std::memory_order_relaxed));
+    FormatValue(strText, "axio_diag_events_total", "counter", "Changes of the AXIO diagnosis queued for the event loop", m_pMetrics->uAxioDiagEvents.load(std::memory_order_relaxed));
+    FormatValue(strText, "axio_diag_events_lost_total", "counter", "Changes of the AXIO diagnosis lost on a full queue", m_pMetrics->uAxioDiagLost.load(std::memory_order_relaxed));
+    FormatValue(strText, "axio_diag_status", "gauge", "AXIO_DIAG_STATUS_REG of the last read", m_pMetrics->uAxioDiagStatus.load(std::memory_order_relaxed));
+    FormatValue(strText, "rt_stalls_total", "counter", "Stalls of a realtime thread detected by the watchdog", m_pMetrics->uRTStalls.load(std::memory_order_relaxed));
+    FormatValue(strText, "rt_longest_stall_seconds", "gauge", "Longest time without a heartbeat of a stalled realtime thread", m_pMetrics->uRTLongestStallUs.load(std::memory_order_relaxed) / 1e6);
+    FormatSummary(strText, "gds_lock_hold_seconds", "Time a GDS buffer is locked by the realtime thread", "buffer=\"input\"", m_pMetrics->zGdsInLockHold);
+    FormatSummary(strText, "gds_lock_hold_seconds", NULL, "buffer=\"output\"", m_pMetrics->zGdsOutLockHold, false);
+    FormatSummary(strText, "gds_lock_hold_seconds", NULL, "buffer=\"diag\"", m_pMetrics->zGdsDiagLockHold, false);
+
+    // subscription cycle
+    FormatSummary(strText, "subscription_poll_seconds", "Time to read and decode one subscription", NULL, m_pMetrics->zSubscriptionPoll);
+    FormatValue(strText, "subscription_reads_total", "counter", "Reads of subscriptions", m_pMetrics->uSubscriptionReads.load(std::memory_order_relaxed));
+    FormatValue(strText, "subscription_errors_total", "counter", "Failed reads of subscriptions", m_pMetrics->uSubscriptionErrors.load(std::memory_order_relaxed));
+    FormatValue(strText, "subscription_store_bytes", "gauge", "Memory of the subscription value stores", m_pMetrics->uValueStoreBytes.load(std::memory_order_relaxed));
+
+    // GDS writer, the statistics are protected by its mutex which is never used by the realtime thread
+    GDSWRITERSTATS zStats = m_pGdsWriter->GetStatistics();
+    FormatValue(strText, "gds_writer_queue_depth", "gauge", "Values waiting to be written to the GDS", m_pGdsWriter->GetQueueDepth());
+    FormatValue(strText, "gds_writer_written_total", "counter", "Values written to the GDS", zStats.uWritten);
+    FormatValue(strText, "gds_writer_errors_total", "counter", "Values rejected by the data access service", zStats.uErrors);
+    FormatValue(strText, "gds_writer_coalesced_total", "counter", "Values replaced by a newer value before writing", zStats.uCoalesced);
+    FormatValue(strText, "gds_writer_max_latency_seconds", "gauge", "Max. time from queueing to writing", zStats.uMaxLatencyUs / 1e6);
+
+    // memory and device
+    long lPageSize = sysconf(_SC_PAGESIZE);
+    unsigned long ulSize = 0;
+    unsigned long ulResident = 0;
+    FILE* pStatm = fopen("/proc/self/statm", "r");
+    if(pStatm != NULL)
+    {
+        if(fscanf(pStatm, "%lu %lu", &ulSize, &ulResident) != 2)
+        {
+            ulSize = 0;
+            ulResident = 0;
+        }
+        fclose(pStatm);
+    }
+    FormatValue(strText, "process_virtual_memory_bytes", "gauge", "Virtual memory of the process", (double)ulSize * lPageSize);
+    FormatValue(strText, "process_resident_memory_bytes", "gauge", "Resident memory of the process", (double)ulResident * lPageSize);
+    FormatValue(strText, "device_cpu_load_percent", "gauge", "CPU load of the device", m_pDeviceStatus->uCpuLoad.load(std::memory_order_relaxed));
+    FormatValue(strText, "device_memory_usage_percent", "gauge", "Memory usage of the device", m_pDeviceStatus->uMemoryUsage.load(std::memory_order_relaxed));
+    FormatValue(strText, "device_board_temperature_celsius", "gauge", "Board temperature of the device", m_pDeviceStatus->i8BoardTemp.load(std::memory_order_relaxed));
+    FormatValue(strText, "device_throttle_level", "gauge", "Throttle level of non-realtime work", m_pDeviceStatus->GetThrottleLevel());
+}
+
+/// @brief				add a histogram as Prometheus summary with quantiles, sum, count and max
+/// @param strText		text in Prometheus format
+/// @param szName		name without prefix
+/// @param szHelp		description, only used with the header
+/// @param szLabel		optional label, e.g. buffer="input"
+/// @param zHistogram	histogram
+/// @param bHeader		add HELP and TYPE, only once per name
+void CMetricsServer::FormatSummary(string& strText, const char* szName, const char* szHelp, const char* szLabel, const CMetricHistogram& zHistogram, bool bHeader)
+{
+    static const char* s_szQuantiles[] = { "0.5", "0.9", "0.99", "0.999" };
+    static const double s_dQuantiles[] = { 0.5, 0.9, 0.99, 0.999 };
+
+    char szLine[256];
+    const char* szSeparator = (szLabel != NULL) ? "," : "";
+    const char* szLabels = (szLabel != NULL) ? szLabel : "";
+
+    if(bHeader)
+    {
+        snprintf(szLine, sizeof(szLine), "# HELP " METRICS_PREFIX "%s %s\n# TYPE " METRICS_PREFIX "%s summary\n", szName, szHelp, szName);
+        strText += szLine;
+    }
+
+    for(size_t nCount = 0; nCount < sizeof(s_dQuantiles) / sizeof(s_dQuantiles[0]); nCount++)
+    {
+        snprintf(szLine, sizeof(szLine), METRICS_PREFIX "%s{%s%squantile=\"%s\"} %.9f\n",
+                 szName, szLabels, szSeparator, s_szQuantiles[nCount], zHistogram.GetQuantileNs(s_dQuantiles[nCount]) / 1e9);
+        strText += szLine;
+    }
+
+    const char* szOpen = (szLabel != NULL) ? "{" : "";
+    const char* szClose = (szLabel != NULL) ? "}" : "";
+    snprintf(szLine, sizeof(szLine), METRICS_PREFIX "%s_sum%s%s%s %.9f\n", szName, szOpen, szLabels, szClose, zHistogram.GetSumNs() / 1e9);
+    strText += szLine;
+    snprintf(szLine, sizeof(szLine), METRICS_PREFIX "%s_count%s%s%s %llu\n", szName, szOpen, szLabels, szClose, (unsigned long long)zHistogram.GetCount());
+    strText += szLine;
+    snprintf(szLine, sizeof(szLine), METRICS_PREFIX "%s_max%s%s%s %.9f\n", szName, szOpen, szLabels, szClose, zHistogram.GetMaxNs() / 1e9);
+    strText += szLine;
+}
+
+/// @brief				add a single counter or gauge
+/// @param strText		text in Prometheus format
+/// @param szName		name without prefix
+/// @param szType		counter or gauge
+/// @param szHelp		description
+/// @param dValue		value
+void CMetricsServer::FormatValue(string& strText, const char* szName, const char* szType, const char* szHelp, double dValue)
+{
+    char szLine[256];
+    snprintf(szLine, sizeof(szLine), "# HELP " METRICS_PREFIX "%s %s\n# TYPE " METRICS_PREFIX "%s %s\n" METRICS_PREFIX "%s %.17g\n",
+             szName, szHelp, szName, szType, szName, dValue);
+    strText += szLine;
+}
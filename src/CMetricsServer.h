@@ -0,0 +1,65 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CMetricsServer.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef CMETRICSSERVER_H_
+#define CMETRICSSERVER_H_
+
+#include <map>
+#include <string>
+#include "Arp/System/Core/Arp.h"
+#include "Arp/System/Commons/Logging.h"
+#include "RuntimeMetrics.h"
+#include "DeviceStatus.h"
+#include "CGdsWriter.h"
+#include "CEventLoop.h"
+
+using namespace std;
+using namespace Arp;
+
+#define METRICS_SOCKET_PATH		"/tmp/PLCnextSampleRuntime.metrics"	// Unix domain socket of the endpoint
+#define METRICS_PREFIX			"sampleruntime_"					// prefix of all metric names
+#define METRICS_RECEIVE_TIMEOUT	100									// max. time to wait for the request in ms
+#define METRICS_MAX_CLIENTS		8									// max. number of clients waiting for their answer
+
+/// @brief	local metrics endpoint in Prometheus text format on a Unix domain socket. A client
+/// 		connects, optionally sends a HTTP GET request and gets the current metrics, e.g.
+/// 			curl --unix-socket /tmp/PLCnextSampleRuntime.metrics http://localhost/metrics
+/// 		The metrics are only read, so the endpoint never blocks the threads which write them.
+/// 		The sockets are handled by the event loop, no thread is needed.
+class CMetricsServer
+{
+public:
+    CMetricsServer();
+    virtual ~CMetricsServer();
+
+    bool Init(const RUNTIMEMETRICS* pMetrics, CGdsWriter* pGdsWriter, const DEVICESTATUS* pDeviceStatus, CEventLoop* pEventLoop);
+
+private:
+    bool m_bInitialized;	// class already initialized?
+    int m_nSocket;			// listening socket
+
+    CEventLoop* m_pEventLoop;
+    map<int, uint64> m_zClients;	// connected clients without answer and their time of connection in ns
+
+    const RUNTIMEMETRICS* m_pMetrics;
+    CGdsWriter* m_pGdsWriter;
+    const DEVICESTATUS* m_pDeviceStatus;
+
+    void Accept();
+    void CheckTimeouts();
+    void HandleClient(int nClient, bool bReceive);
+    void FormatMetrics(string& strText);
+    static void FormatSummary(string& strText, const char* szName, const char* szHelp, const char* szLabel, const CMetricHistogram& zHistogram, bool bHeader = true);
+    static void FormatValue(string& strText, const char* szName, const char* szType, const char* szHelp, double dValue);
+};
+
+#endif /* CMETRICSSERVER_H_ */
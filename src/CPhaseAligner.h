@@ -0,0 +1,362 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CPhaseAligner.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef CPHASEALIGNER_H_
+#define CPHASEALIGNER_H_
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include "RuntimeMetrics.h"
+
+// align the start of the realtime cycle to the update of the input frame by the bus, uncomment
+// to enable. While it measures, the realtime thread polls the input frame in the idle time of
+// its cycle, so at least one input must change from time to time (e.g. an analog input)
+//#define PHASE_ALIGN
+
+#define PHASEALIGN_BUS_CYCLE		500		// update cycle of the input frame in us, RTCYCLETIME must be a multiple of it
+#define PHASEALIGN_MARGIN			20000	// planned time from the update of the input frame to the cycle start in ns
+#define PHASEALIGN_PROBE_INTERVAL	5000	// time between two polls of the input frame in ns
+#define PHASEALIGN_RESOLUTION		15000	// max. time between the two polls around a measured update in ns
+#define PHASEALIGN_SLACK			10000	// end of the polling before the start of the next cycle in ns
+#define PHASEALIGN_MAX_STEP			10000	// max. shift of one cycle start in ns
+#define PHASEALIGN_CALIBRATION		8		// measured updates for the first alignment
+#define PHASEALIGN_TRACKING			3		// measured updates for each later correction of the drift
+#define PHASEALIGN_TRACK_INTERVAL	1000	// cycles between two measurements of the drift
+#define PHASEALIGN_MAX_DRIFT		200000	// max. compensated drift in ns per 1000 cycles (200 ppm with 1 ms)
+#define PHASEALIGN_MEASURE_CYCLES	5000	// max. cycles of one measurement
+#define PHASEALIGN_MAX_BACKOFF		64		// max. factor of the interval after measurements without a result
+#define PHASEALIGN_BLIND_LIMIT		4		// updates in a row outside of the polling before the phase is moved by half a bus cycle
+
+/// @brief	finds the phase of the cycle start which gives the shortest time from the update of the
+/// 		input frame by the bus to the processing. A measurement compares a signature of the
+/// 		input frame of the cycle and of polls in the idle time of the cycle; a change between
+/// 		two polls close to each other is the time of an update. The median of the measured
+/// 		updates gives the shift of the cycle start, so the cycle starts PHASEALIGN_MARGIN after
+/// 		the update. The shift is applied in steps of at most PHASEALIGN_MAX_STEP per cycle. The
+/// 		phase is measured again every PHASEALIGN_TRACK_INTERVAL cycles to follow the drift
+/// 		between the clock of the bus and the monotonic clock: each result corrects the phase
+/// 		and the estimated drift, which is added to every cycle start in between.
+///
+/// 		If the updates always fall into the processing of the cycle, where they cannot be
+/// 		measured, the phase is moved by half a bus cycle. If the inputs do not change, a
+/// 		measurement ends without a result, the phase is kept and the interval to the next
+/// 		measurement is doubled, so the polling does not load the CPU all the time.
+///
+/// 		SetArea is called while the realtime thread is outside of its processing, all other
+/// 		functions only by the realtime thread.
+class CPhaseAligner
+{
+public:
+    CPhaseAligner()
+        : m_pMetrics(NULL),
+          m_uCycleNs(0),
+          m_nFrameOffset(0),
+          m_nFrameSize(0),
+          m_bRestart(false),
+          m_uCycleStartNs(0),
+          m_nPendingNs(0),
+          m_nDriftNs(0),
+          m_nDriftRest(0),
+          m_bDriftValid(false),
+          m_nUnmeasuredNs(0),
+          m_uResultCycles(0),
+          m_bMeasuring(false),
+          m_nRequired(0),
+          m_nSamples(0),
+          m_uMeasureCycles(0),
+          m_uIdleCycles(0),
+          m_uInterval(PHASEALIGN_TRACK_INTERVAL),
+          m_nBlind(0),
+          m_bHaveSample(false),
+          m_uLastSignature(0),
+          m_uLastSampleNs(0)
+    {
+    }
+
+    /// @brief			prepare the alignment
+    /// @param pMetrics	metrics for the measured phase and the corrections
+    /// @param uCycleUs	cycle time of the realtime thread in us
+    void Init(RUNTIMEMETRICS* pMetrics, uint32_t uCycleUs)
+    {
+        m_pMetrics = pMetrics;
+        m_uCycleNs = (uint64_t)uCycleUs * 1000;
+    }
+
+    /// @brief				set the compared part of the input frame and start a new calibration
+    /// @param nFrameOffset	offset of the first input in the frame
+    /// @param nSize		size from the first to the end of the last input
+    void SetArea(size_t nFrameOffset, size_t nSize)
+    {
+        m_nFrameOffset = nFrameOffset;
+        m_nFrameSize = nSize;
+        m_bRestart.store(true, std::memory_order_release);
+    }
+
+    /// @brief				planned start of the next cycle, called by the realtime thread before it waits
+    /// @param uPlannedNs	start of the cycle without alignment, absolute time of CLOCK_MONOTONIC
+    /// @return				shift of the start in ns, to be added to the planned start
+    int64_t Schedule(uint64_t uPlannedNs)
+    {
+        if(m_bRestart.load(std::memory_order_acquire))
+        {
+            m_bRestart.store(false, std::memory_order_relaxed);
+            m_nPendingNs = 0;
+            m_nDriftNs = 0;
+            m_bDriftValid = false;
+            m_uInterval = PHASEALIGN_TRACK_INTERVAL;
+            StartMeasurement(PHASEALIGN_CALIBRATION);
+        }
+
+        int64_t nStepNs = m_nPendingNs;
+        if(nStepNs > PHASEALIGN_MAX_STEP)
+        {
+            nStepNs = PHASEALIGN_MAX_STEP;
+        }
+        else if(nStepNs < -PHASEALIGN_MAX_STEP)
+        {
+            nStepNs = -PHASEALIGN_MAX_STEP;
+        }
+        if(nStepNs != 0)
+        {
+            // the last poll was taken with the old phase
+            m_nPendingNs -= nStepNs;
+            m_bHaveSample = false;
+        }
+
+        // the drift is kept in ns per 1000 cycles, the rest is added in the next cycles
+        m_nDriftRest += m_nDriftNs;
+        nStepNs += m_nDriftRest / 1000;
+        m_nDriftRest %= 1000;
+        m_uResultCycles++;
+
+        m_uCycleStartNs = uPlannedNs + nStepNs;
+
+        if(m_bMeasuring)
+        {
+            if(++m_uMeasureCycles > PHASEALIGN_MEASURE_CYCLES)
+            {
+                // no or not enough changes of the inputs, the phase is kept
+                IncrementMetric(m_pMetrics->uRTPhaseMisses);
+                m_bMeasuring = false;
+                m_uIdleCycles = 0;
+                if(m_uInterval < (uint64_t)PHASEALIGN_TRACK_INTERVAL * PHASEALIGN_MAX_BACKOFF)
+                {
+                    m_uInterval *= 2;
+                }
+            }
+        }
+        else if((++m_uIdleCycles >= m_uInterval) && (m_nPendingNs == 0))
+        {
+            StartMeasurement(PHASEALIGN_TRACKING);
+        }
+
+        return(nStepNs);
+    }
+
+    /// @brief	the cycle start was moved by a realtime violation, measure the phase again
+    void Resynchronize()
+    {
+        m_nPendingNs = 0;
+        m_bDriftValid = false;
+        StartMeasurement(m_bMeasuring ? m_nRequired : PHASEALIGN_TRACKING);
+    }
+
+    /// @brief	shall the input frame be sampled and polled in this cycle?
+    /// @return	true: measurement is running
+    bool IsMeasuring() const
+    {
+        return(m_bMeasuring && (m_nPendingNs == 0));
+    }
+
+    /// @brief			end of the polling in this cycle
+    /// @param uNowNs	start of the polling
+    /// @return			absolute time of CLOCK_MONOTONIC in ns
+    uint64_t GetProbeEndNs(uint64_t uNowNs) const
+    {
+        // one bus cycle is enough to see an update, the next cycle must not be delayed
+        uint64_t uEndNs = m_uCycleStartNs + m_uCycleNs - PHASEALIGN_SLACK;
+        uint64_t uBusEndNs = uNowNs + (uint64_t)PHASEALIGN_BUS_CYCLE * 1000 + PHASEALIGN_RESOLUTION;
+        return((uBusEndNs < uEndNs) ? uBusEndNs : uEndNs);
+    }
+
+    /// @brief			sample of the locked input frame, from the cycle or from a poll
+    /// @param pFrame	input frame
+    /// @param uTimeNs	time of the sample
+    /// @return			true: an update was measured
+    bool Sample(const char* pFrame, uint64_t uTimeNs)
+    {
+        bool bRet = false;
+
+        uint64_t uSignature = GetSignature(pFrame);
+        if(m_bHaveSample && (uSignature != m_uLastSignature))
+        {
+            if(uTimeNs - m_uLastSampleNs <= PHASEALIGN_RESOLUTION)
+            {
+                AddUpdate(m_uLastSampleNs + (uTimeNs - m_uLastSampleNs) / 2);
+                bRet = true;
+            }
+            else if(++m_nBlind >= PHASEALIGN_BLIND_LIMIT)
+            {
+                // the updates fall into the processing or after the polling, move them into the polling
+                m_nPendingNs = PHASEALIGN_BUS_CYCLE * 500;
+                m_nUnmeasuredNs += m_nPendingNs;
+                m_nBlind = 0;
+                m_nSamples = 0;
+            }
+        }
+        m_bHaveSample = true;
+        m_uLastSignature = uSignature;
+        m_uLastSampleNs = uTimeNs;
+
+        return(bRet);
+    }
+
+private:
+    RUNTIMEMETRICS* m_pMetrics;
+    uint64_t m_uCycleNs;
+
+    // compared part of the input frame
+    size_t m_nFrameOffset;
+    size_t m_nFrameSize;
+    std::atomic<bool> m_bRestart;	// new area, calibrate again
+
+    uint64_t m_uCycleStartNs;		// start of the current cycle
+    int64_t m_nPendingNs;			// shift of the phase which is not applied yet
+    int64_t m_nDriftNs;				// estimated drift in ns per 1000 cycles
+    int64_t m_nDriftRest;
+    bool m_bDriftValid;				// the last result can be used for the drift
+    int64_t m_nUnmeasuredNs;		// shifts since the last result which are not caused by the drift
+    uint64_t m_uResultCycles;		// cycles since the last result
+
+    // measurement
+    bool m_bMeasuring;
+    int m_nRequired;				// number of updates to measure
+    int m_nSamples;
+    int64_t m_nShiftNs[PHASEALIGN_CALIBRATION];		// shift of the cycle start for each update
+    uint64_t m_uMeasureCycles;
+    uint64_t m_uIdleCycles;			// cycles since the last measurement
+    uint64_t m_uInterval;			// cycles between two measurements
+    int m_nBlind;					// updates in a row which were not between two close polls
+
+    // last sample of the input frame
+    bool m_bHaveSample;
+    uint64_t m_uLastSignature;
+    uint64_t m_uLastSampleNs;
+
+    void StartMeasurement(int nRequired)
+    {
+        m_bMeasuring = true;
+        m_nRequired = nRequired;
+        m_nSamples = 0;
+        m_uMeasureCycles = 0;
+        m_nBlind = 0;
+        m_bHaveSample = false;
+    }
+
+    /// @brief			shift into the range of -1/2 to 1/2 bus cycle
+    /// @param nShiftNs	shift in ns
+    /// @return			shift which reaches the same phase
+    static int64_t WrapShift(int64_t nShiftNs)
+    {
+        const int64_t nBusNs = (int64_t)PHASEALIGN_BUS_CYCLE * 1000;
+
+        nShiftNs %= nBusNs;
+        if(nShiftNs >= nBusNs / 2)
+        {
+            nShiftNs -= nBusNs;
+        }
+        else if(nShiftNs < -nBusNs / 2)
+        {
+            nShiftNs += nBusNs;
+        }
+        return(nShiftNs);
+    }
+
+    /// @brief			FNV-1a hash of the compared part of the input frame
+    uint64_t GetSignature(const char* pFrame) const
+    {
+        uint64_t uHash = 14695981039346656037ULL;
+        const unsigned char* pData = (const unsigned char*)pFrame + m_nFrameOffset;
+        for(size_t nCount = 0; nCount < m_nFrameSize; nCount++)
+        {
+            uHash = (uHash ^ pData[nCount]) * 1099511628211ULL;
+        }
+        return(uHash);
+    }
+
+    /// @brief			measured update of the input frame
+    /// @param uTimeNs	time of the update
+    void AddUpdate(uint64_t uTimeNs)
+    {
+        const int64_t nBusNs = (int64_t)PHASEALIGN_BUS_CYCLE * 1000;
+
+        // time from the update to the cycle start, the update may also be after the start
+        int64_t nLagNs = ((int64_t)(m_uCycleStartNs - uTimeNs) % nBusNs + nBusNs) % nBusNs;
+
+        // shift to the planned lag, the shorter way around the bus cycle
+        m_nBlind = 0;
+        m_nShiftNs[m_nSamples++] = WrapShift(PHASEALIGN_MARGIN - nLagNs);
+        if(m_nSamples < m_nRequired)
+        {
+            return;
+        }
+
+        // median, robust against a single update which was delayed by the bus
+        for(int i = 1; i < m_nSamples; i++)
+        {
+            for(int j = i; (j > 0) && (m_nShiftNs[j - 1] > m_nShiftNs[j]); j--)
+            {
+                int64_t nTemp = m_nShiftNs[j];
+                m_nShiftNs[j] = m_nShiftNs[j - 1];
+                m_nShiftNs[j - 1] = nTemp;
+            }
+        }
+        int64_t nShiftNs = m_nShiftNs[m_nSamples / 2];
+
+        // the remaining shift since the last result is the error of the estimated drift, only
+        // half of it is corrected, so the noise of the polling does not make the estimation unstable
+        if(m_bDriftValid && (m_uResultCycles > 0))
+        {
+            m_nDriftNs += WrapShift(nShiftNs + m_nUnmeasuredNs) * 1000 / (int64_t)m_uResultCycles / 2;
+            if(m_nDriftNs > PHASEALIGN_MAX_DRIFT)
+            {
+                m_nDriftNs = PHASEALIGN_MAX_DRIFT;
+            }
+            else if(m_nDriftNs < -PHASEALIGN_MAX_DRIFT)
+            {
+                m_nDriftNs = -PHASEALIGN_MAX_DRIFT;
+            }
+        }
+        m_bDriftValid = true;
+        m_uResultCycles = 0;
+        m_nUnmeasuredNs = 0;
+
+        // small differences are noise of the polling, they are measured again with the next result
+        if((nShiftNs > PHASEALIGN_PROBE_INTERVAL) || (nShiftNs < -PHASEALIGN_PROBE_INTERVAL))
+        {
+            m_nPendingNs = nShiftNs;
+            IncrementMetric(m_pMetrics->uRTPhaseCorrections);
+        }
+        else
+        {
+            m_nUnmeasuredNs = -nShiftNs;
+        }
+        m_pMetrics->uRTPhaseLagNs.store((uint64_t)(((PHASEALIGN_MARGIN - nShiftNs) % nBusNs + nBusNs) % nBusNs), std::memory_order_relaxed);
+
+        m_bMeasuring = false;
+        m_uIdleCycles = 0;
+        m_uInterval = PHASEALIGN_TRACK_INTERVAL;
+    }
+};
+
+#endif /* CPHASEALIGNER_H_ */
@@ -0,0 +1,248 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CProcessImagePublisher.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#include "CProcessImagePublisher.h"
+
+#include <new>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define PROCESSIMAGE_ALIGNMENT	64		// alignment of the areas in the segment
+
+/// @brief			round up to PROCESSIMAGE_ALIGNMENT
+/// @param nValue	value
+/// @return			aligned value
+static size_t AlignUp(size_t nValue)
+{
+    return((nValue + PROCESSIMAGE_ALIGNMENT - 1) & ~((size_t)PROCESSIMAGE_ALIGNMENT - 1));
+}
+
+CProcessImagePublisher::CProcessImagePublisher()
+                      : m_pHeader(NULL),
+                        m_pSegment(NULL),
+                        m_nSegmentSize(0),
+                        m_uCycle(0)
+{
+    for(int nArea = 0; nArea < PROCESSIMAGE_AREAS; nArea++)
+    {
+        m_nFrameOffset[nArea] = 0;
+        m_nSize[nArea] = 0;
+    }
+}
+
+CProcessImagePublisher::~CProcessImagePublisher()
+{
+    Destroy();
+}
+
+/// @brief	remove all I/Os of the layout
+void CProcessImagePublisher::Clear()
+{
+    m_zEntries.clear();
+}
+
+/// @brief				add an I/O to the layout
+/// @param zArea		area of I/O
+/// @param strID		ID of I/O
+/// @param nFrameOffset	offset in bus-frame in byte
+/// @param nSize		data size in bytes
+/// @param ucBitMask	bitmask in case of a boolean value, 0 otherwise
+void CProcessImagePublisher::AddEntry(PROCESSIMAGEAREA zArea, const string& strID, size_t nFrameOffset, size_t nSize, unsigned char ucBitMask)
+{
+    PENDINGENTRY zEntry;
+    zEntry.zArea = zArea;
+    zEntry.strID = strID;
+    zEntry.nFrameOffset = nFrameOffset;
+    zEntry.nSize = (nSize > 0) ? nSize : 1;
+    zEntry.ucBitMask = ucBitMask;
+    m_zEntries.push_back(zEntry);
+}
+
+/// @brief	create the shared memory segment with the current layout. An existing segment is
+/// 		marked as stale, so its readers open the new one
+/// @return	true: success, false: failure, the process image is not published
+bool CProcessImagePublisher::Create()
+{
+    Destroy();
+
+#ifdef PROCESSIMAGE_SHM
+    bool bRet = false;
+
+    // the part of the frame with all I/Os of an area
+    size_t nFrameEnd[PROCESSIMAGE_AREAS];
+    for(int nArea = 0; nArea < PROCESSIMAGE_AREAS; nArea++)
+    {
+        m_nFrameOffset[nArea] = SIZE_MAX;
+        nFrameEnd[nArea] = 0;
+    }
+    for(const PENDINGENTRY& zEntry : m_zEntries)
+    {
+        m_nFrameOffset[zEntry.zArea] = min(m_nFrameOffset[zEntry.zArea], zEntry.nFrameOffset);
+        nFrameEnd[zEntry.zArea] = max(nFrameEnd[zEntry.zArea], zEntry.nFrameOffset + zEntry.nSize);
+    }
+
+    // header, layout descriptor and areas, each starts on its own cache line
+    size_t nEntryOffset = AlignUp(sizeof(PROCESSIMAGEHEADER));
+    size_t nAreaOffset[PROCESSIMAGE_AREAS];
+    size_t nOffset = AlignUp(nEntryOffset + m_zEntries.size() * sizeof(PROCESSIMAGEENTRY));
+    for(int nArea = 0; nArea < PROCESSIMAGE_AREAS; nArea++)
+    {
+        if(nFrameEnd[nArea] == 0)
+        {
+            m_nFrameOffset[nArea] = 0;
+        }
+        m_nSize[nArea] = nFrameEnd[nArea] - m_nFrameOffset[nArea];
+        nAreaOffset[nArea] = nOffset;
+        nOffset = AlignUp(nOffset + m_nSize[nArea]);
+    }
+    m_nSegmentSize = nOffset;
+
+    // readers of an old segment keep their mapping until they see that it is stale
+    shm_unlink(PROCESSIMAGE_SHM_NAME);
+    int nFd = shm_open(PROCESSIMAGE_SHM_NAME, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if(nFd >= 0)
+    {
+        if(ftruncate(nFd, m_nSegmentSize) == 0)
+        {
+            // all pages are mapped and locked now, so the realtime thread never gets a page fault
+            void* pSegment = mmap(NULL, m_nSegmentSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, nFd, 0);
+            if(pSegment != MAP_FAILED)
+            {
+                if(mlock(pSegment, m_nSegmentSize) != 0)
+                {
+                    Log::Info("Process image: mlock failed, page faults are possible in the realtime thread");
+                }
+                m_pSegment = (unsigned char*)pSegment;
+                bRet = true;
+            }
+            else
+            {
+                Log::Error("Process image: mmap failed");
+            }
+        }
+        else
+        {
+            Log::Error("Process image: ftruncate failed");
+        }
+        close(nFd);
+    }
+    else
+    {
+        Log::Error("Process image: shm_open of {0} failed", PROCESSIMAGE_SHM_NAME);
+    }
+
+    if(bRet == false)
+    {
+        if(m_pSegment != NULL)
+        {
+            munmap(m_pSegment, m_nSegmentSize);
+            m_pSegment = NULL;
+        }
+        shm_unlink(PROCESSIMAGE_SHM_NAME);
+        return(false);
+    }
+
+    // layout descriptor
+    PROCESSIMAGEENTRY* pEntries = (PROCESSIMAGEENTRY*)(m_pSegment + nEntryOffset);
+    for(size_t nCount = 0; nCount < m_zEntries.size(); nCount++)
+    {
+        const PENDINGENTRY& zEntry = m_zEntries[nCount];
+        PROCESSIMAGEENTRY& zShmEntry = pEntries[nCount];
+        strncpy(zShmEntry.szID, zEntry.strID.c_str(), PROCESSIMAGE_IDLENGTH - 1);
+        zShmEntry.szID[PROCESSIMAGE_IDLENGTH - 1] = '\0';
+        zShmEntry.uOffset = nAreaOffset[zEntry.zArea] + (zEntry.nFrameOffset - m_nFrameOffset[zEntry.zArea]);
+        zShmEntry.uSize = zEntry.nSize;
+        zShmEntry.uBitMask = zEntry.ucBitMask;
+        zShmEntry.uArea = zEntry.zArea;
+    }
+
+    // header, the magic is written last, so a reader never sees an incomplete layout
+    m_pHeader = new(m_pSegment) PROCESSIMAGEHEADER();
+    m_pHeader->uVersion = PROCESSIMAGE_VERSION;
+    m_pHeader->uHeaderSize = sizeof(PROCESSIMAGEHEADER);
+    m_pHeader->uSegmentSize = m_nSegmentSize;
+    m_pHeader->uEntryOffset = nEntryOffset;
+    m_pHeader->uEntryCount = m_zEntries.size();
+    for(int nArea = 0; nArea < PROCESSIMAGE_AREAS; nArea++)
+    {
+        m_pHeader->zAreas[nArea].uOffset = nAreaOffset[nArea];
+        m_pHeader->zAreas[nArea].uSize = m_nSize[nArea];
+    }
+    m_pHeader->uSequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_pHeader->uMagic = PROCESSIMAGE_MAGIC;
+
+    Log::Info("Process image: {0} I/Os published in {1} ({2} bytes)", m_zEntries.size(), PROCESSIMAGE_SHM_NAME, m_nSegmentSize);
+
+    return(true);
+#else
+    return(false);
+#endif
+}
+
+/// @brief	mark the segment as stale and remove it
+void CProcessImagePublisher::Destroy()
+{
+    if(m_pHeader != NULL)
+    {
+        m_pHeader->uMagic = 0;
+        std::atomic_thread_fence(std::memory_order_release);
+
+        munmap(m_pSegment, m_nSegmentSize);
+        shm_unlink(PROCESSIMAGE_SHM_NAME);
+
+        m_pHeader = NULL;
+        m_pSegment = NULL;
+        m_nSegmentSize = 0;
+    }
+}
+
+/// @brief	start writing the image of a cycle, readers retry until EndWrite()
+void CProcessImagePublisher::BeginWrite()
+{
+    if(m_pHeader != NULL)
+    {
+        m_pHeader->uSequence.store(m_pHeader->uSequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+}
+
+/// @brief			copy the part of the bus frame with the I/Os of an area
+/// @param zArea	area
+/// @param pFrame	pointer to bus frame, only valid inside of ArpPlcGds_BeginRead/BeginWrite
+void CProcessImagePublisher::CopyArea(PROCESSIMAGEAREA zArea, const char* pFrame)
+{
+    if((m_pHeader != NULL) && (m_nSize[zArea] > 0))
+    {
+        memcpy(m_pSegment + m_pHeader->zAreas[zArea].uOffset, pFrame + m_nFrameOffset[zArea], m_nSize[zArea]);
+    }
+}
+
+/// @brief					finish writing the image of a cycle
+/// @param bValid			inputs and outputs of the cycle were valid
+/// @param zInputFreshness	freshness of the inputs of the cycle
+void CProcessImagePublisher::EndWrite(bool bValid, const INPUTFRESHNESS& zInputFreshness)
+{
+    if(m_pHeader != NULL)
+    {
+        m_pHeader->uCycle = ++m_uCycle;
+        m_pHeader->uTimeNs = GetMonotonicTimeNs();
+        m_pHeader->uValid = bValid ? 1 : 0;
+        m_pHeader->uInputFresh = zInputFreshness.bFresh ? 1 : 0;
+        m_pHeader->uInputStaleCycles = zInputFreshness.uStaleCycles;
+        m_pHeader->uInputAgeUs = zInputFreshness.uAgeUs;
+        m_pHeader->uSequence.store(m_pHeader->uSequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+}
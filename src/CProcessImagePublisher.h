@@ -0,0 +1,72 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CProcessImagePublisher.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef CPROCESSIMAGEPUBLISHER_H_
+#define CPROCESSIMAGEPUBLISHER_H_
+
+#include <string>
+#include <vector>
+#include "Arp/System/Core/Arp.h"
+#include "Arp/System/Commons/Logging.h"
+#include "ProcessImageFormat.h"
+#include "ProcessData.h"
+#include "Utility.h"
+
+using namespace Arp;
+using namespace std;
+
+// publish the process image in a shared memory segment, comment out to disable
+#define PROCESSIMAGE_SHM
+
+/// @brief	publishes the process image of the realtime thread in a POSIX shared memory segment,
+/// 		see ProcessImageFormat.h. The layout is created while processing is stopped. In the
+/// 		realtime cycle, only one memcpy per area is done and no system call at all.
+class CProcessImagePublisher
+{
+public:
+    CProcessImagePublisher();
+    virtual ~CProcessImagePublisher();
+
+    // layout, must not be called while the realtime thread writes
+    void Clear();
+    void AddEntry(PROCESSIMAGEAREA zArea, const string& strID, size_t nFrameOffset, size_t nSize, unsigned char ucBitMask);
+    bool Create();
+    void Destroy();
+
+    // called by the realtime thread in every cycle
+    void BeginWrite();
+    void CopyArea(PROCESSIMAGEAREA zArea, const char* pFrame);
+    void EndWrite(bool bValid, const INPUTFRESHNESS& zInputFreshness);
+
+private:
+    ///	structure to handle an I/O until the segment is created
+    struct PENDINGENTRY
+    {
+        PROCESSIMAGEAREA zArea;
+        string strID;
+        size_t nFrameOffset;		// offset in bus-frame in byte
+        size_t nSize;				// data size in bytes
+        unsigned char ucBitMask;	// bitmask in case of a boolean value
+    };
+    vector<PENDINGENTRY> m_zEntries;
+
+    // part of the bus frame which is copied for each area
+    size_t m_nFrameOffset[PROCESSIMAGE_AREAS];
+    size_t m_nSize[PROCESSIMAGE_AREAS];
+
+    PROCESSIMAGEHEADER* m_pHeader;	// NULL, if there is no segment
+    unsigned char* m_pSegment;
+    size_t m_nSegmentSize;
+    uint64 m_uCycle;
+};
+
+#endif /* CPROCESSIMAGEPUBLISHER_H_ */
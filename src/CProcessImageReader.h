@@ -0,0 +1,225 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CProcessImageReader.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef CPROCESSIMAGEREADER_H_
+#define CPROCESSIMAGEREADER_H_
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "ProcessImageFormat.h"
+
+/// @brief	read-only access to the process image of the sample runtime for other processes on
+/// 		the controller, see ProcessImageFormat.h. This class is header-only and does not
+/// 		depend on the PLCnext SDK, so it can be copied into other projects.
+///
+/// 		Usage:
+/// 			CProcessImageReader zReader;
+/// 			zReader.Open();
+/// 			const PROCESSIMAGEENTRY* pEntry = zReader.Find("Arp.Io.AxlC/0.IN00");
+/// 			uint64_t uValue = 0;
+/// 			if(zReader.ReadValue(*pEntry, uValue)) { ... }
+/// 			if(zReader.IsStale()) { zReader.Open(); ... }
+///
+/// 		A read does not copy the image and does not call the kernel, it only checks the
+/// 		sequence of the seqlock before and after accessing the mapped memory.
+class CProcessImageReader
+{
+public:
+    CProcessImageReader()
+        : m_pSegment(NULL),
+          m_nSegmentSize(0)
+    {
+    }
+
+    virtual ~CProcessImageReader()
+    {
+        Close();
+    }
+
+    /// @brief			map the segment read-only
+    /// @param szName	name of segment
+    /// @return			true: success, false: segment does not exist or has an unknown format
+    bool Open(const char* szName = PROCESSIMAGE_SHM_NAME)
+    {
+        Close();
+
+        int nFd = shm_open(szName, O_RDONLY, 0);
+        if(nFd < 0)
+        {
+            return(false);
+        }
+
+        struct stat zStat;
+        if((fstat(nFd, &zStat) == 0) && ((size_t)zStat.st_size >= sizeof(PROCESSIMAGEHEADER)))
+        {
+            void* pSegment = mmap(NULL, zStat.st_size, PROT_READ, MAP_SHARED, nFd, 0);
+            if(pSegment != MAP_FAILED)
+            {
+                m_pSegment = (const unsigned char*)pSegment;
+                m_nSegmentSize = zStat.st_size;
+            }
+        }
+        close(nFd);
+
+        const PROCESSIMAGEHEADER* pHeader = GetHeader();
+        if((pHeader == NULL) ||
+           (pHeader->uMagic != PROCESSIMAGE_MAGIC) ||
+           (pHeader->uVersion != PROCESSIMAGE_VERSION) ||
+           (pHeader->uSegmentSize > m_nSegmentSize))
+        {
+            Close();
+            return(false);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return(true);
+    }
+
+    /// @brief	unmap the segment
+    void Close()
+    {
+        if(m_pSegment != NULL)
+        {
+            munmap((void*)m_pSegment, m_nSegmentSize);
+            m_pSegment = NULL;
+            m_nSegmentSize = 0;
+        }
+    }
+
+    /// @brief	was the layout changed by the runtime? Open() has to be called again in this case
+    /// @return	true: stale or not open, false: segment can be used
+    bool IsStale() const
+    {
+        const PROCESSIMAGEHEADER* pHeader = GetHeader();
+        return((pHeader == NULL) || (((const volatile PROCESSIMAGEHEADER*)pHeader)->uMagic != PROCESSIMAGE_MAGIC));
+    }
+
+    /// @brief	header of the segment
+    /// @return	pointer to header, NULL if not open
+    const PROCESSIMAGEHEADER* GetHeader() const
+    {
+        return((const PROCESSIMAGEHEADER*)m_pSegment);
+    }
+
+    /// @brief	number of I/Os in the layout descriptor
+    /// @return	number of I/Os
+    size_t GetEntryCount() const
+    {
+        return((m_pSegment != NULL) ? GetHeader()->uEntryCount : 0);
+    }
+
+    /// @brief			I/O of the layout descriptor
+    /// @param nIndex	index of I/O
+    /// @return			pointer to I/O
+    const PROCESSIMAGEENTRY* GetEntry(size_t nIndex) const
+    {
+        if(nIndex >= GetEntryCount())
+        {
+            return(NULL);
+        }
+        return((const PROCESSIMAGEENTRY*)(m_pSegment + GetHeader()->uEntryOffset) + nIndex);
+    }
+
+    /// @brief			find an I/O by its ID
+    /// @param szID		ID of I/O
+    /// @return			pointer to I/O, NULL if not found
+    const PROCESSIMAGEENTRY* Find(const char* szID) const
+    {
+        for(size_t nCount = 0; nCount < GetEntryCount(); nCount++)
+        {
+            const PROCESSIMAGEENTRY* pEntry = GetEntry(nCount);
+            if(strncmp(pEntry->szID, szID, PROCESSIMAGE_IDLENGTH) == 0)
+            {
+                return(pEntry);
+            }
+        }
+        return(NULL);
+    }
+
+    /// @brief				access the mapped image consistently without copying it. The function
+    /// 					may be called more than once, if the realtime thread wrote in the meantime,
+    /// 					so it must only read the image and must not keep any result of a failed try
+    /// @param zFunction	called with the start of the segment, e.g. a lambda
+    /// @param nRetries		max. number of tries
+    /// @param pCycle		optional, number of the cycle of the image
+    /// @return				true: consistent, false: no consistent image within nRetries
+    template<typename F>
+    bool Read(F zFunction, unsigned int nRetries = 1000, uint64_t* pCycle = NULL) const
+    {
+        const PROCESSIMAGEHEADER* pHeader = GetHeader();
+        if(pHeader == NULL)
+        {
+            return(false);
+        }
+
+        for(unsigned int nTry = 0; nTry < nRetries; nTry++)
+        {
+            uint64_t uSequence = pHeader->uSequence.load(std::memory_order_acquire);
+            if((uSequence & 1) != 0)
+            {
+                // the realtime thread is writing
+                continue;
+            }
+
+            zFunction(m_pSegment);
+            uint64_t uCycle = ((const volatile PROCESSIMAGEHEADER*)pHeader)->uCycle;
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(pHeader->uSequence.load(std::memory_order_relaxed) == uSequence)
+            {
+                if(pCycle != NULL)
+                {
+                    *pCycle = uCycle;
+                }
+                return(true);
+            }
+        }
+        return(false);
+    }
+
+    /// @brief			read the value of one I/O consistently
+    /// @param zEntry	I/O of the layout descriptor
+    /// @param uValue	value, booleans are 0 or 1, max. the first 8 bytes of other values
+    /// @param pCycle	optional, number of the cycle of the image
+    /// @return			true: success, false: no consistent image
+    bool ReadValue(const PROCESSIMAGEENTRY& zEntry, uint64_t& uValue, uint64_t* pCycle = NULL) const
+    {
+        uint64_t uRead = 0;
+        bool bRet = Read([&](const unsigned char* pSegment)
+        {
+            uRead = 0;
+            if(zEntry.uBitMask != 0)
+            {
+                uRead = ((((const volatile unsigned char*)pSegment)[zEntry.uOffset] & zEntry.uBitMask) != 0) ? 1 : 0;
+            }
+            else
+            {
+                memcpy(&uRead, pSegment + zEntry.uOffset, (zEntry.uSize < sizeof(uRead)) ? zEntry.uSize : sizeof(uRead));
+            }
+        }, 1000, pCycle);
+
+        if(bRet)
+        {
+            uValue = uRead;
+        }
+        return(bRet);
+    }
+
+private:
+    const unsigned char* m_pSegment;
+    size_t m_nSegmentSize;
+};
+
+#endif /* CPROCESSIMAGEREADER_H_ */
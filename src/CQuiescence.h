@@ -0,0 +1,97 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CQuiescence.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef CQUIESCENCE_H_
+#define CQUIESCENCE_H_
+
+#include <atomic>
+#include <stdint.h>
+#include <unistd.h>
+#include "Utility.h"
+
+/// @brief	lock-free handshake to find out, if a cyclic thread left its critical section.
+/// 		The cyclic thread increments an epoch counter when entering and when leaving the
+/// 		section, so the epoch is odd while it is inside. Another thread which wants to free
+/// 		resources first disables the processing and then waits until the epoch is even or
+/// 		has changed. The cyclic thread never waits, so this can be used in the realtime thread.
+///
+/// 		Usage in the cyclic thread:
+/// 			zQuiescence.Enter();
+/// 			if(bDoCycle) { ...use resources... }
+/// 			zQuiescence.Leave();
+///
+/// 		Usage in the stopping thread:
+/// 			bDoCycle = false;
+/// 			if(zQuiescence.WaitForQuiescence(uTimeoutUs)) { ...free resources... }
+///
+/// 		The flag for the processing has to be a std::atomic<bool> with the default (sequentially
+/// 		consistent) memory order, so either the cyclic thread sees the cleared flag or the
+/// 		stopping thread sees the odd epoch.
+class CQuiescence
+{
+public:
+    CQuiescence()
+        : m_uEpoch(0)
+    {
+    }
+
+    /// @brief	enter the critical section, must be called before checking the processing flag
+    void Enter()
+    {
+        m_uEpoch.fetch_add(1, std::memory_order_seq_cst);
+    }
+
+    /// @brief	leave the critical section
+    void Leave()
+    {
+        m_uEpoch.fetch_add(1, std::memory_order_release);
+    }
+
+    /// @brief				wait until the cyclic thread is outside of its critical section
+    /// @param uTimeoutUs	max. time to wait in us
+    /// @return				true: quiescent, false: timeout, the resources must not be freed
+    bool WaitForQuiescence(uint32_t uTimeoutUs)
+    {
+        uint32_t uEpoch = m_uEpoch.load(std::memory_order_seq_cst);
+        if((uEpoch & 1) == 0)
+        {
+            // outside, every later entry will see the cleared processing flag
+            return(true);
+        }
+
+        uint64_t uEnd = GetMonotonicTimeNs() + (uint64_t)uTimeoutUs * 1000;
+        uint32_t uPollUs = (uTimeoutUs < 100) ? uTimeoutUs : 100;
+
+        while(m_uEpoch.load(std::memory_order_acquire) == uEpoch)
+        {
+            if(GetMonotonicTimeNs() >= uEnd)
+            {
+                return(false);
+            }
+            usleep(uPollUs);
+        }
+
+        return(true);
+    }
+
+    /// @brief	is the cyclic thread inside of its critical section?
+    /// @return	true: inside, false: outside
+    bool IsInside() const
+    {
+        return((m_uEpoch.load(std::memory_order_acquire) & 1) != 0);
+    }
+
+private:
+    std::atomic<uint32_t> m_uEpoch;	// odd while the cyclic thread is inside
+};
+
+#endif /* CQUIESCENCE_H_ */
@@ -0,0 +1,200 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CRTWakeup.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef CRTWAKEUP_H_
+#define CRTWAKEUP_H_
+
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/timerfd.h>
+#include "RuntimeMetrics.h"
+#include "Utility.h"
+
+// sleep until a guard interval before the start of the cycle and busy-poll the clock for the
+// rest, uncomment to enable. The start jitter is then independent of the wakeup latency of the
+// kernel, but the realtime thread keeps its CPU busy for the guard interval in every cycle
+//#define RTWAKEUP_SPIN
+
+// sleep with an absolute timerfd instead of clock_nanosleep, uncomment to enable
+//#define RTWAKEUP_TIMERFD
+
+#define RTWAKEUP_GUARD_INITIAL	50000	// guard interval before the first tuning in ns
+#define RTWAKEUP_GUARD_MIN		5000	// min. guard interval in ns
+#define RTWAKEUP_GUARD_MAX		200000	// max. guard interval in ns, keep it well below RTCYCLETIME
+#define RTWAKEUP_GUARD_MARGIN	10000	// margin above the highest observed wakeup latency in ns
+#define RTWAKEUP_TUNE_WINDOW	1000	// cycles after which the guard interval may shrink
+
+/// @brief	wakeup of the realtime thread at an absolute time of CLOCK_MONOTONIC. By default this
+/// 		is a plain clock_nanosleep. With RTWAKEUP_SPIN the thread sleeps until the deadline
+/// 		minus a guard interval and spins on the clock until the deadline. The guard interval
+/// 		follows the observed wakeup latency of the sleep: it grows at once when a wakeup was
+/// 		later than the guard plus margin, and it shrinks slowly to the highest latency of the
+/// 		last RTWAKEUP_TUNE_WINDOW cycles plus margin. A wakeup later than the guard interval
+/// 		misses the deadline and is counted as late wakeup.
+///
+/// 		Init has to be called before the realtime thread is started, WaitUntil must only be
+/// 		called by the realtime thread.
+class CRTWakeup
+{
+public:
+    CRTWakeup()
+        : m_nTimerFd(-1),
+          m_pMetrics(NULL),
+          m_uGuardNs(RTWAKEUP_GUARD_INITIAL),
+          m_uWindowMaxNs(0),
+          m_uWindowCycles(0)
+    {
+    }
+
+    ~CRTWakeup()
+    {
+        if(m_nTimerFd >= 0)
+        {
+            close(m_nTimerFd);
+        }
+    }
+
+    /// @brief			prepare the wakeup, creates the timerfd with RTWAKEUP_TIMERFD
+    /// @param pMetrics	metrics for the spin time, guard interval and late wakeups
+    /// @return			true: success, false: timerfd could not be created, clock_nanosleep is used
+    bool Init(RUNTIMEMETRICS* pMetrics)
+    {
+        bool bRet = true;
+
+        m_pMetrics = pMetrics;
+        if(m_pMetrics != NULL)
+        {
+#ifdef RTWAKEUP_SPIN
+            m_pMetrics->uRTWakeupGuardNs.store(m_uGuardNs, std::memory_order_relaxed);
+#endif
+        }
+
+#ifdef RTWAKEUP_TIMERFD
+        if(m_nTimerFd < 0)
+        {
+            m_nTimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+            bRet = (m_nTimerFd >= 0);
+        }
+#endif
+        return(bRet);
+    }
+
+    /// @brief				wait until the start of the next cycle
+    /// @param zDeadline	start of the cycle, absolute time of CLOCK_MONOTONIC
+    void WaitUntil(const timespec& zDeadline)
+    {
+        uint64_t uDeadlineNs = (uint64_t)zDeadline.tv_sec * 1000000000ULL + (uint64_t)zDeadline.tv_nsec;
+
+#ifdef RTWAKEUP_SPIN
+        uint64_t uSleepNs = uDeadlineNs - m_uGuardNs;
+        uint64_t uNowNs = GetMonotonicTimeNs();
+        if(uNowNs < uSleepNs)
+        {
+            // only a sleep which really waited tells something about the wakeup latency
+            SleepUntil(uSleepNs);
+            uNowNs = GetMonotonicTimeNs();
+            Tune(uNowNs - uSleepNs);
+        }
+
+        uint64_t uSpinStartNs = uNowNs;
+        while(uNowNs < uDeadlineNs)
+        {
+            CpuRelax();
+            uNowNs = GetMonotonicTimeNs();
+        }
+        if(m_pMetrics != NULL)
+        {
+            m_pMetrics->zRTSpinTime.Record(uNowNs - uSpinStartNs);
+        }
+#else
+        SleepUntil(uDeadlineNs);
+#endif
+    }
+
+private:
+    int m_nTimerFd;				// -1 without RTWAKEUP_TIMERFD or on error
+    RUNTIMEMETRICS* m_pMetrics;
+    uint64_t m_uGuardNs;		// current guard interval
+    uint64_t m_uWindowMaxNs;	// highest wakeup latency in the current tuning window
+    uint32_t m_uWindowCycles;
+
+    void SleepUntil(uint64_t uTimeNs)
+    {
+        timespec zTime;
+        zTime.tv_sec = (time_t)(uTimeNs / 1000000000ULL);
+        zTime.tv_nsec = (long)(uTimeNs % 1000000000ULL);
+
+        if(m_nTimerFd >= 0)
+        {
+            itimerspec zTimer = {};
+            zTimer.it_value = zTime;
+            uint64_t uExpirations;
+            if((timerfd_settime(m_nTimerFd, TFD_TIMER_ABSTIME, &zTimer, NULL) == 0) &&
+               (read(m_nTimerFd, &uExpirations, sizeof(uExpirations)) == sizeof(uExpirations)))
+            {
+                return;
+            }
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &zTime, NULL);
+    }
+
+    void Tune(uint64_t uLatencyNs)
+    {
+        if((uLatencyNs > m_uGuardNs) && (m_pMetrics != NULL))
+        {
+            IncrementMetric(m_pMetrics->uRTLateWakeups);
+        }
+
+        // grow at once, the next wakeup with the same latency is in time
+        if(uLatencyNs + RTWAKEUP_GUARD_MARGIN > m_uGuardNs)
+        {
+            m_uGuardNs = (uLatencyNs + RTWAKEUP_GUARD_MARGIN < RTWAKEUP_GUARD_MAX) ? uLatencyNs + RTWAKEUP_GUARD_MARGIN : RTWAKEUP_GUARD_MAX;
+        }
+
+        // shrink by a quarter of the distance to the target after each window
+        if(uLatencyNs > m_uWindowMaxNs)
+        {
+            m_uWindowMaxNs = uLatencyNs;
+        }
+        if(++m_uWindowCycles >= RTWAKEUP_TUNE_WINDOW)
+        {
+            uint64_t uTargetNs = m_uWindowMaxNs + RTWAKEUP_GUARD_MARGIN;
+            if(uTargetNs < RTWAKEUP_GUARD_MIN)
+            {
+                uTargetNs = RTWAKEUP_GUARD_MIN;
+            }
+            if(uTargetNs < m_uGuardNs)
+            {
+                m_uGuardNs -= (m_uGuardNs - uTargetNs) / 4;
+            }
+            m_uWindowMaxNs = 0;
+            m_uWindowCycles = 0;
+        }
+
+        if(m_pMetrics != NULL)
+        {
+            m_pMetrics->uRTWakeupGuardNs.store(m_uGuardNs, std::memory_order_relaxed);
+        }
+    }
+
+    static inline void CpuRelax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__arm__) || defined(__aarch64__)
+        __asm__ __volatile__("yield" ::: "memory");
+#endif
+    }
+};
+
+#endif /* CRTWAKEUP_H_ */
@@ -0,0 +1,404 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CRTWatchdog.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#include "CRTWatchdog.h"
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <execinfo.h>
+
+#define WATCHDOG_STACK_SIGNAL	(SIGRTMIN + 4)	// signal to take the user stack of a stalled thread
+
+#ifdef WATCHDOG_STACKS
+// written by the signal handler in the stalled thread, there is only one snapshot at a time
+static void* s_pStackFrames[WATCHDOG_STACK_DEPTH];
+static std::atomic<int> s_nStackDepth(-1);	// -1 until the handler has run
+
+static void StackSignalHandler(int nSignal)
+{
+    (void)nSignal;
+    s_nStackDepth.store(backtrace(s_pStackFrames, WATCHDOG_STACK_DEPTH), std::memory_order_release);
+}
+#endif
+
+/// @brief			read a file of a thread in /proc into a zero-terminated buffer
+/// @param nTid		kernel thread ID
+/// @param szFile	name of the file in /proc/self/task/<tid>
+/// @param pBuffer	buffer for the content
+/// @param nSize	size of the buffer
+/// @return			true: success, false: the file could not be read
+static bool ReadProcFile(int32_t nTid, const char* szFile, char* pBuffer, size_t nSize)
+{
+    bool bRet = false;
+
+    char szPath[64];
+    snprintf(szPath, sizeof(szPath), "/proc/self/task/%d/%s", (int)nTid, szFile);
+
+    int nFd = open(szPath, O_RDONLY | O_CLOEXEC);
+    if(nFd >= 0)
+    {
+        ssize_t nRead = read(nFd, pBuffer, nSize - 1);
+        if(nRead >= 0)
+        {
+            pBuffer[nRead] = '\0';
+            bRet = true;
+        }
+        close(nFd);
+    }
+    return(bRet);
+}
+
+/// @brief			find the value of a line "<key>: <value>" of /proc/<pid>/status
+/// @param szText	content of the file
+/// @param szKey	key including the colon
+/// @return			value, 0 if the key is missing
+static unsigned long long FindStatusValue(const char* szText, const char* szKey)
+{
+    const char* pLine = strstr(szText, szKey);
+    return((pLine != NULL) ? strtoull(pLine + strlen(szKey), NULL, 10) : 0);
+}
+
+CRTWatchdog::CRTWatchdog()
+      : m_zThread(),
+        m_bStarted(false),
+        m_pMetrics(NULL),
+        m_uIntervalNs(0)
+{
+}
+
+CRTWatchdog::~CRTWatchdog()
+{
+}
+
+/// @brief				add a thread to be watched, only before Start
+/// @param szName		name for logging, must be a literal
+/// @param pHeartbeat	heartbeat of the thread, the thread is watched from its first beat
+/// @param uStallUs		time without a beat after which the thread is stalled
+/// @param uAbortUs		time without a beat after which the process is aborted, 0: never
+/// @return				true: success, false: started or too many threads
+bool CRTWatchdog::AddThread(const char* szName, RTHEARTBEAT* pHeartbeat, uint64 uStallUs, uint64 uAbortUs)
+{
+    if(m_bStarted || (pHeartbeat == NULL) || (m_zWatched.size() >= WATCHDOG_MAX_THREADS))
+    {
+        Log::Error("Watchdog: {0} cannot be watched", szName);
+        return(false);
+    }
+
+    WATCHED zWatched;
+    zWatched.szName = szName;
+    zWatched.pHeartbeat = pHeartbeat;
+    zWatched.uStallNs = uStallUs * 1000;
+    zWatched.uAbortNs = uAbortUs * 1000;
+    m_zWatched.push_back(zWatched);
+    return(true);
+}
+
+/// @brief				start the supervisor thread
+/// @param pMetrics		metrics for the stalls
+/// @param uIntervalUs	interval of the checks, the detection latency is the stall time plus this interval
+/// @return				true: success, false: failure
+bool CRTWatchdog::Start(RUNTIMEMETRICS* pMetrics, uint64 uIntervalUs)
+{
+    if(m_bStarted)
+    {
+        return(true);
+    }
+    if((pMetrics == NULL) || (uIntervalUs == 0))
+    {
+        Log::Error("Invalid parameter in CRTWatchdog::Start");
+        return(false);
+    }
+    m_pMetrics = pMetrics;
+    m_uIntervalNs = uIntervalUs * 1000;
+
+#ifdef WATCHDOG_STACKS
+    // the first call of backtrace loads libgcc, this must not happen in the signal handler
+    void* pFrame;
+    backtrace(&pFrame, 1);
+
+    struct sigaction zAction;
+    memset(&zAction, 0, sizeof(zAction));
+    zAction.sa_handler = StackSignalHandler;
+    zAction.sa_flags = SA_RESTART;
+    sigemptyset(&zAction.sa_mask);
+    if(sigaction(WATCHDOG_STACK_SIGNAL, &zAction, NULL) != 0)
+    {
+        Log::Error("Error calling sigaction, the watchdog takes no user stacks");
+    }
+#endif
+
+    bool bRet = false;
+
+    // the supervisor runs above the watched threads, so a spinning thread cannot starve it
+    struct sched_param param;
+    param.sched_priority = WATCHDOG_PRIORITY;
+    pthread_attr_t attr;
+
+    if(pthread_attr_init(&attr) == 0)
+    {
+        if((pthread_attr_setschedpolicy(&attr, SCHED_FIFO) == 0) &&
+           (pthread_attr_setschedparam(&attr, &param) == 0) &&
+           (pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED) == 0))
+        {
+            if(pthread_create(&m_zThread, &attr, CRTWatchdog::StaticCycle, this) == 0)
+            {
+                m_bStarted = true;
+                bRet = true;
+            }
+            else
+            {
+                Log::Error("Error calling pthread_create (watchdog thread)");
+            }
+        }
+        else
+        {
+            Log::Error("Error setting the scheduling of the watchdog thread");
+        }
+        pthread_attr_destroy(&attr);
+    }
+    else
+    {
+        Log::Error("Error calling pthread_attr_init");
+    }
+
+    return(bRet);
+}
+
+/// @brief		static function for thread-entry of the supervisor
+/// @param p	pointer to watchdog object
+void* CRTWatchdog::StaticCycle(void* p)
+{
+    if(p != NULL)
+    {
+        ((CRTWatchdog*)p)->Cycle();
+    }
+    else
+    {
+        Log::Error("Null pointer in CRTWatchdog::StaticCycle");
+    }
+    return(NULL);
+}
+
+/// @brief	loop of the supervisor, it checks all threads in absolute intervals of CLOCK_MONOTONIC
+void CRTWatchdog::Cycle()
+{
+    Log::Info("Call of CRTWatchdog::Cycle");
+
+    uint64 uNextNs = GetMonotonicTimeNs();
+    while(true)
+    {
+        uNextNs += m_uIntervalNs;
+        timespec zNext;
+        zNext.tv_sec = (time_t)(uNextNs / 1000000000ULL);
+        zNext.tv_nsec = (long)(uNextNs % 1000000000ULL);
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &zNext, NULL);
+
+        uint64 uNowNs = GetMonotonicTimeNs();
+        for(size_t nCount = 0; nCount < m_zWatched.size(); nCount++)
+        {
+            Check(m_zWatched[nCount], uNowNs);
+        }
+
+        // after a delay of the supervisor itself, continue from now instead of catching up
+        if(uNowNs > uNextNs + m_uIntervalNs)
+        {
+            uNextNs = uNowNs;
+        }
+    }
+}
+
+/// @brief			check the heartbeat of one thread and escalate a stall
+/// @param zWatched	watched thread
+/// @param uNowNs	time of the check
+void CRTWatchdog::Check(WATCHED& zWatched, uint64 uNowNs)
+{
+    uint64 uBeats = zWatched.pHeartbeat->uBeats.load(std::memory_order_relaxed);
+    if(uBeats != zWatched.uLastBeats)
+    {
+        if(zWatched.bStalled)
+        {
+            Log::Error("Watchdog: {0} resumed after a stall of {1} us", zWatched.szName, (uNowNs - zWatched.uLastBeatNs) / 1000);
+            zWatched.bStalled = false;
+        }
+        zWatched.uLastBeats = uBeats;
+        zWatched.uLastBeatNs = uNowNs;
+        return;
+    }
+
+    // the thread is watched from its first beat, before it may wait for the start of its cycle
+    if(uBeats == 0)
+    {
+        return;
+    }
+
+    uint64 uStallNs = uNowNs - zWatched.uLastBeatNs;
+    if(uStallNs < zWatched.uStallNs)
+    {
+        return;
+    }
+
+    if(m_pMetrics->uRTLongestStallUs.load(std::memory_order_relaxed) < uStallNs / 1000)
+    {
+        m_pMetrics->uRTLongestStallUs.store(uStallNs / 1000, std::memory_order_relaxed);
+    }
+
+    if(zWatched.bStalled == false)
+    {
+        zWatched.bStalled = true;
+        zWatched.uReportedNs = uNowNs;
+        IncrementMetric(m_pMetrics->uRTStalls);
+        Snapshot(zWatched, uStallNs, true);
+    }
+    else if(uNowNs - zWatched.uReportedNs >= (uint64)WATCHDOG_REPEAT_TIME * 1000)
+    {
+        zWatched.uReportedNs = uNowNs;
+        Snapshot(zWatched, uStallNs, false);
+    }
+
+    if((zWatched.uAbortNs != 0) && (uStallNs >= zWatched.uAbortNs))
+    {
+        Log::Error("Watchdog: {0} stalled for {1} us, abort of the process", zWatched.szName, uStallNs / 1000);
+        abort();
+    }
+}
+
+/// @brief			log the state of a stalled thread
+/// @param zWatched	watched thread
+/// @param uStallNs	time since the last beat
+/// @param bStacks	log the stacks with WATCHDOG_STACKS
+void CRTWatchdog::Snapshot(const WATCHED& zWatched, uint64 uStallNs, bool bStacks)
+{
+    int32_t nTid = zWatched.pHeartbeat->nTid.load(std::memory_order_relaxed);
+
+    Log::Error("Watchdog: {0} stalled for {1} us in phase {2}, cycle {3}, thread {4}", zWatched.szName, uStallNs / 1000,
+               zWatched.pHeartbeat->szPhase.load(std::memory_order_relaxed), zWatched.uLastBeats, nTid);
+
+    if(nTid != 0)
+    {
+        LogSchedulerStats(nTid);
+#ifdef WATCHDOG_STACKS
+        if(bStacks)
+        {
+            LogStacks(nTid);
+        }
+#else
+        (void)bStacks;
+#endif
+    }
+}
+
+/// @brief		log the state of a thread and its scheduler statistics from /proc
+/// @param nTid	kernel thread ID
+void CRTWatchdog::LogSchedulerStats(int32_t nTid)
+{
+    char szText[4096];
+
+    // the fields after the name in parentheses, see man proc(5): state is field 3
+    if(ReadProcFile(nTid, "stat", szText, sizeof(szText)))
+    {
+        char szState[2] = "?";
+        unsigned long long uField[41] = {};
+        char* pNext = strrchr(szText, ')');
+        if((pNext != NULL) && (pNext[1] == ' ') && (pNext[2] != '\0'))
+        {
+            szState[0] = pNext[2];
+            pNext += 3;
+            for(int nField = 4; nField <= 40; nField++)
+            {
+                uField[nField] = strtoull(pNext, &pNext, 10);
+            }
+        }
+        long lTicks = sysconf(_SC_CLK_TCK);
+        lTicks = (lTicks > 0) ? lTicks : 100;
+        Log::Error("Watchdog: thread {0} state {1}, cpu {2}, rt priority {3}, user {4} ms, system {5} ms", nTid, szState,
+                   uField[39], uField[40], uField[14] * 1000 / lTicks, uField[15] * 1000 / lTicks);
+    }
+
+    // time on the CPU, time waiting on a run queue, number of timeslices
+    unsigned long long uRunNs = 0, uWaitNs = 0, uSlices = 0;
+    if(ReadProcFile(nTid, "schedstat", szText, sizeof(szText)) &&
+       (sscanf(szText, "%llu %llu %llu", &uRunNs, &uWaitNs, &uSlices) == 3))
+    {
+        Log::Error("Watchdog: thread {0} run {1} us, run queue wait {2} us, timeslices {3}", nTid, uRunNs / 1000, uWaitNs / 1000, uSlices);
+    }
+
+    if(ReadProcFile(nTid, "status", szText, sizeof(szText)))
+    {
+        Log::Error("Watchdog: thread {0} voluntary switches {1}, involuntary switches {2}", nTid,
+                   FindStatusValue(szText, "voluntary_ctxt_switches:"), FindStatusValue(szText, "nonvoluntary_ctxt_switches:"));
+    }
+
+    // the kernel function the thread sleeps in and its system call, e.g. 202 (futex) for a blocked lock on x86_64
+    char szWchan[128] = "?";
+    char szSyscall[256] = "?";
+    ReadProcFile(nTid, "wchan", szWchan, sizeof(szWchan));
+    if(ReadProcFile(nTid, "syscall", szSyscall, sizeof(szSyscall)))
+    {
+        szSyscall[strcspn(szSyscall, " \n")] = '\0';
+    }
+    Log::Error("Watchdog: thread {0} wait channel {1}, system call {2}", nTid, szWchan, szSyscall);
+}
+
+/// @brief		log the kernel stack from /proc and the user stack taken by a signal in the thread
+/// @param nTid	kernel thread ID
+void CRTWatchdog::LogStacks(int32_t nTid)
+{
+#ifdef WATCHDOG_STACKS
+    char szText[2048];
+    if(ReadProcFile(nTid, "stack", szText, sizeof(szText)))
+    {
+        char* pNext = szText;
+        for(char* pLine = strtok_r(pNext, "\n", &pNext); pLine != NULL; pLine = strtok_r(pNext, "\n", &pNext))
+        {
+            Log::Error("Watchdog: kernel stack {0}", pLine);
+        }
+    }
+
+    // a thread blocked in the kernel handles the signal only when it returns to user space
+    s_nStackDepth.store(-1, std::memory_order_relaxed);
+    if(syscall(SYS_tgkill, getpid(), nTid, WATCHDOG_STACK_SIGNAL) == 0)
+    {
+        uint64 uEndNs = GetMonotonicTimeNs() + (uint64)WATCHDOG_STACK_TIMEOUT * 1000;
+        while((s_nStackDepth.load(std::memory_order_acquire) < 0) && (GetMonotonicTimeNs() < uEndNs))
+        {
+            usleep(1000);
+        }
+    }
+
+    int nDepth = s_nStackDepth.load(std::memory_order_acquire);
+    if(nDepth > 0)
+    {
+        char** pSymbols = backtrace_symbols(s_pStackFrames, nDepth);
+        for(int nFrame = 0; nFrame < nDepth; nFrame++)
+        {
+            if(pSymbols != NULL)
+            {
+                Log::Error("Watchdog: user stack {0}", pSymbols[nFrame]);
+            }
+            else
+            {
+                Log::Error("Watchdog: user stack {0}", s_pStackFrames[nFrame]);
+            }
+        }
+        free(pSymbols);
+    }
+    else
+    {
+        Log::Error("Watchdog: no user stack of thread {0} within {1} us", nTid, WATCHDOG_STACK_TIMEOUT);
+    }
+#else
+    (void)nTid;
+#endif
+}
@@ -0,0 +1,127 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CRTWatchdog.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef CRTWATCHDOG_H_
+#define CRTWATCHDOG_H_
+
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <atomic>
+#include <string>
+#include <vector>
+#include "Arp/System/Core/Arp.h"
+#include "Arp/System/Commons/Logging.h"
+#include "RuntimeMetrics.h"
+#include "Utility.h"
+
+using namespace std;
+using namespace Arp;
+
+// the snapshot of a stall contains the kernel stack from /proc (needs root) and the user stack of
+// the stalled thread, uncomment to enable. The user stack is taken by a signal handler in the
+// stalled thread, a blocking system call of that thread returns with EINTR
+//#define WATCHDOG_STACKS
+
+#define WATCHDOG_PRIORITY		82		// SCHED_FIFO priority of the supervisor, above the watched threads
+#define WATCHDOG_MAX_THREADS	4		// max. number of watched threads
+#define WATCHDOG_STACK_DEPTH	32		// max. frames of a user stack
+#define WATCHDOG_STACK_TIMEOUT	20000	// max. time to wait for the user stack in us
+#define WATCHDOG_REPEAT_TIME	1000000	// interval of the reminder while a thread stays stalled in us
+
+///	structure with the heartbeat of a watched thread. It is written only by that thread with
+/// relaxed stores, so it costs a few instructions per cycle and never blocks
+struct RTHEARTBEAT
+{
+    std::atomic<uint64_t> uBeats{0};			// cycles of the thread, 0 before the first cycle
+    std::atomic<const char*> szPhase{"start"};	// last phase entered, must be a literal
+    std::atomic<int32_t> nTid{0};				// kernel thread ID, 0 before the thread runs
+
+    /// @brief	called once by the watched thread before its loop
+    void Attach()
+    {
+        nTid.store(GetThreadId(), std::memory_order_relaxed);
+    }
+
+    /// @brief	called by the watched thread once per cycle
+    void Beat()
+    {
+        uBeats.store(uBeats.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    /// @brief			called by the watched thread at the start of each phase of its cycle
+    /// @param szName	name of the phase, must be a literal
+    void Enter(const char* szName)
+    {
+        szPhase.store(szName, std::memory_order_relaxed);
+    }
+
+    static int32_t GetThreadId()
+    {
+        return((int32_t)syscall(SYS_gettid));
+    }
+};
+
+/// @brief	independent supervisor of the realtime threads. It runs in its own SCHED_FIFO thread
+/// 		above the priority of the watched threads, so it also runs if a watched thread spins.
+/// 		Every check interval it compares the heartbeat of each thread with the last check.
+/// 		A thread without a new beat for its stall time is stalled, the detection latency is
+/// 		at most the stall time plus one check interval. The escalation of a stall:
+///
+/// 		- at once: metric rt_stalls_total and a snapshot in the log with the last phase,
+/// 		  the cycle, the state and scheduler statistics of the thread from /proc and with
+/// 		  WATCHDOG_STACKS the kernel and user stack
+/// 		- every WATCHDOG_REPEAT_TIME: a reminder with a new snapshot of /proc
+/// 		- after the abort time of the thread, if not 0: abort of the process with a core
+/// 		  dump, for applications where a hanging process is worse than no process
+/// 		- on the next beat: the duration of the stall
+///
+/// 		The threads are added before Start, the supervisor is never stopped like the
+/// 		realtime thread
+class CRTWatchdog
+{
+public:
+    CRTWatchdog();
+    virtual ~CRTWatchdog();
+
+    bool AddThread(const char* szName, RTHEARTBEAT* pHeartbeat, uint64 uStallUs, uint64 uAbortUs);
+    bool Start(RUNTIMEMETRICS* pMetrics, uint64 uIntervalUs);
+
+private:
+    ///	structure with the state of a watched thread, only used by the supervisor
+    struct WATCHED
+    {
+        const char* szName = NULL;			// name for logging, must be a literal
+        RTHEARTBEAT* pHeartbeat = NULL;
+        uint64 uStallNs = 0;
+        uint64 uAbortNs = 0;				// 0: never abort
+        uint64 uLastBeats = 0;
+        uint64 uLastBeatNs = 0;				// time of the check which saw a new beat
+        bool bStalled = false;
+        uint64 uReportedNs = 0;				// time of the last snapshot
+    };
+
+    pthread_t m_zThread;
+    bool m_bStarted;
+    RUNTIMEMETRICS* m_pMetrics;
+    uint64 m_uIntervalNs;
+    vector<WATCHED> m_zWatched;
+
+    static void* StaticCycle(void* p);
+    void Cycle();
+    void Check(WATCHED& zWatched, uint64 uNowNs);
+    void Snapshot(const WATCHED& zWatched, uint64 uStallNs, bool bStacks);
+    void LogSchedulerStats(int32_t nTid);
+    void LogStacks(int32_t nTid);
+};
+
+#endif /* CRTWATCHDOG_H_ */
@@ -0,0 +1,366 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CRetainStore.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#include "CRetainStore.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define FNV_OFFSET	0xcbf29ce484222325ULL
+#define FNV_PRIME	0x100000001b3ULL
+
+/// @brief			FNV-1a hash
+/// @param uHash	hash of the previous data
+/// @param pData	data
+/// @param nSize	size of data in bytes
+/// @return			hash
+static uint64 HashFnv(uint64 uHash, const void* pData, size_t nSize)
+{
+    const unsigned char* pByte = (const unsigned char*)pData;
+    for(size_t nCount = 0; nCount < nSize; nCount++)
+    {
+        uHash ^= pByte[nCount];
+        uHash *= FNV_PRIME;
+    }
+    return(uHash);
+}
+
+CRetainStore::CRetainStore()
+            : m_nDataSize(0),
+              m_uMirrorSequence(0),
+              m_uFlushedSequence(0),
+              m_pFile(NULL),
+              m_nFileSize(0),
+              m_nBankSize(0)
+{
+    pthread_mutex_init(&m_zMutex, NULL);
+}
+
+CRetainStore::~CRetainStore()
+{
+    Close();
+    pthread_mutex_destroy(&m_zMutex);
+}
+
+/// @brief	remove all entries, the file has to be closed before
+void CRetainStore::Clear()
+{
+    m_zEntries.clear();
+    m_nDataSize = 0;
+}
+
+/// @brief			add a value which is kept over a restart
+/// @param strID	ID of value, part of the layout hash
+/// @param pValue	value of the realtime thread, must be valid until the file is closed
+/// @param nSize	size in bytes
+void CRetainStore::AddEntry(const string& strID, void* pValue, size_t nSize)
+{
+    RETAINENTRY zEntry;
+    zEntry.strID = strID;
+    zEntry.pValue = (unsigned char*)pValue;
+    zEntry.nSize = nSize;
+    zEntry.nOffset = m_nDataSize;
+    m_zEntries.push_back(zEntry);
+
+    m_nDataSize += nSize;
+}
+
+/// @brief			map the retain file, it is created or initialized if it does not fit to the entries
+/// @param szFile	path of the file
+/// @return			true: success, false: failure, the values are not retained
+bool CRetainStore::Open(const char* szFile)
+{
+    Close();
+
+#ifdef RETAIN_STORE
+    bool bRet = false;
+
+    m_nBankSize = (sizeof(RETAINBANK) + m_nDataSize + 7) & ~(size_t)7;
+    m_nFileSize = sizeof(RETAINHEADER) + 2 * m_nBankSize;
+    uint64 uLayoutHash = GetLayoutHash();
+
+    pthread_mutex_lock(&m_zMutex);
+
+    // the mirror starts with the current values, the first flush is done on the first change
+    m_zMirror.assign(m_nDataSize, 0);
+    for(const RETAINENTRY& zEntry : m_zEntries)
+    {
+        memcpy(&m_zMirror[zEntry.nOffset], zEntry.pValue, zEntry.nSize);
+    }
+    m_zSnapshot.assign(m_nDataSize, 0);
+    m_uMirrorSequence.store(0, std::memory_order_relaxed);
+    m_uFlushedSequence = 0;
+
+    mkdir("retain", 0755);
+    int nFd = open(szFile, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if(nFd >= 0)
+    {
+        struct stat zStat;
+        bool bSizeOk = (fstat(nFd, &zStat) == 0) && ((size_t)zStat.st_size == m_nFileSize);
+        if(bSizeOk || ((ftruncate(nFd, 0) == 0) && (ftruncate(nFd, m_nFileSize) == 0)))
+        {
+            // all pages are mapped now, only the event loop writes to them
+            void* pFile = mmap(NULL, m_nFileSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, nFd, 0);
+            if(pFile != MAP_FAILED)
+            {
+                m_pFile = (unsigned char*)pFile;
+                bRet = true;
+            }
+            else
+            {
+                Log::Error("Retain store: mmap of {0} failed", szFile);
+            }
+        }
+        else
+        {
+            Log::Error("Retain store: ftruncate of {0} failed", szFile);
+        }
+        close(nFd);
+    }
+    else
+    {
+        Log::Error("Retain store: open of {0} failed", szFile);
+    }
+
+    if(bRet)
+    {
+        RETAINHEADER* pHeader = (RETAINHEADER*)m_pFile;
+        if((pHeader->uMagic != RETAIN_MAGIC) || (pHeader->uVersion != RETAIN_VERSION) ||
+           (pHeader->uEntryCount != m_zEntries.size()) || (pHeader->uDataSize != m_nDataSize) ||
+           (pHeader->uLayoutHash != uLayoutHash))
+        {
+            // different program or first start, the old values must not be restored
+            if(pHeader->uMagic == RETAIN_MAGIC)
+            {
+                Log::Info("Retain store: layout changed, retained values are discarded");
+            }
+            memset(m_pFile, 0, m_nFileSize);
+            pHeader->uVersion = RETAIN_VERSION;
+            pHeader->uEntryCount = m_zEntries.size();
+            pHeader->uDataSize = m_nDataSize;
+            pHeader->uLayoutHash = uLayoutHash;
+            pHeader->uMagic = RETAIN_MAGIC;
+            msync(m_pFile, m_nFileSize, MS_SYNC);
+        }
+
+        Log::Info("Retain store: {0} values ({1} bytes) in {2}", m_zEntries.size(), m_nDataSize, szFile);
+    }
+
+    pthread_mutex_unlock(&m_zMutex);
+
+    return(bRet);
+#else
+    return(false);
+#endif
+}
+
+/// @brief	unmap the file, the caller has to flush before
+void CRetainStore::Close()
+{
+    pthread_mutex_lock(&m_zMutex);
+    if(m_pFile != NULL)
+    {
+        munmap(m_pFile, m_nFileSize);
+        m_pFile = NULL;
+    }
+    pthread_mutex_unlock(&m_zMutex);
+}
+
+/// @brief	copy the values of the newest valid bank to the entries and to the mirror
+/// @return	true: values restored, false: no valid values
+bool CRetainStore::Restore()
+{
+    bool bRet = false;
+
+    pthread_mutex_lock(&m_zMutex);
+    if(m_pFile != NULL)
+    {
+        RETAINBANK* pBank = NULL;
+        for(int nBank = 0; nBank < 2; nBank++)
+        {
+            RETAINBANK* pCandidate = GetBank(nBank);
+            if(IsValid(pCandidate) && ((pBank == NULL) || (pCandidate->uSequence > pBank->uSequence)))
+            {
+                pBank = pCandidate;
+            }
+        }
+
+        if(pBank != NULL)
+        {
+            const unsigned char* pData = (const unsigned char*)(pBank + 1);
+            for(const RETAINENTRY& zEntry : m_zEntries)
+            {
+                memcpy(zEntry.pValue, pData + zEntry.nOffset, zEntry.nSize);
+            }
+            memcpy(m_zMirror.data(), pData, m_nDataSize);
+            bRet = true;
+
+            Log::Info("Retain store: {0} values of flush {1} restored", m_zEntries.size(), pBank->uSequence);
+        }
+    }
+    pthread_mutex_unlock(&m_zMutex);
+
+    return(bRet);
+}
+
+/// @brief	discard the values of the file, e.g. on a cold start
+void CRetainStore::Invalidate()
+{
+    pthread_mutex_lock(&m_zMutex);
+    if(m_pFile != NULL)
+    {
+        for(int nBank = 0; nBank < 2; nBank++)
+        {
+            memset(GetBank(nBank), 0, sizeof(RETAINBANK));
+        }
+        msync(m_pFile, m_nFileSize, MS_SYNC);
+    }
+    pthread_mutex_unlock(&m_zMutex);
+}
+
+/// @brief	copy the changed values to the mirror, called by the realtime thread. There is
+/// 		no system call and no lock, the sequence is only changed if a value changed
+void CRetainStore::Capture()
+{
+    // the file is not opened or closed while the realtime thread is inside its cycle
+    if(m_pFile == NULL)
+    {
+        return;
+    }
+
+    uint64 uSequence = m_uMirrorSequence.load(std::memory_order_relaxed);
+    bool bChanged = false;
+
+    for(const RETAINENTRY& zEntry : m_zEntries)
+    {
+        unsigned char* pMirror = &m_zMirror[zEntry.nOffset];
+        if(memcmp(pMirror, zEntry.pValue, zEntry.nSize) != 0)
+        {
+            if(bChanged == false)
+            {
+                // odd: the event loop retries its copy
+                m_uMirrorSequence.store(uSequence + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                bChanged = true;
+            }
+            memcpy(pMirror, zEntry.pValue, zEntry.nSize);
+        }
+    }
+
+    if(bChanged)
+    {
+        m_uMirrorSequence.store(uSequence + 2, std::memory_order_release);
+    }
+}
+
+/// @brief			write the mirror to the older bank of the file, if it changed since the last flush
+/// @param bSync	true: wait until the file is written, e.g. on stop of processing
+/// @return			true: success or nothing to do, false: no consistent copy or no file
+bool CRetainStore::Flush(bool bSync)
+{
+    bool bRet = false;
+
+    pthread_mutex_lock(&m_zMutex);
+    if(m_pFile != NULL)
+    {
+        // consistent copy of the mirror, the realtime thread never waits for us
+        uint64 uSequence = 0;
+        bool bCopied = false;
+        for(int nTry = 0; (nTry < RETAIN_READ_RETRIES) && (bCopied == false); nTry++)
+        {
+            uSequence = m_uMirrorSequence.load(std::memory_order_acquire);
+            if((uSequence & 1) == 0)
+            {
+                if(uSequence == m_uFlushedSequence)
+                {
+                    break;
+                }
+                memcpy(m_zSnapshot.data(), m_zMirror.data(), m_nDataSize);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                bCopied = (m_uMirrorSequence.load(std::memory_order_relaxed) == uSequence);
+            }
+        }
+
+        if(bCopied)
+        {
+            // the older or invalid bank is overwritten, the checksum is written last
+            RETAINBANK* pBank0 = GetBank(0);
+            RETAINBANK* pBank1 = GetBank(1);
+            uint64 uFlush0 = IsValid(pBank0) ? pBank0->uSequence : 0;
+            uint64 uFlush1 = IsValid(pBank1) ? pBank1->uSequence : 0;
+            RETAINBANK* pBank = (uFlush0 <= uFlush1) ? pBank0 : pBank1;
+            uint64 uFlush = ((uFlush0 > uFlush1) ? uFlush0 : uFlush1) + 1;
+
+            pBank->uChecksum = 0;
+            memcpy(pBank + 1, m_zSnapshot.data(), m_nDataSize);
+            pBank->uSequence = uFlush;
+            pBank->uChecksum = GetChecksum(uFlush, m_zSnapshot.data());
+
+            m_uFlushedSequence = uSequence;
+        }
+        bRet = bCopied || (uSequence == m_uFlushedSequence);
+
+        // with MS_ASYNC the kernel writes the dirty pages in the background
+        if(bCopied || bSync)
+        {
+            msync(m_pFile, m_nFileSize, bSync ? MS_SYNC : MS_ASYNC);
+        }
+    }
+    pthread_mutex_unlock(&m_zMutex);
+
+    return(bRet);
+}
+
+/// @brief	hash of the IDs and sizes of all entries
+/// @return	hash
+uint64 CRetainStore::GetLayoutHash() const
+{
+    uint64 uHash = FNV_OFFSET;
+    for(const RETAINENTRY& zEntry : m_zEntries)
+    {
+        uint64 uSize = zEntry.nSize;
+        uHash = HashFnv(uHash, zEntry.strID.c_str(), zEntry.strID.size() + 1);
+        uHash = HashFnv(uHash, &uSize, sizeof(uSize));
+    }
+    return(uHash);
+}
+
+/// @brief			bank of the file
+/// @param nBank	0 or 1
+/// @return			pointer to bank
+RETAINBANK* CRetainStore::GetBank(int nBank) const
+{
+    return((RETAINBANK*)(m_pFile + sizeof(RETAINHEADER) + nBank * m_nBankSize));
+}
+
+/// @brief			check the checksum of a bank
+/// @param pBank	bank
+/// @return			true: complete values of a flush, false: empty or interrupted
+bool CRetainStore::IsValid(const RETAINBANK* pBank) const
+{
+    return((pBank->uChecksum != 0) &&
+           (pBank->uChecksum == GetChecksum(pBank->uSequence, (const unsigned char*)(pBank + 1))));
+}
+
+/// @brief				checksum of a bank
+/// @param uSequence	number of the flush
+/// @param pData		values
+/// @return				checksum, never 0
+uint64 CRetainStore::GetChecksum(uint64 uSequence, const unsigned char* pData) const
+{
+    uint64 uHash = HashFnv(FNV_OFFSET, &uSequence, sizeof(uSequence));
+    uHash = HashFnv(uHash, pData, m_nDataSize);
+    return((uHash != 0) ? uHash : 1);
+}
@@ -0,0 +1,113 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CRetainStore.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef CRETAINSTORE_H_
+#define CRETAINSTORE_H_
+
+#include <pthread.h>
+#include <atomic>
+#include <string>
+#include <vector>
+#include "Arp/System/Core/Arp.h"
+#include "Arp/System/Commons/Logging.h"
+#include "Utility.h"
+
+using namespace Arp;
+using namespace std;
+
+// keep the state of the logic and the retained outputs in a memory-mapped file and restore them on a
+// warm start, comment out to disable
+#define RETAIN_STORE
+
+#define RETAIN_FILE				"retain/PLCnextSampleRuntime.retain"
+#define RETAIN_FLUSH_INTERVAL	100			// interval for writing changed values to the file in ms
+#define RETAIN_MAGIC			0x4E544552	// "RETN"
+#define RETAIN_VERSION			1
+#define RETAIN_READ_RETRIES		100			// max. tries to get a consistent copy of the values
+
+///	header of the retain file, followed by two banks of the same size
+struct RETAINHEADER
+{
+    uint32 uMagic;
+    uint16 uVersion;
+    uint16 uReserved;
+    uint32 uEntryCount;		// number of retained values
+    uint32 uDataSize;		// sum of the sizes of all values in bytes
+    uint64 uLayoutHash;		// hash of the IDs and sizes, the banks are only restored if it matches
+};
+
+///	header of a bank, followed by the values in the order of the entries. The banks are written
+/// alternately, so a bank that was interrupted by a power loss never hides the other one
+struct RETAINBANK
+{
+    uint64 uSequence;		// number of the flush, the valid bank with the higher number is restored
+    uint64 uChecksum;		// FNV-1a over sequence and values, 0 for an empty bank
+};
+
+/// @brief	retain area for values of the realtime thread, e.g. outputs and state of the logic.
+/// 		The realtime thread only compares its values with a mirror in normal memory and
+/// 		copies the changed ones. Writing the file directly would cause page faults, whenever
+/// 		the kernel has written back a page and protects it again to track the next change.
+/// 		The event loop copies the mirror to the file only if it changed, so only changed pages
+/// 		become dirty, and the values are written synchronously when processing stops.
+class CRetainStore
+{
+public:
+    CRetainStore();
+    virtual ~CRetainStore();
+
+    // layout, must not be called while the realtime thread captures
+    void Clear();
+    void AddEntry(const string& strID, void* pValue, size_t nSize);
+    bool Open(const char* szFile = RETAIN_FILE);
+    void Close();
+
+    // values of the file, must not be called while the realtime thread captures
+    bool Restore();
+    void Invalidate();
+
+    // called by the realtime thread in every cycle
+    void Capture();
+
+    // called by a non-realtime thread
+    bool Flush(bool bSync);
+
+private:
+    ///	structure to handle one retained value
+    struct RETAINENTRY
+    {
+        string strID;
+        unsigned char* pValue;		// value of the realtime thread
+        size_t nSize;				// size in bytes
+        size_t nOffset;				// offset in the mirror and in the banks
+    };
+    vector<RETAINENTRY> m_zEntries;
+    size_t m_nDataSize;
+
+    // copy of the values, written by the realtime thread and protected by a seqlock
+    vector<unsigned char> m_zMirror;
+    std::atomic<uint64> m_uMirrorSequence;	// odd while the realtime thread writes
+    uint64 m_uFlushedSequence;				// mirror sequence of the last flush
+
+    pthread_mutex_t m_zMutex;	// protects the file against a flush during open and close
+    unsigned char* m_pFile;		// NULL, if there is no file
+    size_t m_nFileSize;
+    size_t m_nBankSize;
+    vector<unsigned char> m_zSnapshot;	// consistent copy of the mirror for a flush
+
+    uint64 GetLayoutHash() const;
+    RETAINBANK* GetBank(int nBank) const;
+    bool IsValid(const RETAINBANK* pBank) const;
+    uint64 GetChecksum(uint64 uSequence, const unsigned char* pData) const;
+};
+
+#endif /* CRETAINSTORE_H_ */
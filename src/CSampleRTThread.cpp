@@ -11,20 +11,47 @@
  ******************************************************************************/
 
 #include "CSampleRTThread.h"
+#include "CStartupTimeline.h"
 
 #define ARP_IO_AXIO "Arp.Io.AxlC"	// ID of AXIO IO Component
 #define ARP_IO_PN	"Arp.Io.PnC"	// ID of PROFINET IO Component
 
-#define RTCYCLETIME 1000			// Cycletime of RT-Thread in us. Use only multiple of 500
+#if defined(PHASE_ALIGN) && ((RTCYCLETIME % PHASEALIGN_BUS_CYCLE) != 0)
+#error "RTCYCLETIME must be a multiple of PHASEALIGN_BUS_CYCLE"
+#endif
+
+#define RTSTOP_TIMEOUT		(10 * RTCYCLETIME)	// max. time to wait for the end of the RT cycle in us
+#define LOGGINGSTOP_TIMEOUT	500000				// max. time to wait for the end of the logging cycle in us
+
+#define LOGGING_INTERVAL			100	// interval of the logging cycle in the event loop in ms
+#define LOGGING_THROTTLE_REDUCED	5	// log only every n-th logging cycle on THROTTLE_REDUCED
+#define LOGGING_THROTTLE_MINIMAL	20	// log only every n-th logging cycle on THROTTLE_MINIMAL
 
 CSampleRTThread::CSampleRTThread()
       : m_zRTCycleThread(),
-        m_zLoggingThread(),
         m_bInitialized(false),
+        m_uTimersAdded(0),
+        m_uLoggingCycle(0),
+        m_uFrameRecorderCycle(0),
         m_bDoCycle(false),
         m_bFirstRTCycle(true),
         m_pGdsInBuffer(NULL),
-        m_pGdsOutBuffer(NULL)
+        m_pGdsOutBuffer(NULL),
+        m_pGdsAxioDiagBuffer(NULL),
+        m_pSetpointMailbox(NULL),
+        m_pResultMailbox(NULL),
+        m_pDeviceStatus(NULL),
+        m_pMetrics(NULL),
+        m_pIn04(NULL),
+        m_pIn05(NULL),
+        m_pOut04(NULL),
+        m_pOut05(NULL),
+        m_pOut06(NULL),
+        m_pOut07(NULL),
+        m_zStartKind(PlcOperation_None),
+        m_uStartTimeNs(0),
+        m_uFirstValidCycleNs(0),
+        m_bStartReported(true)
 {
 }
 
@@ -32,9 +59,15 @@ CSampleRTThread::~CSampleRTThread()
 {
 }
 
-/// @brief	Init and start the RT- and logging-thread
-/// @return	true: success, false: failure
-bool CSampleRTThread::Init()
+/// @brief					Init and start the RT-thread and the logging cycle in the event loop
+/// @param pSetpointMailbox	mailbox with values of the GDS for the logic
+/// @param pResultMailbox	mailbox for results of the logic to be written to the GDS
+/// @param pDeviceStatus	status of the device for throttling of the logging
+/// @param pMetrics			metrics of the cycle, written lock-free by the realtime thread
+/// @param pEventLoop		event loop for the logging timer
+/// @return					true: success, false: failure
+bool CSampleRTThread::Init(CSetpointMailbox* pSetpointMailbox, CResultMailbox* pResultMailbox, const DEVICESTATUS* pDeviceStatus,
+                           RUNTIMEMETRICS* pMetrics, CEventLoop* pEventLoop)
 {
     if(m_bInitialized)
     {
@@ -46,6 +79,36 @@ bool CSampleRTThread::Init()
 
     bool bRet = false;
 
+    if((pSetpointMailbox == NULL) || (pResultMailbox == NULL) || (pDeviceStatus == NULL) || (pMetrics == NULL) || (pEventLoop == NULL))
+    {
+        Log::Error("Null pointer in CSampleRTThread::Init");
+        return(false);
+    }
+    m_pSetpointMailbox = pSetpointMailbox;
+    m_pResultMailbox = pResultMailbox;
+    m_pDeviceStatus = pDeviceStatus;
+    m_pMetrics = pMetrics;
+
+    if(m_zWakeup.Init(m_pMetrics) == false)
+    {
+        Log::Error("Error calling timerfd_create, the realtime thread uses clock_nanosleep");
+    }
+    m_zPhaseAligner.Init(m_pMetrics, RTCYCLETIME);
+    m_zAxioDiag.Init(m_pMetrics);
+
+#ifdef IOLOG_BINARY
+    m_zIOLogger.Init(IOLOG_MODE, IOLOG_INTERVAL, true);
+#else
+    m_zIOLogger.Init(IOLOG_MODE, IOLOG_INTERVAL, false);
+#endif
+
+    // the timers are added before the thread is created, so a failed Init never leaves a running
+    // realtime thread behind and a repeated Init creates only one
+    if(AddTimers(pEventLoop) == false)
+    {
+        return(false);
+    }
+
     // create a realtime worker thread for AXIO access
     // select a priority in the range of ESM-tasks (67 to 82) to avoid conflicting
     // with the PLCnext runtime. If the AXIO-Bus is used with a realtime priority,
@@ -81,16 +144,8 @@ bool CSampleRTThread::Init()
                     // for convenience, the debug-script will automatically set the capabilities after download
                     if(pthread_create(&m_zRTCycleThread, &attr, CSampleRTThread::RTStaticCycle, this) == 0)
                     {
-                        // create a simple worker thread for RSC-subscriptions
-                        if(pthread_create(&m_zLoggingThread, NULL, CSampleRTThread::StaticLoggingCycle, this) == 0)
-                        {
-                            m_bInitialized = true;
-                            bRet = true;
-                        }
-                        else
-                        {
-                            Log::Error("Error calling pthread_create (realtime logging thread)");
-                        }
+                        m_bInitialized = true;
+                        bRet = true;
                     }
                     else
                     {
@@ -120,15 +175,80 @@ bool CSampleRTThread::Init()
     return(bRet);
 }
 
-/// @brief	The realtime thread will run continuously after creation but the processing of
-/// 		I/Os can be started and stopped e.g. if a new PLCnext Engineer Program was loaded
-/// @return	true: success, false: failure
-bool CSampleRTThread::StartProcessing()
+/// @brief				add the timers of the realtime thread to the event loop. A repeated call adds
+/// 					only the timers which were not added yet, the event loop cannot remove them
+/// @param pEventLoop	event loop for the timers
+/// @return				true: all timers added, false: failure
+bool CSampleRTThread::AddTimers(CEventLoop* pEventLoop)
+{
+    // the logging of the I/Os and the other non-realtime work is done in the event loop of the main thread
+    struct TIMER
+    {
+        const char* szName;
+        uint32 uIntervalMs;
+        TIMERCALLBACK fnCallback;
+    };
+    TIMER zTimers[] =
+    {
+        { "RT logging", LOGGING_INTERVAL, [this]() { LoggingCycle(); } },
+        { "retain store", RETAIN_FLUSH_INTERVAL, [this]() { m_zRetainStore.Flush(false); } },
+        { "frame recorder", FRAMERECORD_FLUSH_INTERVAL, [this]() { FrameRecorderCycle(); } },
+        { "AXIO diag", AXIODIAG_DISPATCH_INTERVAL, [this]() { DispatchAxioDiag(); } }
+    };
+
+    for(; m_uTimersAdded < sizeof(zTimers) / sizeof(zTimers[0]); m_uTimersAdded++)
+    {
+        const TIMER& zTimer = zTimers[m_uTimersAdded];
+        if(pEventLoop->AddTimer(zTimer.szName, zTimer.uIntervalMs, zTimer.fnCallback) == false)
+        {
+            Log::Error("Error adding the timer '{0}' of the realtime thread to the event loop", zTimer.szName);
+            return(false);
+        }
+    }
+    return(true);
+}
+
+/// @brief				The realtime thread will run continuously after creation but the processing of
+/// 					I/Os can be started and stopped e.g. if a new PLCnext Engineer Program was loaded
+/// @param zOperation	kind of start, on a hot start the buffers and I/O plans of the last start are used again
+/// @return				true: success, false: failure
+bool CSampleRTThread::StartProcessing(PlcOperation zOperation)
 {
     Log::Info("Start RT processing");
 
     bool bRet = false;
 
+    // measure the time to the first valid cycle for each kind of start
+    m_zStartKind = zOperation;
+    m_uStartTimeNs = GetMonotonicTimeNs();
+    m_uFirstValidCycleNs = 0;
+    m_bStartReported = false;
+
+    // the realtime thread is outside of its processing, the inputs of the last start are unknown
+    m_zInputFreshness = INPUTFRESHNESS();
+
+    // on a hot start the program layout did not change, so only a cheap check is needed
+    if((zOperation == PlcOperation_StartHot) && (m_pGdsInBuffer != NULL) && (m_pGdsOutBuffer != NULL))
+    {
+        if(CheckIOPlans())
+        {
+            Log::Info("Hot start: buffers and I/O plans of last start are used");
+            m_bDoCycle = true;
+            return(true);
+        }
+        Log::Info("Hot start: I/O plans do not fit to the GDS buffers, they are compiled again");
+    }
+
+    // buffers and plans of the last start are not used on cold and warm starts
+    if((m_pGdsInBuffer != NULL) || (m_pGdsOutBuffer != NULL) || (m_pGdsAxioDiagBuffer != NULL))
+    {
+        if(ReleaseResources() == false)
+        {
+            Log::Error("Resources of last start are still in use, processing is not started");
+            return(false);
+        }
+    }
+
     // get in- and out-buffer of AXIO-bus (check *.tic-files for the ID)
     if(ArpPlcIo_GetBufferPtrByBufferID(ARP_IO_AXIO, "1:IN", &m_pGdsInBuffer))
     {
@@ -152,7 +272,7 @@ bool CSampleRTThread::StartProcessing()
             AddInput(m_strIn07, 1, true);
             AddOutput(m_strOut04, 1, true);
             AddOutput(m_strOut05, 1, true);
-            AddOutput(m_strOut06, 1, true);
+            AddOutput(m_strOut06, 1, true, true);	// output of the latch, it is retained with the latch
             AddOutput(m_strOut07, 1, true);
 
 
@@ -184,6 +304,19 @@ bool CSampleRTThread::StartProcessing()
                 Log::Error("Error calling ArpPlcIo_GetBufferPtrByBufferID for diag buffer");
             }
 
+            CompileIOPlans();
+
+            // the retained values are in the process image before the first cycle, a cold start discards them
+            if(zOperation == PlcOperation_StartCold)
+            {
+                m_zRetainStore.Invalidate();
+                m_zLogicState = LOGICSTATE();
+            }
+            else
+            {
+                m_zRetainStore.Restore();
+            }
+
             m_bDoCycle = true;
             bRet = true;
         }
@@ -261,7 +394,9 @@ bool CSampleRTThread::StartProcessing()
 }
 
 /// @brief	The realtime thread will run continuously after creation but the processing of
-/// 		I/Os can be started and stopped e.g. if a new PLCnext Engineer Program was loaded
+/// 		I/Os can be started and stopped e.g. if a new PLCnext Engineer Program was loaded.
+/// 		The buffers and I/O plans are kept for a hot start, use ReleaseResources() if
+/// 		the program layout changes
 /// @return	true: success, false: failure
 bool CSampleRTThread::StopProcessing()
 {
@@ -269,9 +404,63 @@ bool CSampleRTThread::StopProcessing()
 
     bool bRet = false;
 
-    // this is not threadsafe! In a real application you need to wait for end of cycle before deleting the objects
+    // the realtime thread and the logging cycle in the event loop will not start a new cycle from now on
     m_bDoCycle = false;
 
+    // no outputs are written after the stop returned
+    if(m_zRTQuiescence.WaitForQuiescence(RTSTOP_TIMEOUT))
+    {
+        // the values of the last cycle are on the disk before the PLC stops
+        m_zRetainStore.Flush(true);
+        m_zFrameRecorder.Flush();
+        bRet = true;
+    }
+    else
+    {
+        Log::Error("RT cycle did not finish within {0} us", RTSTOP_TIMEOUT);
+    }
+
+    return(bRet);
+}
+
+/// @brief	release the GDS buffers and free the I/O maps and plans, after the realtime thread
+/// 		and the logging cycle left their current cycle. Processing must be stopped before
+/// @return	true: success, false: a thread did not leave its cycle in time, nothing is released
+bool CSampleRTThread::ReleaseResources()
+{
+    Log::Info("Release RT resources");
+
+    bool bRet = false;
+
+    if(m_bDoCycle)
+    {
+        Log::Error("RT processing is running, resources are not released");
+        return(bRet);
+    }
+
+    // wait with a bounded latency, the realtime thread itself never waits for this handshake
+    if(m_zRTQuiescence.WaitForQuiescence(RTSTOP_TIMEOUT) == false)
+    {
+        Log::Error("RT cycle did not finish within {0} us, resources are not released", RTSTOP_TIMEOUT);
+        return(bRet);
+    }
+    if(m_zLoggingQuiescence.WaitForQuiescence(LOGGINGSTOP_TIMEOUT) == false)
+    {
+        Log::Error("Logging cycle did not finish within {0} us, resources are not released", LOGGINGSTOP_TIMEOUT);
+        return(bRet);
+    }
+
+    // readers of the process image see that it is stale
+    m_zProcessImage.Destroy();
+
+    // the entries point to the values of the I/O maps
+    m_zRetainStore.Flush(true);
+    m_zRetainStore.Close();
+    m_zRetainStore.Clear();
+
+    m_zFrameRecorder.Close();
+    m_zFrameRecorder.Clear();
+
     ArpPlcIo_ReleaseGdsBuffer(m_pGdsInBuffer);
     m_pGdsInBuffer = NULL;
     ArpPlcIo_ReleaseGdsBuffer(m_pGdsOutBuffer);
@@ -301,6 +490,16 @@ bool CSampleRTThread::StopProcessing()
         it++;
     }
 
+    m_zInputPlan.clear();
+    m_zOutputPlan.clear();
+    m_zAxioDiagPlan.clear();
+    m_pIn04 = NULL;
+    m_pIn05 = NULL;
+    m_pOut04 = NULL;
+    m_pOut05 = NULL;
+    m_pOut06 = NULL;
+    m_pOut07 = NULL;
+
     m_zInputsMap.clear();
     m_zOutputsMap.clear();
     m_zAxioDiagVarsMap.clear();
@@ -337,6 +536,7 @@ void CSampleRTThread::RTCycle()
     // of the program, not a relative time from cycle to cycle which could drift over time
     if(clock_gettime(CLOCK_MONOTONIC, &zCycleTime) == 0)
     {
+        m_zHeartbeat.Attach();
         while(true)
         {
             timespec zCurrentTime;
@@ -351,33 +551,90 @@ void CSampleRTThread::RTCycle()
                 if(timeCmp(zCurrentTime, zCycleTime) > 0)
                 {
                     // realtime violation, just log and recover in this example
+                    IncrementMetric(m_pMetrics->uRTOverruns);
                     Log::Error("Error realtime violation in realtime cycle");
                     Log::Error("current time: {0} sec {1} nsec cycle start: {2} sec {3} nsec ", zCurrentTime.tv_sec, zCurrentTime.tv_nsec, zCycleTime.tv_sec, zCycleTime.tv_nsec);
 
                     zCycleTime = zCurrentTime;
                     timeAdd(zCycleTime, RTCYCLETIME);	// calculate wakeup-time for next cycle
+#ifdef PHASE_ALIGN
+                    m_zPhaseAligner.Resynchronize();
+#endif
                 }
             }
             else
             {
-                // in the first cycle we wait for the next full second
-                // plus a fixed offset (TBD)
+                // in the first cycle we wait for the next full second plus a fixed offset,
+                // with PHASE_ALIGN the phase is calibrated from the updates of the input frame
                 zCycleTime.tv_sec +=1;
                 zCycleTime.tv_nsec = 450000;
                 m_bFirstRTCycle = false;
             }
 
-            // schedule next cycle
-            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &zCycleTime, NULL);
+#ifdef PHASE_ALIGN
+            // move the cycle towards the update of the input frame in small steps
+            timeAddNs(zCycleTime, m_zPhaseAligner.Schedule((uint64)zCycleTime.tv_sec * 1000000000 + zCycleTime.tv_nsec));
+#endif
+
+            // schedule next cycle, with RTWAKEUP_SPIN the last part is busy-polled
+            m_zHeartbeat.Enter("wait");
+            m_zWakeup.WaitUntil(zCycleTime);
+            m_zHeartbeat.Beat();
+
+            uint64 uWakeupNs = GetMonotonicTimeNs();
+            uint64 uPlannedNs = (uint64)zCycleTime.tv_sec * 1000000000 + zCycleTime.tv_nsec;
+            m_pMetrics->zRTWakeupLatency.Record((uWakeupNs > uPlannedNs) ? (uWakeupNs - uPlannedNs) : 0);
 
+            // buffers and maps are not freed while we are inside, see StopProcessing
+            m_zHeartbeat.Enter("quiescence");
+            m_zRTQuiescence.Enter();
             if(m_bDoCycle)
             {
+                // the shared process image and the recorded frames are written while the frames are accessed
+                m_zProcessImage.BeginWrite();
+                m_zFrameRecorder.BeginRecord();
+
                 // do some processing
-                ReadInputData();
-                ReadAxioDiagVars();
+                m_zHeartbeat.Enter("read inputs");
+                bool bValid = ReadInputData();
+                // a healthy bus is read at a reduced rate, a faulted bus and a cycle without fresh inputs at once
+                m_zHeartbeat.Enter("read diag");
+                if(m_zAxioDiag.IsDue(m_zInputFreshness.bFresh))
+                {
+                    ReadAxioDiagVars();
+                }
+                m_zHeartbeat.Enter("logic");
                 DoLogic();
-                WriteOutputData();
+                m_zHeartbeat.Enter("write outputs");
+                bValid = WriteOutputData() && bValid;
+
+                // only the changed values are copied, the file is written by the event loop
+                m_zHeartbeat.Enter("publish");
+                m_zRetainStore.Capture();
+
+                m_zProcessImage.EndWrite(bValid, m_zInputFreshness);
+                m_zFrameRecorder.EndRecord(bValid, m_pSetpointMailbox->GetReadBuffer());
+
+                // the logging cycle reports the time from start of processing to this cycle
+                if(bValid && (m_uFirstValidCycleNs.load(std::memory_order_relaxed) == 0))
+                {
+                    m_uFirstValidCycleNs.store(GetMonotonicTimeNs(), std::memory_order_release);
+                }
+
+                m_pMetrics->zRTCycleDuration.Record(GetMonotonicTimeNs() - uWakeupNs);
+                IncrementMetric(m_pMetrics->uRTCycles);
+
+#ifdef PHASE_ALIGN
+                // the polling for the calibration is not part of the cycle duration
+                if(m_zPhaseAligner.IsMeasuring())
+                {
+                    uint64 uNowNs = GetMonotonicTimeNs();
+                    m_zHeartbeat.Enter("phase probe");
+                    ProbeInputFrame(m_zPhaseAligner.GetProbeEndNs(uNowNs));
+                }
+#endif
             }
+            m_zRTQuiescence.Leave();
         }
     }
     else
@@ -386,84 +643,155 @@ void CSampleRTThread::RTCycle()
     }
 }
 
-/// @brief		static function for worker thread-entry of the realtime cycle function
-/// @param p	pointer to thread object
-void* CSampleRTThread::StaticLoggingCycle(void* p)
+/// @brief	heartbeat of the realtime thread for the watchdog
+/// @return	heartbeat, written by the realtime thread in every cycle
+RTHEARTBEAT* CSampleRTThread::GetHeartbeat()
 {
-    if(p != NULL)
+    return(&m_zHeartbeat);
+}
+
+///	@brief	write the recorded frames to the file, called by the event loop every FRAMERECORD_FLUSH_INTERVAL ms
+void CSampleRTThread::FrameRecorderCycle()
+{
+    // on high CPU load or temperature the file is written less often, but in larger blocks
+    if((m_uFrameRecorderCycle++ % m_pDeviceStatus->GetThrottleDivider(FRAMERECORD_THROTTLE_REDUCED, FRAMERECORD_THROTTLE_MINIMAL)) == 0)
     {
-        ((CSampleRTThread*)p)->LoggingCycle();
+        m_zFrameRecorder.Flush();
     }
-    return(NULL);
 }
 
-///	@brief	thread for logging the realtime I/O data, this cannot be done in the realtime thread
-/// 		without violating the realtime
+///	@brief	logging of the realtime I/O data, this cannot be done in the realtime thread
+/// 		without violating the realtime. Called by the event loop every LOGGING_INTERVAL ms
 void CSampleRTThread::LoggingCycle()
 {
-    while(true)
+    // maps are not freed while we are inside, see StopProcessing
+    m_zLoggingQuiescence.Enter();
+    if(m_bDoCycle)
     {
-        if(m_bDoCycle)
-        {
-            //Log::Info("************* RT-Thread values ****************");
+        ReportStartTime();
+    }
 
-            // log status of I/Os of RT-thread
-            // you can check the log messages in the local log-file of this application, usually in a subfolder named "Logs"
-            std::map<std::string, RAWIO>::iterator it = m_zInputsMap.begin();
-            while(it != m_zInputsMap.end())
-            {
-                RAWIO& zRawIO = it->second;
-                LogIO(zRawIO);
+    // on high CPU load or temperature the I/Os are logged less often
+    uint32 uDivider = m_pDeviceStatus->GetThrottleDivider(LOGGING_THROTTLE_REDUCED, LOGGING_THROTTLE_MINIMAL);
+    if(m_bDoCycle && ((m_uLoggingCycle++ % uDivider) == 0))
+    {
+        //Log::Info("************* RT-Thread values ****************");
 
-                it++;
-            }
+        // log status of I/Os of RT-thread, the I/O logger decides which values are written
+        // you can check the log messages in the local log-file of this application, usually in a subfolder named "Logs"
+        m_zIOLogger.BeginCycle();
 
-            it = m_zOutputsMap.begin();
-            while(it != m_zOutputsMap.end())
-            {
-                RAWIO& zRawIO = it->second;
-                LogIO(zRawIO);
+        size_t nIndex = 0;
+        for(size_t nCount = 0; nCount < m_zInputPlan.size(); nCount++)
+        {
+            LogIO(nIndex++, *m_zInputPlan[nCount]);
+        }
+        for(size_t nCount = 0; nCount < m_zOutputPlan.size(); nCount++)
+        {
+            LogIO(nIndex++, *m_zOutputPlan[nCount]);
+        }
+        for(size_t nCount = 0; nCount < m_zAxioDiagPlan.size(); nCount++)
+        {
+            LogIO(nIndex++, *m_zAxioDiagPlan[nCount]);
+        }
 
-                it++;
-            }
+        m_zIOLogger.EndCycle();
+    }
+    m_zLoggingQuiescence.Leave();
+}
 
-            it = m_zAxioDiagVarsMap.begin();
-            while(it != m_zAxioDiagVarsMap.end())
-            {
-                RAWIO& zRawIO = it->second;
-                LogIO(zRawIO);
+/// @brief	report the events of the AXIO diagnosis, called by the event loop every AXIODIAG_DISPATCH_INTERVAL ms
+void CSampleRTThread::DispatchAxioDiag()
+{
+    AXIODIAGEVENT zEvent;
+    while(m_zAxioDiag.Pop(zEvent))
+    {
+        char szRegisters[32];
+        snprintf(szRegisters, sizeof(szRegisters), "0x%04X / 0x%04X", zEvent.uStatus, zEvent.uParam);
 
-                it++;
-            }
+        switch(zEvent.zKind)
+        {
+            case AXIODIAGEVENT_SET:
+                if((zEvent.zFlag == AXIODIAG_PF) || (zEvent.zFlag == AXIODIAG_BUS) || (zEvent.zFlag == AXIODIAG_SYSFAIL))
+                {
+                    Log::Error("AXIO diag: {0} set, status / param {1}", CAxioDiagMonitor::GetFlagName(zEvent.zFlag), szRegisters);
+                }
+                else
+                {
+                    Log::Info("AXIO diag: {0} set, status / param {1}", CAxioDiagMonitor::GetFlagName(zEvent.zFlag), szRegisters);
+                }
+                break;
+            case AXIODIAGEVENT_CLEARED:
+                if(zEvent.zFlag == AXIODIAG_RUN)
+                {
+                    Log::Error("AXIO diag: {0} cleared, status / param {1}", CAxioDiagMonitor::GetFlagName(zEvent.zFlag), szRegisters);
+                }
+                else
+                {
+                    Log::Info("AXIO diag: {0} cleared, status / param {1}", CAxioDiagMonitor::GetFlagName(zEvent.zFlag), szRegisters);
+                }
+                break;
+            case AXIODIAGEVENT_PARAM:
+                Log::Info("AXIO diag: parameter changed, status / param {0}", szRegisters);
+                break;
         }
-        WAIT100ms
     }
 }
 
-/// @brief			log a single I/O
-/// @param zRawIO	reference to I/O
-void CSampleRTThread::LogIO(RAWIO& zRawIO)
+/// @brief	log the time from start of processing to the first valid cycle once per start
+void CSampleRTThread::ReportStartTime()
 {
-    if(zRawIO.bIsBool)
+    uint64 uFirstValidCycleNs = m_uFirstValidCycleNs.load(std::memory_order_acquire);
+    if(m_bStartReported || (uFirstValidCycleNs == 0))
     {
-        Log::Info("{0}: {1}", zRawIO.strID, zRawIO.bValue);
+        return;
     }
-    else if(zRawIO.zSize == 1)
+    m_bStartReported = true;
+
+    // the first productive cycle completes the startup timeline of the process
+    g_zStartupTimeline.Mark(STARTUP_FIRSTCYCLE, uFirstValidCycleNs);
+    g_zStartupTimeline.Report();
+
+    size_t nKind = 0;
+    const char* szKind = NULL;
+    switch(m_zStartKind)
     {
-        // log first byte of value
-        // if you are wondering about the formatting syntax of the Log-Class, check
-        // http://fmtlib.net/latest/syntax.html
-        unsigned char ucValue = *(zRawIO.pValue);
-        Log::Info("{0}: {1:#04x}", zRawIO.strID, ucValue);
+        case PlcOperation_StartCold:	nKind = 0; szKind = "cold"; break;
+        case PlcOperation_StartWarm:	nKind = 1; szKind = "warm"; break;
+        case PlcOperation_StartHot:		nKind = 2; szKind = "hot"; break;
+        default:						return;
     }
-    else
+
+    uint64 uTimeUs = (uFirstValidCycleNs - m_uStartTimeNs) / 1000;
+    STARTTIMES& zTimes = m_zStartTimes[nKind];
+    zTimes.uCount++;
+    zTimes.uLastUs = uTimeUs;
+    if(uTimeUs > zTimes.uMaxUs)
+    {
+        zTimes.uMaxUs = uTimeUs;
+    }
+
+    Log::Info("Time to first valid cycle after {0} start: {1} us ({2} {0} starts, max. {3} us)", szKind, uTimeUs, zTimes.uCount, zTimes.uMaxUs);
+}
+
+/// @brief			hand over the value of a single I/O to the I/O logger
+/// @param nIndex	index of I/O in the I/O plans
+/// @param zRawIO	reference to I/O
+void CSampleRTThread::LogIO(size_t nIndex, RAWIO& zRawIO)
+{
+    uint64 uValue = 0;
+
+    if(zRawIO.bIsBool)
     {
-        // log first 2 byte of value
-        // if you are wondering about the formatting syntax of the Log-Class, check
-        // http://fmtlib.net/latest/syntax.html
-        unsigned short usValue = *((short*)zRawIO.pValue);
-        Log::Info("{0}: {1:#06x}", zRawIO.strID, usValue);
+        uValue = zRawIO.bValue ? 1 : 0;
     }
+    else if(zRawIO.pValue != NULL)
+    {
+        // the first 8 bytes of the value are logged
+        memcpy(&uValue, zRawIO.pValue, (zRawIO.zSize < sizeof(uValue)) ? zRawIO.zSize : sizeof(uValue));
+    }
+
+    m_zIOLogger.LogPoint(nIndex, zRawIO.strID, zRawIO.bIsBool, zRawIO.zSize, uValue);
 }
 
 /// @brief			add one input to the list of inputs
@@ -517,13 +845,15 @@ bool CSampleRTThread::AddInput(std::string strID, size_t zSize, bool bIsBool)
 /// @param strID	identifier of output (check *.tic-files for the name)
 /// @param zSize	size in bytes
 /// @param bIsBool	true, if it is a single-bit value
+/// @param bRetain	true, if the output keeps its value over a warm start
 /// @return			true: success, false: failure
-bool CSampleRTThread::AddOutput(std::string strID, size_t zSize, bool bIsBool)
+bool CSampleRTThread::AddOutput(std::string strID, size_t zSize, bool bIsBool, bool bRetain)
 {
     bool bRet = false;
     RAWIO zIO;
     zIO.strID = strID;
     zIO.bIsBool = bIsBool;
+    zIO.bRetain = bRetain;
     zIO.zSize = zSize;
     zIO.pValue = (unsigned char*)malloc(zSize);
     memset(zIO.pValue, 0, zSize);
@@ -607,6 +937,235 @@ bool CSampleRTThread::AddAxioDiagVar(std::string strID, size_t zSize, bool bIsBo
     return(bRet);
 }
 
+/// @brief		build the I/O plans from the maps, so the realtime cycle does not need any map lookup
+/// @return		true: success, false: failure
+bool CSampleRTThread::CompileIOPlans(void)
+{
+    // the I/Os used by the logic. A missing I/O is added with default values, so the logic
+    // always gets a valid pointer
+    m_pIn04 = &m_zInputsMap[m_strIn04];
+    m_pIn05 = &m_zInputsMap[m_strIn05];
+    m_pOut04 = &m_zOutputsMap[m_strOut04];
+    m_pOut05 = &m_zOutputsMap[m_strOut05];
+    m_pOut06 = &m_zOutputsMap[m_strOut06];
+    m_pOut07 = &m_zOutputsMap[m_strOut07];
+
+    // the elements of a map do not move, so the pointers stay valid until the maps are cleared
+    m_zInputPlan.clear();
+    m_zInputPlan.reserve(m_zInputsMap.size());
+    for(std::map<std::string, RAWIO>::iterator it = m_zInputsMap.begin(); it != m_zInputsMap.end(); it++)
+    {
+        m_zInputPlan.push_back(&(it->second));
+    }
+
+    m_zOutputPlan.clear();
+    m_zOutputPlan.reserve(m_zOutputsMap.size());
+    for(std::map<std::string, RAWIO>::iterator it = m_zOutputsMap.begin(); it != m_zOutputsMap.end(); it++)
+    {
+        m_zOutputPlan.push_back(&(it->second));
+    }
+
+    m_zAxioDiagPlan.clear();
+    m_zAxioDiagPlan.reserve(m_zAxioDiagVarsMap.size());
+    for(std::map<std::string, RAWIO>::iterator it = m_zAxioDiagVarsMap.begin(); it != m_zAxioDiagVarsMap.end(); it++)
+    {
+        m_zAxioDiagPlan.push_back(&(it->second));
+    }
+
+    // the logging cycle is not running, see StartProcessing, see StartProcessing
+    m_zIOLogger.Reset(m_zInputPlan.size() + m_zOutputPlan.size() + m_zAxioDiagPlan.size());
+
+    CompileProcessImage();
+    CompileRetainStore();
+    CompileFrameRecorder();
+    CompilePhaseAligner();
+    CompileAxioDiag();
+
+    return(true);
+}
+
+/// @brief		create the retain area from the state of the logic and the outputs which were added with
+/// 			bRetain. On a warm start, DoLogic continues with the restored state, all other outputs
+/// 			start with 0
+void CSampleRTThread::CompileRetainStore(void)
+{
+    m_zRetainStore.Clear();
+
+    m_zRetainStore.AddEntry("Logic.Latch", &m_zLogicState.bLatch, sizeof(m_zLogicState.bLatch));
+    m_zRetainStore.AddEntry("Logic.LastIn04", &m_zLogicState.bLastIn04, sizeof(m_zLogicState.bLastIn04));
+    m_zRetainStore.AddEntry("Logic.LastIn05", &m_zLogicState.bLastIn05, sizeof(m_zLogicState.bLastIn05));
+
+    for(size_t nCount = 0; nCount < m_zOutputPlan.size(); nCount++)
+    {
+        RAWIO& zIO = *m_zOutputPlan[nCount];
+        if(zIO.bRetain == false)
+        {
+            continue;
+        }
+
+        if(zIO.bIsBool)
+        {
+            m_zRetainStore.AddEntry(zIO.strID, &zIO.bValue, sizeof(zIO.bValue));
+        }
+        else
+        {
+            m_zRetainStore.AddEntry(zIO.strID, zIO.pValue, zIO.zSize);
+        }
+    }
+
+    // without the file, the values are not retained but the realtime processing continues
+    m_zRetainStore.Open();
+}
+
+/// @brief		create the layout of the recorded frames from the I/O plans, it is the same as the process image
+void CSampleRTThread::CompileFrameRecorder(void)
+{
+    m_zFrameRecorder.Clear();
+
+    for(size_t nCount = 0; nCount < m_zInputPlan.size(); nCount++)
+    {
+        const RAWIO& zIO = *m_zInputPlan[nCount];
+        m_zFrameRecorder.AddEntry(PROCESSIMAGE_INPUTS, zIO.strID, zIO.nOffset, zIO.zSize, zIO.bIsBool ? zIO.ucBitMask : 0);
+    }
+    for(size_t nCount = 0; nCount < m_zOutputPlan.size(); nCount++)
+    {
+        const RAWIO& zIO = *m_zOutputPlan[nCount];
+        m_zFrameRecorder.AddEntry(PROCESSIMAGE_OUTPUTS, zIO.strID, zIO.nOffset, zIO.zSize, zIO.bIsBool ? zIO.ucBitMask : 0);
+    }
+    for(size_t nCount = 0; nCount < m_zAxioDiagPlan.size(); nCount++)
+    {
+        const RAWIO& zIO = *m_zAxioDiagPlan[nCount];
+        m_zFrameRecorder.AddEntry(PROCESSIMAGE_DIAG, zIO.strID, zIO.nOffset, zIO.zSize, zIO.bIsBool ? zIO.ucBitMask : 0);
+    }
+
+    // without the file, the frames are not recorded but the realtime processing continues
+    m_zFrameRecorder.Open(RTCYCLETIME);
+}
+
+/// @brief		set the part of the input frame which is observed for the phase of the cycle
+void CSampleRTThread::CompilePhaseAligner(void)
+{
+#ifdef PHASE_ALIGN
+    size_t nBegin = SIZE_MAX;
+    size_t nEnd = 0;
+    for(size_t nCount = 0; nCount < m_zInputPlan.size(); nCount++)
+    {
+        const RAWIO& zIO = *m_zInputPlan[nCount];
+        nBegin = min(nBegin, zIO.nOffset);
+        nEnd = max(nEnd, zIO.nOffset + (zIO.bIsBool ? 1 : zIO.zSize));
+    }
+
+    // the realtime thread is not inside its cycle, the calibration starts with the next cycle
+    if(nBegin < nEnd)
+    {
+        m_zPhaseAligner.SetArea(nBegin, nEnd - nBegin);
+    }
+#endif
+}
+
+/// @brief		resolve the diagnosis registers and the positions of their flags for the event-driven decoding
+void CSampleRTThread::CompileAxioDiag(void)
+{
+    static const char* s_szFlagVars[AXIODIAG_FLAGS] =
+    {
+        "AXIO_DIAG_STATUS_REG_PW",
+        "AXIO_DIAG_STATUS_REG_PF",
+        "AXIO_DIAG_STATUS_REG_BUS",
+        "AXIO_DIAG_STATUS_REG_RUN",
+        "AXIO_DIAG_STATUS_REG_ACT",
+        "AXIO_DIAG_STATUS_REG_RDY",
+        "AXIO_DIAG_STATUS_REG_SYSFAIL"
+    };
+
+    // the realtime thread is not inside its cycle, the next sample reports all set flags
+    m_zAxioDiag.Clear();
+    if(m_pGdsAxioDiagBuffer == NULL)
+    {
+        return;
+    }
+
+    std::map<std::string, RAWIO>::iterator itStatus = m_zAxioDiagVarsMap.find(String::Format("{}/AXIO_DIAG_STATUS_REG", ARP_IO_AXIO));
+    std::map<std::string, RAWIO>::iterator itParam = m_zAxioDiagVarsMap.find(String::Format("{}/AXIO_DIAG_PARAM_REG", ARP_IO_AXIO));
+    m_zAxioDiag.SetRegisters((itStatus != m_zAxioDiagVarsMap.end()) ? itStatus->second.nOffset : SIZE_MAX,
+                             (itParam != m_zAxioDiagVarsMap.end()) ? itParam->second.nOffset : SIZE_MAX);
+
+    // the firmware provides each flag as BOOL variable, so the bit positions are taken from the GDS
+    for(int nFlag = 0; nFlag < AXIODIAG_FLAGS; nFlag++)
+    {
+        size_t nOffset = 0;
+        unsigned char ucBitOffset = 0;
+        if(ArpPlcGds_GetVariableBitOffset(m_pGdsAxioDiagBuffer, String::Format("{}/{}", ARP_IO_AXIO, s_szFlagVars[nFlag]), &nOffset, &ucBitOffset))
+        {
+            m_zAxioDiag.SetFlag((AXIODIAGFLAG)nFlag, nOffset, (uint8_t)(1 << ucBitOffset));
+        }
+        else
+        {
+            Log::Error("Error calling ArpPlcGds_GetVariableBitOffset for {0}, the flag is not decoded", s_szFlagVars[nFlag]);
+        }
+    }
+}
+
+/// @brief		create the layout of the shared process image from the I/O plans
+void CSampleRTThread::CompileProcessImage(void)
+{
+    m_zProcessImage.Clear();
+
+    for(size_t nCount = 0; nCount < m_zInputPlan.size(); nCount++)
+    {
+        const RAWIO& zIO = *m_zInputPlan[nCount];
+        m_zProcessImage.AddEntry(PROCESSIMAGE_INPUTS, zIO.strID, zIO.nOffset, zIO.zSize, zIO.bIsBool ? zIO.ucBitMask : 0);
+    }
+    for(size_t nCount = 0; nCount < m_zOutputPlan.size(); nCount++)
+    {
+        const RAWIO& zIO = *m_zOutputPlan[nCount];
+        m_zProcessImage.AddEntry(PROCESSIMAGE_OUTPUTS, zIO.strID, zIO.nOffset, zIO.zSize, zIO.bIsBool ? zIO.ucBitMask : 0);
+    }
+    for(size_t nCount = 0; nCount < m_zAxioDiagPlan.size(); nCount++)
+    {
+        const RAWIO& zIO = *m_zAxioDiagPlan[nCount];
+        m_zProcessImage.AddEntry(PROCESSIMAGE_DIAG, zIO.strID, zIO.nOffset, zIO.zSize, zIO.bIsBool ? zIO.ucBitMask : 0);
+    }
+
+    // without the segment, the process image is not published but the realtime processing continues
+    m_zProcessImage.Create();
+}
+
+/// @brief		cheap check, if the compiled I/O plans still fit to the GDS buffers. Only the offsets
+/// 			of the first and the last I/O of each plan are resolved again
+/// @return		true: plans can be used, false: plans must be compiled again
+bool CSampleRTThread::CheckIOPlans(void)
+{
+    if(m_zInputPlan.empty() || m_zOutputPlan.empty())
+    {
+        return(false);
+    }
+
+    return(CheckOffset(m_pGdsInBuffer, *m_zInputPlan.front()) &&
+           CheckOffset(m_pGdsInBuffer, *m_zInputPlan.back()) &&
+           CheckOffset(m_pGdsOutBuffer, *m_zOutputPlan.front()) &&
+           CheckOffset(m_pGdsOutBuffer, *m_zOutputPlan.back()));
+}
+
+/// @brief			check if an I/O still has the same offset in a GDS buffer
+/// @param pBuffer	GDS buffer
+/// @param zIO		reference to RAWIO
+/// @return			true: same offset, false: offset changed or I/O does not exist
+bool CSampleRTThread::CheckOffset(TGdsBuffer* pBuffer, const RAWIO& zIO)
+{
+    size_t nOffset = 0;
+
+    if(zIO.bIsBool)
+    {
+        unsigned char ucBitOffset = 0;
+        return(ArpPlcGds_GetVariableBitOffset(pBuffer, String(zIO.strID), &nOffset, &ucBitOffset) &&
+               (nOffset == zIO.nOffset) &&
+               ((unsigned char)(1 << ucBitOffset) == zIO.ucBitMask));
+    }
+
+    return(ArpPlcGds_GetVariableOffset(pBuffer, String(zIO.strID), &nOffset) &&
+           (nOffset == zIO.nOffset));
+}
+
 /// @brief		read inputs from AXIO frame
 /// @return		true: success, false: failure
 bool CSampleRTThread::ReadInputData(void)
@@ -614,22 +1173,39 @@ bool CSampleRTThread::ReadInputData(void)
     bool bRet = true;
 
     char* pFrame = NULL;
+    uint64 uLockNs = GetMonotonicTimeNs();
 
     // begin read operation, memory buffer will be locked
     if(ArpPlcGds_BeginRead(m_pGdsInBuffer, &pFrame))
     {
-        std::map<std::string, RAWIO>::iterator it = m_zInputsMap.begin();
-        while(it != m_zInputsMap.end())
+        bool bChanged = false;
+        for(size_t nCount = 0; nCount < m_zInputPlan.size(); nCount++)
         {
-            if(ReadValue(pFrame, it->second) == false)
+            RAWIO& zIO = *m_zInputPlan[nCount];
+            if(ReadValue(pFrame, zIO) == false)
             {
                 bRet = false;
             }
+            if(zIO.bChanged)
+            {
+                zIO.uChangedNs = uLockNs;
+                bChanged = true;
+            }
 
             // logging of IO values is done in Non-RT thread to not violate realtime
+        }
+        UpdateInputFreshness(true, bChanged, uLockNs);
 
-            it++;
+        // one copy of the input part of the frame for other processes and for the replay
+        m_zProcessImage.CopyArea(PROCESSIMAGE_INPUTS, pFrame);
+        m_zFrameRecorder.CopyArea(PROCESSIMAGE_INPUTS, pFrame);
+
+#ifdef PHASE_ALIGN
+        if(m_zPhaseAligner.IsMeasuring())
+        {
+            m_zPhaseAligner.Sample(pFrame, GetMonotonicTimeNs());
         }
+#endif
 
         // unlock buffer
         if(ArpPlcGds_EndRead(m_pGdsInBuffer))
@@ -643,14 +1219,69 @@ bool CSampleRTThread::ReadInputData(void)
     }
     else
     {
-        // returned false, data is not (yet) valid
+        // returned false, data is not (yet) valid, the inputs keep the values of the last fresh frame
         ArpPlcGds_EndRead(m_pGdsInBuffer);
+        UpdateInputFreshness(false, false, uLockNs);
         bRet = false;
     }
 
+    m_pMetrics->zGdsInLockHold.Record(GetMonotonicTimeNs() - uLockNs);
+
     return(bRet);
 }
 
+/// @brief			update the freshness of the inputs for the logic and the consumers
+/// @param bFresh	the inputs were read from a valid frame
+/// @param bChanged	at least one input was changed
+/// @param uReadNs	time of the read
+void CSampleRTThread::UpdateInputFreshness(bool bFresh, bool bChanged, uint64 uReadNs)
+{
+    m_zInputFreshness.bFresh = bFresh;
+    m_zInputFreshness.bChanged = bChanged;
+    if(bFresh)
+    {
+        m_zInputFreshness.uStaleCycles = 0;
+        m_zInputFreshness.uAgeUs = 0;
+        m_zInputFreshness.uFreshNs = uReadNs;
+    }
+    else
+    {
+        m_zInputFreshness.uStaleCycles++;
+        m_zInputFreshness.uAgeUs = (m_zInputFreshness.uFreshNs != 0) ? (uReadNs - m_zInputFreshness.uFreshNs) / 1000 : INPUTAGE_UNKNOWN;
+        IncrementMetric(m_pMetrics->uRTStaleCycles);
+    }
+    m_pMetrics->uRTInputAgeUs.store(m_zInputFreshness.uAgeUs, std::memory_order_relaxed);
+}
+
+/// @brief			poll the input frame in the idle time of the cycle to measure the update by the bus.
+/// 				The frame is only locked for the signature, the bus is not delayed
+/// @param uEndNs	end of the polling, absolute time of CLOCK_MONOTONIC in ns
+void CSampleRTThread::ProbeInputFrame(uint64 uEndNs)
+{
+    uint64 uNowNs = GetMonotonicTimeNs();
+    while(uNowNs < uEndNs)
+    {
+        char* pFrame = NULL;
+        bool bUpdate = false;
+        if(ArpPlcGds_BeginRead(m_pGdsInBuffer, &pFrame))
+        {
+            bUpdate = m_zPhaseAligner.Sample(pFrame, GetMonotonicTimeNs());
+        }
+        ArpPlcGds_EndRead(m_pGdsInBuffer);
+
+        // one update per cycle is enough
+        if(bUpdate)
+        {
+            break;
+        }
+
+        uint64 uNextNs = uNowNs + PHASEALIGN_PROBE_INTERVAL;
+        while((uNowNs = GetMonotonicTimeNs()) < uNextNs)
+        {
+        }
+    }
+}
+
 /// @brief      read diagnosis variables from AXIO frame
 /// @return     true: success, false: failure
 bool CSampleRTThread::ReadAxioDiagVars(void)
@@ -658,23 +1289,27 @@ bool CSampleRTThread::ReadAxioDiagVars(void)
     bool bRet = true;
 
     char* pFrame = NULL;
+    uint64 uLockNs = GetMonotonicTimeNs();
 
     // begin read operation, memory buffer will be locked
     if(ArpPlcGds_BeginRead(m_pGdsAxioDiagBuffer, &pFrame))
     {
-        std::map<std::string, RAWIO>::iterator it = m_zAxioDiagVarsMap.begin();
-        while(it != m_zAxioDiagVarsMap.end())
+        for(size_t nCount = 0; nCount < m_zAxioDiagPlan.size(); nCount++)
         {
-            if(ReadValue(pFrame, it->second) == false)
+            if(ReadValue(pFrame, *m_zAxioDiagPlan[nCount]) == false)
             {
                 bRet = false;
             }
 
             // logging of IO values is done in Non-RT thread to not violate realtime
-
-            it++;
         }
 
+        // only a change of the registers is decoded into events
+        m_zAxioDiag.Sample(pFrame, uLockNs);
+
+        m_zProcessImage.CopyArea(PROCESSIMAGE_DIAG, pFrame);
+        m_zFrameRecorder.CopyArea(PROCESSIMAGE_DIAG, pFrame);
+
         // unlock buffer
         if(ArpPlcGds_EndRead(m_pGdsAxioDiagBuffer))
         {
@@ -692,6 +1327,8 @@ bool CSampleRTThread::ReadAxioDiagVars(void)
         bRet = false;
     }
 
+    m_pMetrics->zGdsDiagLockHold.Record(GetMonotonicTimeNs() - uLockNs);
+
     return(bRet);
 }
 /// @brief		do some processing
@@ -700,24 +1337,63 @@ bool CSampleRTThread::DoLogic(void)
 {
     bool bRet = false;
 
-    // an AND logic
-    if(m_zInputsMap[m_strIn04].bValue == true && m_zInputsMap[m_strIn05].bValue == true)
+    // the inputs are only evaluated again, if the bus delivered a fresh frame in this cycle
+    if(m_zInputFreshness.bFresh)
     {
-        m_zOutputsMap[m_strOut05].bValue = true;
-    }
-    else
-    {
-        m_zOutputsMap[m_strOut05].bValue = false;
+        // an AND logic
+        if(m_pIn04->bValue == true && m_pIn05->bValue == true)
+        {
+            m_pOut05->bValue = true;
+        }
+        else
+        {
+            m_pOut05->bValue = false;
+        }
+
+        // a latch which is set by a rising edge of In04 and reset by a rising edge of In05. The latch
+        // and the last inputs are retained, so after a warm start it continues where it stopped
+        if(m_pIn04->bValue && (m_zLogicState.bLastIn04 == false))
+        {
+            m_zLogicState.bLatch = true;
+        }
+        if(m_pIn05->bValue && (m_zLogicState.bLastIn05 == false))
+        {
+            m_zLogicState.bLatch = false;
+        }
+        m_zLogicState.bLastIn04 = m_pIn04->bValue;
+        m_zLogicState.bLastIn05 = m_pIn05->bValue;
+        m_pOut06->bValue = m_zLogicState.bLatch;
     }
 
     // useful for realtime measurements with an oscilloscope
 
     // create a toggle
-    m_zOutputsMap[m_strOut04].bValue = !m_zOutputsMap[m_strOut04].bValue;
+    m_pOut04->bValue = !m_pOut04->bValue;
 
-    // read one input and forward it to an output
-    m_zOutputsMap[m_strOut06].bValue = m_zInputsMap[m_strIn04].bValue;
+    // take over the newest values of the IEC program. This never waits for the subscription
+    // thread, if there is no new data, the values of the last cycle are used again
+    m_pSetpointMailbox->Update();
+    const GDSSETPOINTS& zSetpoints = m_pSetpointMailbox->GetReadBuffer();
+
+    // combine an input of the fieldbus with a setpoint of the IEC program
+    m_pOut07->bValue = zSetpoints.bValid && zSetpoints.bVarC && m_pIn05->bValue;
+
+    // too old inputs or a faulted bus must not control the outputs anymore, they go to the safe state.
+    // Only before the first fresh frame of a start, a retained output keeps its restored value, so
+    // the process continues with the state of the last run instead of a glitch to the safe state
+    if((m_zInputFreshness.uAgeUs > INPUT_MAX_AGE) || m_zAxioDiag.IsFaulted())
+    {
+        bool bHoldRetained = (m_zInputFreshness.uAgeUs == INPUTAGE_UNKNOWN) && (m_zAxioDiag.IsFaulted() == false);
+        m_pOut05->bValue = bHoldRetained && m_pOut05->bRetain && m_pOut05->bValue;
+        m_pOut06->bValue = bHoldRetained && m_pOut06->bRetain && m_pOut06->bValue;
+        m_pOut07->bValue = bHoldRetained && m_pOut07->bRetain && m_pOut07->bValue;
+    }
 
+    // hand the result of the AND logic back to the IEC program, it is written by the subscription cycle
+    RTRESULTS& zResults = m_pResultMailbox->GetWriteBuffer();
+    zResults.bValid = true;
+    zResults.bVarA = m_pOut05->bValue;
+    m_pResultMailbox->Publish();
 
     return(bRet);
 }
@@ -729,19 +1405,20 @@ bool CSampleRTThread::WriteOutputData(void)
     bool bRet = true;
 
     char* pFrame;
+    uint64 uLockNs = GetMonotonicTimeNs();
     if(ArpPlcGds_BeginWrite(m_pGdsOutBuffer, &pFrame))
     {
-        std::map<std::string, RAWIO>::iterator it = m_zOutputsMap.begin();
-        while(it != m_zOutputsMap.end())
+        for(size_t nCount = 0; nCount < m_zOutputPlan.size(); nCount++)
         {
-            if(WriteValue(pFrame, it->second) == false)
+            if(WriteValue(pFrame, *m_zOutputPlan[nCount]) == false)
             {
                 bRet = false;
             }
-
-            it++;
         }
 
+        m_zProcessImage.CopyArea(PROCESSIMAGE_OUTPUTS, pFrame);
+        m_zFrameRecorder.CopyArea(PROCESSIMAGE_OUTPUTS, pFrame);
+
         // unlock buffer
         if(ArpPlcGds_EndWrite(m_pGdsOutBuffer))
         {
@@ -758,6 +1435,8 @@ bool CSampleRTThread::WriteOutputData(void)
         bRet = false;
     }
 
+    m_pMetrics->zGdsOutLockHold.Record(GetMonotonicTimeNs() - uLockNs);
+
     return(bRet);
 }
 
@@ -776,12 +1455,18 @@ bool CSampleRTThread::ReadValue(const char* pFrame, RAWIO& zIO)
     if(zIO.bIsBool)
     {
         // get value of bit
-        zIO.bValue = ((*pDataAddress) & zIO.ucBitMask) != 0;
+        bool bValue = ((*pDataAddress) & zIO.ucBitMask) != 0;
+        zIO.bChanged = (bValue != zIO.bValue);
+        zIO.bValue = bValue;
     }
     else
     {
-        // get number of bytes
-        memcpy(zIO.pValue, pDataAddress, zIO.zSize);
+        // get number of bytes, only if they changed
+        zIO.bChanged = (memcmp(zIO.pValue, pDataAddress, zIO.zSize) != 0);
+        if(zIO.bChanged)
+        {
+            memcpy(zIO.pValue, pDataAddress, zIO.zSize);
+        }
     }
 
     return(bRet);
@@ -834,6 +1519,16 @@ void timeAdd(struct timespec& zValue, long lAdd)
     }
 }
 
+/// @brief			add a positive or negative time in ns
+/// @param zValue	reference to time value
+/// @param nAddNs	time in ns
+void timeAddNs(struct timespec& zValue, int64_t nAddNs)
+{
+    int64_t nTimeNs = (int64_t)zValue.tv_sec * 1000000000 + zValue.tv_nsec + nAddNs;
+    zValue.tv_sec = (time_t)(nTimeNs / 1000000000);
+    zValue.tv_nsec = (long)(nTimeNs % 1000000000);
+}
+
 /// @brief			compare helper function for missing time calculations
 /// @param zFirst	reference to time value
 /// @param zSecond	reference to time value
@@ -16,19 +16,44 @@
 #include <pthread.h>
 #include <string>
 #include <map>
+#include <vector>
+#include <atomic>
 
 #include "Arp/System/Core/Arp.h"
 #include "Arp/System/Commons/Logging.h"
 #include "Arp/Plc/AnsiC/Gds/DataLayout.h"
 #include "Arp/Plc/AnsiC/Io/FbIoSystem.h"
 #include "Arp/Plc/AnsiC/Io/Axio.h"
+#include "Arp/Plc/AnsiC/Domain/PlcOperationHandler.h"
 #include "Utility.h"
+#include "ProcessData.h"
+#include "DeviceStatus.h"
+#include "RuntimeMetrics.h"
+#include "CIOLogger.h"
+#include "CProcessImagePublisher.h"
+#include "CRetainStore.h"
+#include "CFrameRecorder.h"
+#include "CQuiescence.h"
+#include "CRTWakeup.h"
+#include "CPhaseAligner.h"
+#include "CRTWatchdog.h"
+#include "CAxioDiagMonitor.h"
+#include "CEventLoop.h"
 
 using namespace Arp;
 using namespace std;
 
+#define RTCYCLETIME 1000			// Cycletime of RT-Thread in us. Use only multiple of 500
+#define INPUT_MAX_AGE (10 * RTCYCLETIME)	// older inputs are not used by the logic, outputs go to the safe state, in us
+
+// supervision of the realtime thread by CRTWatchdog, the stall is detected after at most STALL_TIME + INTERVAL
+#define RTWATCHDOG_INTERVAL		(2 * RTCYCLETIME)	// check interval of the watchdog in us
+#define RTWATCHDOG_STALL_TIME	(5 * RTCYCLETIME)	// a realtime thread without a cycle for this time is stalled, in us
+#define RTWATCHDOG_ABORT_TIME	0					// abort of the process after a stall of this time in us, 0: never
+
 // time calculation helpers
 void timeAdd(struct timespec& zValue, long lAdd);
+void timeAddNs(struct timespec& zValue, int64_t nAddNs);
 int timeCmp(struct timespec& zFirst, struct timespec& zSecond);
 
 ///	structure to handle a metadata and value of a single I/O
@@ -39,42 +64,108 @@ struct RAWIO
     size_t nOffset = 0;				// offset in bus-frame in byte
     unsigned char ucBitMask = 0;	// bitmask in case of a boolean value
     bool bIsBool = false;			// true, if it is a boolean
+    bool bRetain = false;			// output keeps its value over a warm start, see CompileRetainStore
 
     // current value
     unsigned char* pValue = NULL;	// pointer to data, if it is no boolean
     size_t zSize = 0;				// data size in bytes
     bool bValue = false;			// value if it is a boolean
+    bool bChanged = false;			// value was changed by the last ReadValue
+    uint64 uChangedNs = 0;			// CLOCK_MONOTONIC of the last change of an input, its age is the time since
+};
+
+///	state of the logic, it is kept over a warm start by the retain store
+struct LOGICSTATE
+{
+    bool bLatch = false;		// set by a rising edge of In04, reset by a rising edge of In05, drives Out06
+    bool bLastIn04 = false;		// inputs of the last fresh frame for the edge detection, so a warm
+    bool bLastIn05 = false;		// start does not see an edge which was already handled
+};
+
+///	structure to handle the time from start of processing to the first valid cycle
+struct STARTTIMES
+{
+    uint64 uCount = 0;		// number of starts
+    uint64 uLastUs = 0;		// time of last start in us
+    uint64 uMaxUs = 0;		// longest time in us
 };
 
 class CSampleRTThread
 {
+    // the host tools in tools/RTBenchmark, tools/JitterTest and tools/FrameReplay use the private functions
+    friend class CRTBenchmark;
+    friend class CJitterTest;
+    friend class CFrameReplay;
+
 public:
     CSampleRTThread();
     virtual ~CSampleRTThread();
 
-    bool Init();
+    bool Init(CSetpointMailbox* pSetpointMailbox, CResultMailbox* pResultMailbox, const DEVICESTATUS* pDeviceStatus,
+              RUNTIMEMETRICS* pMetrics, CEventLoop* pEventLoop);
     static void* RTStaticCycle(void* p);
     void RTCycle();
-    static void* StaticLoggingCycle(void* p);
     void LoggingCycle();
+    void FrameRecorderCycle();
 
-    bool StartProcessing();
+    bool StartProcessing(PlcOperation zOperation);
     bool StopProcessing();
+    bool ReleaseResources();
+
+    RTHEARTBEAT* GetHeartbeat();
 
 private:
     // workerthread for cycle
     pthread_t m_zRTCycleThread;
-    pthread_t m_zLoggingThread;	// log status of I/Os in extra thread
 
     bool m_bInitialized;	// class already initialized?
-    bool m_bDoCycle;		// shall the subscription cycle run?
+
+    // timers of the non-realtime work in the event loop
+    uint32 m_uTimersAdded;	// number of timers added, a repeated Init does not add them twice
+    bool AddTimers(CEventLoop* pEventLoop);
+
+    uint32 m_uLoggingCycle;	// counter of the logging cycle in the event loop, for throttling
+    uint32 m_uFrameRecorderCycle;	// counter of the flushes of the frame recorder, for throttling
+    std::atomic<bool> m_bDoCycle;	// shall the cycle run?
     bool m_bFirstRTCycle;	// is it the first cycle?
 
+    // sleep or sleep-then-spin until the start of a cycle
+    CRTWakeup m_zWakeup;
+
+    // beat and phase of every cycle for the watchdog
+    RTHEARTBEAT m_zHeartbeat;
+
+    // freshness of the inputs of the current cycle, evaluated by the logic
+    INPUTFRESHNESS m_zInputFreshness;
+    void UpdateInputFreshness(bool bFresh, bool bChanged, uint64 uReadNs);
+
+    // phase of the cycle relative to the update of the input frame by the bus
+    CPhaseAligner m_zPhaseAligner;
+    void ProbeInputFrame(uint64 uEndNs);
+
+    // changes of the AXIO diagnosis registers as events for the event loop
+    CAxioDiagMonitor m_zAxioDiag;
+    void DispatchAxioDiag();
+
+    // handshake to free the buffers only after the threads left their cycle
+    CQuiescence m_zRTQuiescence;
+    CQuiescence m_zLoggingQuiescence;
+
     // GDS buffers for raw I/O access
     TGdsBuffer* m_pGdsInBuffer;
     TGdsBuffer* m_pGdsOutBuffer;
     TGdsBuffer* m_pGdsAxioDiagBuffer;
 
+    // exchange of data with the subscription cycle in the event loop, never call RSC services in the realtime thread
+    CSetpointMailbox* m_pSetpointMailbox;
+    CResultMailbox* m_pResultMailbox;
+
+    // status of the device, the logging is throttled on high CPU load or temperature
+    const DEVICESTATUS* m_pDeviceStatus;
+
+    // cycle and lock times for the metrics endpoint
+    RUNTIMEMETRICS* m_pMetrics;
+
     // some sample I/O IDs
     String m_strInByte;
     String m_strIn04;
@@ -91,12 +182,55 @@ private:
     std::map<std::string, RAWIO> m_zOutputsMap;
     std::map<std::string, RAWIO> m_zAxioDiagVarsMap;
 
-    void LogIO(RAWIO& zRawIO);
+    // compiled I/O plans: the realtime cycle only iterates over these vectors and uses the
+    // cached pointers, there is no map lookup in the cycle. Buffers and plans are kept
+    // over a stop of the PLC, so a hot start does not need to resolve the offsets again
+    std::vector<RAWIO*> m_zInputPlan;
+    std::vector<RAWIO*> m_zOutputPlan;
+    std::vector<RAWIO*> m_zAxioDiagPlan;
+    RAWIO* m_pIn04;
+    RAWIO* m_pIn05;
+    RAWIO* m_pOut04;
+    RAWIO* m_pOut05;
+    RAWIO* m_pOut06;
+    RAWIO* m_pOut07;
+    bool CompileIOPlans();
+    void CompileProcessImage();
+    void CompileRetainStore();
+    void CompileFrameRecorder();
+    void CompilePhaseAligner();
+    void CompileAxioDiag();
+    bool CheckIOPlans();
+    bool CheckOffset(TGdsBuffer* pBuffer, const RAWIO& zIO);
+
+    // time from start of processing to the first cycle with valid inputs and outputs
+    PlcOperation m_zStartKind;
+    uint64 m_uStartTimeNs;
+    std::atomic<uint64> m_uFirstValidCycleNs;	// 0 until the first valid cycle
+    std::atomic<bool> m_bStartReported;
+    STARTTIMES m_zStartTimes[3];				// cold, warm and hot start
+    void ReportStartTime();
+
+    // process image in shared memory for other processes on the controller
+    CProcessImagePublisher m_zProcessImage;
+
+    // outputs in a memory-mapped file, restored on a warm start
+    CRetainStore m_zRetainStore;
+
+    // frames of every cycle in a ring file for a replay on a host
+    CFrameRecorder m_zFrameRecorder;
+
+    // change-driven and rate-limited logging of the I/Os in the logging cycle
+    CIOLogger m_zIOLogger;
+    void LogIO(size_t nIndex, RAWIO& zRawIO);
     bool AddInput(std::string strID, size_t zSize, bool bIsBool);
-    bool AddOutput(std::string strID, size_t zSize, bool bIsBool);
+    bool AddOutput(std::string strID, size_t zSize, bool bIsBool, bool bRetain = false);
     bool AddAxioDiagVar(std::string strID, size_t zSize, bool bIsBool);
 
     // example usage of direct access to fieldbus-frame
+    // state of the logic, only used by the realtime thread and retained by m_zRetainStore
+    LOGICSTATE m_zLogicState;
+
     bool ReadInputData(void);
     bool ReadAxioDiagVars(void);
     bool DoLogic(void);
@@ -11,6 +11,7 @@
  ******************************************************************************/
 
 #include "CSampleRuntime.h"
+#include "CStartupTimeline.h"
 
 #include "Arp/System/Rsc/ServiceManager.hpp"
 #include "Arp/Plc/AnsiC/ArpPlc.h"
@@ -23,11 +24,16 @@ PlcOperation CSampleRuntime::m_zPLCMode = PlcOperation_None;
 
 CSampleRuntime::CSampleRuntime()
               : m_bInitialized(false),
+                m_zInitThread(),
+                m_bInitRunning(false),
+                m_zPendingOperation(PlcOperation_None),
                 m_szVendorName(NULL),
                 m_byCpuLoad((byte)0),
                 m_byMemoryUsage((byte)0),
                 m_i8BoardTemp(0)
 {
+    pthread_mutex_init(&m_zStateMutex, NULL);
+
     // announce the status-update callback
     // this is important to get the status of the "firmware-ready"-event PlcOperation_StartWarm
     ArpPlcDomain_SetHandler(PlcOperationHandler);
@@ -35,33 +41,156 @@ CSampleRuntime::CSampleRuntime()
 
 CSampleRuntime::~CSampleRuntime()
 {
+    pthread_mutex_destroy(&m_zStateMutex);
 }
 
-/// @brief: init/connect to the PLCnext services and start the cycle-threads
-/// @return	true: success, false: failure
-bool CSampleRuntime::Init()
+/// @brief				start processing, called from the PLC state callback. The start is done by the
+/// 					init pipeline thread and this function returns immediately. If the runtime is not
+/// 					initialized yet, the pipeline initializes it first
+/// @param zOperation	kind of start (cold, warm or hot)
+/// @return				true: init pipeline started or running, false: failure
+bool CSampleRuntime::RequestStart(PlcOperation zOperation)
+{
+    bool bRet = false;
+
+    pthread_mutex_lock(&m_zStateMutex);
+
+    // a running pipeline takes over the newest start
+    m_zPendingOperation = zOperation;
+    if(m_bInitRunning)
+    {
+        bRet = true;
+    }
+    else
+    {
+        pthread_attr_t zAttr;
+        pthread_attr_init(&zAttr);
+        pthread_attr_setdetachstate(&zAttr, PTHREAD_CREATE_DETACHED);
+
+        if(pthread_create(&m_zInitThread, &zAttr, CSampleRuntime::StaticInitPipeline, this) == 0)
+        {
+            m_bInitRunning = true;
+            bRet = true;
+        }
+        else
+        {
+            Log::Error("Error calling pthread_create (init pipeline)");
+            m_zPendingOperation = PlcOperation_None;
+        }
+
+        pthread_attr_destroy(&zAttr);
+    }
+    pthread_mutex_unlock(&m_zStateMutex);
+
+    return(bRet);
+}
+
+/// @brief								stop processing, called from the PLC state callback. A start
+/// 									which is still pending in the init pipeline is canceled
+/// @param bReleaseProgramResources		release everything which depends on the program, e.g. on unload
+/// @return								true: success, false: failure
+bool CSampleRuntime::RequestStop(bool bReleaseProgramResources)
 {
+    bool bRet = true;
+
+    pthread_mutex_lock(&m_zStateMutex);
+    m_zPendingOperation = PlcOperation_None;
     if(m_bInitialized)
     {
-        return(true);
+        bRet = StopProcessing();
+        if(bReleaseProgramResources)
+        {
+            bRet = ReleaseProgramResources() && bRet;
+        }
+    }
+    pthread_mutex_unlock(&m_zStateMutex);
+
+    return(bRet);
+}
+
+/// @brief		static function for thread-entry of the init pipeline
+/// @param p	pointer to thread object
+void* CSampleRuntime::StaticInitPipeline(void* p)
+{
+    if(p != NULL)
+    {
+        ((CSampleRuntime*)p)->InitPipeline();
+    }
+    else
+    {
+        Log::Error("Null pointer in StaticInitPipeline");
     }
+    return(NULL);
+}
+
+/// @brief	initialize the runtime, if not done yet, and start the processing, if the PLC was not
+/// 		stopped in the meantime
+void CSampleRuntime::InitPipeline()
+{
+    uint64 uStartNs = GetMonotonicTimeNs();
+
+    pthread_mutex_lock(&m_zStateMutex);
+    bool bInitialized = m_bInitialized;
+    pthread_mutex_unlock(&m_zStateMutex);
+
+    if(bInitialized == false)
+    {
+        g_zStartupTimeline.Mark(STARTUP_INITBEGIN);
+
+        // the initialization is done without the lock, so stop requests are not blocked
+        bInitialized = Init();
+        if(bInitialized)
+        {
+            g_zStartupTimeline.Mark(STARTUP_INITDONE);
+        }
+        else
+        {
+            Log::Error("Error during initialization");
+        }
+    }
+
+    pthread_mutex_lock(&m_zStateMutex);
+    m_bInitialized = bInitialized;
+    if(bInitialized && (m_zPendingOperation != PlcOperation_None))
+    {
+        uint64 uStepStartNs = GetMonotonicTimeNs();
+        if(StartProcessing(m_zPendingOperation) == false)
+        {
+            Log::Error("Error starting processing");
+        }
+        LogInitStep("start processing", uStepStartNs);
+    }
+    else if(bInitialized)
+    {
+        Log::Info("Init pipeline: PLC was stopped before the start, processing is not started");
+    }
+    m_zPendingOperation = PlcOperation_None;
+    m_bInitRunning = false;
+    pthread_mutex_unlock(&m_zStateMutex);
+
+    Log::Info("Init pipeline: finished after {0} us", (GetMonotonicTimeNs() - uStartNs) / 1000);
+}
 
+/// @brief: init/connect to the PLCnext services and start the cycle-threads
+/// 		Runs in the init pipeline thread
+/// @return	true: success, false: failure
+bool CSampleRuntime::Init()
+{
     Log::Info("Call of CSampleRuntime::Init");
 
     bool bRet = false;
+    uint64 uStepStartNs = GetMonotonicTimeNs();
 
     // the firmware needs to be in the state PlcOperation_StartWarm before we can acquire services
-    m_pDeviceInfoService = ServiceManager::GetService<IDeviceInfoService>();
-    m_pDeviceStatusService = ServiceManager::GetService<IDeviceStatusService>();
-    m_pLicenseStatusService = ServiceManager::GetService<ILicenseStatusService>();
-
-    if((m_pDeviceStatusService != NULL) &&
-       (m_pDeviceInfoService != NULL) &&
-       (m_pLicenseStatusService != NULL)
-       )
+    if(AcquireServices() == true)
     {
+        g_zStartupTimeline.Mark(STARTUP_SERVICES);
+        LogInitStep("acquire services", uStepStartNs);
+
         if(GetDeviceStatus() == true)
         {
+            LogInitStep("device status", uStepStartNs);
+
             // check current license
             unsigned int uFirmCode = 0;		// you get FirmCode+ProductCode after creating a new app in the PLCnext store
             unsigned int uProductCode = 0;	// hardcode these numbers in your application
@@ -75,36 +204,192 @@ bool CSampleRuntime::Init()
             {
                 // no valid license on the device -> switch to demo mode, do not just quit the app!
             }
+            LogInitStep("license status", uStepStartNs);
 
-            if(m_zRTThread.Init() == true)
+            // the status is sampled periodically, the threads throttle their non-realtime work on high load
+            if(m_zDeviceStatusSampler.Init(m_pDeviceStatusService, &g_zEventLoop, DEVICESTATUS_SAMPLE_INTERVAL) == true)
             {
-                if(m_zSubscriptionThread.Init() == true)
+                LogInitStep("device status sampler", uStepStartNs);
+
+                if(m_zRTThread.Init(&m_zSetpointMailbox, &m_zResultMailbox, m_zDeviceStatusSampler.GetStatus(), &m_zMetrics, &g_zEventLoop) == true)
                 {
-                    m_bInitialized = true;
-                    bRet = true;
+                    LogInitStep("RT thread", uStepStartNs);
+
+                    if(m_zGdsWriter.Init(m_pDataAccessService, &g_zEventLoop, GDSWRITER_FLUSH_INTERVAL) == true)
+                    {
+                        LogInitStep("GDS writer", uStepStartNs);
+
+                        if(m_zSubscriptionThread.Init(m_pSubscriptionService, m_pDataAccessService,
+                                                      &m_zSetpointMailbox, &m_zResultMailbox, &m_zGdsWriter,
+                                                      m_zDeviceStatusSampler.GetStatus(), &m_zMetrics, &g_zEventLoop) == true)
+                        {
+                            LogInitStep("subscription cycle", uStepStartNs);
+
+                            // the endpoint is only for diagnosis, the runtime also works without it
+                            if(m_zMetricsServer.Init(&m_zMetrics, &m_zGdsWriter, m_zDeviceStatusSampler.GetStatus(), &g_zEventLoop) == false)
+                            {
+                                Log::Error("Metrics endpoint not available");
+                            }
+                            LogInitStep("metrics server", uStepStartNs);
+
+                            // the watchdog is only for diagnosis, the runtime also works without it. It is
+                            // started as last step, a failed Init is repeated and must not add the thread twice
+                            if((m_zWatchdog.AddThread("RT thread", m_zRTThread.GetHeartbeat(), RTWATCHDOG_STALL_TIME, RTWATCHDOG_ABORT_TIME) == false) ||
+                               (m_zWatchdog.Start(&m_zMetrics, RTWATCHDOG_INTERVAL) == false))
+                            {
+                                Log::Error("Watchdog of the realtime thread not available");
+                            }
+                            LogInitStep("watchdog", uStepStartNs);
+                            bRet = true;
+                        }
+                    }
                 }
             }
+            else
+            {
+                Log::Error("Error initializing the device status sampler");
+            }
         }
     }
 
     return(bRet);
 }
 
-/// @brief	start processing of I/O data in the different threads
-/// 		e.g. after a new PLCnext Engineer Program was loaded
-/// @return	true: success, false: failure
-bool CSampleRuntime::StartProcessing()
+/// @brief	acquire all RSC services in parallel, each GetService call runs in its own thread
+/// @return	true: all services available, false: at least one service is missing
+bool CSampleRuntime::AcquireServices()
+{
+    static const char* s_szServiceNames[INITSERVICE_COUNT] =
+    {
+        "IDeviceInfoService",
+        "IDeviceStatusService",
+        "ILicenseStatusService",
+        "ISubscriptionService",
+        "IDataAccessService"
+    };
+
+    bool bRet = true;
+
+    SERVICEREQUEST zRequests[INITSERVICE_COUNT];
+    pthread_t zThreads[INITSERVICE_COUNT];
+    bool bStarted[INITSERVICE_COUNT];
+
+    for(int nCount = 0; nCount < INITSERVICE_COUNT; nCount++)
+    {
+        zRequests[nCount].pRT = this;
+        zRequests[nCount].zService = (INITSERVICE)nCount;
+        bStarted[nCount] = (pthread_create(&zThreads[nCount], NULL, CSampleRuntime::StaticAcquireService, &zRequests[nCount]) == 0);
+        if(bStarted[nCount] == false)
+        {
+            // no thread available, acquire the service in this thread
+            AcquireService(zRequests[nCount]);
+        }
+    }
+
+    for(int nCount = 0; nCount < INITSERVICE_COUNT; nCount++)
+    {
+        if(bStarted[nCount])
+        {
+            pthread_join(zThreads[nCount], NULL);
+        }
+
+        if(zRequests[nCount].bAcquired)
+        {
+            Log::Info("Init pipeline: {0} acquired in {1} us", s_szServiceNames[nCount], zRequests[nCount].uDurationUs);
+        }
+        else
+        {
+            Log::Error("Init pipeline: {0} not available ({1} us)", s_szServiceNames[nCount], zRequests[nCount].uDurationUs);
+            bRet = false;
+        }
+    }
+
+    return(bRet);
+}
+
+/// @brief		static function for thread-entry of a service acquisition
+/// @param p	pointer to SERVICEREQUEST
+void* CSampleRuntime::StaticAcquireService(void* p)
+{
+    if(p != NULL)
+    {
+        SERVICEREQUEST* pRequest = (SERVICEREQUEST*)p;
+        pRequest->pRT->AcquireService(*pRequest);
+    }
+    else
+    {
+        Log::Error("Null pointer in StaticAcquireService");
+    }
+    return(NULL);
+}
+
+/// @brief			acquire one RSC service, every request writes its own member only
+/// @param zRequest	service to acquire, result and duration are stored in it
+void CSampleRuntime::AcquireService(SERVICEREQUEST& zRequest)
+{
+    uint64 uStartNs = GetMonotonicTimeNs();
+
+    switch(zRequest.zService)
+    {
+        case INITSERVICE_DEVICEINFO:
+            m_pDeviceInfoService = ServiceManager::GetService<IDeviceInfoService>();
+            zRequest.bAcquired = (m_pDeviceInfoService != NULL);
+            break;
+        case INITSERVICE_DEVICESTATUS:
+            m_pDeviceStatusService = ServiceManager::GetService<IDeviceStatusService>();
+            zRequest.bAcquired = (m_pDeviceStatusService != NULL);
+            break;
+        case INITSERVICE_LICENSESTATUS:
+            m_pLicenseStatusService = ServiceManager::GetService<ILicenseStatusService>();
+            zRequest.bAcquired = (m_pLicenseStatusService != NULL);
+            break;
+        case INITSERVICE_SUBSCRIPTION:
+            m_pSubscriptionService = ServiceManager::GetService<ISubscriptionService>();
+            zRequest.bAcquired = (m_pSubscriptionService != NULL);
+            break;
+        case INITSERVICE_DATAACCESS:
+            m_pDataAccessService = ServiceManager::GetService<IDataAccessService>();
+            zRequest.bAcquired = (m_pDataAccessService != NULL);
+            break;
+        default:
+            break;
+    }
+
+    zRequest.uDurationUs = (GetMonotonicTimeNs() - uStartNs) / 1000;
+}
+
+/// @brief				log the duration of one step of the init pipeline
+/// @param szStep		name of step
+/// @param uStepStartNs	start time of step, set to the start time of the next step
+void CSampleRuntime::LogInitStep(const char* szStep, uint64& uStepStartNs)
+{
+    uint64 uNow = GetMonotonicTimeNs();
+    Log::Info("Init pipeline: {0} done in {1} us", szStep, (uNow - uStepStartNs) / 1000);
+    uStepStartNs = uNow;
+}
+
+/// @brief				start processing of I/O data in the different threads
+/// 					e.g. after a new PLCnext Engineer Program was loaded
+/// @param zOperation	kind of start (cold, warm or hot)
+/// @return				true: success, false: failure
+bool CSampleRuntime::StartProcessing(PlcOperation zOperation)
 {
     Log::Info("Start processing");
+    g_zStartupTimeline.Mark(STARTUP_STARTBEGIN);
 
     bool bRet = false;
-    if(m_zRTThread.StartProcessing() == true)
+    if(m_zRTThread.StartProcessing(zOperation) == true)
     {
-        if(m_zSubscriptionThread.StartProcessing() == true)
+        if(m_zGdsWriter.StartProcessing() == true)
         {
-            bRet = true;
+            // on a hot start the program layout did not change, so the subscriptions can be used without check
+            if(m_zSubscriptionThread.StartProcessing(zOperation == PlcOperation_StartHot) == true)
+            {
+                bRet = true;
+            }
         }
     }
+    g_zStartupTimeline.Mark(STARTUP_STARTDONE);
 
     return(bRet);
 }
@@ -120,6 +405,34 @@ bool CSampleRuntime::StopProcessing()
     if(m_zRTThread.StopProcessing() == true)
     {
         if(m_zSubscriptionThread.StopProcessing() == true)
+        {
+            if(m_zGdsWriter.StopProcessing() == true)
+            {
+                bRet = true;
+            }
+        }
+    }
+
+    return(bRet);
+}
+
+/// @brief	release everything which depends on the layout of the PLCnext Engineer Program,
+/// 		e.g. if the program is unloaded. Must be called after StopProcessing()
+/// @return	true: success, false: failure
+bool CSampleRuntime::ReleaseProgramResources()
+{
+    Log::Info("Release program resources");
+
+    bool bRet = false;
+    if(m_bInitialized == false)
+    {
+        // nothing acquired yet
+        return(true);
+    }
+
+    if(m_zRTThread.ReleaseResources() == true)
+    {
+        if(m_zSubscriptionThread.ReleaseSubscriptions() == true)
         {
             bRet = true;
         }
@@ -168,42 +481,43 @@ void PlcOperationHandler(enum PlcOperation operation)
             break;
         case PlcOperation_StartCold:
             Log::Info("Call of PLC Start Cold");
+            g_zStartupTimeline.Mark(STARTUP_STARTCALLBACK);
             // when this state-change occurred, the PLCnext runtime is ready to serve requests.
-            // Now we can request the needed service-interfaces.
+            // The service-interfaces are requested by the init pipeline, so this callback is not blocked.
             // Plc may by stopped by system watchdog so that is possible to start plc cold on system start
-            if(g_pRT->Init() == false)
+            if(g_pRT->RequestStart(operation) == false)
             {
                 Log::Error("Error during initialization");
             }
-            g_pRT->StartProcessing();
-
             break;
         case PlcOperation_StartWarm:
             Log::Info("Call of PLC Start Warm");
+            g_zStartupTimeline.Mark(STARTUP_STARTCALLBACK);
 
             // when this state-change occurred, the PLCnext runtime is ready to serve requests.
-            // Now we can request the needed service-interfaces.
-            if(g_pRT->Init() == false)
+            // The service-interfaces are requested by the init pipeline, so this callback is not blocked.
+            if(g_pRT->RequestStart(operation) == false)
             {
                 Log::Error("Error during initialization");
             }
-            g_pRT->StartProcessing();
             break;
         case PlcOperation_StartHot:
             Log::Info("Call of PLC Start Hot");
-            g_pRT->StartProcessing();
+            g_pRT->RequestStart(operation);
             break;
         case PlcOperation_Stop:
             Log::Info("Call of PLC Stop");
-            g_pRT->StopProcessing();
+            // keep everything which depends on the program, it is used again on the next start
+            g_pRT->RequestStop(false);
             break;
         case PlcOperation_Reset:
             Log::Info("Call of PLC Reset");
-            g_pRT->StopProcessing();
+            g_pRT->RequestStop(true);
             break;
         case PlcOperation_Unload:
             Log::Info("Call of PLC Unload");
-            g_pRT->StopProcessing();
+            // the next program might have another layout
+            g_pRT->RequestStop(true);
             break;
         case PlcOperation_None:
             Log::Info("Call of PLC None");
@@ -213,4 +527,3 @@ void PlcOperationHandler(enum PlcOperation operation)
             break;
     }
 }
-
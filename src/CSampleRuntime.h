@@ -16,6 +16,10 @@
 #include "Utility.h"
 #include "CSampleRTThread.h"
 #include "CSampleSubscriptionThread.h"
+#include "CDeviceStatusSampler.h"
+#include "CMetricsServer.h"
+#include "CRTWatchdog.h"
+#include "RuntimeMetrics.h"
 
 #include <pthread.h>
 #include "Arp/Device/Interface/Services/IDeviceStatusService.hpp"
@@ -34,6 +38,26 @@ void PlcOperationHandler(enum PlcOperation operation);
 class CSampleRuntime;
 extern CSampleRuntime* g_pRT;	// global pointer to sample runtime to make it call-able from callback-function
 
+// services which are acquired in parallel by the init pipeline
+enum INITSERVICE
+{
+    INITSERVICE_DEVICEINFO = 0,
+    INITSERVICE_DEVICESTATUS,
+    INITSERVICE_LICENSESTATUS,
+    INITSERVICE_SUBSCRIPTION,
+    INITSERVICE_DATAACCESS,
+    INITSERVICE_COUNT
+};
+
+///	structure to handle the acquisition of one service in its own thread
+struct SERVICEREQUEST
+{
+    CSampleRuntime* pRT = NULL;
+    INITSERVICE zService = INITSERVICE_DEVICEINFO;
+    bool bAcquired = false;		// service available?
+    uint64 uDurationUs = 0;		// time for GetService
+};
+
 class CSampleRuntime
 {
 public:
@@ -42,20 +66,51 @@ public:
 
     static PlcOperation m_zPLCMode;	// current mode of operation
 
-    bool Init();
-    bool StartProcessing();
-    bool StopProcessing();
+    // called from the PLC state callback, they return without waiting for the initialization
+    bool RequestStart(PlcOperation zOperation);
+    bool RequestStop(bool bReleaseProgramResources);
 
 private:
     bool m_bInitialized;	// already initializes?
 
+    // the initialization runs in its own thread, so the PLC state callback is not blocked
+    pthread_t m_zInitThread;
+    pthread_mutex_t m_zStateMutex;		// protects the state below and serializes start and stop
+    bool m_bInitRunning;				// init pipeline thread is running
+    PlcOperation m_zPendingOperation;	// start to be done by the init pipeline, PlcOperation_None after a stop
+    static void* StaticInitPipeline(void* p);
+    void InitPipeline();
+
+    bool Init();
+    bool AcquireServices();
+    static void* StaticAcquireService(void* p);
+    void AcquireService(SERVICEREQUEST& zRequest);
+    void LogInitStep(const char* szStep, uint64& uStepStartNs);
+
+    bool StartProcessing(PlcOperation zOperation);
+    bool StopProcessing();
+    bool ReleaseProgramResources();
+
     CSampleRTThread m_zRTThread;
+    CRTWatchdog m_zWatchdog;	// supervisor of the realtime thread
     CSampleSubscriptionThread m_zSubscriptionThread;
+    CGdsWriter m_zGdsWriter;
+    CDeviceStatusSampler m_zDeviceStatusSampler;
+
+    // counters and histograms of the threads, served by the metrics endpoint
+    RUNTIMEMETRICS m_zMetrics;
+    CMetricsServer m_zMetricsServer;
+
+    // wait-free exchange of data between the subscription cycle in the event loop and the realtime thread
+    CSetpointMailbox m_zSetpointMailbox;
+    CResultMailbox m_zResultMailbox;
 
     // RSC services
     IDeviceInfoService::Ptr m_pDeviceInfoService;
     IDeviceStatusService::Ptr m_pDeviceStatusService;
     ILicenseStatusService::Ptr m_pLicenseStatusService;
+    ISubscriptionService::Ptr m_pSubscriptionService;
+    IDataAccessService::Ptr m_pDataAccessService;
 
     bool GetDeviceStatus();
 
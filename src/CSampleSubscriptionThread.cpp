@@ -11,35 +11,94 @@
  ******************************************************************************/
 
 #include "CSampleSubscriptionThread.h"
+#include "CSubscriptionBenchmark.h"
 
-#include "Arp/System/Rsc/ServiceManager.hpp"
 
 using namespace Arp::System::Rsc;
 
+// uncomment to measure creation time, read latency and CPU usage of the different
+// subscription kinds and of direct reads for each subscription group once after start
+//#define SUBSCRIPTION_BENCHMARK
+#define SUBSCRIPTION_BENCHMARK_READS 1000	// number of reads per subscription kind
+
+#define SUBSCRIPTIONSTOP_TIMEOUT 2000000	// max. time to wait for the end of the subscription cycle in us
+
+#define SUBSCRIPTION_INTERVAL 100			// interval of the subscription cycle in the event loop in ms
+#define SUBSCRIPTION_THROTTLE_REDUCED	2	// multiple of the cycle time on THROTTLE_REDUCED
+#define SUBSCRIPTION_THROTTLE_MINIMAL	5	// multiple of the cycle time on THROTTLE_MINIMAL
+
 // a PLCnext Engineer Project should exist on the device with this simple structure:
 // A program-instance named "MyProgramInst" which has three Ports of datatype bool: VarA (IN Port), VarB (IN Port) and VarC (Out Port)
 static const char GDSPort1[] = "Arp.Plc.Eclr/MyProgramInst.VarA";
 static const char GDSPort2[] = "Arp.Plc.Eclr/MyProgramInst.VarB";
 static const char GDSPort3[] = "Arp.Plc.Eclr/MyProgramInst.VarC";
 
+// for the coherence check of SUBSCRIPTION_BENCHMARK, the program can have two integer variables which it
+// writes in the same cycle: BenchCounter := BenchCounter + 1; BenchMirror := BenchCounter;
+// Without them, the check is skipped
+static const char GDSBenchmarkCounter[] = "Arp.Plc.Eclr/MyProgramInst.BenchCounter";
+static const char GDSBenchmarkMirror[] = "Arp.Plc.Eclr/MyProgramInst.BenchMirror";
+
+///	structure to configure one group of subscribed GDS variables
+struct SUBSCRIPTIONGROUPCONFIG
+{
+    const char* szName;			// name of group, only used for logging
+    SubscriptionKind zKind;		// realtime class of the subscription
+    uint64 uSampleRate;			// sample rate in us
+    vector<string> zVariables;	// names of the GDS variables
+    vector<RscType> zTypes;		// types of the GDS variables in the same order, a warm start checks them
+};
+
+// each group gets its own subscription, so the SubscriptionKind can be selected for each group.
+// Check the description of SubscriptionKind for the different realtime classes, and use
+// SUBSCRIPTION_BENCHMARK to measure their costs for your variables on the controller
+static const SUBSCRIPTIONGROUPCONFIG s_zSubscriptionGroupConfig[] =
+{
+    // name		kind								sample rate	variables							types
+    { "Ports",	SubscriptionKind::HighPerformance,	1000000,	{ GDSPort1, GDSPort2, GDSPort3 },	{ RscType::Bool, RscType::Bool, RscType::Bool } },
+};
+
 CSampleSubscriptionThread::CSampleSubscriptionThread() :
-                m_zCycleThread(),
                 m_bInitialized(false),
                 m_bDoCycle(false),
-                m_uSubscriptionId(0),
+                m_uCycle(0),
+                m_pSetpointMailbox(NULL),
+                m_pResultMailbox(NULL),
+                m_pGdsWriter(NULL),
+                m_pDeviceStatus(NULL),
+                m_pMetrics(NULL),
+                m_bBenchmarkPending(false),
+                m_zBenchmarkThread(),
+                m_bBenchmarkStarted(false),
                 m_gdsPort1(0),
                 m_gdsPort2(0),
-                m_gdsPort3(0)
+                m_gdsPort3(0),
+                m_bResultsWritten(false),
+                m_bWrittenVarA(false)
 {
 }
 
 CSampleSubscriptionThread::~CSampleSubscriptionThread()
 {
+    if(m_bBenchmarkStarted)
+    {
+        pthread_join(m_zBenchmarkThread, NULL);
+    }
 }
 
-/// @brief	Init and start the subscription thread
-/// @return	true: success, false: failure
-bool CSampleSubscriptionThread::Init()
+/// @brief						Init and start the subscription cycle in the event loop
+/// @param pSubscriptionService	subscription service, acquired by the init pipeline
+/// @param pDataAccessService		data access service, acquired by the init pipeline
+/// @param pSetpointMailbox		mailbox for values of the GDS for the realtime logic
+/// @param pResultMailbox		mailbox with results of the realtime logic to be written to the GDS
+/// @param pGdsWriter			writer for the results
+/// @param pDeviceStatus		status of the device for throttling of the subscription reads
+/// @param pMetrics				metrics of the subscription reads
+/// @param pEventLoop			event loop for the subscription timer
+/// @return						true: success, false: failure
+bool CSampleSubscriptionThread::Init(ISubscriptionService::Ptr pSubscriptionService, IDataAccessService::Ptr pDataAccessService,
+                                     CSetpointMailbox* pSetpointMailbox, CResultMailbox* pResultMailbox, CGdsWriter* pGdsWriter,
+                                     const DEVICESTATUS* pDeviceStatus, RUNTIMEMETRICS* pMetrics, CEventLoop* pEventLoop)
 {
     if(m_bInitialized)
     {
@@ -51,62 +110,138 @@ bool CSampleSubscriptionThread::Init()
 
     bool bRet = false;
 
-    // the firmware needs to be in the state PlcOperation_StartWarm before we can acquire services
-    m_pSubscriptionService = ServiceManager::GetService<ISubscriptionService>();
-    m_pDataAccessService = ServiceManager::GetService<IDataAccessService>();
+    if((pSetpointMailbox == NULL) || (pResultMailbox == NULL) || (pGdsWriter == NULL) || (pDeviceStatus == NULL) || (pMetrics == NULL) || (pEventLoop == NULL))
+    {
+        Log::Error("Null pointer in CSampleSubscriptionThread::Init");
+        return(false);
+    }
+    m_pSetpointMailbox = pSetpointMailbox;
+    m_pResultMailbox = pResultMailbox;
+    m_pGdsWriter = pGdsWriter;
+    m_pDeviceStatus = pDeviceStatus;
+    m_pMetrics = pMetrics;
+
+    m_pSubscriptionService = pSubscriptionService;
+    m_pDataAccessService = pDataAccessService;
 
     if((m_pSubscriptionService != NULL) &&
        (m_pDataAccessService != NULL))
     {
-        // create a simple worker thread for RSC-subscriptions
-        if(pthread_create(&m_zCycleThread, NULL, CSampleSubscriptionThread::StaticCycle, this) == 0)
+        // take over the configuration of the subscription groups
+        m_zSubscriptionGroups.clear();
+        for(const SUBSCRIPTIONGROUPCONFIG& zConfig : s_zSubscriptionGroupConfig)
         {
-            m_bInitialized = true;
-            bRet = true;
+            if(zConfig.zTypes.size() != zConfig.zVariables.size())
+            {
+                Log::Error("Subscription group {0} needs one type for each variable", zConfig.szName);
+                return(false);
+            }
+
+            SUBSCRIPTIONGROUP zGroup;
+            zGroup.strName = zConfig.szName;
+            zGroup.zKind = zConfig.zKind;
+            zGroup.uSampleRate = zConfig.uSampleRate;
+            zGroup.zVariables = zConfig.zVariables;
+            zGroup.zTypes = zConfig.zTypes;
+            m_zSubscriptionGroups.push_back(zGroup);
         }
-        else
+
+#ifdef SUBSCRIPTION_BENCHMARK
+        m_bBenchmarkPending = true;
+#endif
+
+        // the subscriptions are read in the event loop of the main thread
+        if(pEventLoop->AddTimer("subscription cycle", SUBSCRIPTION_INTERVAL, [this]() { Cycle(); }))
         {
-            Log::Error("Error calling pthread_create (non-realtime thread)");
+            m_bInitialized = true;
+            bRet = true;
         }
     }
     else
     {
-        Log::Error("Error getting service (non-realtime thread)");
+        Log::Error("Missing service (subscription cycle)");
     }
 
     return(bRet);
 }
 
-/// @brief	The thread will run continuously after creation but the processing of
-/// 		I/Os can be started and stopped e.g. if a new PLCnext Engineer Program was loaded
-/// @return	true: success, false: failure
-bool CSampleSubscriptionThread::StartProcessing()
+/// @brief				The subscription cycle runs in the event loop after Init, but the processing of
+/// 					I/Os can be started and stopped e.g. if a new PLCnext Engineer Program was loaded.
+/// 					Subscriptions of the last start are used again, if the program layout did not change
+/// @param bHotStart	true: hot start, the program layout is unchanged and the subscriptions are used without check
+/// @return				true: success, false: failure
+bool CSampleSubscriptionThread::StartProcessing(bool bHotStart)
 {
     Log::Info("Subcription: Start processing");
 
     bool bRet = false;
+    uint64 uStart = GetMonotonicTimeNs();
+
+    // the last stop might not have waited long enough for the end of the cycle
+    if(m_zQuiescence.WaitForQuiescence(SUBSCRIPTIONSTOP_TIMEOUT) == false)
+    {
+        Log::Error("Subscription cycle is still running, processing is not started");
+        return(bRet);
+    }
+    size_t nReused = 0;
+
     try
     {
-        if(CreateSubscription())
+        bRet = true;
+        for(SUBSCRIPTIONGROUP& zGroup : m_zSubscriptionGroups)
+        {
+            zGroup.bReused = false;
+
+            if(zGroup.uSubscriptionId != 0)
+            {
+                if(bHotStart || ValidateSubscription(zGroup))
+                {
+                    zGroup.bReused = true;
+                    nReused++;
+                    continue;
+                }
+
+                // the variables of the subscription do not exist any more or changed their type
+                Log::Info("Subscription of group {0} does not match the program, it is created again", zGroup.strName);
+                DeleteSubscription(zGroup);
+            }
+
+            if(CreateSubscription(zGroup) == false)
+            {
+                bRet = false;
+            }
+        }
+
+        if(bRet)
         {
             m_bDoCycle = true;
-            bRet = true;
+        }
+        else
+        {
+            // do not keep a part of the subscriptions
+            ReleaseSubscriptions();
         }
     }
     catch(Arp::Exception &e)
     {
+        bRet = false;
         Log::Error("StartProcessing - Exception occured in CreateSubscription: {0}", e);
     }
     catch(...)
     {
+        bRet = false;
         Log::Error("StartProcessing - Unknown Exception occured");
     } 
 
+    Log::Info("Subscription: {0} of {1} subscriptions reused, start took {2} us", nReused, m_zSubscriptionGroups.size(), (GetMonotonicTimeNs() - uStart) / 1000);
+
     return(bRet);
 }
 
-/// @brief	The thread will run continuously after creation but the processing of
-/// 		I/Os can be started and stopped e.g. if a new PLCnext Engineer Program was loaded
+/// @brief	The subscription cycle runs in the event loop after Init, but the processing of
+/// 		I/Os can be started and stopped e.g. if a new PLCnext Engineer Program was loaded.
+/// 		The subscriptions are kept for the next start, use ReleaseSubscriptions() if
+/// 		the program layout changes
 /// @return	true: success, false: failure
 bool CSampleSubscriptionThread::StopProcessing()
 {
@@ -114,110 +249,238 @@ bool CSampleSubscriptionThread::StopProcessing()
 
     bool bRet = false;
 
-    // this is not threadsafe! In a real application you need to wait for end of cycle
-    // before deleting the subscription
+    // the cycle will not start a new read from now on, wait for the end of a running one
     m_bDoCycle = false;
 
-    if(DeleteSubscription())
+    if(m_zQuiescence.WaitForQuiescence(SUBSCRIPTIONSTOP_TIMEOUT))
     {
         bRet = true;
     }
+    else
+    {
+        Log::Error("Subscription cycle did not finish within {0} us", SUBSCRIPTIONSTOP_TIMEOUT);
+    }
 
     return(bRet);
 }
 
-/// @brief		static function for worker thread-entry of the cycle function
-/// @param p	pointer to thread object
-void* CSampleSubscriptionThread::StaticCycle(void* p)
+/// @brief	delete all subscriptions, e.g. if the PLCnext Engineer Program is unloaded and
+/// 		the subscribed variables might not exist in the next program
+/// @return	true: success, false: failure
+bool CSampleSubscriptionThread::ReleaseSubscriptions()
 {
-    if(p != NULL)
+    Log::Info("Subcription: Release subscriptions");
+
+    bool bRet = true;
+
+    // the cycle must not use the subscriptions any more
+    if(m_bDoCycle || (m_zQuiescence.WaitForQuiescence(SUBSCRIPTIONSTOP_TIMEOUT) == false))
     {
-        ((CSampleSubscriptionThread*)p)->Cycle();
+        Log::Error("Subscription cycle is still running, subscriptions are not released");
+        return(false);
     }
-    else
+
+    try
     {
-        Log::Error("Null pointer in StaticCycle");
+        for(SUBSCRIPTIONGROUP& zGroup : m_zSubscriptionGroups)
+        {
+            if((zGroup.uSubscriptionId != 0) && (DeleteSubscription(zGroup) == false))
+            {
+                bRet = false;
+            }
+        }
     }
-    return(NULL);
+    catch(Arp::Exception &e)
+    {
+        bRet = false;
+        Log::Error("ReleaseSubscriptions - Arp Exception! {0}", e);
+    }
+    catch(...)
+    {
+        bRet = false;
+        Log::Error("ReleaseSubscriptions - Unknown Exception occured");
+    }
+
+    return(bRet);
 }
 
-/// @brief		loop to process values of subscription
+/// @brief		process values of subscription, called by the event loop every SUBSCRIPTION_INTERVAL ms
 void CSampleSubscriptionThread::Cycle()
 {
-    Log::Info("Call of CSampleSubscriptionThread::Cycle");
+    // on high CPU load or temperature the subscriptions are read less often
+    if((m_uCycle++ % m_pDeviceStatus->GetThrottleDivider(SUBSCRIPTION_THROTTLE_REDUCED, SUBSCRIPTION_THROTTLE_MINIMAL)) != 0)
+    {
+        return;
+    }
 
-    while(true)
+    // subscriptions are not deleted while we are inside, see StopProcessing
+    m_zQuiescence.Enter();
+    if(m_bDoCycle)
     {
-        if(m_bDoCycle)
+        if(m_bBenchmarkPending)
         {
-            // you can check the log messages in the local log-file of this application, usually in a subfolder named "Logs"
-            Log::Info("************* Subscription-Thread values ******");
+            StartBenchmark();
+            m_bBenchmarkPending = false;
+        }
+
+        // you can check the log messages in the local log-file of this application, usually in a subfolder named "Logs"
+        Log::Info("************* Subscription values ******");
 
-            ReadSubscription();
+        uint64 uStoreBytes = 0;
+        bool bComplete = true;
+        for(SUBSCRIPTIONGROUP& zGroup : m_zSubscriptionGroups)
+        {
+            uint64 uPollNs = GetMonotonicTimeNs();
+            bool bRead = ReadSubscription(zGroup);
+            m_pMetrics->zSubscriptionPoll.Record(GetMonotonicTimeNs() - uPollNs);
+            IncrementMetric(m_pMetrics->uSubscriptionReads);
+            if(bRead == false)
+            {
+                IncrementMetric(m_pMetrics->uSubscriptionErrors);
+            }
+            if((bRead == false) || (zGroup.bComplete == false))
+            {
+                bComplete = false;
+            }
+            uStoreBytes += zGroup.zValues.GetMemoryUsage();
 
-            Log::Info("{0}: Value: {1}", GDSPort1, m_gdsPort1 ? "true" : "false");
-            Log::Info("{0}: Value: {1}", GDSPort2, m_gdsPort2 ? "true" : "false");
-            Log::Info("{0}: Value: {1}", GDSPort3, m_gdsPort3 ? "true" : "false");
+            if((bRead == false) && zGroup.bReused)
+            {
+                // the firmware dropped the reused subscription, create it again once
+                Log::Info("Reused subscription of group {0} cannot be read, it is created again", zGroup.strName);
+                zGroup.bReused = false;
+                try
+                {
+                    DeleteSubscription(zGroup);
+                    if(CreateSubscription(zGroup) == false)
+                    {
+                        IncrementMetric(m_pMetrics->uSubscriptionErrors);
+                        DeleteSubscription(zGroup);
+                    }
+                }
+                catch(Arp::Exception &e)
+                {
+                    IncrementMetric(m_pMetrics->uSubscriptionErrors);
+                    Log::Error("Cycle - Exception occured in CreateSubscription: {0}", e);
+                }
+                catch(...)
+                {
+                    IncrementMetric(m_pMetrics->uSubscriptionErrors);
+                    Log::Error("Cycle - Unknown Exception occured");
+                }
+            }
         }
+        m_pMetrics->uValueStoreBytes.store(uStoreBytes, std::memory_order_relaxed);
+
+        Log::Info("{0}: Value: {1}", GDSPort1, m_gdsPort1 ? "true" : "false");
+        Log::Info("{0}: Value: {1}", GDSPort2, m_gdsPort2 ? "true" : "false");
+        Log::Info("{0}: Value: {1}", GDSPort3, m_gdsPort3 ? "true" : "false");
 
-        WAIT100ms;
+        // exchange data with the realtime logic
+        PublishSetpoints(bComplete);
+        WriteResults();
     }
+    m_zQuiescence.Leave();
 }
 
-/// @brief		create a GDS subscription for three ports.
-/// @return		true: success, false: failure
-bool CSampleSubscriptionThread::CreateSubscription()
+/// @brief	start the subscription benchmark in its own thread. It takes seconds, the logging,
+/// 		the GDS writer and the other timers of the event loop keep running meanwhile
+void CSampleSubscriptionThread::StartBenchmark()
+{
+    if(pthread_create(&m_zBenchmarkThread, NULL, CSampleSubscriptionThread::StaticBenchmark, this) == 0)
+    {
+        m_bBenchmarkStarted = true;
+    }
+    else
+    {
+        Log::Error("Error calling pthread_create (subscription benchmark)");
+    }
+}
+
+/// @brief		static function for thread-entry of the subscription benchmark
+/// @param p	pointer to thread object
+void* CSampleSubscriptionThread::StaticBenchmark(void* p)
+{
+    if(p != NULL)
+    {
+        ((CSampleSubscriptionThread*)p)->Benchmark();
+    }
+    else
+    {
+        Log::Error("Null pointer in StaticBenchmark");
+    }
+    return(NULL);
+}
+
+/// @brief	measure the subscription kinds for each configured group of variables. The benchmark
+/// 		creates its own subscriptions and only uses the constant configuration, so the
+/// 		subscription cycle can run at the same time
+void CSampleSubscriptionThread::Benchmark()
+{
+    CSubscriptionBenchmark zBenchmark(m_pSubscriptionService, m_pDataAccessService);
+    zBenchmark.SetCoherencePair(GDSBenchmarkCounter, GDSBenchmarkMirror);
+    for(const SUBSCRIPTIONGROUPCONFIG& zConfig : s_zSubscriptionGroupConfig)
+    {
+        zBenchmark.Run(zConfig.szName, zConfig.zVariables, zConfig.uSampleRate, SUBSCRIPTION_BENCHMARK_READS);
+    }
+}
+
+/// @brief			create a GDS subscription for a group of variables
+/// @param zGroup	group of variables, the ID of the subscription will be stored in the group
+/// @return			true: success, false: failure
+bool CSampleSubscriptionThread::CreateSubscription(SUBSCRIPTIONGROUP& zGroup)
 {
-    Log::Info("Call of CSampleSubscriptionThread::CreateSubscription");
+    Log::Info("Call of CSampleSubscriptionThread::CreateSubscription for group {0}", zGroup.strName);
 
     bool bRet = false;
 
     // create subscription, check the description of SubscriptionKind for the different realtime classes
-    m_uSubscriptionId = m_pSubscriptionService->CreateSubscription(SubscriptionKind::HighPerformance);
+    zGroup.uSubscriptionId = m_pSubscriptionService->CreateSubscription(zGroup.zKind);
 
-    if(m_uSubscriptionId != 0)
+    if(zGroup.uSubscriptionId != 0)
     {
         // add the variables
-        if(m_pSubscriptionService->AddVariable(m_uSubscriptionId, GDSPort1) == DataAccessError::None)
+        bool bAdded = true;
+        for(const string& strVariable : zGroup.zVariables)
         {
-            if(m_pSubscriptionService->AddVariable(m_uSubscriptionId, GDSPort2) == DataAccessError::None)
+            if(m_pSubscriptionService->AddVariable(zGroup.uSubscriptionId, strVariable.c_str()) != DataAccessError::None)
             {
-                if(m_pSubscriptionService->AddVariable(m_uSubscriptionId, GDSPort3) == DataAccessError::None)
+                Log::Error("Unable to subscribe variable {0}", strVariable);
+                bAdded = false;
+                break;
+            }
+        }
+
+        if(bAdded)
+        {
+            // subscribe the build subscription and save the returned record info for further reading
+            // of the subscription to know the order of result
+            if(m_pSubscriptionService->Subscribe(zGroup.uSubscriptionId, zGroup.uSampleRate) == DataAccessError::None)
+            {
+                // get information about the order / layout of the vector of read variable values
+                if(RSCReadVariableInfos(zGroup.uSubscriptionId, zGroup.zInfos) != DataAccessError::None)
                 {
-                    // subscribe the build subscription and save the returned record info for further reading
-                    // of the subscription to know the order of result
-                    const uint64 sampleRate = 1000000; // us == 1s
-                    if(m_pSubscriptionService->Subscribe(m_uSubscriptionId, sampleRate) == DataAccessError::None)
-                    {
-                        // get information about the order / layout of the vector of read variable values
-                        if(RSCReadVariableInfos(m_zSubscriptionInfos) == DataAccessError::None)
-                        {
-                            bRet = true;
-                        }
-                        else
-                        {
-                            Log::Error("Unable to read variable information");
-                        }
-                    }
-                    else
-                    {
-                        Log::Error("ISubscriptionservice::Subscribe returned error");
-                    }
+                    Log::Error("Unable to read variable information");
+                }
+                else if(MatchesConfiguration(zGroup, zGroup.zInfos) == false)
+                {
+                    Log::Error("Variables of group {0} do not have the configured types", zGroup.strName);
                 }
                 else
                 {
-                    Log::Error("Unable to subscribe variable {0}", GDSPort3);
+                    // size the storage for the values once, reading the subscription does not allocate memory then
+                    if(zGroup.zValues.Init(zGroup.zInfos))
+                    {
+                        Log::Info("Subscription of group {0}: {1} variables, {2} bytes for values", zGroup.strName, zGroup.zInfos.size(), zGroup.zValues.GetMemoryUsage());
+                        bRet = true;
+                    }
                 }
             }
             else
             {
-                Log::Error("Unable to subscribe variable {0}", GDSPort2);
+                Log::Error("ISubscriptionservice::Subscribe returned error");
             }
         }
-        else
-        {
-            Log::Error("Unable to subscribe variable {0}", GDSPort1);
-        }
     }
     else
     {
@@ -226,17 +489,62 @@ bool CSampleSubscriptionThread::CreateSubscription()
     return bRet;
 }
 
-/// @brief		delete the subscription
-/// @return		true: success, false: failure
-bool CSampleSubscriptionThread::DeleteSubscription()
+/// @brief			check if an existing subscription still fits to the program, this is much
+/// 				faster than creating the subscription again variable by variable
+/// @param zGroup	group of variables
+/// @return			true: subscription can be used, false: subscription must be created again
+bool CSampleSubscriptionThread::ValidateSubscription(SUBSCRIPTIONGROUP& zGroup)
+{
+    bool bRet = false;
+
+    // the infos of the last start were read from the same subscription, so the current infos are
+    // compared with the configuration to detect a changed layout of the program
+    vector<VariableInfo> zInfos;
+    if((RSCReadVariableInfos(zGroup.uSubscriptionId, zInfos) == DataAccessError::None) &&
+       MatchesConfiguration(zGroup, zInfos))
+    {
+        zGroup.zInfos = zInfos;
+        bRet = true;
+    }
+
+    return(bRet);
+}
+
+/// @brief			check the variable infos of a subscription against the configuration of the group
+/// @param zGroup	group of variables
+/// @param zInfos	infos of the subscription
+/// @return			true: the configured variables with the configured types in the configured order
+bool CSampleSubscriptionThread::MatchesConfiguration(const SUBSCRIPTIONGROUP& zGroup, const vector<VariableInfo>& zInfos)
 {
-    Log::Info("Call of CSampleSubscriptionThread::DeleteSubscription");
+    if((zInfos.size() != zGroup.zVariables.size()) || (zGroup.zTypes.size() != zGroup.zVariables.size()))
+    {
+        return(false);
+    }
+
+    for(size_t nCount = 0; nCount < zInfos.size(); nCount++)
+    {
+        if((strcmp(zInfos[nCount].Name.CStr(), zGroup.zVariables[nCount].c_str()) != 0) ||
+           (zInfos[nCount].Type != zGroup.zTypes[nCount]))
+        {
+            return(false);
+        }
+    }
+
+    return(true);
+}
+
+/// @brief			delete the subscription of a group of variables
+/// @param zGroup	group of variables
+/// @return			true: success, false: failure
+bool CSampleSubscriptionThread::DeleteSubscription(SUBSCRIPTIONGROUP& zGroup)
+{
+    Log::Info("Call of CSampleSubscriptionThread::DeleteSubscription for group {0}", zGroup.strName);
 
     bool bRet = false;
 
-    if(m_uSubscriptionId != 0)
+    if(zGroup.uSubscriptionId != 0)
     {
-        if(m_pSubscriptionService->DeleteSubscription(m_uSubscriptionId) == DataAccessError::None)
+        if(m_pSubscriptionService->DeleteSubscription(zGroup.uSubscriptionId) == DataAccessError::None)
         {
             bRet = true;
         }
@@ -245,54 +553,61 @@ bool CSampleSubscriptionThread::DeleteSubscription()
             Log::Error("ISubscriptionservice::DeleteSubscription returned error");
         }
 
-        m_uSubscriptionId = 0;
+        zGroup.uSubscriptionId = 0;
+        zGroup.zValues.Clear();
     }
     return(bRet);
 }
 
-/// @brief		poll the subscribed values and parse them
-/// @return		true: success, false: failure
-bool CSampleSubscriptionThread::ReadSubscription()
+/// @brief			poll the subscribed values of a group and parse them
+/// @param zGroup	group of variables
+/// @return			true: success, false: failure
+bool CSampleSubscriptionThread::ReadSubscription(SUBSCRIPTIONGROUP& zGroup)
 {
     bool bRet = false;
+    zGroup.bComplete = false;
 
     try
     {
         // Read the subscription
-        if(RSCReadVariableValues(m_zSubscriptionValues) == DataAccessError::None)
+        if(RSCReadVariableValues(zGroup.uSubscriptionId, zGroup.zValues) == DataAccessError::None)
         {
             // The order of the subscription info vector is the same as the subscription values vector,
-            // we can iterate over both in the same loop
-            if(m_zSubscriptionValues.size() == m_zSubscriptionInfos.size())	// sanity-check
+            // we can iterate over both in the same loop. The number of values actually read is checked,
+            // a reply with too few or too many values does not fit to the infos
+            if(zGroup.zValues.GetReceivedCount() == zGroup.zInfos.size())	// sanity-check
             {
-                for(std::size_t nCount = 0; nCount < m_zSubscriptionValues.size(); ++nCount)
+                zGroup.bComplete = true;
+                for(std::size_t nCount = 0; nCount < zGroup.zValues.GetCount(); ++nCount)
                 {
-                    if(m_zSubscriptionValues[nCount].GetType() != RscType::Void)
+                    if(zGroup.zValues.IsValid(nCount))
 					{
 
-                        if(strcmp(m_zSubscriptionInfos[nCount].Name.CStr(), GDSPort1) == 0)
+                        if(strcmp(zGroup.zInfos[nCount].Name.CStr(), GDSPort1) == 0)
                         {
-                            m_zSubscriptionValues[nCount].CopyTo(m_gdsPort1);
+                            zGroup.zValues.GetValue(nCount, m_gdsPort1);
                         }
-                        if(strcmp(m_zSubscriptionInfos[nCount].Name.CStr(), GDSPort2) == 0)
+                        if(strcmp(zGroup.zInfos[nCount].Name.CStr(), GDSPort2) == 0)
                         {
-                            m_zSubscriptionValues[nCount].CopyTo(m_gdsPort2);
+                            zGroup.zValues.GetValue(nCount, m_gdsPort2);
                         }
-                        if(strcmp(m_zSubscriptionInfos[nCount].Name.CStr(), GDSPort3) == 0)
+                        if(strcmp(zGroup.zInfos[nCount].Name.CStr(), GDSPort3) == 0)
                         {
-                            m_zSubscriptionValues[nCount].CopyTo(m_gdsPort3);
+                            zGroup.zValues.GetValue(nCount, m_gdsPort3);
                         }
                     }
                     else
 					{
-						Log::Info("Subscription {0} is not available yet. Initial value of its variable will be used!", m_zSubscriptionInfos[nCount].Name);
+                        zGroup.bComplete = false;
+						Log::Info("Subscription {0} is not available yet. Initial value of its variable will be used!", zGroup.zInfos[nCount].Name);
 					}
                 }
                 bRet = true;
             }
             else
             {
-                Log::Error("Inconsistent size of subscription info and subscription values vector");
+                Log::Error("Inconsistent size of subscription info ({0}) and subscription values ({1})",
+                           zGroup.zInfos.size(), zGroup.zValues.GetReceivedCount());
             }
         }
         else
@@ -313,31 +628,79 @@ bool CSampleSubscriptionThread::ReadSubscription()
     return(bRet);
 }
 
-// create a delegate (callback-function) for reading the vector of subscription values
-DataAccessError CSampleSubscriptionThread::RSCReadVariableValues(vector<RscVariant<512>>& values)
+/// @brief			hand the subscribed values over to the realtime logic
+/// @param bValid	true: every group was read and every value was valid
+/// @return			true: success, false: failure
+bool CSampleSubscriptionThread::PublishSetpoints(bool bValid)
+{
+    // the write buffer does not contain the last values, so every member has to be set
+    GDSSETPOINTS& zSetpoints = m_pSetpointMailbox->GetWriteBuffer();
+    zSetpoints.bValid = bValid;
+    zSetpoints.bVarA = m_gdsPort1;
+    zSetpoints.bVarB = m_gdsPort2;
+    zSetpoints.bVarC = m_gdsPort3;
+    m_pSetpointMailbox->Publish();
+
+    return(true);
+}
+
+/// @brief		queue the newest results of the realtime logic for writing to the GDS, if they changed
+/// @return		true: success, false: failure
+bool CSampleSubscriptionThread::WriteResults()
+{
+    bool bRet = true;
+
+    if(m_pResultMailbox->Update() == false)
+    {
+        // no new results since last call
+        return(bRet);
+    }
+
+    const RTRESULTS& zResults = m_pResultMailbox->GetReadBuffer();
+    if(zResults.bValid && ((m_bResultsWritten == false) || (zResults.bVarA != m_bWrittenVarA)))
+    {
+        // the writer merges this with other requests into one RSC call
+        if(m_pGdsWriter->Write(GDSPort1, zResults.bVarA))
+        {
+            m_bWrittenVarA = zResults.bVarA;
+            m_bResultsWritten = true;
+        }
+        else
+        {
+            bRet = false;
+        }
+    }
+
+    return(bRet);
+}
+
+// create a delegate (callback-function) for reading the vector of subscription values.
+// The values are decoded directly into the columns of the store, only one RscVariant is
+// needed as temporary buffer
+DataAccessError CSampleSubscriptionThread::RSCReadVariableValues(uint32 uSubscriptionId, CSubscriptionValueStore& values)
 {
+    // a read which does not call the delegate has no values, not the values of the last read
+    values.BeginUpdate();
+
     ISubscriptionService::ReadValuesValuesDelegate readSubscriptionValuesDelegate =
         ISubscriptionService::ReadValuesValuesDelegate::create([&](IRscReadEnumerator<RscVariant<512>>& readEnumerator)
     {
-        values.clear();
-
         size_t valueCount = readEnumerator.BeginRead();
-        values.reserve(valueCount);
 
         RscVariant<512> current;
         for (size_t i = 0; i < valueCount; i++)
         {
             readEnumerator.ReadNext(current);
-            values.push_back(current);
+            values.Store(i, current);
         }
         readEnumerator.EndRead();
     });
 
-    return m_pSubscriptionService->ReadValues(m_uSubscriptionId, readSubscriptionValuesDelegate);
+    return m_pSubscriptionService->ReadValues(uSubscriptionId, readSubscriptionValuesDelegate);
 }
 
 // create a delegate (callback-function) for reading the vector of subscription information
-DataAccessError CSampleSubscriptionThread::RSCReadVariableInfos(vector<VariableInfo>& values)
+DataAccessError CSampleSubscriptionThread::RSCReadVariableInfos(uint32 uSubscriptionId, vector<VariableInfo>& values)
 {
     ISubscriptionService::GetVariableInfosVariableInfoDelegate getSubscriptionInfosDelegate =
         ISubscriptionService::GetVariableInfosVariableInfoDelegate::create([&](IRscReadEnumerator<VariableInfo>& readEnumerator)
@@ -356,5 +719,5 @@ DataAccessError CSampleSubscriptionThread::RSCReadVariableInfos(vector<VariableI
         readEnumerator.EndRead();
     });
 
-    return m_pSubscriptionService->GetVariableInfos(m_uSubscriptionId, getSubscriptionInfosDelegate);
+    return m_pSubscriptionService->GetVariableInfos(uSubscriptionId, getSubscriptionInfosDelegate);
 }
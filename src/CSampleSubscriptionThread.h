@@ -10,59 +10,117 @@
  *
  ******************************************************************************/
 
+#ifndef CSAMPLESUBSCRIPTIONTHREAD_H_
+#define CSAMPLESUBSCRIPTIONTHREAD_H_
+
+#include <pthread.h>
 #include <vector>
+#include <atomic>
 #include "Arp/Plc/Gds/Services/ISubscriptionService.hpp"
 #include "Arp/Plc/Gds/Services/IDataAccessService.hpp"
 #include "Arp/System/Commons/Logging.h"
 #include "Utility.h"
+#include "ProcessData.h"
+#include "DeviceStatus.h"
+#include "RuntimeMetrics.h"
+#include "CGdsWriter.h"
+#include "CSubscriptionValueStore.h"
+#include "CQuiescence.h"
+#include "CEventLoop.h"
 
 using namespace std;
 using namespace Arp;
 using namespace Arp::Plc::Gds::Services;
 
-#ifndef CSAMPLESUBSCRIPTIONTHREAD_H_
-#define CSAMPLESUBSCRIPTIONTHREAD_H_
+///	structure to handle one subscription for a group of GDS variables
+struct SUBSCRIPTIONGROUP
+{
+    // definition of group
+    string strName;							// name of group, only used for logging
+    SubscriptionKind zKind = SubscriptionKind::HighPerformance;	// realtime class of the subscription
+    uint64 uSampleRate = 0;					// sample rate in us
+    vector<string> zVariables;				// names of the GDS variables
+    vector<RscType> zTypes;					// types of the GDS variables in the same order
+
+    // current subscription
+    uint32 uSubscriptionId = 0;				// ID of subscription, 0 if not subscribed
+    CSubscriptionValueStore zValues;		// values of last read, stored in columns of their own type
+    vector<VariableInfo> zInfos;			// order / layout of the values
+    bool bReused = false;					// subscription was kept from the last start
+    bool bComplete = false;					// every value of the last read was valid
+};
 
 class CSampleSubscriptionThread
 {
+    // the host tool in tools/RscBenchmark uses the private functions
+    friend class CRscBenchmark;
+
 public:
     CSampleSubscriptionThread();
     virtual ~CSampleSubscriptionThread();
 
-    bool Init();
-    static void* StaticCycle(void* p);
+    bool Init(ISubscriptionService::Ptr pSubscriptionService, IDataAccessService::Ptr pDataAccessService,
+              CSetpointMailbox* pSetpointMailbox, CResultMailbox* pResultMailbox, CGdsWriter* pGdsWriter,
+              const DEVICESTATUS* pDeviceStatus, RUNTIMEMETRICS* pMetrics, CEventLoop* pEventLoop);
     void Cycle();
 
     // start and stop our own processing
-    bool StartProcessing();
+    bool StartProcessing(bool bHotStart);
     bool StopProcessing();
+    bool ReleaseSubscriptions();
 
 private:
 
-    pthread_t m_zCycleThread;
-
     bool m_bInitialized;	// class already initialized?
-    bool m_bDoCycle;		// shall the subscription cycle run?
+    std::atomic<bool> m_bDoCycle;	// shall the subscription cycle run?
+    uint32 m_uCycle;				// counter of the subscription cycle in the event loop, for throttling
+    CQuiescence m_zQuiescence;		// handshake to delete subscriptions only after the cycle left
 
     ISubscriptionService::Ptr m_pSubscriptionService;
     IDataAccessService::Ptr m_pDataAccessService;
 
     // example usage of GDS subscription
-    bool CreateSubscription();
-    bool DeleteSubscription();
-    bool ReadSubscription();
-    DataAccessError RSCReadVariableValues(vector<RscVariant<512>>& values);
-    DataAccessError RSCReadVariableInfos(vector<VariableInfo>& values);
+    bool CreateSubscription(SUBSCRIPTIONGROUP& zGroup);
+    bool ValidateSubscription(SUBSCRIPTIONGROUP& zGroup);
+    bool MatchesConfiguration(const SUBSCRIPTIONGROUP& zGroup, const vector<VariableInfo>& zInfos);
+    bool DeleteSubscription(SUBSCRIPTIONGROUP& zGroup);
+    bool ReadSubscription(SUBSCRIPTIONGROUP& zGroup);
+    DataAccessError RSCReadVariableValues(uint32 uSubscriptionId, CSubscriptionValueStore& values);
+    DataAccessError RSCReadVariableInfos(uint32 uSubscriptionId, vector<VariableInfo>& values);
+
+    // exchange of data with the realtime thread
+    CSetpointMailbox* m_pSetpointMailbox;
+    CResultMailbox* m_pResultMailbox;
+    CGdsWriter* m_pGdsWriter;
+
+    // status of the device, the subscriptions are read less often on high CPU load or temperature
+    const DEVICESTATUS* m_pDeviceStatus;
 
-    // subscriptions
-    uint32 m_uSubscriptionId;
-    vector<RscVariant<512>> m_zSubscriptionValues;
-    vector<VariableInfo> m_zSubscriptionInfos;
+    // poll times and memory for the metrics endpoint
+    RUNTIMEMETRICS* m_pMetrics;
+
+    bool PublishSetpoints(bool bValid);
+    bool WriteResults();
+
+    // subscriptions, one per group of variables
+    vector<SUBSCRIPTIONGROUP> m_zSubscriptionGroups;
+    bool m_bBenchmarkPending;	// shall the subscription benchmark start in the next cycle?
+
+    // the benchmark runs in its own thread, so it does not block the event loop
+    pthread_t m_zBenchmarkThread;
+    bool m_bBenchmarkStarted;
+    void StartBenchmark();
+    static void* StaticBenchmark(void* p);
+    void Benchmark();
 
     // data fields
     bool m_gdsPort1;
     bool m_gdsPort2;
     bool m_gdsPort3;
+
+    // last results of the realtime logic which were queued for writing to the GDS
+    bool m_bResultsWritten;
+    bool m_bWrittenVarA;
 };
 
 #endif /* CSAMPLESUBSCRIPTIONTHREAD_H_ */
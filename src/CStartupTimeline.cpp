@@ -0,0 +1,160 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CStartupTimeline.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#include "CStartupTimeline.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <unistd.h>
+#include "Arp/System/Core/Arp.h"
+#include "Arp/System/Commons/Logging.h"
+
+using namespace Arp;
+using namespace std;
+
+// the atomics of a global object are zero-initialized before any constructor runs
+CStartupTimeline g_zStartupTimeline;
+
+static const char* s_szMilestoneNames[STARTUP_COUNT] =
+{
+    "main",
+    "module_setup",
+    "runtime_created",
+    "start_callback",
+    "init_begin",
+    "services_acquired",
+    "init_done",
+    "start_processing_begin",
+    "start_processing_done",
+    "first_rt_cycle"
+};
+
+/// @brief				record the current time for a milestone, only the first call per milestone is used
+/// @param zMilestone	milestone
+void CStartupTimeline::Mark(STARTUPMILESTONE zMilestone)
+{
+    Mark(zMilestone, GetMonotonicTimeNs());
+}
+
+/// @brief				record a time for a milestone, only the first call per milestone is used
+/// @param zMilestone	milestone
+/// @param uTimeNs		time of CLOCK_MONOTONIC in ns
+void CStartupTimeline::Mark(STARTUPMILESTONE zMilestone, uint64_t uTimeNs)
+{
+    if(zMilestone >= STARTUP_COUNT)
+    {
+        return;
+    }
+
+    if(zMilestone == STARTUP_MAIN)
+    {
+        // the time after power on is the KPI, so the time since boot is recorded as well
+        timespec zTime;
+        clock_gettime(CLOCK_BOOTTIME, &zTime);
+        uint64_t uExpected = 0;
+        m_uBootTimeNs.compare_exchange_strong(uExpected, (uint64_t)zTime.tv_sec * 1000000000ULL + (uint64_t)zTime.tv_nsec);
+    }
+
+    uint64_t uExpected = 0;
+    m_uTimeNs[zMilestone].compare_exchange_strong(uExpected, uTimeNs);
+}
+
+/// @brief				was a milestone reached?
+/// @param zMilestone	milestone
+/// @return				true: reached, false: not reached yet
+bool CStartupTimeline::IsMarked(STARTUPMILESTONE zMilestone) const
+{
+    return((zMilestone < STARTUP_COUNT) && (m_uTimeNs[zMilestone].load() != 0));
+}
+
+/// @brief	write the startup report once as a single JSON line to the log and to STARTUP_REPORT_FILE.
+/// 		Times are in ms relative to the entry of main(), missing milestones are reported as null
+/// @return	true: report written, false: first cycle not reached yet or already reported
+bool CStartupTimeline::Report()
+{
+    if((IsMarked(STARTUP_FIRSTCYCLE) == false) || m_bReported.exchange(true))
+    {
+        return(false);
+    }
+
+    uint64_t uMainNs = m_uTimeNs[STARTUP_MAIN].load();
+
+    // start time of the process in clock ticks since boot, field 22 of /proc/self/stat
+    long long llExecMs = -1;
+    FILE* pStat = fopen("/proc/self/stat", "r");
+    if(pStat != NULL)
+    {
+        char szStat[1024];
+        if(fgets(szStat, sizeof(szStat), pStat) != NULL)
+        {
+            // the name of the process in field 2 may contain spaces, so start after its closing bracket
+            const char* pField = strrchr(szStat, ')');
+            unsigned long long ullStartTicks = 0;
+            if((pField != NULL) &&
+               (sscanf(pField + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %*u %*u %*d %*d %*d %*d %*d %*d %llu", &ullStartTicks) == 1))
+            {
+                llExecMs = (long long)(ullStartTicks * 1000 / sysconf(_SC_CLK_TCK));
+            }
+        }
+        fclose(pStat);
+    }
+
+    char szValue[64];
+    string strReport = "{\"startup\":{\"version\":1,\"build\":\"" __DATE__ " " __TIME__ "\"";
+
+    snprintf(szValue, sizeof(szValue), ",\"boot_to_exec_ms\":%lld", llExecMs);
+    strReport += szValue;
+    snprintf(szValue, sizeof(szValue), ",\"boot_to_main_ms\":%.3f", m_uBootTimeNs.load() / 1000000.0);
+    strReport += szValue;
+
+    strReport += ",\"milestones\":{";
+    uint64_t uLastNs = uMainNs;
+    for(int nCount = 0; nCount < STARTUP_COUNT; nCount++)
+    {
+        uint64_t uTimeNs = m_uTimeNs[nCount].load();
+        if(uTimeNs != 0)
+        {
+            // time since main() and since the previous milestone
+            snprintf(szValue, sizeof(szValue), "{\"t_ms\":%.3f,\"delta_ms\":%.3f}",
+                     (int64_t)(uTimeNs - uMainNs) / 1000000.0, (int64_t)(uTimeNs - uLastNs) / 1000000.0);
+            uLastNs = uTimeNs;
+        }
+        else
+        {
+            snprintf(szValue, sizeof(szValue), "null");
+        }
+        strReport += (nCount > 0) ? ",\"" : "\"";
+        strReport += s_szMilestoneNames[nCount];
+        strReport += "\":";
+        strReport += szValue;
+    }
+    strReport += "}";
+
+    snprintf(szValue, sizeof(szValue), ",\"total_ms\":%.3f}}", (m_uTimeNs[STARTUP_FIRSTCYCLE].load() - uMainNs) / 1000000.0);
+    strReport += szValue;
+
+    Log::Info("Startup report: {0}", strReport);
+
+    FILE* pFile = fopen(STARTUP_REPORT_FILE, "a");
+    if(pFile != NULL)
+    {
+        fprintf(pFile, "%s\n", strReport.c_str());
+        fclose(pFile);
+    }
+    else
+    {
+        Log::Error("Cannot write startup report to {0}", STARTUP_REPORT_FILE);
+    }
+
+    return(true);
+}
@@ -0,0 +1,59 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CStartupTimeline.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef CSTARTUPTIMELINE_H_
+#define CSTARTUPTIMELINE_H_
+
+#include <atomic>
+#include <stdint.h>
+#include "Utility.h"
+
+#define STARTUP_REPORT_FILE		"logs/StartupReport.jsonl"	// one report per line is appended, see tools/StartupCompare
+
+///	milestones of the startup, in the expected order
+enum STARTUPMILESTONE
+{
+    STARTUP_MAIN = 0,			// entry of main()
+    STARTUP_MODULESETUP,		// ArpSystemModule_Setup returned
+    STARTUP_RUNTIME,			// CSampleRuntime created, PLC state callback registered
+    STARTUP_STARTCALLBACK,		// first PlcOperation_StartCold or PlcOperation_StartWarm callback
+    STARTUP_INITBEGIN,			// init pipeline started
+    STARTUP_SERVICES,			// all RSC services acquired
+    STARTUP_INITDONE,			// all threads initialized
+    STARTUP_STARTBEGIN,			// StartProcessing called
+    STARTUP_STARTDONE,			// StartProcessing returned
+    STARTUP_FIRSTCYCLE,			// first RT cycle with valid inputs and outputs
+    STARTUP_COUNT
+};
+
+/// @brief	records the monotonic time of each startup milestone once and writes one startup
+/// 		report after the first productive RT cycle. Mark() only does an atomic compare and
+/// 		exchange, so it can be called from any thread, even before the logger is ready.
+class CStartupTimeline
+{
+public:
+    void Mark(STARTUPMILESTONE zMilestone);
+    void Mark(STARTUPMILESTONE zMilestone, uint64_t uTimeNs);
+    bool IsMarked(STARTUPMILESTONE zMilestone) const;
+
+    // called by a non-realtime thread after the first productive cycle
+    bool Report();
+
+private:
+    std::atomic<uint64_t> m_uTimeNs[STARTUP_COUNT];	// CLOCK_MONOTONIC, 0 if not reached
+    std::atomic<uint64_t> m_uBootTimeNs;				// CLOCK_BOOTTIME at entry of main()
+    std::atomic<bool> m_bReported;
+};
+
+extern CStartupTimeline g_zStartupTimeline;	// global, so the milestones of main() can be recorded
+
+#endif /* CSTARTUPTIMELINE_H_ */
@@ -0,0 +1,420 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CSubscriptionBenchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#include "CSubscriptionBenchmark.h"
+
+CSubscriptionBenchmark::CSubscriptionBenchmark(ISubscriptionService::Ptr pSubscriptionService, IDataAccessService::Ptr pDataAccessService)
+                     : m_pSubscriptionService(pSubscriptionService),
+                       m_pDataAccessService(pDataAccessService),
+                       m_bCoherence(false)
+{
+}
+
+CSubscriptionBenchmark::~CSubscriptionBenchmark()
+{
+}
+
+/// @brief				set two integer variables to check if a read delivers the values of one task
+/// 					cycle. The program has to write both in the same cycle with the same value, e.g.
+/// 					Counter := Counter + 1; Mirror := Counter; A read where they differ is torn.
+/// 					If the program does not have the pair, the check is skipped
+/// @param strCounter	name of the counter
+/// @param strMirror	name of the mirror
+void CSubscriptionBenchmark::SetCoherencePair(const string& strCounter, const string& strMirror)
+{
+    m_strCounter = strCounter;
+    m_strMirror = strMirror;
+}
+
+/// @brief				measure all subscription kinds and direct reads for a set of variables. With a
+/// 					coherence pair, each read also checks if its values are from one task cycle.
+/// 					The results are written to the log-file. This takes a while and causes
+/// 					load on the controller, so do not run it during production
+/// @param strGroup		name of variable set, only used for logging
+/// @param zVariables	names of the GDS variables
+/// @param uSampleRate	sample rate of the subscriptions in us
+/// @param nReads		number of reads for each method
+/// @return				true: all methods could be measured, false: at least one failed
+bool CSubscriptionBenchmark::Run(const string& strGroup, const vector<string>& zVariables, uint64 uSampleRate, size_t nReads)
+{
+    Log::Info("Subscription benchmark for group {0}: {1} variables, {2} reads", strGroup, zVariables.size(), nReads);
+
+    bool bRet = true;
+
+    // the pair is read by every method together with the variables of the group
+    vector<string> zReadVariables = zVariables;
+    m_bCoherence = FindCoherencePair();
+    if(m_bCoherence)
+    {
+        zReadVariables.push_back(m_strCounter);
+        zReadVariables.push_back(m_strMirror);
+    }
+
+    // the recording kind is not measured, it needs a ring buffer and is read with ReadRecords
+    const SubscriptionKind zKinds[] = { SubscriptionKind::DirectRead, SubscriptionKind::HighPerformance, SubscriptionKind::RealTime };
+    const char* szKindNames[] = { "DirectRead", "HighPerformance", "RealTime" };
+
+    for(size_t nKind = 0; nKind < sizeof(zKinds) / sizeof(zKinds[0]); nKind++)
+    {
+        SUBSCRIPTIONBENCHMARKRESULT zResult;
+        zResult.strMethod = szKindNames[nKind];
+
+        try
+        {
+            zResult.bSuccess = BenchmarkSubscription(zKinds[nKind], zReadVariables, uSampleRate, nReads, zResult);
+        }
+        catch(Arp::Exception &e)
+        {
+            Log::Error("Subscription benchmark - Arp Exception! {0}", e);
+        }
+        catch(...)
+        {
+            Log::Error("Subscription benchmark - Unknown Exception occured");
+        }
+
+        if(zResult.bSuccess == false)
+        {
+            bRet = false;
+        }
+        LogResult(strGroup, zVariables.size(), zResult);
+    }
+
+    SUBSCRIPTIONBENCHMARKRESULT zResult;
+    zResult.strMethod = "IDataAccessService::Read";
+    try
+    {
+        zResult.bSuccess = BenchmarkDirectRead(zReadVariables, nReads, zResult);
+    }
+    catch(Arp::Exception &e)
+    {
+        Log::Error("Subscription benchmark - Arp Exception! {0}", e);
+    }
+    catch(...)
+    {
+        Log::Error("Subscription benchmark - Unknown Exception occured");
+    }
+
+    if(zResult.bSuccess == false)
+    {
+        bRet = false;
+    }
+    LogResult(strGroup, zVariables.size(), zResult);
+
+    return(bRet);
+}
+
+/// @brief				create a subscription of one kind, read it several times and delete it again
+/// @param zKind		kind of subscription
+/// @param zVariables	names of the GDS variables
+/// @param uSampleRate	sample rate in us
+/// @param nReads		number of reads
+/// @param zResult		reference to the result
+/// @return				true: success, false: failure
+bool CSubscriptionBenchmark::BenchmarkSubscription(SubscriptionKind zKind, const vector<string>& zVariables, uint64 uSampleRate, size_t nReads, SUBSCRIPTIONBENCHMARKRESULT& zResult)
+{
+    bool bRet = false;
+
+    // creation time includes everything which is needed before the first read
+    uint64 uStart = GetMonotonicTimeNs();
+    uint32 uSubscriptionId = m_pSubscriptionService->CreateSubscription(zKind);
+
+    if(uSubscriptionId == 0)
+    {
+        Log::Error("ISubscriptionservice::CreateSubscription returned error");
+        return(false);
+    }
+
+    bool bAdded = true;
+    for(const string& strVariable : zVariables)
+    {
+        if(m_pSubscriptionService->AddVariable(uSubscriptionId, strVariable.c_str()) != DataAccessError::None)
+        {
+            Log::Error("Unable to subscribe variable {0}", strVariable);
+            bAdded = false;
+            break;
+        }
+    }
+
+    vector<VariableInfo> zInfos;
+    ISubscriptionService::GetVariableInfosVariableInfoDelegate getInfosDelegate =
+        ISubscriptionService::GetVariableInfosVariableInfoDelegate::create([&](IRscReadEnumerator<VariableInfo>& readEnumerator)
+    {
+        size_t valueCount = readEnumerator.BeginRead();
+        zInfos.reserve(valueCount);
+
+        VariableInfo current;
+        for (size_t i = 0; i < valueCount; i++)
+        {
+            readEnumerator.ReadNext(current);
+            zInfos.push_back(current);
+        }
+        readEnumerator.EndRead();
+    });
+
+    if(bAdded &&
+       (m_pSubscriptionService->Subscribe(uSubscriptionId, uSampleRate) == DataAccessError::None) &&
+       (m_pSubscriptionService->GetVariableInfos(uSubscriptionId, getInfosDelegate) == DataAccessError::None))
+    {
+        zResult.uCreateTimeUs = (GetMonotonicTimeNs() - uStart) / 1000;
+
+        // decode the values in the same way as the subscription cycle does, but without
+        // storing them, so only the cost of the transfer and the decoding is measured
+        size_t nValid = 0;
+        COHERENCEREAD zPair;
+        RscVariant<512> current;
+        ISubscriptionService::ReadValuesValuesDelegate readValuesDelegate =
+            ISubscriptionService::ReadValuesValuesDelegate::create([&](IRscReadEnumerator<RscVariant<512>>& readEnumerator)
+        {
+            size_t valueCount = readEnumerator.BeginRead();
+            for (size_t i = 0; i < valueCount; i++)
+            {
+                readEnumerator.ReadNext(current);
+                if((i < zInfos.size()) && (current.GetType() == zInfos[i].Type))
+                {
+                    nValid++;
+                    ReadCoherence(i, zVariables.size(), current, zPair);
+                }
+            }
+            readEnumerator.EndRead();
+        });
+
+        uint64 uCpuStart = GetThreadCpuTimeUs();
+        uint64 uWallStart = GetMonotonicTimeNs();
+        for(size_t nCount = 0; nCount < nReads; nCount++)
+        {
+            nValid = 0;
+            zPair = COHERENCEREAD();
+            uint64 uReadStart = GetMonotonicTimeNs();
+            if(m_pSubscriptionService->ReadValues(uSubscriptionId, readValuesDelegate) == DataAccessError::None)
+            {
+                AddReadLatency((GetMonotonicTimeNs() - uReadStart) / 1000, zResult);
+                if(nValid == zVariables.size())
+                {
+                    zResult.uCompleteReads++;
+                }
+                CheckCoherence(zPair, zResult);
+            }
+        }
+        zResult.uWallTimeUs = (GetMonotonicTimeNs() - uWallStart) / 1000;
+        zResult.uCpuTimeUs = GetThreadCpuTimeUs() - uCpuStart;
+
+        bRet = (zResult.uReads == nReads);
+    }
+    else
+    {
+        Log::Error("Unable to create subscription for benchmark");
+    }
+
+    m_pSubscriptionService->DeleteSubscription(uSubscriptionId);
+
+    return(bRet);
+}
+
+/// @brief				read the variables directly with the data access service
+/// @param zVariables	names of the GDS variables
+/// @param nReads		number of reads
+/// @param zResult		reference to the result
+/// @return				true: success, false: failure
+bool CSubscriptionBenchmark::BenchmarkDirectRead(const vector<string>& zVariables, size_t nReads, SUBSCRIPTIONBENCHMARKRESULT& zResult)
+{
+    // there is nothing to create for direct reads, every read transfers the names again
+    IDataAccessService::ReadPortNamesDelegate portNamesDelegate =
+        IDataAccessService::ReadPortNamesDelegate::create([&](IRscWriteEnumerator<RscString<512>>& portNames)
+    {
+        portNames.BeginWrite(zVariables.size());
+        for(const string& strVariable : zVariables)
+        {
+            portNames.WriteNext(RscString<512>(strVariable.c_str()));
+        }
+        portNames.EndWrite();
+    });
+
+    size_t nValid = 0;
+    size_t nReturned = 0;
+    COHERENCEREAD zPair;
+    ReadItem current;
+    IDataAccessService::ReadReturnValueDelegate returnValueDelegate =
+        IDataAccessService::ReadReturnValueDelegate::create([&](IRscReadEnumerator<ReadItem>& readEnumerator)
+    {
+        nReturned = readEnumerator.BeginRead();
+        for (size_t i = 0; i < nReturned; i++)
+        {
+            readEnumerator.ReadNext(current);
+            if(current.Error == DataAccessError::None)
+            {
+                nValid++;
+                ReadCoherence(i, zVariables.size(), current.Value, zPair);
+            }
+        }
+        readEnumerator.EndRead();
+    });
+
+    uint64 uCpuStart = GetThreadCpuTimeUs();
+    uint64 uWallStart = GetMonotonicTimeNs();
+    for(size_t nCount = 0; nCount < nReads; nCount++)
+    {
+        nValid = 0;
+        nReturned = 0;
+        zPair = COHERENCEREAD();
+        uint64 uReadStart = GetMonotonicTimeNs();
+        m_pDataAccessService->Read(portNamesDelegate, returnValueDelegate);
+        if(nReturned == zVariables.size())
+        {
+            AddReadLatency((GetMonotonicTimeNs() - uReadStart) / 1000, zResult);
+            if(nValid == zVariables.size())
+            {
+                zResult.uCompleteReads++;
+            }
+            CheckCoherence(zPair, zResult);
+        }
+    }
+    zResult.uWallTimeUs = (GetMonotonicTimeNs() - uWallStart) / 1000;
+    zResult.uCpuTimeUs = GetThreadCpuTimeUs() - uCpuStart;
+
+    return(zResult.uReads == nReads);
+}
+
+/// @brief	check if the program has the coherence pair with integer values
+/// @return	true: the pair is read by every method, false: no pair set or not found
+bool CSubscriptionBenchmark::FindCoherencePair()
+{
+    if(m_strCounter.empty() || m_strMirror.empty())
+    {
+        return(false);
+    }
+
+    int64 iValue = 0;
+    ReadItem zCounter = m_pDataAccessService->ReadSingle(RscString<512>(m_strCounter.c_str()));
+    ReadItem zMirror = m_pDataAccessService->ReadSingle(RscString<512>(m_strMirror.c_str()));
+    if((zCounter.Error != DataAccessError::None) || (GetInteger(zCounter.Value, iValue) == false) ||
+       (zMirror.Error != DataAccessError::None) || (GetInteger(zMirror.Value, iValue) == false))
+    {
+        Log::Info("Subscription benchmark: no integer variables {0} and {1}, the coherence is not checked", m_strCounter, m_strMirror);
+        return(false);
+    }
+
+    return(true);
+}
+
+/// @brief				take the value of the coherence pair out of a read, the pair is at the end of the variables
+/// @param nIndex		index of the value
+/// @param nVariables	number of read variables
+/// @param zValue		valid value
+/// @param zRead		reference to the values of the pair in this read
+void CSubscriptionBenchmark::ReadCoherence(size_t nIndex, size_t nVariables, const RscVariant<512>& zValue, COHERENCEREAD& zRead)
+{
+    if(m_bCoherence && (nIndex + 2 == nVariables))
+    {
+        zRead.bCounter = GetInteger(zValue, zRead.iCounter);
+    }
+    else if(m_bCoherence && (nIndex + 1 == nVariables))
+    {
+        zRead.bMirror = GetInteger(zValue, zRead.iMirror);
+    }
+}
+
+/// @brief				count a read of the coherence pair
+/// @param zRead		values of the pair in this read
+/// @param zResult		reference to the result
+void CSubscriptionBenchmark::CheckCoherence(const COHERENCEREAD& zRead, SUBSCRIPTIONBENCHMARKRESULT& zResult)
+{
+    if(m_bCoherence && zRead.bCounter && zRead.bMirror)
+    {
+        zResult.uCoherenceChecks++;
+        if(zRead.iCounter != zRead.iMirror)
+        {
+            zResult.uTornReads++;
+        }
+    }
+}
+
+/// @brief				add the latency of one successful read to the result
+/// @param uLatencyUs	latency in us
+/// @param zResult		reference to the result
+void CSubscriptionBenchmark::AddReadLatency(uint64 uLatencyUs, SUBSCRIPTIONBENCHMARKRESULT& zResult)
+{
+    if((zResult.uReads == 0) || (uLatencyUs < zResult.uReadMinUs))
+    {
+        zResult.uReadMinUs = uLatencyUs;
+    }
+    if(uLatencyUs > zResult.uReadMaxUs)
+    {
+        zResult.uReadMaxUs = uLatencyUs;
+    }
+    zResult.uReadSumUs += uLatencyUs;
+    zResult.uReads++;
+}
+
+/// @brief				log the result of one method as a single line, so the results
+/// 					of all methods can be compared in the log-file
+/// @param strGroup		name of variable set
+/// @param nVariables	number of variables
+/// @param zResult		reference to the result
+void CSubscriptionBenchmark::LogResult(const string& strGroup, size_t nVariables, const SUBSCRIPTIONBENCHMARKRESULT& zResult)
+{
+    if(zResult.uReads == 0)
+    {
+        Log::Error("Subscription benchmark {0}/{1}: no successful read", strGroup, zResult.strMethod);
+        return;
+    }
+
+    uint64 uReadAvgUs = zResult.uReadSumUs / zResult.uReads;
+    double dCpuPercent = (zResult.uWallTimeUs > 0) ? (100.0 * zResult.uCpuTimeUs / zResult.uWallTimeUs) : 0.0;
+    double dCpuPerReadUs = (double)zResult.uCpuTimeUs / zResult.uReads;
+    double dCompletePercent = 100.0 * zResult.uCompleteReads / zResult.uReads;
+
+    // reads with a valid value for the counter and the mirror, of which this many were torn
+    string strCoherence = "not checked";
+    if(zResult.uCoherenceChecks > 0)
+    {
+        strCoherence = to_string(zResult.uTornReads) + " torn of " + to_string(zResult.uCoherenceChecks);
+    }
+
+    Log::Info("Subscription benchmark {0}/{1}: variables={2} create={3}us read min/avg/max={4}/{5}/{6}us cpu={7:.1f}% ({8:.1f}us/read) complete={9:.1f}% coherence={10}{11}",
+              strGroup, zResult.strMethod, nVariables, zResult.uCreateTimeUs,
+              zResult.uReadMinUs, uReadAvgUs, zResult.uReadMaxUs,
+              dCpuPercent, dCpuPerReadUs, dCompletePercent, strCoherence,
+              zResult.bSuccess ? "" : " (incomplete)");
+}
+
+/// @brief			value of an integer variable
+/// @param zValue	value
+/// @param iValue	reference to the value
+/// @return			true: success, false: not an integer
+bool CSubscriptionBenchmark::GetInteger(const RscVariant<512>& zValue, int64& iValue)
+{
+    bool bRet = true;
+
+    switch(zValue.GetType())
+    {
+        case RscType::Int8:		{ int8 i = 0; zValue.CopyTo(i); iValue = i; break; }
+        case RscType::Uint8:	{ uint8 u = 0; zValue.CopyTo(u); iValue = u; break; }
+        case RscType::Int16:	{ int16 i = 0; zValue.CopyTo(i); iValue = i; break; }
+        case RscType::Uint16:	{ uint16 u = 0; zValue.CopyTo(u); iValue = u; break; }
+        case RscType::Int32:	{ int32 i = 0; zValue.CopyTo(i); iValue = i; break; }
+        case RscType::Uint32:	{ uint32 u = 0; zValue.CopyTo(u); iValue = u; break; }
+        case RscType::Int64:	{ zValue.CopyTo(iValue); break; }
+        case RscType::Uint64:	{ uint64 u = 0; zValue.CopyTo(u); iValue = (int64)u; break; }
+        default:				bRet = false; break;
+    }
+
+    return(bRet);
+}
+
+/// @brief	CPU time which was used by the calling thread
+/// @return	time in us
+uint64 CSubscriptionBenchmark::GetThreadCpuTimeUs()
+{
+    timespec zTime;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &zTime);
+    return((uint64)zTime.tv_sec * 1000000 + (uint64)zTime.tv_nsec / 1000);
+}
@@ -0,0 +1,84 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CSubscriptionBenchmark.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef CSUBSCRIPTIONBENCHMARK_H_
+#define CSUBSCRIPTIONBENCHMARK_H_
+
+#include <vector>
+#include <string>
+#include "Arp/Plc/Gds/Services/ISubscriptionService.hpp"
+#include "Arp/Plc/Gds/Services/IDataAccessService.hpp"
+#include "Arp/System/Commons/Logging.h"
+#include "Utility.h"
+
+using namespace std;
+using namespace Arp;
+using namespace Arp::Plc::Gds::Services;
+
+///	structure to handle the measured values of one read method
+struct SUBSCRIPTIONBENCHMARKRESULT
+{
+    string strMethod;				// subscription kind or direct read
+    bool bSuccess = false;			// could the method be used at all?
+
+    uint64 uCreateTimeUs = 0;		// time to create and subscribe in us
+    uint64 uReads = 0;				// number of successful reads
+    uint64 uReadMinUs = 0;			// read latency in us
+    uint64 uReadMaxUs = 0;
+    uint64 uReadSumUs = 0;
+    uint64 uCpuTimeUs = 0;			// CPU time of the calling thread for all reads in us
+    uint64 uWallTimeUs = 0;			// elapsed time for all reads in us
+    uint64 uCompleteReads = 0;		// reads with a valid value for every variable
+    uint64 uCoherenceChecks = 0;	// reads with a valid value for both variables of the coherence pair
+    uint64 uTornReads = 0;			// reads where the counter and its mirror differed
+};
+
+class CSubscriptionBenchmark
+{
+public:
+    CSubscriptionBenchmark(ISubscriptionService::Ptr pSubscriptionService, IDataAccessService::Ptr pDataAccessService);
+    virtual ~CSubscriptionBenchmark();
+
+    void SetCoherencePair(const string& strCounter, const string& strMirror);
+    bool Run(const string& strGroup, const vector<string>& zVariables, uint64 uSampleRate, size_t nReads);
+
+private:
+    ISubscriptionService::Ptr m_pSubscriptionService;
+    IDataAccessService::Ptr m_pDataAccessService;
+
+    // integer counter and its mirror, which the program writes in the same task cycle
+    string m_strCounter;
+    string m_strMirror;
+    bool m_bCoherence;		// the pair is appended to the variables of the current run
+
+    ///	structure with the values of the coherence pair of one read
+    struct COHERENCEREAD
+    {
+        bool bCounter = false;		// the counter was read with a valid integer value
+        int64 iCounter = 0;
+        bool bMirror = false;		// the mirror was read with a valid integer value
+        int64 iMirror = 0;
+    };
+
+    bool BenchmarkSubscription(SubscriptionKind zKind, const vector<string>& zVariables, uint64 uSampleRate, size_t nReads, SUBSCRIPTIONBENCHMARKRESULT& zResult);
+    bool BenchmarkDirectRead(const vector<string>& zVariables, size_t nReads, SUBSCRIPTIONBENCHMARKRESULT& zResult);
+    bool FindCoherencePair();
+    void ReadCoherence(size_t nIndex, size_t nVariables, const RscVariant<512>& zValue, COHERENCEREAD& zRead);
+    void CheckCoherence(const COHERENCEREAD& zRead, SUBSCRIPTIONBENCHMARKRESULT& zResult);
+    void AddReadLatency(uint64 uLatencyUs, SUBSCRIPTIONBENCHMARKRESULT& zResult);
+    void LogResult(const string& strGroup, size_t nVariables, const SUBSCRIPTIONBENCHMARKRESULT& zResult);
+
+    static bool GetInteger(const RscVariant<512>& zValue, int64& iValue);
+    static uint64 GetThreadCpuTimeUs();
+};
+
+#endif /* CSUBSCRIPTIONBENCHMARK_H_ */
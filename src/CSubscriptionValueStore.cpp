@@ -0,0 +1,305 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CSubscriptionValueStore.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#include "CSubscriptionValueStore.h"
+
+#define STRINGARENA_RESERVE 64		// initial reserve per string variable in bytes
+
+CSubscriptionValueStore::CSubscriptionValueStore()
+                       : m_nReceived(0)
+{
+}
+
+CSubscriptionValueStore::~CSubscriptionValueStore()
+{
+}
+
+/// @brief			create the columns for the variables of a subscription
+/// @param zInfos	information about the order / layout of the subscription values
+/// @return			true: success, false: failure
+bool CSubscriptionValueStore::Init(const vector<VariableInfo>& zInfos)
+{
+    Clear();
+
+    size_t nBools = 0;
+    size_t n8 = 0;
+    size_t n16 = 0;
+    size_t n32 = 0;
+    size_t n64 = 0;
+    size_t nReal32 = 0;
+    size_t nReal64 = 0;
+    size_t nStrings = 0;
+
+    m_zSlots.resize(zInfos.size());
+
+    for(size_t nCount = 0; nCount < zInfos.size(); nCount++)
+    {
+        SLOT& zSlot = m_zSlots[nCount];
+        zSlot.zType = zInfos[nCount].Type;
+
+        switch(zSlot.zType)
+        {
+            case RscType::Bool:			zSlot.uColumnIndex = nBools++; break;
+            case RscType::Int8:
+            case RscType::Uint8:
+            case RscType::Char:			zSlot.uColumnIndex = n8++; break;
+            case RscType::Int16:
+            case RscType::Uint16:		zSlot.uColumnIndex = n16++; break;
+            case RscType::Int32:
+            case RscType::Uint32:		zSlot.uColumnIndex = n32++; break;
+            case RscType::Int64:
+            case RscType::Uint64:		zSlot.uColumnIndex = n64++; break;
+            case RscType::Real32:		zSlot.uColumnIndex = nReal32++; break;
+            case RscType::Real64:		zSlot.uColumnIndex = nReal64++; break;
+            case RscType::String:
+            case RscType::Utf8String:	zSlot.uColumnIndex = nStrings++; break;
+            default:
+                // e.g. structures and arrays are not supported by this store, the
+                // variable is kept in the layout but it will never be valid
+                Log::Info("Unsupported type {0} of subscribed variable {1}", (int)zSlot.zType, zInfos[nCount].Name);
+                zSlot.uColumnIndex = 0;
+                break;
+        }
+    }
+
+    m_zValid.resize((zInfos.size() + 63) / 64, 0);
+    m_zBools.resize((nBools + 63) / 64, 0);
+    m_zColumn8.resize(n8, 0);
+    m_zColumn16.resize(n16, 0);
+    m_zColumn32.resize(n32, 0);
+    m_zColumn64.resize(n64, 0);
+    m_zReal32.resize(nReal32, 0);
+    m_zReal64.resize(nReal64, 0);
+    m_zStrings.resize(nStrings);
+    m_zStringArena.reserve(nStrings * STRINGARENA_RESERVE);
+
+    return(true);
+}
+
+/// @brief	remove all variables and free the memory
+void CSubscriptionValueStore::Clear()
+{
+    vector<SLOT>().swap(m_zSlots);
+    vector<uint64>().swap(m_zValid);
+    vector<uint64>().swap(m_zBools);
+    vector<uint8>().swap(m_zColumn8);
+    vector<uint16>().swap(m_zColumn16);
+    vector<uint32>().swap(m_zColumn32);
+    vector<uint64>().swap(m_zColumn64);
+    vector<float32>().swap(m_zReal32);
+    vector<float64>().swap(m_zReal64);
+    vector<STRINGREF>().swap(m_zStrings);
+    vector<char>().swap(m_zStringArena);
+    m_nReceived = 0;
+}
+
+/// @brief	start a new read of the subscription, all values become invalid until they are stored
+void CSubscriptionValueStore::BeginUpdate()
+{
+    fill(m_zValid.begin(), m_zValid.end(), 0);
+    m_nReceived = 0;
+
+    // the capacity is kept, so the arena only allocates if the strings get longer
+    m_zStringArena.clear();
+}
+
+/// @brief			store a value which was read from the subscription. Every call is counted, also
+/// 				for a value which is not stored, so a read with too many values is detected
+/// @param nIndex	index of variable in the subscription
+/// @param zValue	value read from the subscription
+/// @return			true: stored, false: value is not available, its index is out of range or its type does not match
+bool CSubscriptionValueStore::Store(size_t nIndex, const RscVariant<512>& zValue)
+{
+    m_nReceived++;
+
+    if(nIndex >= m_zSlots.size())
+    {
+        return(false);
+    }
+
+    const SLOT& zSlot = m_zSlots[nIndex];
+    if(zValue.GetType() != zSlot.zType)
+    {
+        // RscType::Void, if the value is not available yet
+        return(false);
+    }
+
+    switch(zSlot.zType)
+    {
+        case RscType::Bool:
+        {
+            bool bValue = false;
+            zValue.CopyTo(bValue);
+            SetBit(m_zBools, zSlot.uColumnIndex, bValue);
+            break;
+        }
+        case RscType::Int8:
+        {
+            int8 i8Value = 0;
+            zValue.CopyTo(i8Value);
+            m_zColumn8[zSlot.uColumnIndex] = (uint8)i8Value;
+            break;
+        }
+        case RscType::Uint8:
+        {
+            zValue.CopyTo(m_zColumn8[zSlot.uColumnIndex]);
+            break;
+        }
+        case RscType::Char:
+        {
+            char cValue = 0;
+            zValue.CopyTo(cValue);
+            m_zColumn8[zSlot.uColumnIndex] = (uint8)cValue;
+            break;
+        }
+        case RscType::Int16:
+        {
+            int16 i16Value = 0;
+            zValue.CopyTo(i16Value);
+            m_zColumn16[zSlot.uColumnIndex] = (uint16)i16Value;
+            break;
+        }
+        case RscType::Uint16:
+        {
+            zValue.CopyTo(m_zColumn16[zSlot.uColumnIndex]);
+            break;
+        }
+        case RscType::Int32:
+        {
+            int32 i32Value = 0;
+            zValue.CopyTo(i32Value);
+            m_zColumn32[zSlot.uColumnIndex] = (uint32)i32Value;
+            break;
+        }
+        case RscType::Uint32:
+        {
+            zValue.CopyTo(m_zColumn32[zSlot.uColumnIndex]);
+            break;
+        }
+        case RscType::Int64:
+        {
+            int64 i64Value = 0;
+            zValue.CopyTo(i64Value);
+            m_zColumn64[zSlot.uColumnIndex] = (uint64)i64Value;
+            break;
+        }
+        case RscType::Uint64:
+        {
+            zValue.CopyTo(m_zColumn64[zSlot.uColumnIndex]);
+            break;
+        }
+        case RscType::Real32:
+        {
+            zValue.CopyTo(m_zReal32[zSlot.uColumnIndex]);
+            break;
+        }
+        case RscType::Real64:
+        {
+            zValue.CopyTo(m_zReal64[zSlot.uColumnIndex]);
+            break;
+        }
+        case RscType::String:
+        case RscType::Utf8String:
+        {
+            const char* szValue = zValue.GetChars();
+            size_t nLength = (szValue != NULL) ? strlen(szValue) : 0;
+
+            STRINGREF& zString = m_zStrings[zSlot.uColumnIndex];
+            zString.uOffset = m_zStringArena.size();
+            zString.uLength = nLength;
+            m_zStringArena.insert(m_zStringArena.end(), szValue, szValue + nLength);
+            m_zStringArena.push_back('\0');
+            break;
+        }
+        default:
+            return(false);
+    }
+
+    SetBit(m_zValid, nIndex, true);
+    return(true);
+}
+
+/// @brief	number of variables
+/// @return	number of variables
+size_t CSubscriptionValueStore::GetCount() const
+{
+    return(m_zSlots.size());
+}
+
+/// @brief	number of values received since BeginUpdate, including the values which were not stored
+/// @return	number of values
+size_t CSubscriptionValueStore::GetReceivedCount() const
+{
+    return(m_nReceived);
+}
+
+/// @brief			type of a variable
+/// @param nIndex	index of variable in the subscription
+/// @return			type
+RscType CSubscriptionValueStore::GetType(size_t nIndex) const
+{
+    return((nIndex < m_zSlots.size()) ? m_zSlots[nIndex].zType : RscType::Void);
+}
+
+/// @brief			was a value stored for the variable in the last read?
+/// @param nIndex	index of variable in the subscription
+/// @return			true: valid, false: not available
+bool CSubscriptionValueStore::IsValid(size_t nIndex) const
+{
+    return((nIndex < m_zSlots.size()) && GetBit(m_zValid, nIndex));
+}
+
+/// @brief			value of a bool variable
+/// @param nIndex	index of variable in the subscription
+/// @param bValue	reference to value
+/// @return			true: success, false: no valid bool value
+bool CSubscriptionValueStore::GetValue(size_t nIndex, bool& bValue) const
+{
+    if((IsValid(nIndex) == false) || (m_zSlots[nIndex].zType != RscType::Bool))
+    {
+        return(false);
+    }
+
+    bValue = GetBit(m_zBools, m_zSlots[nIndex].uColumnIndex);
+    return(true);
+}
+
+/// @brief			value of a string variable, only valid until the next read
+/// @param nIndex	index of variable in the subscription
+/// @return			zero terminated string, NULL if there is no valid string value
+const char* CSubscriptionValueStore::GetString(size_t nIndex) const
+{
+    if((IsValid(nIndex) == false) ||
+       ((m_zSlots[nIndex].zType != RscType::String) && (m_zSlots[nIndex].zType != RscType::Utf8String)))
+    {
+        return(NULL);
+    }
+
+    return(&m_zStringArena[m_zStrings[m_zSlots[nIndex].uColumnIndex].uOffset]);
+}
+
+/// @brief	memory which is used by the columns
+/// @return	size in bytes
+size_t CSubscriptionValueStore::GetMemoryUsage() const
+{
+    return(m_zSlots.capacity() * sizeof(SLOT) +
+           m_zValid.capacity() * sizeof(uint64) +
+           m_zBools.capacity() * sizeof(uint64) +
+           m_zColumn8.capacity() * sizeof(uint8) +
+           m_zColumn16.capacity() * sizeof(uint16) +
+           m_zColumn32.capacity() * sizeof(uint32) +
+           m_zColumn64.capacity() * sizeof(uint64) +
+           m_zReal32.capacity() * sizeof(float32) +
+           m_zReal64.capacity() * sizeof(float64) +
+           m_zStrings.capacity() * sizeof(STRINGREF) +
+           m_zStringArena.capacity());
+}
@@ -0,0 +1,132 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CSubscriptionValueStore.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef CSUBSCRIPTIONVALUESTORE_H_
+#define CSUBSCRIPTIONVALUESTORE_H_
+
+#include <vector>
+#include <string.h>
+#include "Arp/Plc/Gds/Services/ISubscriptionService.hpp"
+#include "Arp/System/Commons/Logging.h"
+
+using namespace std;
+using namespace Arp;
+using namespace Arp::Plc::Gds::Services;
+
+/// @brief	compact storage for the values of one subscription. Instead of one RscVariant<512>
+/// 		per variable, the values are stored in columns of their own size: a bit array for
+/// 		bools, native arrays for numbers and one arena for all strings. The columns are
+/// 		sized once from the VariableInfo of the subscription, so reading the subscription
+/// 		does not allocate any memory (except for growing strings).
+class CSubscriptionValueStore
+{
+public:
+    CSubscriptionValueStore();
+    virtual ~CSubscriptionValueStore();
+
+    bool Init(const vector<VariableInfo>& zInfos);
+    void Clear();
+
+    // called for every read of the subscription
+    void BeginUpdate();
+    bool Store(size_t nIndex, const RscVariant<512>& zValue);
+
+    size_t GetCount() const;
+    size_t GetReceivedCount() const;
+    RscType GetType(size_t nIndex) const;
+    bool IsValid(size_t nIndex) const;
+    bool GetValue(size_t nIndex, bool& bValue) const;
+    const char* GetString(size_t nIndex) const;
+    size_t GetMemoryUsage() const;
+
+    /// @brief			value of a numeric variable, converted to the requested type
+    /// @param nIndex	index of variable in the subscription
+    /// @param value	reference to value
+    /// @return			true: success, false: no valid numeric value
+    template<typename T>
+    bool GetValue(size_t nIndex, T& value) const
+    {
+        if(IsValid(nIndex) == false)
+        {
+            return(false);
+        }
+
+        const SLOT& zSlot = m_zSlots[nIndex];
+        switch(zSlot.zType)
+        {
+            case RscType::Bool:		value = (T)GetBit(m_zBools, zSlot.uColumnIndex); break;
+            case RscType::Int8:		value = (T)(int8)m_zColumn8[zSlot.uColumnIndex]; break;
+            case RscType::Uint8:	value = (T)m_zColumn8[zSlot.uColumnIndex]; break;
+            case RscType::Char:		value = (T)m_zColumn8[zSlot.uColumnIndex]; break;
+            case RscType::Int16:	value = (T)(int16)m_zColumn16[zSlot.uColumnIndex]; break;
+            case RscType::Uint16:	value = (T)m_zColumn16[zSlot.uColumnIndex]; break;
+            case RscType::Int32:	value = (T)(int32)m_zColumn32[zSlot.uColumnIndex]; break;
+            case RscType::Uint32:	value = (T)m_zColumn32[zSlot.uColumnIndex]; break;
+            case RscType::Int64:	value = (T)(int64)m_zColumn64[zSlot.uColumnIndex]; break;
+            case RscType::Uint64:	value = (T)m_zColumn64[zSlot.uColumnIndex]; break;
+            case RscType::Real32:	value = (T)m_zReal32[zSlot.uColumnIndex]; break;
+            case RscType::Real64:	value = (T)m_zReal64[zSlot.uColumnIndex]; break;
+            default:				return(false);
+        }
+        return(true);
+    }
+
+private:
+    ///	structure to find the value of a variable in its column
+    struct SLOT
+    {
+        RscType zType;			// type of variable from VariableInfo
+        uint32 uColumnIndex;	// index in the column of this type
+    };
+
+    ///	structure to find a string in the arena
+    struct STRINGREF
+    {
+        uint32 uOffset;			// offset of first character in arena
+        uint32 uLength;			// length without terminating zero
+    };
+
+    vector<SLOT> m_zSlots;			// one per variable, same order as the subscription
+    vector<uint64> m_zValid;		// bit array, one bit per variable
+
+    // columns
+    vector<uint64> m_zBools;		// bit array
+    vector<uint8> m_zColumn8;		// Int8, Uint8, Char
+    vector<uint16> m_zColumn16;		// Int16, Uint16
+    vector<uint32> m_zColumn32;		// Int32, Uint32
+    vector<uint64> m_zColumn64;		// Int64, Uint64
+    vector<float32> m_zReal32;
+    vector<float64> m_zReal64;
+    vector<STRINGREF> m_zStrings;	// String, Utf8String
+    vector<char> m_zStringArena;	// zero terminated strings of the last read
+    size_t m_nReceived;				// values of the last read, compared with the number of variables
+
+    static void SetBit(vector<uint64>& zBits, size_t nIndex, bool bValue)
+    {
+        uint64 uMask = (uint64)1 << (nIndex & 63);
+        if(bValue)
+        {
+            zBits[nIndex >> 6] |= uMask;
+        }
+        else
+        {
+            zBits[nIndex >> 6] &= ~uMask;
+        }
+    }
+
+    static bool GetBit(const vector<uint64>& zBits, size_t nIndex)
+    {
+        return((zBits[nIndex >> 6] & ((uint64)1 << (nIndex & 63))) != 0);
+    }
+};
+
+#endif /* CSUBSCRIPTIONVALUESTORE_H_ */
@@ -0,0 +1,87 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  CTripleBuffer.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef CTRIPLEBUFFER_H_
+#define CTRIPLEBUFFER_H_
+
+#include <atomic>
+#include <stdint.h>
+
+/// @brief	wait-free mailbox for exactly one writer and one reader thread, e.g. to hand
+/// 		data between the realtime thread and a non-realtime thread without any lock.
+/// 		The writer always has a buffer of its own, the reader always gets the newest
+/// 		complete data and neither of them ever waits for the other one.
+/// 		The write buffer is not a copy of the last published data, so the writer has
+/// 		to fill all members before every Publish().
+template<typename T>
+class CTripleBuffer
+{
+public:
+    CTripleBuffer()
+        : m_uShared(1),
+          m_uWrite(0),
+          m_uRead(2)
+    {
+    }
+
+    /// @brief	buffer of the writer, only valid until the next Publish()
+    /// @return	reference to write buffer
+    T& GetWriteBuffer()
+    {
+        return(m_zBuffers[m_uWrite].zData);
+    }
+
+    /// @brief	hand the write buffer over to the reader and get the free buffer for the next write
+    void Publish()
+    {
+        uint8_t uOld = m_uShared.exchange(m_uWrite | NEWDATA, std::memory_order_acq_rel);
+        m_uWrite = uOld & INDEXMASK;
+    }
+
+    /// @brief	switch the read buffer to the newest published data, if there is any
+    /// @return	true: new data available, false: read buffer is unchanged
+    bool Update()
+    {
+        if((m_uShared.load(std::memory_order_relaxed) & NEWDATA) == 0)
+        {
+            return(false);
+        }
+
+        uint8_t uOld = m_uShared.exchange(m_uRead, std::memory_order_acq_rel);
+        m_uRead = uOld & INDEXMASK;
+        return(true);
+    }
+
+    /// @brief	buffer of the reader, only valid until the next Update()
+    /// @return	reference to read buffer
+    const T& GetReadBuffer() const
+    {
+        return(m_zBuffers[m_uRead].zData);
+    }
+
+private:
+    static const uint8_t INDEXMASK = 0x03;
+    static const uint8_t NEWDATA = 0x04;
+
+    // each buffer in its own cache line, so writer and reader do not disturb each other
+    struct alignas(64) BUFFER
+    {
+        T zData;
+    };
+    BUFFER m_zBuffers[3];
+
+    std::atomic<uint8_t> m_uShared;	// index of the buffer in between plus flag for new data
+    uint8_t m_uWrite;				// index of buffer, only used by the writer
+    uint8_t m_uRead;				// index of buffer, only used by the reader
+};
+
+#endif /* CTRIPLEBUFFER_H_ */
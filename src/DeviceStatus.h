@@ -0,0 +1,62 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  DeviceStatus.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef DEVICESTATUS_H_
+#define DEVICESTATUS_H_
+
+#include <atomic>
+#include <stdint.h>
+
+// The status of the device is sampled by CDeviceStatusSampler and read by any thread
+// without a lock. Only plain data is allowed in this structure, no RSC types, so it can
+// be used by the realtime thread as well.
+
+///	throttle level for non-realtime work, depending on CPU load and board temperature
+enum THROTTLELEVEL
+{
+    THROTTLE_NONE = 0,		// normal operation
+    THROTTLE_REDUCED,		// a threshold is exceeded, reduce housekeeping
+    THROTTLE_MINIMAL		// a critical threshold is exceeded, do only what is necessary
+};
+
+///	structure with the last sampled status of the device, every value is read and written atomically
+struct DEVICESTATUS
+{
+    std::atomic<uint8_t> uCpuLoad{0};				// load of CPU in percent
+    std::atomic<uint8_t> uMemoryUsage{0};			// memory usage in percent
+    std::atomic<int8_t> i8BoardTemp{0};				// board temperature in degrees centigrade
+    std::atomic<uint32_t> uSamples{0};				// number of samples, 0 if not sampled yet
+    std::atomic<uint32_t> uThrottleLevel{THROTTLE_NONE};
+
+    /// @brief	current throttle level
+    /// @return	throttle level
+    THROTTLELEVEL GetThrottleLevel() const
+    {
+        return((THROTTLELEVEL)uThrottleLevel.load(std::memory_order_relaxed));
+    }
+
+    /// @brief				divider for the rate of non-realtime work, e.g. do the work only in every n-th cycle
+    /// @param uReduced		divider for THROTTLE_REDUCED
+    /// @param uMinimal		divider for THROTTLE_MINIMAL
+    /// @return				divider, 1 if there is no throttling
+    uint32_t GetThrottleDivider(uint32_t uReduced, uint32_t uMinimal) const
+    {
+        switch(GetThrottleLevel())
+        {
+            case THROTTLE_REDUCED:	return(uReduced);
+            case THROTTLE_MINIMAL:	return(uMinimal);
+            default:				return(1);
+        }
+    }
+};
+
+#endif /* DEVICESTATUS_H_ */
@@ -0,0 +1,77 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  FrameRecordFormat.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef FRAMERECORDFORMAT_H_
+#define FRAMERECORDFORMAT_H_
+
+#include <stdint.h>
+#include "ProcessImageFormat.h"
+
+// Layout of the ring file with the recorded frames, written by CFrameRecorder and read by
+// the replay in tools/FrameReplay. This header is used on the host as well, so it must not
+// depend on the PLCnext SDK. All values are stored in the byte order of the controller.
+//
+// The file starts with a FRAMERECORDHEADER, followed by the layout descriptor (one
+// PROCESSIMAGEENTRY per I/O, uOffset is the offset of the value in a record) and a ring of
+// uCapacity records of uRecordSize bytes. Every record starts with a FRAMERECORD, followed
+// by the recorded part of the input, output and diag frame and the setpoints of the IEC
+// program which the logic used in the cycle. Like in the process image, the recorded part of
+// a frame is the part which contains the I/Os of the area.
+//
+// The ring holds the newest min(uRecords, uCapacity) records, the oldest one is at index
+// uRecords % uCapacity once the ring is full. Records which could not be written in time are
+// counted in uDropped, the next record has the FRAMERECORD_GAP flag.
+
+#define FRAMERECORD_MAGIC		0x43455246		// "FREC"
+#define FRAMERECORD_VERSION		1
+
+// flags of a record, the area flags are set if the area was read from or written to the frame
+#define FRAMERECORD_INPUTS		0x01
+#define FRAMERECORD_OUTPUTS		0x02
+#define FRAMERECORD_DIAG		0x04
+#define FRAMERECORD_VALID		0x08	// inputs and outputs of the cycle were valid
+#define FRAMERECORD_GAP			0x10	// records before this one were dropped
+
+///	structure at the start of the file
+struct FRAMERECORDHEADER
+{
+    uint32_t uMagic;			// FRAMERECORD_MAGIC
+    uint16_t uVersion;			// FRAMERECORD_VERSION
+    uint16_t uHeaderSize;		// sizeof(FRAMERECORDHEADER)
+    uint32_t uEntryOffset;		// offset of first PROCESSIMAGEENTRY in file
+    uint32_t uEntryCount;		// number of I/Os
+    uint32_t uRecordOffset;		// offset of first record in file
+    uint32_t uRecordSize;		// size of one record including the FRAMERECORD
+    uint32_t uCapacity;			// number of records in the ring
+    uint32_t uCycleTimeUs;		// cycle time of the realtime thread in us
+    uint32_t uFrameOffset[PROCESSIMAGE_AREAS];	// offset of the recorded part in the bus frame
+    uint32_t uReserved;
+    PROCESSIMAGEAREADESC zAreas[PROCESSIMAGE_AREAS];	// recorded part of the frames in a record
+    PROCESSIMAGEAREADESC zSetpoints;	// setpoints of the IEC program in a record
+    uint64_t uLayoutHash;		// hash of IDs, offsets and sizes, the replay checks it
+    uint64_t uRecords;			// number of records written since the file was created
+    uint64_t uDropped;			// number of cycles which were not recorded
+};
+
+///	structure at the start of every record
+struct FRAMERECORD
+{
+    uint64_t uCycle;			// number of the cycle since the file was created, starting at 0
+    uint64_t uTimeNs;			// CLOCK_MONOTONIC at the start of the I/O of the cycle
+    uint32_t uFlags;			// FRAMERECORD_xxx
+    uint32_t uReserved;
+};
+
+static_assert(sizeof(FRAMERECORDHEADER) == 104, "unexpected size of FRAMERECORDHEADER");
+static_assert(sizeof(FRAMERECORD) == 24, "unexpected size of FRAMERECORD");
+
+#endif /* FRAMERECORDFORMAT_H_ */
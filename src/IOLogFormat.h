@@ -0,0 +1,82 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  IOLogFormat.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef IOLOGFORMAT_H_
+#define IOLOGFORMAT_H_
+
+#include <stdint.h>
+
+// Compact binary format of the I/O log, written by CIOLogger and read by the offline
+// decoder in tools/IOLogDecoder. This header is used on the host as well, so it must
+// not depend on the PLCnext SDK. All values are stored in the byte order of the
+// controller (little endian).
+//
+// A file starts with an IOLOGFILEHEADER, followed by records. Every record starts with
+// an IOLOGRECORDHEADER:
+// - IOLOGRECORD_POINT:		defines the name of an I/O, payload is IOLOGPOINTDEF followed
+// 							by the name without terminating zero. The indexes of all I/Os
+// 							are defined again, whenever the I/O plans are compiled again
+// - IOLOGRECORD_VALUE:		value of an I/O, payload is IOLOGVALUE
+// - IOLOGRECORD_SUMMARY:	value of an I/O at the end of a summary interval, payload is
+// 							IOLOGVALUE, uCount is the number of changes in the interval
+
+#define IOLOG_MAGIC		0x474F4C49		// "ILOG"
+#define IOLOG_VERSION	1
+
+///	types of records
+enum IOLOGRECORDTYPE
+{
+    IOLOGRECORD_POINT = 1,
+    IOLOGRECORD_VALUE = 2,
+    IOLOGRECORD_SUMMARY = 3
+};
+
+///	structure at the start of a file
+struct IOLOGFILEHEADER
+{
+    uint32_t uMagic;			// IOLOG_MAGIC
+    uint16_t uVersion;			// IOLOG_VERSION
+    uint16_t uHeaderSize;		// sizeof(IOLOGFILEHEADER)
+    uint64_t uStartTimeNs;		// CLOCK_REALTIME at creation of the file in ns, the records contain offsets to it
+};
+
+///	structure at the start of every record
+struct IOLOGRECORDHEADER
+{
+    uint8_t uType;				// IOLOGRECORDTYPE
+    uint8_t uReserved;
+    uint16_t uLength;			// size of payload in bytes
+    uint32_t uIndex;			// index of I/O
+};
+
+///	payload of IOLOGRECORD_POINT, followed by the name
+struct IOLOGPOINTDEF
+{
+    uint8_t bIsBool;			// 1, if it is a boolean
+    uint8_t uSize;				// data size in bytes, max. 8 bytes are logged
+    uint16_t uReserved;
+};
+
+///	payload of IOLOGRECORD_VALUE and IOLOGRECORD_SUMMARY
+struct IOLOGVALUE
+{
+    uint32_t uTimeMs;			// time since uStartTimeNs of the file in ms
+    uint32_t uCount;			// VALUE: suppressed changes before this value, SUMMARY: changes in the interval
+    uint64_t uValue;			// value, booleans are 0 or 1
+};
+
+static_assert(sizeof(IOLOGFILEHEADER) == 16, "unexpected size of IOLOGFILEHEADER");
+static_assert(sizeof(IOLOGRECORDHEADER) == 8, "unexpected size of IOLOGRECORDHEADER");
+static_assert(sizeof(IOLOGPOINTDEF) == 4, "unexpected size of IOLOGPOINTDEF");
+static_assert(sizeof(IOLOGVALUE) == 16, "unexpected size of IOLOGVALUE");
+
+#endif /* IOLOGFORMAT_H_ */
@@ -26,6 +26,8 @@
 #include "Arp/System/ModuleLib/Module.h"
 
 #include "CSampleRuntime.h"
+#include "CStartupTimeline.h"
+#include "CEventLoop.h"
 
 using namespace std;
 
@@ -33,6 +35,9 @@ CSampleRuntime* g_pRT;
 
 int main(int argc, char** argv) {
 
+    // the startup report is written after the first productive RT cycle
+    g_zStartupTimeline.Mark(STARTUP_MAIN);
+
     // Ask plcnext for access to its services
     // Use syslog for logging until the PLCnext logger is ready
     openlog ("PLCnextSampleRuntime", LOG_CONS | LOG_PID | LOG_NDELAY, LOG_LOCAL1);
@@ -75,14 +80,21 @@ int main(int argc, char** argv) {
     }
     syslog (LOG_INFO, "Set Up Arp System Module");
     closelog();
+    g_zStartupTimeline.Mark(STARTUP_MODULESETUP);
+
+    // the timers and sockets of all non-realtime work are handled in the main thread,
+    // the event loop must exist before the init pipeline registers them
+    if (g_zEventLoop.Init() == false)
+    {
+        Log::Error("Could not create the event loop");
+        return -1;
+    }
 
     g_pRT = new CSampleRuntime();
+    g_zStartupTimeline.Mark(STARTUP_RUNTIME);
 
     // loop forever
-    for (;;)
-    {
-        WAIT1s;
-    }
+    g_zEventLoop.Run();
 
     return 0;
 }
@@ -0,0 +1,54 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  ProcessData.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef PROCESSDATA_H_
+#define PROCESSDATA_H_
+
+#include <stdint.h>
+#include "CTripleBuffer.h"
+
+// The realtime thread must not call any RSC service, so the values of the GDS variables
+// are handed over with wait-free mailboxes between the subscription cycle in
+// the event loop and the realtime logic. Only plain data is allowed in these structures, no RSC types.
+
+///	structure with values of the subscribed GDS variables for the realtime logic
+struct GDSSETPOINTS
+{
+    bool bValid = false;		// false, until the subscription delivered the values
+    bool bVarA = false;			// Arp.Plc.Eclr/MyProgramInst.VarA
+    bool bVarB = false;			// Arp.Plc.Eclr/MyProgramInst.VarB
+    bool bVarC = false;			// Arp.Plc.Eclr/MyProgramInst.VarC
+};
+
+///	structure with results of the realtime logic to be written to GDS variables
+struct RTRESULTS
+{
+    bool bValid = false;		// false, if the logic did not calculate the results
+    bool bVarA = false;			// Arp.Plc.Eclr/MyProgramInst.VarA
+};
+
+#define INPUTAGE_UNKNOWN	UINT64_MAX	// age of the inputs before the first fresh frame
+
+///	structure with the freshness of the inputs in the current cycle of the realtime logic
+struct INPUTFRESHNESS
+{
+    bool bFresh = false;			// the inputs were read from a valid frame in this cycle
+    bool bChanged = false;			// at least one input differs from the last fresh frame
+    uint64_t uStaleCycles = 0;		// cycles in a row without a fresh frame, 0 if fresh
+    uint64_t uAgeUs = INPUTAGE_UNKNOWN;	// time since the last fresh frame was read, 0 if fresh
+    uint64_t uFreshNs = 0;			// CLOCK_MONOTONIC when the last fresh frame was read, 0 if none
+};
+
+typedef CTripleBuffer<GDSSETPOINTS> CSetpointMailbox;	// subscription cycle -> realtime thread
+typedef CTripleBuffer<RTRESULTS> CResultMailbox;		// realtime thread -> subscription cycle
+
+#endif /* PROCESSDATA_H_ */
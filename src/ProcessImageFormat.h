@@ -0,0 +1,93 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  ProcessImageFormat.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef PROCESSIMAGEFORMAT_H_
+#define PROCESSIMAGEFORMAT_H_
+
+#include <atomic>
+#include <stdint.h>
+
+// Layout of the POSIX shared memory segment with the process image, written by
+// CProcessImagePublisher in the realtime thread and read by other processes on the
+// controller with CProcessImageReader. This header must not depend on the PLCnext SDK.
+//
+// The segment starts with a PROCESSIMAGEHEADER, followed by the layout descriptor (one
+// PROCESSIMAGEENTRY per I/O) and the data of the areas. The data of each area is a copy
+// of the part of the bus frame which contains the I/Os of this area, so the value of an
+// I/O is at the same position as in the frame.
+//
+// The data is protected by a seqlock: the sequence is odd while the realtime thread
+// writes the image of a cycle. A reader reads the sequence, reads the data and reads the
+// sequence again. The data is consistent, if both sequences are equal and even.
+//
+// If the layout changes, e.g. after a new PLCnext Engineer program was loaded, the old
+// segment is marked as stale (uMagic = 0) and a new segment with the same name is created.
+// Readers have to open the segment again in this case.
+
+#define PROCESSIMAGE_SHM_NAME	"/PLCnextSampleRuntime.ProcessImage"
+#define PROCESSIMAGE_MAGIC		0x474D4950		// "PIMG"
+#define PROCESSIMAGE_VERSION	2
+#define PROCESSIMAGE_IDLENGTH	64				// max. length of ID of I/O including terminating zero
+
+///	areas of the process image
+enum PROCESSIMAGEAREA
+{
+    PROCESSIMAGE_INPUTS = 0,
+    PROCESSIMAGE_OUTPUTS,
+    PROCESSIMAGE_DIAG,
+    PROCESSIMAGE_AREAS
+};
+
+///	structure to find the data of an area in the segment
+struct PROCESSIMAGEAREADESC
+{
+    uint32_t uOffset;			// offset of data in segment
+    uint32_t uSize;				// size of data in bytes
+};
+
+///	structure to describe one I/O of the process image
+struct PROCESSIMAGEENTRY
+{
+    char szID[PROCESSIMAGE_IDLENGTH];	// ID of I/O, zero terminated
+    uint32_t uOffset;			// offset of value in segment
+    uint16_t uSize;				// data size in bytes
+    uint8_t uBitMask;			// bitmask in case of a boolean value, 0 otherwise
+    uint8_t uArea;				// PROCESSIMAGEAREA
+};
+
+///	structure at the start of the segment
+struct PROCESSIMAGEHEADER
+{
+    // layout, constant for the lifetime of the segment
+    uint32_t uMagic;			// PROCESSIMAGE_MAGIC, 0 if the segment is stale
+    uint16_t uVersion;			// PROCESSIMAGE_VERSION
+    uint16_t uHeaderSize;		// sizeof(PROCESSIMAGEHEADER)
+    uint32_t uSegmentSize;		// size of segment in bytes
+    uint32_t uEntryOffset;		// offset of first PROCESSIMAGEENTRY in segment
+    uint32_t uEntryCount;		// number of I/Os
+    uint32_t uReserved;
+    PROCESSIMAGEAREADESC zAreas[PROCESSIMAGE_AREAS];
+
+    // state of the image, in its own cache line
+    alignas(64) std::atomic<uint64_t> uSequence;	// odd while the realtime thread writes
+    uint64_t uCycle;			// number of the cycle of the image
+    uint64_t uTimeNs;			// CLOCK_MONOTONIC after the image was written
+    uint32_t uValid;			// 1: inputs and outputs of the cycle were valid
+    uint32_t uInputFresh;		// 1: inputs were read from a fresh frame of the bus in this cycle
+    uint64_t uInputStaleCycles;	// cycles in a row without a fresh input frame
+    uint64_t uInputAgeUs;		// time since the last fresh input frame, UINT64_MAX before the first
+};
+
+static_assert(sizeof(PROCESSIMAGEENTRY) == 72, "unexpected size of PROCESSIMAGEENTRY");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "the seqlock must be lock-free to be shared between processes");
+
+#endif /* PROCESSIMAGEFORMAT_H_ */
@@ -0,0 +1,152 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  RuntimeMetrics.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef RUNTIMEMETRICS_H_
+#define RUNTIMEMETRICS_H_
+
+#include <atomic>
+#include <stdint.h>
+
+// Counters and histograms of the runtime, written in the hot paths and read by
+// CMetricsServer. Every histogram and counter has exactly one writing thread, so an update
+// is a relaxed load and store without any read-modify-write, lock or system call. This
+// makes them usable in the realtime thread. Only plain data is allowed here, no RSC types.
+
+#define METRIC_BUCKETS		24	// bucket n counts values below 2^(n+7) ns (128 ns to 1 s), the last bucket all others
+
+/// @brief	histogram with logarithmic buckets for durations in ns, one writing thread and any
+/// 		number of reading threads. Quantiles are estimated with the upper limit of the bucket
+class CMetricHistogram
+{
+public:
+    CMetricHistogram()
+    {
+        for(int nBucket = 0; nBucket < METRIC_BUCKETS; nBucket++)
+        {
+            m_uBuckets[nBucket].store(0, std::memory_order_relaxed);
+        }
+        m_uCount.store(0, std::memory_order_relaxed);
+        m_uSumNs.store(0, std::memory_order_relaxed);
+        m_uMaxNs.store(0, std::memory_order_relaxed);
+    }
+
+    /// @brief			record a value, must only be called by one thread
+    /// @param uValueNs	duration in ns
+    void Record(uint64_t uValueNs)
+    {
+        int nBucket = 0;
+        if((uValueNs >> 7) != 0)
+        {
+            nBucket = 64 - __builtin_clzll(uValueNs >> 7);
+            if(nBucket >= METRIC_BUCKETS)
+            {
+                nBucket = METRIC_BUCKETS - 1;
+            }
+        }
+
+        m_uBuckets[nBucket].store(m_uBuckets[nBucket].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        m_uSumNs.store(m_uSumNs.load(std::memory_order_relaxed) + uValueNs, std::memory_order_relaxed);
+        if(uValueNs > m_uMaxNs.load(std::memory_order_relaxed))
+        {
+            m_uMaxNs.store(uValueNs, std::memory_order_relaxed);
+        }
+        m_uCount.store(m_uCount.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    uint64_t GetCount() const	{ return(m_uCount.load(std::memory_order_acquire)); }
+    uint64_t GetSumNs() const	{ return(m_uSumNs.load(std::memory_order_relaxed)); }
+    uint64_t GetMaxNs() const	{ return(m_uMaxNs.load(std::memory_order_relaxed)); }
+
+    /// @brief			estimate a quantile
+    /// @param dQuantile	quantile between 0 and 1
+    /// @return			upper limit of the bucket of the quantile in ns, 0 if there are no values
+    uint64_t GetQuantileNs(double dQuantile) const
+    {
+        uint64_t uBuckets[METRIC_BUCKETS];
+        uint64_t uTotal = 0;
+        for(int nBucket = 0; nBucket < METRIC_BUCKETS; nBucket++)
+        {
+            uBuckets[nBucket] = m_uBuckets[nBucket].load(std::memory_order_relaxed);
+            uTotal += uBuckets[nBucket];
+        }
+        if(uTotal == 0)
+        {
+            return(0);
+        }
+
+        uint64_t uRank = (uint64_t)(dQuantile * uTotal + 0.5);
+        uint64_t uSum = 0;
+        for(int nBucket = 0; nBucket < METRIC_BUCKETS - 1; nBucket++)
+        {
+            uSum += uBuckets[nBucket];
+            if(uSum >= uRank)
+            {
+                // the maximum is a better estimate, if it is below the limit of the bucket
+                uint64_t uLimitNs = (uint64_t)1 << (nBucket + 7);
+                uint64_t uMaxNs = GetMaxNs();
+                return((uMaxNs < uLimitNs) ? uMaxNs : uLimitNs);
+            }
+        }
+        return(GetMaxNs());
+    }
+
+private:
+    std::atomic<uint64_t> m_uBuckets[METRIC_BUCKETS];
+    std::atomic<uint64_t> m_uCount;
+    std::atomic<uint64_t> m_uSumNs;
+    std::atomic<uint64_t> m_uMaxNs;
+};
+
+/// @brief			increment a counter which has only one writing thread
+/// @param uCounter	counter
+/// @param uValue	increment
+inline void IncrementMetric(std::atomic<uint64_t>& uCounter, uint64_t uValue = 1)
+{
+    uCounter.store(uCounter.load(std::memory_order_relaxed) + uValue, std::memory_order_relaxed);
+}
+
+///	structure with all metrics of the runtime, the comment names the writing thread
+struct RUNTIMEMETRICS
+{
+    // realtime thread
+    CMetricHistogram zRTCycleDuration;			// processing time of a cycle
+    CMetricHistogram zRTWakeupLatency;			// time from planned to actual start of a cycle
+    CMetricHistogram zGdsInLockHold;			// time between ArpPlcGds_BeginRead and EndRead of the inputs
+    CMetricHistogram zGdsOutLockHold;			// time between ArpPlcGds_BeginWrite and EndWrite of the outputs
+    CMetricHistogram zGdsDiagLockHold;			// time between ArpPlcGds_BeginRead and EndRead of the diag variables
+    CMetricHistogram zRTSpinTime;				// busy-polling before the start of a cycle, see CRTWakeup
+    std::atomic<uint64_t> uRTCycles{0};			// processed cycles
+    std::atomic<uint64_t> uRTOverruns{0};		// realtime violations
+    std::atomic<uint64_t> uRTWakeupGuardNs{0};	// current guard interval of CRTWakeup, 0 without RTWAKEUP_SPIN
+    std::atomic<uint64_t> uRTLateWakeups{0};	// wakeups after the guard interval, the cycle started late
+    std::atomic<uint64_t> uRTPhaseLagNs{0};		// measured time from the update of the input frame to the cycle start, see CPhaseAligner
+    std::atomic<uint64_t> uRTPhaseCorrections{0};	// shifts of the cycle phase
+    std::atomic<uint64_t> uRTStaleCycles{0};	// cycles without a fresh input frame
+    std::atomic<uint64_t> uRTInputAgeUs{0};		// time since the last fresh input frame, UINT64_MAX before the first
+    std::atomic<uint64_t> uRTPhaseMisses{0};	// measurements of the phase without enough changes of the inputs
+    std::atomic<uint64_t> uAxioDiagReads{0};	// reads of the diag frame, see CAxioDiagMonitor
+    std::atomic<uint64_t> uAxioDiagEvents{0};	// changes of the AXIO diagnosis queued for the event loop
+    std::atomic<uint64_t> uAxioDiagLost{0};		// changes of the AXIO diagnosis lost on a full queue
+    std::atomic<uint64_t> uAxioDiagStatus{0};	// AXIO_DIAG_STATUS_REG of the last read
+
+    // watchdog thread, see CRTWatchdog
+    std::atomic<uint64_t> uRTStalls{0};			// stalls of a realtime thread
+    std::atomic<uint64_t> uRTLongestStallUs{0};	// longest time without a heartbeat of a stalled thread
+
+    // subscription cycle in the event loop
+    CMetricHistogram zSubscriptionPoll;			// time to read and decode one subscription
+    std::atomic<uint64_t> uSubscriptionReads{0};
+    std::atomic<uint64_t> uSubscriptionErrors{0};
+    std::atomic<uint64_t> uValueStoreBytes{0};	// memory of all subscription value stores
+};
+
+#endif /* RUNTIMEMETRICS_H_ */
@@ -13,10 +13,22 @@
 #ifndef UTILITY_H_
 #define UTILITY_H_
 
+#include <stdint.h>
+#include <time.h>
+
 #define WAIT100ms 	usleep(100000);		// 100ms
 #define WAIT1s 		usleep(1000000);	// 1s
 #define WAIT10s 	usleep(10000000);	// 10s
 
 typedef void * (*THREADFUNCPTR)(void *);
 
+/// @brief	current time of the monotonic clock in ns, e.g. for measurements of durations
+/// @return	time in ns
+inline uint64_t GetMonotonicTimeNs()
+{
+    timespec zTime;
+    clock_gettime(CLOCK_MONOTONIC, &zTime);
+    return((uint64_t)zTime.tv_sec * 1000000000ULL + (uint64_t)zTime.tv_nsec);
+}
+
 #endif /* UTILITY_H_ */
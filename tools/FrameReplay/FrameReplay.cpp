@@ -0,0 +1,513 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  FrameReplay.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+// Replays the frames recorded by CFrameRecorder (see FrameRecordFormat.h) cycle for cycle into the
+// unchanged logic of the sample runtime (CSampleRTThread) on a Linux host, using the GDS simulator
+// without its bus thread. For every cycle, the recorded input and diag frames and the setpoints of
+// the IEC program are fed in, ReadInputData, ReadAxioDiagVars, DoLogic and WriteOutputData are
+// called, and the outputs are compared with the recorded ones. Build from the root of the repository:
+//
+//   cmake -S tools -B build-tools && cmake --build build-tools --target FrameReplay
+//   ./build-tools/FrameReplay [--realtime] [--mismatches 10] [--layout file] [-v] FrameRecord.bin
+//
+// The first record and the first record after a gap only set the state of the logic, they are not
+// compared. Without --realtime, the cycles are replayed as fast as possible and the throughput is
+// reported; with --realtime, each cycle starts at the recorded time after the first one. The exit
+// code is 1 if at least one output differs, 2 on errors and 0 otherwise. Like the runtime, the
+// replay creates the retain file in retain/ of the current directory and the shared process image.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <string>
+#include <vector>
+#include "GdsSimulator.h"
+#include "CSampleRTThread.h"
+#include "FrameRecordFormat.h"
+
+using namespace std;
+
+#define REPLAY_LAYOUT		"tools/GdsSimulator/AxioSample.layout"
+#define REPLAY_MISMATCHES	10		// default number of reported output differences
+
+///	structure with the result of a replay
+struct REPLAYSTATS
+{
+    uint64 uCycles = 0;			// replayed cycles
+    uint64 uCompared = 0;		// cycles with compared outputs
+    uint64 uMismatches = 0;		// cycles with at least one different output
+    uint64 uFirstMismatch = 0;	// number of the first cycle with a different output
+    uint64 uGaps = 0;			// records after dropped cycles
+    uint64 uMaxLateNs = 0;		// longest delay of a cycle with --realtime
+    uint64 uDurationNs = 0;
+};
+
+/// @brief	replay of a recording with the realtime object of the sample runtime
+class CFrameReplay
+{
+public:
+    CFrameReplay()
+               : m_pRT(NULL)
+    {
+        memset(&m_zHeader, 0, sizeof(m_zHeader));
+    }
+
+    virtual ~CFrameReplay()
+    {
+    }
+
+    /// @brief			read the header, the layout and the records of a recording, oldest record first
+    /// @param szFile	path of the recording
+    /// @return			true: success, false: failure
+    bool Load(const char* szFile)
+    {
+        bool bRet = false;
+
+        FILE* pFile = fopen(szFile, "rb");
+        if(pFile == NULL)
+        {
+            Log::Error("Cannot open {0}", szFile);
+            return(bRet);
+        }
+
+        if((fread(&m_zHeader, sizeof(m_zHeader), 1, pFile) == 1) && (m_zHeader.uMagic == FRAMERECORD_MAGIC) &&
+           (m_zHeader.uVersion == FRAMERECORD_VERSION) && (m_zHeader.uHeaderSize == sizeof(FRAMERECORDHEADER)) &&
+           (m_zHeader.zSetpoints.uSize == sizeof(GDSSETPOINTS)) && (m_zHeader.uCapacity > 0))
+        {
+            // the ring is full, if more records were written than it holds
+            uint64 uCount = min(m_zHeader.uRecords, (uint64)m_zHeader.uCapacity);
+            uint64 uFirst = (m_zHeader.uRecords > m_zHeader.uCapacity) ? (m_zHeader.uRecords % m_zHeader.uCapacity) : 0;
+            size_t nRecordSize = m_zHeader.uRecordSize;
+
+            m_zEntries.resize(m_zHeader.uEntryCount);
+            m_zRecords.resize(uCount * nRecordSize);
+
+            bRet = (fseek(pFile, m_zHeader.uEntryOffset, SEEK_SET) == 0) &&
+                   (fread(m_zEntries.data(), sizeof(PROCESSIMAGEENTRY), m_zEntries.size(), pFile) == m_zEntries.size());
+
+            // oldest part of the ring up to its end, then the newer part from its start
+            uint64 uPart = uCount - uFirst;
+            bRet = bRet && (fseek(pFile, m_zHeader.uRecordOffset + uFirst * nRecordSize, SEEK_SET) == 0) &&
+                   (fread(m_zRecords.data(), nRecordSize, uPart, pFile) == uPart);
+            bRet = bRet && (fseek(pFile, m_zHeader.uRecordOffset, SEEK_SET) == 0) &&
+                   (fread(m_zRecords.data() + uPart * nRecordSize, nRecordSize, uFirst, pFile) == uFirst);
+
+            if(bRet == false)
+            {
+                Log::Error("{0} is truncated", szFile);
+            }
+        }
+        else
+        {
+            Log::Error("{0} is no recording of this version", szFile);
+        }
+
+        fclose(pFile);
+        return(bRet);
+    }
+
+    /// @brief			start processing of the realtime object with the simulated buffers, the
+    /// 				realtime thread itself is not created
+    /// @param szLayout	layout of the simulated GDS buffers
+    /// @return			true: success, false: failure or the recording has a different layout
+    bool Setup(const char* szLayout)
+    {
+        // without the bus thread, the frames only contain what the replay writes
+        if(g_zGdsSimulator.LoadLayout(szLayout) == false)
+        {
+            return(false);
+        }
+        g_zGdsSimulator.MarkValid();
+
+        m_pRT = new CSampleRTThread();
+        m_pRT->m_pSetpointMailbox = &m_zSetpointMailbox;
+        m_pRT->m_pResultMailbox = &m_zResultMailbox;
+        m_pRT->m_pDeviceStatus = &m_zDeviceStatus;
+        m_pRT->m_pMetrics = &m_zMetrics;
+
+        // a warm start does not discard the retain file, the retained outputs are replaced by the recording
+        if(m_pRT->StartProcessing(PlcOperation_StartWarm) == false)
+        {
+            return(false);
+        }
+
+        if(m_pRT->m_zFrameRecorder.GetLayoutHash() != m_zHeader.uLayoutHash)
+        {
+            Log::Error("The recording was made with different I/Os or offsets, check the layout {0}", szLayout);
+            return(false);
+        }
+        if(m_zHeader.uCycleTimeUs != RTCYCLETIME)
+        {
+            Log::Warning("The recording was made with a cycle time of {0} us, the replay uses {1} us", m_zHeader.uCycleTimeUs, RTCYCLETIME);
+        }
+
+        return(true);
+    }
+
+    /// @brief				replay all records
+    /// @param bRealtime	true: start each cycle at the recorded time, false: as fast as possible
+    /// @param uMaxReports	number of output differences which are printed
+    /// @param zStats		result of the replay
+    void Run(bool bRealtime, uint32 uMaxReports, REPLAYSTATS& zStats)
+    {
+        size_t nCount = GetRecordCount();
+        if(nCount == 0)
+        {
+            return;
+        }
+
+        const FRAMERECORD* pFirst = GetRecord(0);
+        timespec zStart;
+        clock_gettime(CLOCK_MONOTONIC, &zStart);
+        uint64 uStartNs = GetMonotonicTimeNs();
+        uint32 uReported = 0;
+
+        Seed(pFirst);
+
+        for(size_t nIndex = 1; nIndex < nCount; nIndex++)
+        {
+            const FRAMERECORD* pRecord = GetRecord(nIndex);
+
+            if(bRealtime)
+            {
+                timespec zCycleTime = zStart;
+                uint64 uOffsetNs = pRecord->uTimeNs - pFirst->uTimeNs;
+                zCycleTime.tv_sec += uOffsetNs / 1000000000;
+                timeAdd(zCycleTime, (uOffsetNs % 1000000000) / 1000);
+                clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &zCycleTime, NULL);
+
+                uint64 uPlannedNs = uStartNs + uOffsetNs;
+                uint64 uNowNs = GetMonotonicTimeNs();
+                zStats.uMaxLateNs = max(zStats.uMaxLateNs, (uNowNs > uPlannedNs) ? (uNowNs - uPlannedNs) : 0);
+            }
+
+            // the logic did not see the cycles before, its state is taken from the recording again
+            if(pRecord->uFlags & FRAMERECORD_GAP)
+            {
+                zStats.uGaps++;
+                Seed(pRecord);
+                continue;
+            }
+
+            // an area which was not read in the recorded cycle keeps its values, like in the realtime cycle
+            ReadInputs(pRecord);
+            if(pRecord->uFlags & FRAMERECORD_DIAG)
+            {
+                WriteArea(m_pRT->m_pGdsAxioDiagBuffer, PROCESSIMAGE_DIAG, pRecord);
+                m_pRT->ReadAxioDiagVars();
+            }
+            PublishSetpoints(pRecord);
+            m_pRT->DoLogic();
+            m_pRT->WriteOutputData();
+            zStats.uCycles++;
+
+            if(pRecord->uFlags & FRAMERECORD_OUTPUTS)
+            {
+                zStats.uCompared++;
+                if(Compare(pRecord, uMaxReports, uReported) == false)
+                {
+                    if(zStats.uMismatches == 0)
+                    {
+                        zStats.uFirstMismatch = pRecord->uCycle;
+                    }
+                    zStats.uMismatches++;
+                }
+            }
+        }
+
+        zStats.uDurationNs = GetMonotonicTimeNs() - uStartNs;
+    }
+
+    /// @brief	stop processing and release the simulated buffers
+    void Shutdown()
+    {
+        if(m_pRT != NULL)
+        {
+            m_pRT->StopProcessing();
+            m_pRT->ReleaseResources();
+        }
+    }
+
+    /// @brief	print the recording
+    void PrintRecording()
+    {
+        size_t nCount = GetRecordCount();
+        printf("recording: %u I/Os, %u bytes per cycle, cycle time %u us, %zu of %llu cycles in the ring, %llu dropped\n",
+               m_zHeader.uEntryCount, m_zHeader.uRecordSize, m_zHeader.uCycleTimeUs, nCount,
+               (unsigned long long)m_zHeader.uRecords, (unsigned long long)m_zHeader.uDropped);
+        if(nCount > 0)
+        {
+            printf("cycles %llu to %llu, %.3f s\n", (unsigned long long)GetRecord(0)->uCycle,
+                   (unsigned long long)GetRecord(nCount - 1)->uCycle,
+                   (GetRecord(nCount - 1)->uTimeNs - GetRecord(0)->uTimeNs) / 1e9);
+        }
+    }
+
+private:
+    FRAMERECORDHEADER m_zHeader;
+    vector<PROCESSIMAGEENTRY> m_zEntries;
+    vector<unsigned char> m_zRecords;
+
+    CSampleRTThread* m_pRT;		// never deleted, like in the runtime
+    CSetpointMailbox m_zSetpointMailbox;
+    CResultMailbox m_zResultMailbox;
+    DEVICESTATUS m_zDeviceStatus;
+    RUNTIMEMETRICS m_zMetrics;
+
+    /// @brief	number of records
+    /// @return	count
+    size_t GetRecordCount() const
+    {
+        return(m_zRecords.size() / m_zHeader.uRecordSize);
+    }
+
+    /// @brief			record in the order of the cycles
+    /// @param nIndex	index, 0 is the oldest record
+    /// @return			pointer to record
+    const FRAMERECORD* GetRecord(size_t nIndex) const
+    {
+        return((const FRAMERECORD*)(m_zRecords.data() + nIndex * m_zHeader.uRecordSize));
+    }
+
+    /// @brief			copy the recorded part of a frame into a simulated GDS buffer
+    /// @param pBuffer	GDS buffer
+    /// @param zArea	area of the record
+    /// @param pRecord	record
+    void WriteArea(TGdsBuffer* pBuffer, PROCESSIMAGEAREA zArea, const FRAMERECORD* pRecord)
+    {
+        if(pBuffer == NULL)
+        {
+            return;
+        }
+
+        char* pFrame = NULL;
+        if(ArpPlcGds_BeginWrite(pBuffer, &pFrame))
+        {
+            memcpy(pFrame + m_zHeader.uFrameOffset[zArea], (const unsigned char*)pRecord + m_zHeader.zAreas[zArea].uOffset,
+                   m_zHeader.zAreas[zArea].uSize);
+        }
+        ArpPlcGds_EndWrite(pBuffer);
+    }
+
+    /// @brief			hand the recorded setpoints of the IEC program to the logic
+    /// @param pRecord	record
+    void PublishSetpoints(const FRAMERECORD* pRecord)
+    {
+        memcpy(&m_zSetpointMailbox.GetWriteBuffer(), (const unsigned char*)pRecord + m_zHeader.zSetpoints.uOffset, sizeof(GDSSETPOINTS));
+        m_zSetpointMailbox.Publish();
+    }
+
+    /// @brief			read the recorded inputs, the freshness of the inputs for the logic follows the
+    /// 				recorded time, so the logic sees the same age as in the recorded cycle
+    /// @param pRecord	record
+    void ReadInputs(const FRAMERECORD* pRecord)
+    {
+        if(pRecord->uFlags & FRAMERECORD_INPUTS)
+        {
+            WriteArea(m_pRT->m_pGdsInBuffer, PROCESSIMAGE_INPUTS, pRecord);
+            m_pRT->ReadInputData();
+            m_pRT->m_zInputFreshness.uFreshNs = pRecord->uTimeNs;
+        }
+        else
+        {
+            m_pRT->UpdateInputFreshness(false, false, pRecord->uTimeNs);
+        }
+    }
+
+    /// @brief			set the state of the logic from a record: inputs, diag and setpoints as read
+    /// 				in the cycle and the outputs as written at its end
+    /// @param pRecord	record
+    void Seed(const FRAMERECORD* pRecord)
+    {
+        ReadInputs(pRecord);
+        if(pRecord->uFlags & FRAMERECORD_DIAG)
+        {
+            WriteArea(m_pRT->m_pGdsAxioDiagBuffer, PROCESSIMAGE_DIAG, pRecord);
+            m_pRT->ReadAxioDiagVars();
+        }
+        PublishSetpoints(pRecord);
+
+        if(pRecord->uFlags & FRAMERECORD_OUTPUTS)
+        {
+            WriteArea(m_pRT->m_pGdsOutBuffer, PROCESSIMAGE_OUTPUTS, pRecord);
+
+            char* pFrame = NULL;
+            if(ArpPlcGds_BeginRead(m_pRT->m_pGdsOutBuffer, &pFrame))
+            {
+                for(size_t nCount = 0; nCount < m_pRT->m_zOutputPlan.size(); nCount++)
+                {
+                    m_pRT->ReadValue(pFrame, *m_pRT->m_zOutputPlan[nCount]);
+                }
+            }
+            ArpPlcGds_EndRead(m_pRT->m_pGdsOutBuffer);
+        }
+
+        // the state of the logic is not recorded, it is taken from the seeded inputs and the latch output
+        m_pRT->m_zLogicState.bLatch = m_pRT->m_pOut06->bValue;
+        m_pRT->m_zLogicState.bLastIn04 = m_pRT->m_pIn04->bValue;
+        m_pRT->m_zLogicState.bLastIn05 = m_pRT->m_pIn05->bValue;
+    }
+
+    /// @brief				compare the outputs of the replayed cycle with the recorded ones. Only the
+    /// 					values of the I/Os are compared, not other bits of the same bytes
+    /// @param pRecord		record
+    /// @param uMaxReports	number of differences which are printed
+    /// @param uReported	number of differences printed so far
+    /// @return				true: all outputs are equal, false: at least one differs
+    bool Compare(const FRAMERECORD* pRecord, uint32 uMaxReports, uint32& uReported)
+    {
+        bool bRet = true;
+
+        char* pFrame = NULL;
+        if(ArpPlcGds_BeginRead(m_pRT->m_pGdsOutBuffer, &pFrame))
+        {
+            const unsigned char* pRecorded = (const unsigned char*)pRecord;
+            size_t nFrameBase = m_zHeader.uFrameOffset[PROCESSIMAGE_OUTPUTS];
+            size_t nRecordBase = m_zHeader.zAreas[PROCESSIMAGE_OUTPUTS].uOffset;
+
+            for(const PROCESSIMAGEENTRY& zEntry : m_zEntries)
+            {
+                if(zEntry.uArea != PROCESSIMAGE_OUTPUTS)
+                {
+                    continue;
+                }
+
+                const unsigned char* pExpected = pRecorded + zEntry.uOffset;
+                const unsigned char* pActual = (const unsigned char*)pFrame + nFrameBase + (zEntry.uOffset - nRecordBase);
+                bool bEqual = (zEntry.uBitMask != 0) ? (((*pExpected ^ *pActual) & zEntry.uBitMask) == 0)
+                                                     : (memcmp(pExpected, pActual, zEntry.uSize) == 0);
+                if(bEqual == false)
+                {
+                    bRet = false;
+                    if(uReported < uMaxReports)
+                    {
+                        uReported++;
+                        printf("cycle %llu: %s recorded %s replayed %s\n", (unsigned long long)pRecord->uCycle, zEntry.szID,
+                               FormatValue(zEntry, pExpected).c_str(), FormatValue(zEntry, pActual).c_str());
+                    }
+                }
+            }
+        }
+        ArpPlcGds_EndRead(m_pRT->m_pGdsOutBuffer);
+
+        return(bRet);
+    }
+
+    /// @brief			value of an I/O as text
+    /// @param zEntry	I/O
+    /// @param pValue	pointer to value
+    /// @return			0 or 1 for a boolean, the bytes in hex otherwise
+    static string FormatValue(const PROCESSIMAGEENTRY& zEntry, const unsigned char* pValue)
+    {
+        if(zEntry.uBitMask != 0)
+        {
+            return((*pValue & zEntry.uBitMask) ? "1" : "0");
+        }
+
+        string strValue = "0x";
+        char szByte[3];
+        for(uint16 uCount = 0; uCount < zEntry.uSize; uCount++)
+        {
+            snprintf(szByte, sizeof(szByte), "%02x", pValue[uCount]);
+            strValue += szByte;
+        }
+        return(strValue);
+    }
+};
+
+int main(int argc, char** argv)
+{
+    const char* szLayout = REPLAY_LAYOUT;
+    const char* szFile = NULL;
+    bool bRealtime = false;
+    uint32 uMaxReports = REPLAY_MISMATCHES;
+
+    // the messages of the runtime go to stderr, only warnings and errors without -v
+    g_nSimLogLevel = 2;
+
+    for(int nCount = 1; nCount < argc; nCount++)
+    {
+        bool bValue = (nCount + 1 < argc);
+        if(strcmp(argv[nCount], "--realtime") == 0)
+        {
+            bRealtime = true;
+        }
+        else if((strcmp(argv[nCount], "--mismatches") == 0) && bValue)
+        {
+            uMaxReports = (uint32)atoi(argv[++nCount]);
+        }
+        else if((strcmp(argv[nCount], "--layout") == 0) && bValue)
+        {
+            szLayout = argv[++nCount];
+        }
+        else if(strcmp(argv[nCount], "-v") == 0)
+        {
+            g_nSimLogLevel = 0;
+        }
+        else if((argv[nCount][0] != '-') && (szFile == NULL))
+        {
+            szFile = argv[nCount];
+        }
+        else
+        {
+            szFile = NULL;
+            break;
+        }
+    }
+
+    if(szFile == NULL)
+    {
+        fprintf(stderr, "usage: %s [--realtime] [--mismatches count] [--layout file] [-v] recording\n", argv[0]);
+        return(2);
+    }
+
+    // the recording is read completely, before the runtime may create a new one
+    CFrameReplay zReplay;
+    if(zReplay.Load(szFile) == false)
+    {
+        return(2);
+    }
+    zReplay.PrintRecording();
+
+    if(zReplay.Setup(szLayout) == false)
+    {
+        return(2);
+    }
+
+    REPLAYSTATS zStats;
+    zReplay.Run(bRealtime, uMaxReports, zStats);
+    zReplay.Shutdown();
+
+    printf("replayed %llu cycles in %.3f s", (unsigned long long)zStats.uCycles, zStats.uDurationNs / 1e9);
+    if(bRealtime)
+    {
+        printf(", max. delay of a cycle %.1f us\n", zStats.uMaxLateNs / 1000.0);
+    }
+    else if(zStats.uCycles > 0)
+    {
+        printf(", %.0f cycles/s, %.2f us per cycle\n", zStats.uCycles * 1e9 / max(zStats.uDurationNs, (uint64)1),
+               zStats.uDurationNs / 1000.0 / zStats.uCycles);
+    }
+    else
+    {
+        printf("\n");
+    }
+    printf("compared %llu cycles, %llu with different outputs", (unsigned long long)zStats.uCompared, (unsigned long long)zStats.uMismatches);
+    if(zStats.uMismatches > 0)
+    {
+        printf(", first in cycle %llu", (unsigned long long)zStats.uFirstMismatch);
+    }
+    printf(", %llu gaps\n", (unsigned long long)zStats.uGaps);
+
+    return((zStats.uMismatches > 0) ? 1 : 0);
+}
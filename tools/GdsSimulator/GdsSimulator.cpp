@@ -0,0 +1,619 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  GdsSimulator.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <map>
+#include "GdsSimulator.h"
+#include "Arp/System/Commons/Logging.h"
+
+#define GDSSIM_MAX_LINE		512		// max. length of a line of the layout file
+
+CGdsSimulator g_zGdsSimulator;
+
+///	structure to handle a variable of a simulated buffer
+struct GDSSIMVAR
+{
+    size_t nOffset = 0;			// offset in frame in byte
+    int nBitOffset = -1;		// bit in the byte, -1 if it is no boolean
+};
+
+///	simulated GDS buffer, the SDK only hands out pointers to it
+struct TGdsBuffer
+{
+    string strIoSystem;
+    string strBufferID;
+    GDSSIMKIND zKind = GDSSIM_INPUT;
+
+    vector<char> zFrame;
+    vector<char> zConsumed;		// copy of the output frame of the last bus cycle
+    map<string, GDSSIMVAR> zVariables;
+
+    pthread_mutex_t zMutex;		// priority inheritance, the application runs with a realtime priority
+    std::atomic<bool> bValid{false};
+    std::atomic<uint32> uUsers{0};
+
+    // statistics, written by the application and the bus thread
+    std::atomic<uint64> uReads{0};
+    std::atomic<uint64> uWrites{0};
+    std::atomic<uint64> uInvalid{0};
+    std::atomic<uint64> uContended{0};
+    std::atomic<uint64> uOutputChanges{0};
+};
+
+/// @brief			lock a buffer and count, if the bus or the application had to wait
+/// @param pBuffer	buffer
+static void LockBuffer(TGdsBuffer* pBuffer)
+{
+    if(pthread_mutex_trylock(&pBuffer->zMutex) != 0)
+    {
+        pBuffer->uContended.fetch_add(1, std::memory_order_relaxed);
+        pthread_mutex_lock(&pBuffer->zMutex);
+    }
+}
+
+CGdsSimulator::CGdsSimulator()
+          : m_zBusThread(),
+            m_bBusRunning(false),
+            m_uCycleUs(GDSSIM_BUS_CYCLE),
+            m_uBusCycles(0),
+            m_uBusOverruns(0),
+            m_uDiagRegisters((uint32)GDSSIM_DIAG_STATUS << 16),
+            m_fnAccessHook(NULL),
+            m_pAccessHookUser(NULL)
+{
+}
+
+CGdsSimulator::~CGdsSimulator()
+{
+    StopBus();
+    Clear();
+}
+
+/// @brief			read the layout of the buffers from a text file
+/// @param szFile	name of layout file
+/// @return			true: success, false: failure
+bool CGdsSimulator::LoadLayout(const char* szFile)
+{
+    bool bRet = false;
+
+    FILE* pFile = fopen(szFile, "r");
+    if(pFile == NULL)
+    {
+        Log::Error("GDS simulator: cannot open layout file {0}: {1}", szFile, strerror(errno));
+        return(bRet);
+    }
+
+    bRet = true;
+
+    char szLine[GDSSIM_MAX_LINE];
+    char szIoSystem[GDSSIM_MAX_LINE] = "";
+    char szBufferID[GDSSIM_MAX_LINE] = "";
+    size_t nLine = 0;
+
+    while(bRet && (fgets(szLine, sizeof(szLine), pFile) != NULL))
+    {
+        nLine++;
+
+        char* pComment = strchr(szLine, '#');
+        if(pComment != NULL)
+        {
+            *pComment = '\0';
+        }
+
+        char szFirst[GDSSIM_MAX_LINE];
+        char szSecond[GDSSIM_MAX_LINE];
+        char szThird[GDSSIM_MAX_LINE];
+        char szKind[GDSSIM_MAX_LINE];
+        unsigned long ulSize = 0;
+        int nFields = sscanf(szLine, "%s %s %s %lu %s", szFirst, szSecond, szThird, &ulSize, szKind);
+
+        if(nFields <= 0)
+        {
+            // empty line
+            continue;
+        }
+
+        if((strcmp(szFirst, "buffer") == 0) && (nFields == 5))
+        {
+            GDSSIMKIND zKind = GDSSIM_INPUT;
+            if(strcmp(szKind, "output") == 0)
+            {
+                zKind = GDSSIM_OUTPUT;
+            }
+            else if(strcmp(szKind, "diag") == 0)
+            {
+                zKind = GDSSIM_DIAG;
+            }
+            else if(strcmp(szKind, "input") != 0)
+            {
+                Log::Error("GDS simulator: {0}:{1}: unknown kind of buffer {2}", szFile, nLine, szKind);
+                bRet = false;
+                continue;
+            }
+
+            strcpy(szIoSystem, szSecond);
+            strcpy(szBufferID, szThird);
+            bRet = AddBuffer(szIoSystem, szBufferID, ulSize, zKind);
+        }
+        else if((nFields == 2) && (szBufferID[0] != '\0'))
+        {
+            unsigned long ulOffset = 0;
+            int nBitOffset = -1;
+            if(sscanf(szSecond, "%lu.%d", &ulOffset, &nBitOffset) < 1)
+            {
+                Log::Error("GDS simulator: {0}:{1}: invalid offset {2}", szFile, nLine, szSecond);
+                bRet = false;
+                continue;
+            }
+            bRet = AddVariable(szIoSystem, szBufferID, szFirst, ulOffset, nBitOffset);
+        }
+        else
+        {
+            Log::Error("GDS simulator: {0}:{1}: invalid line", szFile, nLine);
+            bRet = false;
+        }
+    }
+
+    fclose(pFile);
+
+    if(bRet)
+    {
+        Log::Info("GDS simulator: {0} buffers loaded from {1}", m_zBuffers.size(), szFile);
+    }
+
+    return(bRet);
+}
+
+/// @brief				add a buffer with an empty frame
+/// @param szIoSystem	ID of I/O system, e.g. Arp.Io.AxlC
+/// @param szBufferID	ID of buffer, e.g. 1:IN
+/// @param nSize		size of frame in bytes
+/// @param zKind		what the bus does with the frame
+/// @return				true: success, false: failure
+bool CGdsSimulator::AddBuffer(const char* szIoSystem, const char* szBufferID, size_t nSize, GDSSIMKIND zKind)
+{
+    if(m_bBusRunning)
+    {
+        Log::Error("GDS simulator: buffers cannot be added while the bus is running");
+        return(false);
+    }
+    if(FindBuffer(szIoSystem, szBufferID) != NULL)
+    {
+        Log::Error("GDS simulator: buffer {0} {1} already exists", szIoSystem, szBufferID);
+        return(false);
+    }
+
+    TGdsBuffer* pBuffer = new TGdsBuffer();
+    pBuffer->strIoSystem = szIoSystem;
+    pBuffer->strBufferID = szBufferID;
+    pBuffer->zKind = zKind;
+    pBuffer->zFrame.resize(nSize, 0);
+    pBuffer->zConsumed.resize(nSize, 0);
+
+    pthread_mutexattr_t zAttr;
+    pthread_mutexattr_init(&zAttr);
+    pthread_mutexattr_setprotocol(&zAttr, PTHREAD_PRIO_INHERIT);
+    pthread_mutex_init(&pBuffer->zMutex, &zAttr);
+    pthread_mutexattr_destroy(&zAttr);
+
+    m_zBuffers.push_back(pBuffer);
+
+    return(true);
+}
+
+/// @brief				add a variable to a buffer
+/// @param szIoSystem	ID of I/O system
+/// @param szBufferID	ID of buffer
+/// @param szPortName	full name of the variable, e.g. Arp.Io.AxlC/0.IN04
+/// @param nOffset		offset in frame in bytes
+/// @param nBitOffset	bit in the byte for booleans, -1 otherwise
+/// @return				true: success, false: failure
+bool CGdsSimulator::AddVariable(const char* szIoSystem, const char* szBufferID, const char* szPortName, size_t nOffset, int nBitOffset)
+{
+    TGdsBuffer* pBuffer = FindBuffer(szIoSystem, szBufferID);
+    if(pBuffer == NULL)
+    {
+        Log::Error("GDS simulator: buffer {0} {1} does not exist", szIoSystem, szBufferID);
+        return(false);
+    }
+    if((nOffset >= pBuffer->zFrame.size()) || (nBitOffset > 7))
+    {
+        Log::Error("GDS simulator: offset {0}.{1} of {2} is outside of the frame", nOffset, nBitOffset, szPortName);
+        return(false);
+    }
+
+    GDSSIMVAR& zVar = pBuffer->zVariables[szPortName];
+    zVar.nOffset = nOffset;
+    zVar.nBitOffset = nBitOffset;
+
+    return(true);
+}
+
+/// @brief	remove all buffers, they must not be used anymore
+void CGdsSimulator::Clear()
+{
+    for(size_t nCount = 0; nCount < m_zBuffers.size(); nCount++)
+    {
+        pthread_mutex_destroy(&m_zBuffers[nCount]->zMutex);
+        delete m_zBuffers[nCount];
+    }
+    m_zBuffers.clear();
+}
+
+/// @brief				start the bus thread, the buffers become valid after its first cycle
+/// @param uCycleUs		cycle of the bus in us
+/// @param bRealtime	run the bus with SCHED_FIFO, if the process is allowed to
+/// @return				true: success, false: failure
+bool CGdsSimulator::StartBus(uint32 uCycleUs, bool bRealtime)
+{
+    if(m_bBusRunning)
+    {
+        return(true);
+    }
+
+    m_uCycleUs = (uCycleUs > 0) ? uCycleUs : GDSSIM_BUS_CYCLE;
+    m_bBusRunning = true;
+
+    bool bRet = false;
+
+    if(bRealtime)
+    {
+        struct sched_param param;
+        param.sched_priority = GDSSIM_BUS_PRIORITY;
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+        pthread_attr_setschedparam(&attr, &param);
+        pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        bRet = (pthread_create(&m_zBusThread, &attr, CGdsSimulator::BusStaticCycle, this) == 0);
+        pthread_attr_destroy(&attr);
+
+        if(bRet == false)
+        {
+            Log::Warning("GDS simulator: no permission for SCHED_FIFO, the bus runs with normal priority");
+        }
+    }
+
+    if(bRet == false)
+    {
+        bRet = (pthread_create(&m_zBusThread, NULL, CGdsSimulator::BusStaticCycle, this) == 0);
+    }
+
+    if(bRet)
+    {
+        Log::Info("GDS simulator: bus started with {0} us cycle", m_uCycleUs);
+    }
+    else
+    {
+        Log::Error("GDS simulator: error calling pthread_create (bus thread)");
+        m_bBusRunning = false;
+    }
+
+    return(bRet);
+}
+
+/// @brief	stop the bus thread, the frames keep their last values
+void CGdsSimulator::StopBus()
+{
+    if(m_bBusRunning)
+    {
+        m_bBusRunning = false;
+        pthread_join(m_zBusThread, NULL);
+        Log::Info("GDS simulator: bus stopped after {0} cycles", m_uBusCycles.load());
+    }
+}
+
+/// @brief	mark all frames as valid without a running bus, e.g. for benchmarks of the copy code
+void CGdsSimulator::MarkValid()
+{
+    for(size_t nCount = 0; nCount < m_zBuffers.size(); nCount++)
+    {
+        m_zBuffers[nCount]->bValid = true;
+    }
+}
+
+/// @brief			set the registers which the bus writes into the diag frames from the next bus cycle
+/// @param uStatus	AXIO_DIAG_STATUS_REG, GDSSIM_DIAG_STATUS for a running bus
+/// @param uParam	AXIO_DIAG_PARAM_REG
+void CGdsSimulator::SetDiagStatus(uint16 uStatus, uint16 uParam)
+{
+    m_uDiagRegisters.store(((uint32)uStatus << 16) | uParam, std::memory_order_relaxed);
+}
+
+/// @brief	sum of the statistics of the bus and all buffers
+/// @return	statistics
+GDSSIMSTATS CGdsSimulator::GetStatistics()
+{
+    GDSSIMSTATS zStats;
+    zStats.uBusCycles = m_uBusCycles.load(std::memory_order_relaxed);
+    zStats.uBusOverruns = m_uBusOverruns.load(std::memory_order_relaxed);
+
+    for(size_t nCount = 0; nCount < m_zBuffers.size(); nCount++)
+    {
+        const TGdsBuffer* pBuffer = m_zBuffers[nCount];
+        zStats.uReads += pBuffer->uReads.load(std::memory_order_relaxed);
+        zStats.uWrites += pBuffer->uWrites.load(std::memory_order_relaxed);
+        zStats.uInvalid += pBuffer->uInvalid.load(std::memory_order_relaxed);
+        zStats.uContended += pBuffer->uContended.load(std::memory_order_relaxed);
+        zStats.uOutputChanges += pBuffer->uOutputChanges.load(std::memory_order_relaxed);
+        zStats.uOpenBuffers += pBuffer->uUsers.load(std::memory_order_relaxed);
+    }
+
+    return(zStats);
+}
+
+/// @brief			set the function which is called for every access of the application
+/// @param fnHook	function, NULL to remove the hook
+/// @param pUser	first argument of the function
+void CGdsSimulator::SetAccessHook(GDSSIMHOOK fnHook, void* pUser)
+{
+    m_pAccessHookUser = pUser;
+    m_fnAccessHook = fnHook;
+}
+
+/// @brief				hand out a buffer to the application
+/// @param szIoSystem	ID of I/O system
+/// @param szBufferID	ID of buffer
+/// @return				buffer, NULL if it does not exist
+TGdsBuffer* CGdsSimulator::AcquireBuffer(const char* szIoSystem, const char* szBufferID)
+{
+    TGdsBuffer* pBuffer = FindBuffer(szIoSystem, szBufferID);
+    if(pBuffer != NULL)
+    {
+        pBuffer->uUsers.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return(pBuffer);
+}
+
+/// @brief			take back a buffer from the application
+/// @param pBuffer	buffer
+/// @return			true: success, false: the buffer was not acquired
+bool CGdsSimulator::ReleaseBuffer(TGdsBuffer* pBuffer)
+{
+    bool bRet = false;
+
+    if(pBuffer != NULL)
+    {
+        uint32 uUsers = pBuffer->uUsers.load(std::memory_order_relaxed);
+        while(uUsers > 0)
+        {
+            if(pBuffer->uUsers.compare_exchange_weak(uUsers, uUsers - 1, std::memory_order_relaxed))
+            {
+                bRet = true;
+                break;
+            }
+        }
+    }
+
+    return(bRet);
+}
+
+/// @brief				find a buffer by its IDs
+/// @param szIoSystem	ID of I/O system
+/// @param szBufferID	ID of buffer
+/// @return				buffer, NULL if it does not exist
+TGdsBuffer* CGdsSimulator::FindBuffer(const char* szIoSystem, const char* szBufferID)
+{
+    for(size_t nCount = 0; nCount < m_zBuffers.size(); nCount++)
+    {
+        if((m_zBuffers[nCount]->strIoSystem == szIoSystem) && (m_zBuffers[nCount]->strBufferID == szBufferID))
+        {
+            return(m_zBuffers[nCount]);
+        }
+    }
+
+    return(NULL);
+}
+
+/// @brief		static function to start the bus thread
+/// @param p	pointer to simulator
+/// @return		NULL
+void* CGdsSimulator::BusStaticCycle(void* p)
+{
+    ((CGdsSimulator*)p)->BusCycle();
+    return(NULL);
+}
+
+/// @brief	cyclic update of the frames with an absolute wakeup time, like the RT cycle of the sample
+void CGdsSimulator::BusCycle()
+{
+    timespec zCycleTime;
+    clock_gettime(CLOCK_MONOTONIC, &zCycleTime);
+
+    while(m_bBusRunning)
+    {
+        uint64 uCycle = m_uBusCycles.load(std::memory_order_relaxed);
+        UpdateFrames(uCycle);
+        m_uBusCycles.store(uCycle + 1, std::memory_order_relaxed);
+
+        zCycleTime.tv_nsec += (long)m_uCycleUs * 1000;
+        while(zCycleTime.tv_nsec >= 1000000000)
+        {
+            zCycleTime.tv_nsec -= 1000000000;
+            zCycleTime.tv_sec++;
+        }
+
+        timespec zCurrentTime;
+        clock_gettime(CLOCK_MONOTONIC, &zCurrentTime);
+        if((zCurrentTime.tv_sec > zCycleTime.tv_sec) ||
+           ((zCurrentTime.tv_sec == zCycleTime.tv_sec) && (zCurrentTime.tv_nsec > zCycleTime.tv_nsec)))
+        {
+            // the bus does not catch up, it continues with the current time like the real bus
+            m_uBusOverruns.fetch_add(1, std::memory_order_relaxed);
+            zCycleTime = zCurrentTime;
+        }
+
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &zCycleTime, NULL);
+    }
+}
+
+/// @brief			one bus cycle: new inputs, status of the bus and consumption of the outputs
+/// @param uCycle	number of bus cycle
+void CGdsSimulator::UpdateFrames(uint64 uCycle)
+{
+    // the stimulus is a counter per byte, so every bit of the inputs toggles with its own rate
+    uint8 uStimulus = (uint8)(uCycle >> GDSSIM_STIMULUS_SHIFT);
+
+    for(size_t nCount = 0; nCount < m_zBuffers.size(); nCount++)
+    {
+        TGdsBuffer* pBuffer = m_zBuffers[nCount];
+
+        LockBuffer(pBuffer);
+        switch(pBuffer->zKind)
+        {
+            case GDSSIM_INPUT:
+                for(size_t i = 0; i < pBuffer->zFrame.size(); i++)
+                {
+                    pBuffer->zFrame[i] = (char)(uint8)(uStimulus + i);
+                }
+                break;
+            case GDSSIM_OUTPUT:
+                if(memcmp(pBuffer->zConsumed.data(), pBuffer->zFrame.data(), pBuffer->zFrame.size()) != 0)
+                {
+                    memcpy(pBuffer->zConsumed.data(), pBuffer->zFrame.data(), pBuffer->zFrame.size());
+                    pBuffer->uOutputChanges.fetch_add(1, std::memory_order_relaxed);
+                }
+                break;
+            case GDSSIM_DIAG:
+                if(pBuffer->zFrame.size() >= 4)
+                {
+                    // big endian like the registers of the bus master
+                    uint32 uRegisters = m_uDiagRegisters.load(std::memory_order_relaxed);
+                    pBuffer->zFrame[0] = (char)(uRegisters >> 24);
+                    pBuffer->zFrame[1] = (char)(uRegisters >> 16);
+                    pBuffer->zFrame[2] = (char)(uRegisters >> 8);
+                    pBuffer->zFrame[3] = (char)(uRegisters & 0xFF);
+                }
+                break;
+        }
+        pBuffer->bValid.store(true, std::memory_order_release);
+        pthread_mutex_unlock(&pBuffer->zMutex);
+    }
+}
+
+// AnsiC functions of the SDK, used by the sample runtime without changes
+
+extern "C"
+{
+
+bool ArpPlcIo_GetBufferPtrByBufferID(const char* szIoSystem, const char* szBufferID, TGdsBuffer** ppBuffer)
+{
+    if((szIoSystem == NULL) || (szBufferID == NULL) || (ppBuffer == NULL))
+    {
+        return(false);
+    }
+
+    *ppBuffer = g_zGdsSimulator.AcquireBuffer(szIoSystem, szBufferID);
+    return(*ppBuffer != NULL);
+}
+
+bool ArpPlcIo_ReleaseGdsBuffer(TGdsBuffer* pBuffer)
+{
+    return(g_zGdsSimulator.ReleaseBuffer(pBuffer));
+}
+
+bool ArpPlcGds_GetVariableOffset(TGdsBuffer* pBuffer, const char* szPortName, size_t* pOffset)
+{
+    if((pBuffer == NULL) || (szPortName == NULL) || (pOffset == NULL))
+    {
+        return(false);
+    }
+
+    map<string, GDSSIMVAR>::const_iterator it = pBuffer->zVariables.find(szPortName);
+    if(it == pBuffer->zVariables.end())
+    {
+        return(false);
+    }
+
+    *pOffset = it->second.nOffset;
+    return(true);
+}
+
+bool ArpPlcGds_GetVariableBitOffset(TGdsBuffer* pBuffer, const char* szPortName, size_t* pOffset, unsigned char* pBitOffset)
+{
+    if((pBuffer == NULL) || (szPortName == NULL) || (pOffset == NULL) || (pBitOffset == NULL))
+    {
+        return(false);
+    }
+
+    map<string, GDSSIMVAR>::const_iterator it = pBuffer->zVariables.find(szPortName);
+    if(it == pBuffer->zVariables.end())
+    {
+        return(false);
+    }
+
+    *pOffset = it->second.nOffset;
+    *pBitOffset = (it->second.nBitOffset >= 0) ? (unsigned char)it->second.nBitOffset : 0;
+    return(true);
+}
+
+// like in the SDK, the buffer is locked even if the data is not valid yet, so EndRead has to be called in any case
+bool ArpPlcGds_BeginRead(TGdsBuffer* pBuffer, char** ppFrame)
+{
+    if((pBuffer == NULL) || (ppFrame == NULL))
+    {
+        return(false);
+    }
+
+    LockBuffer(pBuffer);
+    *ppFrame = pBuffer->zFrame.data();
+
+    if(pBuffer->bValid.load(std::memory_order_acquire) == false)
+    {
+        pBuffer->uInvalid.fetch_add(1, std::memory_order_relaxed);
+        return(false);
+    }
+
+    pBuffer->uReads.fetch_add(1, std::memory_order_relaxed);
+    g_zGdsSimulator.CallAccessHook(pBuffer, false);
+    return(true);
+}
+
+bool ArpPlcGds_EndRead(TGdsBuffer* pBuffer)
+{
+    if(pBuffer == NULL)
+    {
+        return(false);
+    }
+
+    return(pthread_mutex_unlock(&pBuffer->zMutex) == 0);
+}
+
+bool ArpPlcGds_BeginWrite(TGdsBuffer* pBuffer, char** ppFrame)
+{
+    if((pBuffer == NULL) || (ppFrame == NULL))
+    {
+        return(false);
+    }
+
+    LockBuffer(pBuffer);
+    *ppFrame = pBuffer->zFrame.data();
+    pBuffer->uWrites.fetch_add(1, std::memory_order_relaxed);
+    g_zGdsSimulator.CallAccessHook(pBuffer, true);
+    return(true);
+}
+
+bool ArpPlcGds_EndWrite(TGdsBuffer* pBuffer)
+{
+    if(pBuffer == NULL)
+    {
+        return(false);
+    }
+
+    return(pthread_mutex_unlock(&pBuffer->zMutex) == 0);
+}
+
+}
@@ -0,0 +1,126 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  GdsSimulator.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef GDSSIMULATOR_H_
+#define GDSSIMULATOR_H_
+
+#include <pthread.h>
+#include <atomic>
+#include <string>
+#include <vector>
+#include "Arp/System/Core/Arp.h"
+#include "Arp/Plc/AnsiC/Gds/DataLayout.h"
+#include "Arp/Plc/AnsiC/Io/FbIoSystem.h"
+
+using namespace std;
+using namespace Arp;
+
+#define GDSSIM_BUS_CYCLE		500		// default cycle of the simulated bus in us, like the AXIO bus without ESM tasks
+#define GDSSIM_BUS_PRIORITY		81		// SCHED_FIFO priority of the bus thread, above the realtime thread of the sample
+#define GDSSIM_STIMULUS_SHIFT	8		// the input stimulus changes every 2^n bus cycles
+#define GDSSIM_DIAG_STATUS		0x00E0	// RUN, ACT and RDY bits of the AXIO_DIAG_STATUS_REG, see AxioSample.layout
+
+///	kind of a simulated GDS buffer, it defines what the bus thread does with the frame
+enum GDSSIMKIND
+{
+    GDSSIM_INPUT = 0,	// written by the bus with a stimulus, read by the application
+    GDSSIM_OUTPUT,		// written by the application, consumed by the bus
+    GDSSIM_DIAG			// written by the bus with the status of a running bus
+};
+
+// called in the thread of the application after every successful ArpPlcGds_BeginRead / BeginWrite,
+// e.g. to take the time of each cycle. It must be as fast as the realtime cycle requires
+typedef void (*GDSSIMHOOK)(void* pUser, TGdsBuffer* pBuffer, bool bWrite);
+
+///	structure with statistics of the simulated bus
+struct GDSSIMSTATS
+{
+    uint64 uBusCycles = 0;		// finished bus cycles
+    uint64 uBusOverruns = 0;	// bus cycles which started too late
+    uint64 uReads = 0;			// successful ArpPlcGds_BeginRead calls
+    uint64 uWrites = 0;			// successful ArpPlcGds_BeginWrite calls
+    uint64 uInvalid = 0;		// ArpPlcGds_BeginRead calls before the first bus cycle
+    uint64 uContended = 0;		// Begin calls which had to wait for the bus
+    uint64 uOutputChanges = 0;	// bus cycles which consumed a changed output frame
+    uint64 uOpenBuffers = 0;	// buffers which are acquired and not released
+};
+
+/// @brief	stand-in for the GDS buffers and the AnsiC functions of the PLCnext SDK, so the realtime
+/// 		part of the sample runtime can run on a Linux host. The buffers are plain frames in the
+/// 		process, a bus thread updates them cyclically like the I/O system of the controller.
+/// 		The layout of the buffers is read from a text file or added by the program:
+///
+/// 			# buffer <I/O system> <buffer ID> <size> <input|output|diag>
+/// 			buffer Arp.Io.AxlC 1:IN 8 input
+/// 			# <port name> <byte offset>[.<bit offset>]
+/// 			Arp.Io.AxlC/0.~DI8 0
+/// 			Arp.Io.AxlC/0.IN04 0.4
+class CGdsSimulator
+{
+public:
+    CGdsSimulator();
+    virtual ~CGdsSimulator();
+
+    // layout of the buffers, only before the bus is started
+    bool LoadLayout(const char* szFile);
+    bool AddBuffer(const char* szIoSystem, const char* szBufferID, size_t nSize, GDSSIMKIND zKind);
+    bool AddVariable(const char* szIoSystem, const char* szBufferID, const char* szPortName, size_t nOffset, int nBitOffset = -1);
+    void Clear();
+
+    // simulated bus
+    bool StartBus(uint32 uCycleUs = GDSSIM_BUS_CYCLE, bool bRealtime = true);
+    void StopBus();
+    void MarkValid();
+    void SetDiagStatus(uint16 uStatus, uint16 uParam);
+    GDSSIMSTATS GetStatistics();
+
+    // observation of the accesses of the application, only before the bus is started
+    void SetAccessHook(GDSSIMHOOK fnHook, void* pUser);
+
+    // used by the AnsiC functions
+    TGdsBuffer* AcquireBuffer(const char* szIoSystem, const char* szBufferID);
+    bool ReleaseBuffer(TGdsBuffer* pBuffer);
+
+    /// @brief			call the access hook, if there is one
+    /// @param pBuffer	accessed buffer
+    /// @param bWrite	true: BeginWrite, false: BeginRead
+    void CallAccessHook(TGdsBuffer* pBuffer, bool bWrite)
+    {
+        if(m_fnAccessHook != NULL)
+        {
+            m_fnAccessHook(m_pAccessHookUser, pBuffer, bWrite);
+        }
+    }
+
+private:
+    vector<TGdsBuffer*> m_zBuffers;
+
+    pthread_t m_zBusThread;
+    std::atomic<bool> m_bBusRunning;
+    uint32 m_uCycleUs;
+    std::atomic<uint64> m_uBusCycles;
+    std::atomic<uint64> m_uBusOverruns;
+    std::atomic<uint32> m_uDiagRegisters;	// status in the high word, parameter in the low word
+
+    GDSSIMHOOK m_fnAccessHook;
+    void* m_pAccessHookUser;
+
+    TGdsBuffer* FindBuffer(const char* szIoSystem, const char* szBufferID);
+    static void* BusStaticCycle(void* p);
+    void BusCycle();
+    void UpdateFrames(uint64 uCycle);
+};
+
+// the AnsiC functions have no context, so there is one simulator per process
+extern CGdsSimulator g_zGdsSimulator;
+
+#endif /* GDSSIMULATOR_H_ */
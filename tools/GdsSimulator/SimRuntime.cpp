@@ -0,0 +1,205 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  SimRuntime.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+// Runs the unchanged realtime thread of the sample runtime (CSampleRTThread) on a Linux host
+// against the GDS simulator, so the I/O copy code, the logic and the timing of the cycle can be
+// debugged and profiled without a controller. The RSC services are not simulated, the setpoints
+// of the IEC program stay invalid. Build from the root of the repository:
+//
+//   cmake -S tools -B build-tools && cmake --build build-tools --target SimRuntime
+//   sudo ./build-tools/SimRuntime [-l tools/GdsSimulator/AxioSample.layout] [-t seconds] [-b bus cycle in us] [-s stall in ms] [-f fault in ms] [-v]
+//
+// With -s, the realtime thread is blocked once for the given time while it holds the lock of a frame,
+// two seconds after its start, so the snapshot of the watchdog can be checked. With -f, the bus reports
+// a periphery fault (PF) of module 3 for the given time, four seconds after the start of the program.
+//
+// The realtime thread needs SCHED_FIFO, so the program must run as root or with CAP_SYS_NICE.
+// The exit code is 1 if the realtime thread could not be started or had overruns.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "GdsSimulator.h"
+#include "CSampleRTThread.h"
+#include "CEventLoop.h"
+
+#define SIMRUNTIME_LAYOUT	"tools/GdsSimulator/AxioSample.layout"
+#define SIMRUNTIME_DURATION	10		// default run time in seconds
+#define SIMRUNTIME_STALL_DELAY	3		// time from the start of the program to the injected stall in seconds
+#define SIMRUNTIME_FAULT_DELAY	4		// time from the start of the program to the injected bus fault in seconds
+#define SIMRUNTIME_FAULT_STATUS	(GDSSIM_DIAG_STATUS | 0x0002)	// PF bit of the status register, see AxioSample.layout
+#define SIMRUNTIME_FAULT_PARAM	0x0003	// number of the faulty module
+
+// injected stall, read by the access hook in the realtime thread
+static std::atomic<uint64> s_uStallAtNs(0);	// 0: no stall pending
+static uint64 s_uStallUs = 0;
+
+/// @brief			access hook of the simulator, blocks the realtime thread once with a locked frame
+/// @param pUser	not used
+/// @param pBuffer	not used
+/// @param bWrite	true: BeginWrite, false: BeginRead
+static void StallHook(void* pUser, TGdsBuffer* pBuffer, bool bWrite)
+{
+    (void)pUser;
+    (void)pBuffer;
+
+    uint64 uStallAtNs = s_uStallAtNs.load(std::memory_order_relaxed);
+    if((bWrite == false) && (uStallAtNs != 0) && (GetMonotonicTimeNs() >= uStallAtNs))
+    {
+        s_uStallAtNs.store(0, std::memory_order_relaxed);
+        usleep(s_uStallUs);
+    }
+}
+
+/// @brief		static function to run the event loop in its own thread, the main thread waits for the end of the run
+/// @param p	not used
+/// @return		never returns
+static void* EventLoopStaticCycle(void* p)
+{
+    (void)p;
+    g_zEventLoop.Run();
+    return(NULL);
+}
+
+/// @brief				print one histogram of the metrics
+/// @param szName		name of histogram
+/// @param zHistogram	histogram
+static void PrintHistogram(const char* szName, const CMetricHistogram& zHistogram)
+{
+    uint64 uCount = zHistogram.GetCount();
+    printf("%-22s %10llu %10.1f %10.1f %10.1f %10.1f\n", szName, (unsigned long long)uCount,
+           (uCount > 0) ? zHistogram.GetSumNs() / 1000.0 / uCount : 0.0,
+           zHistogram.GetQuantileNs(0.5) / 1000.0, zHistogram.GetQuantileNs(0.99) / 1000.0,
+           zHistogram.GetMaxNs() / 1000.0);
+}
+
+int main(int argc, char** argv)
+{
+    const char* szLayout = SIMRUNTIME_LAYOUT;
+    uint32 uDuration = SIMRUNTIME_DURATION;
+    uint32 uBusCycleUs = GDSSIM_BUS_CYCLE;
+    uint32 uStallMs = 0;
+    uint32 uFaultMs = 0;
+
+    int nOption = 0;
+    while((nOption = getopt(argc, argv, "l:t:b:s:f:v")) != -1)
+    {
+        switch(nOption)
+        {
+            case 'l':	szLayout = optarg; break;
+            case 't':	uDuration = (uint32)atoi(optarg); break;
+            case 'b':	uBusCycleUs = (uint32)atoi(optarg); break;
+            case 's':	uStallMs = (uint32)atoi(optarg); break;
+            case 'f':	uFaultMs = (uint32)atoi(optarg); break;
+            case 'v':	g_nSimLogLevel = 0; break;
+            default:
+                fprintf(stderr, "usage: %s [-l layout] [-t seconds] [-b bus cycle in us] [-s stall in ms] [-f fault in ms] [-v]\n", argv[0]);
+                return(2);
+        }
+    }
+
+    if(g_zGdsSimulator.LoadLayout(szLayout) == false)
+    {
+        return(2);
+    }
+    if(uStallMs > 0)
+    {
+        s_uStallUs = (uint64)uStallMs * 1000;
+        s_uStallAtNs.store(GetMonotonicTimeNs() + (uint64)SIMRUNTIME_STALL_DELAY * 1000000000, std::memory_order_relaxed);
+        g_zGdsSimulator.SetAccessHook(StallHook, NULL);
+    }
+    if(g_zGdsSimulator.StartBus(uBusCycleUs) == false)
+    {
+        return(2);
+    }
+
+    pthread_t zEventLoopThread;
+    if((g_zEventLoop.Init() == false) || (pthread_create(&zEventLoopThread, NULL, EventLoopStaticCycle, NULL) != 0))
+    {
+        Log::Error("Could not start the event loop");
+        return(2);
+    }
+    pthread_detach(zEventLoopThread);
+
+    // nothing writes the setpoints, the logic sees them as invalid like before the first subscription read
+    CSetpointMailbox zSetpointMailbox;
+    CResultMailbox zResultMailbox;
+    DEVICESTATUS zDeviceStatus;
+    RUNTIMEMETRICS zMetrics;
+
+    // the thread runs forever and uses the metrics, so it is never deleted
+    CSampleRTThread* pRTThread = new CSampleRTThread();
+    if(pRTThread->Init(&zSetpointMailbox, &zResultMailbox, &zDeviceStatus, &zMetrics, &g_zEventLoop) == false)
+    {
+        Log::Error("The realtime thread could not be started, SCHED_FIFO needs root or CAP_SYS_NICE");
+        return(1);
+    }
+    if(pRTThread->StartProcessing(PlcOperation_StartWarm) == false)
+    {
+        return(1);
+    }
+
+    // like the runtime, the realtime thread is supervised by the watchdog
+    CRTWatchdog* pWatchdog = new CRTWatchdog();
+    if((pWatchdog->AddThread("RT thread", pRTThread->GetHeartbeat(), RTWATCHDOG_STALL_TIME, RTWATCHDOG_ABORT_TIME) == false) ||
+       (pWatchdog->Start(&zMetrics, RTWATCHDOG_INTERVAL) == false))
+    {
+        Log::Error("The watchdog could not be started");
+        return(1);
+    }
+
+    // the realtime thread starts at the next full second
+    if((uFaultMs > 0) && (uDuration + 1 > SIMRUNTIME_FAULT_DELAY))
+    {
+        sleep(SIMRUNTIME_FAULT_DELAY);
+        g_zGdsSimulator.SetDiagStatus(SIMRUNTIME_FAULT_STATUS, SIMRUNTIME_FAULT_PARAM);
+        usleep(uFaultMs * 1000);
+        g_zGdsSimulator.SetDiagStatus(GDSSIM_DIAG_STATUS, 0);
+        sleep(uDuration + 1 - SIMRUNTIME_FAULT_DELAY);
+    }
+    else
+    {
+        sleep(uDuration + 1);
+    }
+
+    pRTThread->StopProcessing();
+    pRTThread->ReleaseResources();
+    g_zGdsSimulator.StopBus();
+
+    GDSSIMSTATS zStats = g_zGdsSimulator.GetStatistics();
+    uint64 uOverruns = zMetrics.uRTOverruns.load();
+
+    printf("\n%-22s %10s %10s %10s %10s %10s\n", "us", "count", "mean", "p50", "p99", "max");
+    PrintHistogram("rt_cycle", zMetrics.zRTCycleDuration);
+    PrintHistogram("rt_wakeup_latency", zMetrics.zRTWakeupLatency);
+    PrintHistogram("gds_in_lock_hold", zMetrics.zGdsInLockHold);
+    PrintHistogram("gds_out_lock_hold", zMetrics.zGdsOutLockHold);
+    PrintHistogram("gds_diag_lock_hold", zMetrics.zGdsDiagLockHold);
+    printf("\nrt cycles %llu, overruns %llu\n", (unsigned long long)zMetrics.uRTCycles.load(), (unsigned long long)uOverruns);
+    printf("rt phase lag %.1f us, corrections %llu, misses %llu\n", zMetrics.uRTPhaseLagNs.load() / 1000.0,
+           (unsigned long long)zMetrics.uRTPhaseCorrections.load(), (unsigned long long)zMetrics.uRTPhaseMisses.load());
+    printf("axio diag reads %llu, events %llu, lost %llu\n", (unsigned long long)zMetrics.uAxioDiagReads.load(),
+           (unsigned long long)zMetrics.uAxioDiagEvents.load(), (unsigned long long)zMetrics.uAxioDiagLost.load());
+    printf("watchdog stalls %llu, longest stall %llu us\n", (unsigned long long)zMetrics.uRTStalls.load(),
+           (unsigned long long)zMetrics.uRTLongestStallUs.load());
+    printf("bus cycles %llu, overruns %llu, reads %llu, writes %llu, invalid %llu, contended %llu, output changes %llu, open buffers %llu\n",
+           (unsigned long long)zStats.uBusCycles, (unsigned long long)zStats.uBusOverruns,
+           (unsigned long long)zStats.uReads, (unsigned long long)zStats.uWrites,
+           (unsigned long long)zStats.uInvalid, (unsigned long long)zStats.uContended,
+           (unsigned long long)zStats.uOutputChanges, (unsigned long long)zStats.uOpenBuffers);
+
+    // the realtime thread and the event loop never return
+    fflush(stdout);
+    _exit((uOverruns > 0) ? 1 : 0);
+}
@@ -0,0 +1,32 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  PlcOperationHandler.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+// Host stand-in for the PLC states of the AnsiC API
+
+#ifndef ARP_SIM_PLCOPERATIONHANDLER_H_
+#define ARP_SIM_PLCOPERATIONHANDLER_H_
+
+enum PlcOperation
+{
+    PlcOperation_None = 0,
+    PlcOperation_Load,
+    PlcOperation_Setup,
+    PlcOperation_StartCold,
+    PlcOperation_StartWarm,
+    PlcOperation_StartHot,
+    PlcOperation_Stop,
+    PlcOperation_Reset,
+    PlcOperation_Unload,
+    PlcOperation_Change
+};
+
+#endif /* ARP_SIM_PLCOPERATIONHANDLER_H_ */
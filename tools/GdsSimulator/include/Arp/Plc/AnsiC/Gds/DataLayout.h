@@ -0,0 +1,32 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  DataLayout.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+// Host stand-in for the GDS functions of the AnsiC API, implemented by GdsSimulator.cpp
+
+#ifndef ARP_SIM_DATALAYOUT_H_
+#define ARP_SIM_DATALAYOUT_H_
+
+#include <stddef.h>
+
+typedef struct TGdsBuffer TGdsBuffer;
+
+extern "C"
+{
+bool ArpPlcGds_GetVariableOffset(TGdsBuffer* pBuffer, const char* szPortName, size_t* pOffset);
+bool ArpPlcGds_GetVariableBitOffset(TGdsBuffer* pBuffer, const char* szPortName, size_t* pOffset, unsigned char* pBitOffset);
+bool ArpPlcGds_BeginRead(TGdsBuffer* pBuffer, char** ppFrame);
+bool ArpPlcGds_EndRead(TGdsBuffer* pBuffer);
+bool ArpPlcGds_BeginWrite(TGdsBuffer* pBuffer, char** ppFrame);
+bool ArpPlcGds_EndWrite(TGdsBuffer* pBuffer);
+}
+
+#endif /* ARP_SIM_DATALAYOUT_H_ */
@@ -0,0 +1,19 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  Axio.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+// Host stand-in for the Axioline header of the AnsiC API, the IDs of the I/O systems are
+// defined by the sample runtime itself
+
+#ifndef ARP_SIM_AXIO_H_
+#define ARP_SIM_AXIO_H_
+
+#endif /* ARP_SIM_AXIO_H_ */
@@ -0,0 +1,26 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  FbIoSystem.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+// Host stand-in for the I/O system functions of the AnsiC API, implemented by GdsSimulator.cpp
+
+#ifndef ARP_SIM_FBIOSYSTEM_H_
+#define ARP_SIM_FBIOSYSTEM_H_
+
+#include "Arp/Plc/AnsiC/Gds/DataLayout.h"
+
+extern "C"
+{
+bool ArpPlcIo_GetBufferPtrByBufferID(const char* szIoSystem, const char* szBufferID, TGdsBuffer** ppBuffer);
+bool ArpPlcIo_ReleaseGdsBuffer(TGdsBuffer* pBuffer);
+}
+
+#endif /* ARP_SIM_FBIOSYSTEM_H_ */
@@ -0,0 +1,52 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  Logging.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+// Host stand-in for the logger of the PLCnext SDK, the messages are written to stderr
+
+#ifndef ARP_SIM_LOGGING_H_
+#define ARP_SIM_LOGGING_H_
+
+#include <time.h>
+#include "Arp/System/Core/Arp.h"
+
+namespace Arp
+{
+
+// messages below this level are dropped: 0 debug, 1 info, 2 warning, 3 error
+inline int g_nSimLogLevel = 1;
+
+class Log
+{
+public:
+    template<typename... Args> static void Debug(const char* szFormat, const Args&... args)		{ Write(0, "DEBUG", szFormat, args...); }
+    template<typename... Args> static void Info(const char* szFormat, const Args&... args)		{ Write(1, "INFO ", szFormat, args...); }
+    template<typename... Args> static void Warning(const char* szFormat, const Args&... args)	{ Write(2, "WARN ", szFormat, args...); }
+    template<typename... Args> static void Error(const char* szFormat, const Args&... args)		{ Write(3, "ERROR", szFormat, args...); }
+    template<typename... Args> static void Fatal(const char* szFormat, const Args&... args)		{ Write(3, "FATAL", szFormat, args...); }
+
+private:
+    template<typename... Args>
+    static void Write(int nLevel, const char* szLevel, const char* szFormat, const Args&... args)
+    {
+        if(nLevel < g_nSimLogLevel)
+        {
+            return;
+        }
+        timespec zTime;
+        clock_gettime(CLOCK_MONOTONIC, &zTime);
+        fprintf(stderr, "%5ld.%06ld %s %s\n", (long)zTime.tv_sec, zTime.tv_nsec / 1000, szLevel, SimFormat(szFormat, args...).c_str());
+    }
+};
+
+}
+
+#endif /* ARP_SIM_LOGGING_H_ */
@@ -0,0 +1,177 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  Arp.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+// Host stand-in for the basic types of the PLCnext SDK, only the parts which are used by
+// the realtime path of the sample runtime (see tools/GdsSimulator)
+
+#ifndef ARP_SIM_ARP_H_
+#define ARP_SIM_ARP_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <exception>
+#include <sstream>
+#include <type_traits>
+#include <string>
+#include <vector>
+
+namespace Arp
+{
+
+typedef uint8_t byte;
+typedef int8_t int8;
+typedef uint8_t uint8;
+typedef int16_t int16;
+typedef uint16_t uint16;
+typedef int32_t int32;
+typedef uint32_t uint32;
+typedef int64_t int64;
+typedef uint64_t uint64;
+typedef float float32;
+typedef double float64;
+
+/// @brief			write one argument with a format specification like #04x or .1f
+/// @param zStream	output
+/// @param strSpec	specification after the colon, may be empty
+/// @param value	argument
+template<typename T>
+void SimFormatArg(std::ostringstream& zStream, const std::string& strSpec, const T& value)
+{
+    std::ostringstream zArg;
+    size_t nPos = 0;
+    if((nPos < strSpec.size()) && (strSpec[nPos] == '#'))
+    {
+        zArg << std::showbase;
+        nPos++;
+    }
+    if((nPos < strSpec.size()) && (strSpec[nPos] == '0'))
+    {
+        zArg << std::setfill('0') << std::internal;
+        nPos++;
+    }
+    int nWidth = 0;
+    while((nPos < strSpec.size()) && isdigit((unsigned char)strSpec[nPos]))
+    {
+        nWidth = nWidth * 10 + (strSpec[nPos++] - '0');
+    }
+    if((nPos < strSpec.size()) && (strSpec[nPos] == '.'))
+    {
+        int nPrecision = atoi(strSpec.c_str() + nPos + 1);
+        zArg << std::fixed << std::setprecision(nPrecision);
+    }
+    if(strSpec.find('x') != std::string::npos)
+    {
+        zArg << std::hex;
+    }
+    zArg << std::setw(nWidth);
+
+    // characters are printed as numbers like in the SDK
+    if constexpr(sizeof(T) == 1 && std::is_integral<T>::value)
+    {
+        zArg << (int)value;
+    }
+    else
+    {
+        zArg << value;
+    }
+    zStream << zArg.str();
+}
+
+/// @brief			format like the SDK, {} for the next argument and {n} or {n:spec} for argument n
+/// @param szFormat	format string
+/// @param args		arguments
+/// @return			formatted text
+template<typename... Args>
+std::string SimFormat(const char* szFormat, const Args&... args)
+{
+    std::vector<std::function<void(std::ostringstream&, const std::string&)>> zArgs;
+    (zArgs.push_back([&args](std::ostringstream& zStream, const std::string& strSpec) { SimFormatArg(zStream, strSpec, args); }), ...);
+
+    std::ostringstream zStream;
+    size_t nNext = 0;
+    for(const char* p = szFormat; *p != '\0'; p++)
+    {
+        if(*p == '{')
+        {
+            const char* pEnd = strchr(p, '}');
+            if(pEnd != NULL)
+            {
+                std::string strField(p + 1, pEnd);
+                size_t nColon = strField.find(':');
+                std::string strIndex = strField.substr(0, nColon);
+                std::string strSpec = (nColon != std::string::npos) ? strField.substr(nColon + 1) : "";
+                size_t nIndex = strIndex.empty() ? nNext++ : (size_t)atoi(strIndex.c_str());
+                if(nIndex < zArgs.size())
+                {
+                    zArgs[nIndex](zStream, strSpec);
+                }
+                p = pEnd;
+                continue;
+            }
+        }
+        zStream << *p;
+    }
+    return(zStream.str());
+}
+
+///	string class of the SDK, reduced to the functions used by the sample runtime
+class String
+{
+public:
+    String() {}
+    String(const char* sz) : m_str((sz != NULL) ? sz : "") {}
+    String(const std::string& str) : m_str(str) {}
+
+    const char* CStr() const { return(m_str.c_str()); }
+    size_t Length() const { return(m_str.size()); }
+    bool IsEmpty() const { return(m_str.empty()); }
+
+    operator const std::string&() const { return(m_str); }
+    operator const char*() const { return(m_str.c_str()); }
+    bool operator==(const String& other) const { return(m_str == other.m_str); }
+    bool operator<(const String& other) const { return(m_str < other.m_str); }
+
+    template<typename... Args>
+    static String Format(const char* szFormat, const Args&... args)
+    {
+        return(String(SimFormat(szFormat, args...)));
+    }
+
+    friend std::ostream& operator<<(std::ostream& zStream, const String& str) { return(zStream << str.m_str); }
+
+private:
+    std::string m_str;
+};
+
+///	base of the exceptions of the SDK
+class Exception : public std::exception
+{
+public:
+    Exception() {}
+    Exception(const char* szMessage) : m_strMessage(szMessage) {}
+
+    const char* what() const noexcept override { return(m_strMessage.c_str()); }
+    friend std::ostream& operator<<(std::ostream& zStream, const Exception& e) { return(zStream << e.m_strMessage); }
+
+private:
+    std::string m_strMessage;
+};
+
+}
+
+#endif /* ARP_SIM_ARP_H_ */
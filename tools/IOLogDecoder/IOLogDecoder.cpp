@@ -0,0 +1,173 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  IOLogDecoder.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+// Offline decoder for the binary I/O log of the sample runtime (see CIOLogger and
+// IOLOG_BINARY). It runs on the host and does not need the PLCnext SDK:
+//
+//   cmake -S tools -B build-tools && cmake --build build-tools --target IOLogDecoder
+//   ./build-tools/IOLogDecoder IOLog.bin [IOLog.bin.old ...]
+//
+// Every value is printed as one line: time (UTC), record type, ID of I/O, value and
+// the number of suppressed changes (VALUE) or changes in the interval (SUMMARY).
+
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <time.h>
+#include <string>
+#include <vector>
+#include "IOLogFormat.h"
+
+using namespace std;
+
+///	structure to handle the definition of an I/O
+struct POINT
+{
+    string strID;
+    bool bIsBool = false;
+    uint8_t uSize = 0;
+};
+
+/// @brief				print the time of a record
+/// @param uStartTimeNs	realtime of creation of the file in ns
+/// @param uTimeMs		offset of record in ms
+static void PrintTime(uint64_t uStartTimeNs, uint32_t uTimeMs)
+{
+    uint64_t uTimeNs = uStartTimeNs + (uint64_t)uTimeMs * 1000000;
+    time_t zSeconds = (time_t)(uTimeNs / 1000000000);
+    struct tm zTm;
+    gmtime_r(&zSeconds, &zTm);
+
+    char szTime[32];
+    strftime(szTime, sizeof(szTime), "%Y-%m-%d %H:%M:%S", &zTm);
+    printf("%s.%03u", szTime, (unsigned int)((uTimeNs / 1000000) % 1000));
+}
+
+/// @brief			decode one file
+/// @param szFile	name of file
+/// @return			true: success, false: file is not a valid I/O log or truncated
+static bool DecodeFile(const char* szFile)
+{
+    FILE* pFile = fopen(szFile, "rb");
+    if(pFile == NULL)
+    {
+        fprintf(stderr, "%s: cannot open file\n", szFile);
+        return(false);
+    }
+
+    bool bRet = false;
+
+    IOLOGFILEHEADER zHeader;
+    if((fread(&zHeader, sizeof(zHeader), 1, pFile) != 1) || (zHeader.uMagic != IOLOG_MAGIC))
+    {
+        fprintf(stderr, "%s: no I/O log\n", szFile);
+    }
+    else if(zHeader.uVersion != IOLOG_VERSION)
+    {
+        fprintf(stderr, "%s: unsupported version %u\n", szFile, zHeader.uVersion);
+    }
+    else
+    {
+        // skip a bigger header of a newer version
+        fseek(pFile, zHeader.uHeaderSize, SEEK_SET);
+
+        vector<POINT> zPoints;
+        vector<uint8_t> zPayload;
+        uint64_t uRecords = 0;
+
+        bRet = true;
+
+        IOLOGRECORDHEADER zRecord;
+        while(fread(&zRecord, sizeof(zRecord), 1, pFile) == 1)
+        {
+            zPayload.resize(zRecord.uLength);
+            if((zRecord.uLength > 0) && (fread(zPayload.data(), zRecord.uLength, 1, pFile) != 1))
+            {
+                fprintf(stderr, "%s: truncated record after %" PRIu64 " records\n", szFile, uRecords);
+                bRet = false;
+                break;
+            }
+            uRecords++;
+
+            if(zRecord.uType == IOLOGRECORD_POINT)
+            {
+                if(zRecord.uLength < sizeof(IOLOGPOINTDEF))
+                {
+                    continue;
+                }
+                IOLOGPOINTDEF zDef;
+                memcpy(&zDef, zPayload.data(), sizeof(zDef));
+
+                if(zRecord.uIndex >= zPoints.size())
+                {
+                    zPoints.resize(zRecord.uIndex + 1);
+                }
+                POINT& zPoint = zPoints[zRecord.uIndex];
+                zPoint.strID.assign((const char*)zPayload.data() + sizeof(zDef), zRecord.uLength - sizeof(zDef));
+                zPoint.bIsBool = (zDef.bIsBool != 0);
+                zPoint.uSize = zDef.uSize;
+            }
+            else if(((zRecord.uType == IOLOGRECORD_VALUE) || (zRecord.uType == IOLOGRECORD_SUMMARY)) &&
+                    (zRecord.uLength >= sizeof(IOLOGVALUE)))
+            {
+                IOLOGVALUE zValue;
+                memcpy(&zValue, zPayload.data(), sizeof(zValue));
+
+                PrintTime(zHeader.uStartTimeNs, zValue.uTimeMs);
+                printf(" %-7s ", (zRecord.uType == IOLOGRECORD_VALUE) ? "VALUE" : "SUMMARY");
+
+                if(zRecord.uIndex < zPoints.size())
+                {
+                    const POINT& zPoint = zPoints[zRecord.uIndex];
+                    if(zPoint.bIsBool)
+                    {
+                        printf("%s: %s", zPoint.strID.c_str(), (zValue.uValue != 0) ? "true" : "false");
+                    }
+                    else
+                    {
+                        printf("%s: 0x%0*" PRIx64, zPoint.strID.c_str(), 2 * zPoint.uSize, zValue.uValue);
+                    }
+                }
+                else
+                {
+                    printf("#%u: 0x%" PRIx64, zRecord.uIndex, zValue.uValue);
+                }
+                printf(" (%u)\n", zValue.uCount);
+            }
+            // unknown records of newer versions are skipped
+        }
+    }
+
+    fclose(pFile);
+    return(bRet);
+}
+
+int main(int argc, char** argv)
+{
+    if(argc < 2)
+    {
+        fprintf(stderr, "usage: %s <IOLog.bin> [...]\n", argv[0]);
+        return(2);
+    }
+
+    int nRet = 0;
+    for(int nCount = 1; nCount < argc; nCount++)
+    {
+        if(DecodeFile(argv[nCount]) == false)
+        {
+            nRet = 1;
+        }
+    }
+
+    return(nRet);
+}
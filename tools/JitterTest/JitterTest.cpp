@@ -0,0 +1,443 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  JitterTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+// Measures the jitter of the unchanged realtime cycle of the sample runtime (CSampleRTThread::RTCycle)
+// against the GDS simulator, similar to cyclictest, while threads with a normal priority create CPU,
+// memory and logging load. This qualifies a kernel or a configuration for jitter before it is used
+// on a controller. Build from the root of the repository:
+//
+//   cmake -S tools -B build-tools && cmake --build build-tools --target JitterTest
+//   sudo ./build-tools/JitterTest [--duration 60] [--cpu-load 2] [--memory-load 1] [--memory-mb 64] [--log-rate 1000]
+//                                 [--affinity 1] [--mlock] [--histogram jitter.hist] [--layout file] 2> jitter.log
+//
+// The start of each cycle is taken when the cycle locks the input frame (ArpPlcGds_BeginRead). The
+// intervals between two cycle starts are collected in a histogram with 1 us buckets; the wakeup
+// latency is taken from the metrics of the realtime thread. If the process is not allowed to use
+// SCHED_FIFO, the realtime thread runs with a normal priority and the report says so. The exit code
+// is 1 if the realtime thread had overruns, 2 on errors and 0 otherwise.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <atomic>
+#include <vector>
+#include "GdsSimulator.h"
+#include "CSampleRTThread.h"
+#include "CEventLoop.h"
+
+using namespace std;
+
+#define JITTER_DURATION			60		// default run time in seconds
+#define JITTER_HISTOGRAM_US		10000	// range of the histogram in us, longer intervals are counted in the last bucket
+#define JITTER_LOGGING_INTERVAL	100		// interval of the I/O logging without SCHED_FIFO in ms, like LOGGING_INTERVAL
+#define JITTER_MEMORY_MB		64		// default size of the buffer of each memory load thread
+#define JITTER_CACHELINE		64
+#define JITTER_LAYOUT			"tools/GdsSimulator/AxioSample.layout"
+
+///	structure with the intervals between two cycle starts, written only by the realtime thread
+struct JITTERSTATS
+{
+    uint64 uCount = 0;			// number of intervals
+    uint64 uLastStartNs = 0;	// start of the last cycle, 0 before the first cycle
+    uint64 uMinNs = UINT64_MAX;
+    uint64 uMaxNs = 0;
+    uint64 uSumNs = 0;
+    double dSumSquares = 0;		// in us^2, for the standard deviation
+    uint64 uLate = 0;			// intervals longer than 1.5 cycles
+    uint64 zHistogram[JITTER_HISTOGRAM_US + 1] = {};
+};
+
+static JITTERSTATS g_zStats;
+static TGdsBuffer* g_pInBuffer = NULL;
+static std::atomic<bool> g_bLoadRunning(true);
+
+/// @brief			hook of the GDS simulator, takes the start of each cycle in the realtime thread
+/// @param pUser	not used
+/// @param pBuffer	accessed buffer
+/// @param bWrite	true: BeginWrite, false: BeginRead
+static void OnGdsAccess(void* pUser, TGdsBuffer* pBuffer, bool bWrite)
+{
+    (void)pUser;
+
+    if(bWrite || (pBuffer != g_pInBuffer))
+    {
+        return;
+    }
+
+    uint64 uNowNs = GetMonotonicTimeNs();
+    if(g_zStats.uLastStartNs != 0)
+    {
+        uint64 uIntervalNs = uNowNs - g_zStats.uLastStartNs;
+        uint64 uBucket = uIntervalNs / 1000;
+
+        g_zStats.uCount++;
+        g_zStats.uMinNs = min(g_zStats.uMinNs, uIntervalNs);
+        g_zStats.uMaxNs = max(g_zStats.uMaxNs, uIntervalNs);
+        g_zStats.uSumNs += uIntervalNs;
+        g_zStats.dSumSquares += (uIntervalNs / 1000.0) * (uIntervalNs / 1000.0);
+        g_zStats.zHistogram[min(uBucket, (uint64)JITTER_HISTOGRAM_US)]++;
+        if(uIntervalNs * 2 > (uint64)RTCYCLETIME * 3000)
+        {
+            g_zStats.uLate++;
+        }
+    }
+    g_zStats.uLastStartNs = uNowNs;
+}
+
+/// @brief	access to the realtime thread of the sample runtime, to run it without SCHED_FIFO
+class CJitterTest
+{
+public:
+    /// @brief				start the realtime cycle with a normal priority after Init failed at
+    /// 					the creation of the thread, everything else is set by Init
+    /// @param pRTThread	realtime object
+    /// @param pEventLoop	event loop for the logging timer
+    /// @return				true: success, false: failure
+    static bool StartWithNormalPriority(CSampleRTThread* pRTThread, CEventLoop* pEventLoop)
+    {
+        if((pthread_create(&pRTThread->m_zRTCycleThread, NULL, CSampleRTThread::RTStaticCycle, pRTThread) != 0) ||
+           (pEventLoop->AddTimer("RT logging", JITTER_LOGGING_INTERVAL, [pRTThread]() { pRTThread->LoggingCycle(); }) == false))
+        {
+            return(false);
+        }
+        pRTThread->m_bInitialized = true;
+        return(true);
+    }
+
+    /// @brief				bind the realtime thread to one CPU
+    /// @param pRTThread	realtime object
+    /// @param nCpu			number of CPU
+    /// @return				true: success, false: failure
+    static bool SetAffinity(CSampleRTThread* pRTThread, int nCpu)
+    {
+        cpu_set_t zCpus;
+        CPU_ZERO(&zCpus);
+        CPU_SET(nCpu, &zCpus);
+        return(pthread_setaffinity_np(pRTThread->m_zRTCycleThread, sizeof(zCpus), &zCpus) == 0);
+    }
+};
+
+/// @brief		static function to run the event loop in its own thread
+/// @param p	not used
+/// @return		never returns
+static void* EventLoopStaticCycle(void* p)
+{
+    (void)p;
+    g_zEventLoop.Run();
+    return(NULL);
+}
+
+/// @brief		CPU load: floating point calculations without memory access
+/// @param p	not used
+/// @return		NULL
+static void* CpuLoadCycle(void* p)
+{
+    (void)p;
+
+    volatile double dValue = 1.0;
+    while(g_bLoadRunning.load(std::memory_order_relaxed))
+    {
+        for(int nCount = 0; nCount < 100000; nCount++)
+        {
+            dValue = dValue * 1.0000001 + 0.0000001;
+        }
+    }
+    return(NULL);
+}
+
+/// @brief		memory load: read and write every cache line of a buffer which is larger than the caches
+/// @param p	size of buffer in MB
+/// @return		NULL
+static void* MemoryLoadCycle(void* p)
+{
+    size_t nSize = (size_t)(uintptr_t)p * 1024 * 1024;
+    vector<uint8> zBuffer(nSize, 0);
+
+    while(g_bLoadRunning.load(std::memory_order_relaxed))
+    {
+        for(size_t nOffset = 0; nOffset < nSize; nOffset += JITTER_CACHELINE)
+        {
+            zBuffer[nOffset]++;
+        }
+    }
+    return(NULL);
+}
+
+/// @brief		logging load: messages with the logger of the runtime at a fixed rate
+/// @param p	messages per second
+/// @return		NULL
+static void* LoggingLoadCycle(void* p)
+{
+    uint32 uRate = (uint32)(uintptr_t)p;
+    timespec zTime;
+    clock_gettime(CLOCK_MONOTONIC, &zTime);
+
+    uint64 uMessage = 0;
+    while(g_bLoadRunning.load(std::memory_order_relaxed))
+    {
+        Log::Info("Logging load: message {0} with some text to format, value {1:#010x}", uMessage, (uint32)uMessage);
+        uMessage++;
+
+        zTime.tv_nsec += 1000000000L / uRate;
+        while(zTime.tv_nsec >= 1000000000L)
+        {
+            zTime.tv_nsec -= 1000000000L;
+            zTime.tv_sec++;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &zTime, NULL);
+    }
+    return(NULL);
+}
+
+/// @brief				start load threads with a normal priority
+/// @param nThreads		number of threads
+/// @param fnCycle		function of thread
+/// @param p			argument of function
+/// @return				true: success, false: failure
+static bool StartLoad(int nThreads, void* (*fnCycle)(void*), void* p)
+{
+    for(int nCount = 0; nCount < nThreads; nCount++)
+    {
+        pthread_t zThread;
+        if(pthread_create(&zThread, NULL, fnCycle, p) != 0)
+        {
+            Log::Error("Error calling pthread_create (load thread)");
+            return(false);
+        }
+        pthread_detach(zThread);
+    }
+    return(true);
+}
+
+/// @brief				quantile of the interval histogram
+/// @param dQuantile	quantile, e.g. 0.99
+/// @return				upper end of the bucket in us
+static uint64 GetIntervalQuantileUs(double dQuantile)
+{
+    uint64 uRank = (uint64)ceil(dQuantile * g_zStats.uCount);
+    uint64 uSum = 0;
+    for(uint64 uBucket = 0; uBucket <= JITTER_HISTOGRAM_US; uBucket++)
+    {
+        uSum += g_zStats.zHistogram[uBucket];
+        if((uSum >= uRank) && (uSum > 0))
+        {
+            return(uBucket + 1);
+        }
+    }
+    return(JITTER_HISTOGRAM_US);
+}
+
+int main(int argc, char** argv)
+{
+    const char* szLayout = JITTER_LAYOUT;
+    const char* szHistogram = NULL;
+    uint32 uDuration = JITTER_DURATION;
+    int nCpuLoad = 0;
+    int nMemoryLoad = 0;
+    uint32 uMemoryMb = JITTER_MEMORY_MB;
+    uint32 uLogRate = 0;
+    int nAffinity = -1;
+    bool bMlock = false;
+
+    // the messages of the runtime go to stderr, only warnings and errors without a logging load
+    g_nSimLogLevel = 2;
+
+    for(int nCount = 1; nCount < argc; nCount++)
+    {
+        bool bValue = (nCount + 1 < argc);
+        if((strcmp(argv[nCount], "--duration") == 0) && bValue)
+        {
+            uDuration = (uint32)atoi(argv[++nCount]);
+        }
+        else if((strcmp(argv[nCount], "--cpu-load") == 0) && bValue)
+        {
+            nCpuLoad = atoi(argv[++nCount]);
+        }
+        else if((strcmp(argv[nCount], "--memory-load") == 0) && bValue)
+        {
+            nMemoryLoad = atoi(argv[++nCount]);
+        }
+        else if((strcmp(argv[nCount], "--memory-mb") == 0) && bValue)
+        {
+            uMemoryMb = (uint32)atoi(argv[++nCount]);
+        }
+        else if((strcmp(argv[nCount], "--log-rate") == 0) && bValue)
+        {
+            uLogRate = (uint32)atoi(argv[++nCount]);
+        }
+        else if((strcmp(argv[nCount], "--affinity") == 0) && bValue)
+        {
+            nAffinity = atoi(argv[++nCount]);
+        }
+        else if((strcmp(argv[nCount], "--histogram") == 0) && bValue)
+        {
+            szHistogram = argv[++nCount];
+        }
+        else if((strcmp(argv[nCount], "--layout") == 0) && bValue)
+        {
+            szLayout = argv[++nCount];
+        }
+        else if(strcmp(argv[nCount], "--mlock") == 0)
+        {
+            bMlock = true;
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--duration s] [--cpu-load threads] [--memory-load threads] [--memory-mb MB] [--log-rate messages/s]\n"
+                            "       [--affinity cpu] [--mlock] [--histogram file] [--layout file]\n", argv[0]);
+            return(2);
+        }
+    }
+    if(uLogRate > 0)
+    {
+        g_nSimLogLevel = 1;
+    }
+
+    // like cyclictest, page faults of the realtime thread are avoided
+    if(bMlock && (mlockall(MCL_CURRENT | MCL_FUTURE) != 0))
+    {
+        Log::Warning("mlockall failed, the memory is not locked");
+        bMlock = false;
+    }
+
+    if(g_zGdsSimulator.LoadLayout(szLayout) == false)
+    {
+        return(2);
+    }
+    if(ArpPlcIo_GetBufferPtrByBufferID("Arp.Io.AxlC", "1:IN", &g_pInBuffer) == false)
+    {
+        Log::Error("The layout has no input buffer Arp.Io.AxlC 1:IN");
+        return(2);
+    }
+    g_zGdsSimulator.SetAccessHook(OnGdsAccess, NULL);
+    if(g_zGdsSimulator.StartBus() == false)
+    {
+        return(2);
+    }
+
+    pthread_t zEventLoopThread;
+    if((g_zEventLoop.Init() == false) || (pthread_create(&zEventLoopThread, NULL, EventLoopStaticCycle, NULL) != 0))
+    {
+        Log::Error("Could not start the event loop");
+        return(2);
+    }
+    pthread_detach(zEventLoopThread);
+
+    CSetpointMailbox zSetpointMailbox;
+    CResultMailbox zResultMailbox;
+    DEVICESTATUS zDeviceStatus;
+    RUNTIMEMETRICS zMetrics;
+
+    // the thread runs forever and uses the metrics, so it is never deleted
+    CSampleRTThread* pRTThread = new CSampleRTThread();
+    const char* szPolicy = "SCHED_FIFO";
+    if(pRTThread->Init(&zSetpointMailbox, &zResultMailbox, &zDeviceStatus, &zMetrics, &g_zEventLoop) == false)
+    {
+        // the same cycle runs with a normal priority, so the harness can be used without root,
+        // but the numbers only show the behaviour of a normal thread
+        Log::Warning("No permission for SCHED_FIFO (root or CAP_SYS_NICE), the realtime thread runs with SCHED_OTHER");
+        szPolicy = "SCHED_OTHER";
+
+        if(CJitterTest::StartWithNormalPriority(pRTThread, &g_zEventLoop) == false)
+        {
+            Log::Error("The realtime thread could not be started");
+            return(2);
+        }
+    }
+
+    if(nAffinity >= 0)
+    {
+        if(CJitterTest::SetAffinity(pRTThread, nAffinity) == false)
+        {
+            Log::Warning("The realtime thread could not be bound to CPU {0}", nAffinity);
+            nAffinity = -1;
+        }
+    }
+
+    if((StartLoad(nCpuLoad, CpuLoadCycle, NULL) == false) ||
+       (StartLoad(nMemoryLoad, MemoryLoadCycle, (void*)(uintptr_t)uMemoryMb) == false) ||
+       (StartLoad((uLogRate > 0) ? 1 : 0, LoggingLoadCycle, (void*)(uintptr_t)uLogRate) == false))
+    {
+        return(2);
+    }
+
+    if(pRTThread->StartProcessing(PlcOperation_StartWarm) == false)
+    {
+        return(2);
+    }
+
+    // the realtime thread starts at the next full second
+    sleep(uDuration + 1);
+
+    pRTThread->StopProcessing();
+    g_bLoadRunning = false;
+    g_zGdsSimulator.StopBus();
+
+    // the realtime thread is outside of its cycle, so the statistics do not change anymore
+    uint64 uOverruns = zMetrics.uRTOverruns.load();
+    double dMeanUs = (g_zStats.uCount > 0) ? g_zStats.uSumNs / 1000.0 / g_zStats.uCount : 0;
+    double dStdDevUs = (g_zStats.uCount > 0) ? sqrt(max(0.0, g_zStats.dSumSquares / g_zStats.uCount - dMeanUs * dMeanUs)) : 0;
+    double dMaxJitterUs = (g_zStats.uCount > 0) ? max(g_zStats.uMaxNs / 1000.0 - RTCYCLETIME, RTCYCLETIME - g_zStats.uMinNs / 1000.0) : 0;
+
+    printf("\npolicy %s, cpu %s, mlock %s, load: %d cpu, %d memory (%u MB), %u log messages/s\n", szPolicy,
+           (nAffinity >= 0) ? to_string(nAffinity).c_str() : "any", bMlock ? "yes" : "no",
+           nCpuLoad, nMemoryLoad, uMemoryMb, uLogRate);
+    printf("cycle %u us, %llu intervals\n", RTCYCLETIME, (unsigned long long)g_zStats.uCount);
+    printf("interval us: min %.1f, mean %.1f, max %.1f, stddev %.1f, p99 %llu, p99.9 %llu\n",
+           (g_zStats.uCount > 0) ? g_zStats.uMinNs / 1000.0 : 0.0, dMeanUs, g_zStats.uMaxNs / 1000.0, dStdDevUs,
+           (unsigned long long)GetIntervalQuantileUs(0.99), (unsigned long long)GetIntervalQuantileUs(0.999));
+    printf("max. jitter %.1f us, intervals > 1.5 cycles %llu\n", dMaxJitterUs, (unsigned long long)g_zStats.uLate);
+    printf("wakeup latency us: p50 %.1f, p99 %.1f, p99.9 %.1f, max %.1f\n",
+           zMetrics.zRTWakeupLatency.GetQuantileNs(0.5) / 1000.0, zMetrics.zRTWakeupLatency.GetQuantileNs(0.99) / 1000.0,
+           zMetrics.zRTWakeupLatency.GetQuantileNs(0.999) / 1000.0, zMetrics.zRTWakeupLatency.GetMaxNs() / 1000.0);
+    if(zMetrics.zRTSpinTime.GetCount() > 0)
+    {
+        printf("spin time us: p50 %.1f, max %.1f, guard %.1f us, late wakeups %llu\n",
+               zMetrics.zRTSpinTime.GetQuantileNs(0.5) / 1000.0, zMetrics.zRTSpinTime.GetMaxNs() / 1000.0,
+               zMetrics.uRTWakeupGuardNs.load() / 1000.0, (unsigned long long)zMetrics.uRTLateWakeups.load());
+    }
+    printf("cycle duration us: p50 %.1f, p99 %.1f, max %.1f\n",
+           zMetrics.zRTCycleDuration.GetQuantileNs(0.5) / 1000.0, zMetrics.zRTCycleDuration.GetQuantileNs(0.99) / 1000.0,
+           zMetrics.zRTCycleDuration.GetMaxNs() / 1000.0);
+    printf("rt cycles %llu, overruns %llu\n", (unsigned long long)zMetrics.uRTCycles.load(), (unsigned long long)uOverruns);
+
+    // like the histogram of cyclictest: one line per bucket with the interval in us and the count
+    if(szHistogram != NULL)
+    {
+        FILE* pFile = fopen(szHistogram, "w");
+        if(pFile != NULL)
+        {
+            fprintf(pFile, "# interval of %u us cycle, policy %s\n# us count\n", RTCYCLETIME, szPolicy);
+            for(uint64 uBucket = 0; uBucket <= JITTER_HISTOGRAM_US; uBucket++)
+            {
+                if(g_zStats.zHistogram[uBucket] > 0)
+                {
+                    fprintf(pFile, "%06llu %llu\n", (unsigned long long)uBucket, (unsigned long long)g_zStats.zHistogram[uBucket]);
+                }
+            }
+            fclose(pFile);
+        }
+        else
+        {
+            Log::Error("Cannot create histogram file {0}", szHistogram);
+        }
+    }
+
+    // the realtime thread and the event loop never return
+    fflush(stdout);
+    _exit((uOverruns > 0) ? 1 : 0);
+}
@@ -0,0 +1,119 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  ProcessImageReader.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+// Example reader of the process image of the sample runtime (see CProcessImagePublisher).
+// It runs as a separate process on the controller and prints the values of all I/Os. For the
+// controller it is built with the SDK like the runtime, on the host next to SimRuntime with:
+//
+//   cmake -S tools -B build-tools && cmake --build build-tools --target ProcessImageReader
+//   ./build-tools/ProcessImageReader [count] [interval in ms]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <vector>
+#include "CProcessImageReader.h"
+
+using namespace std;
+
+int main(int argc, char** argv)
+{
+    int nCount = (argc > 1) ? atoi(argv[1]) : 1;
+    int nIntervalMs = (argc > 2) ? atoi(argv[2]) : 1000;
+
+    CProcessImageReader zReader;
+    if(zReader.Open() == false)
+    {
+        fprintf(stderr, "cannot open %s, is the runtime running?\n", PROCESSIMAGE_SHM_NAME);
+        return(1);
+    }
+
+    for(int nLoop = 0; (nCount <= 0) || (nLoop < nCount); nLoop++)
+    {
+        if(zReader.IsStale())
+        {
+            // a new program was loaded, the layout might have changed
+            printf("layout changed, opening again\n");
+            if(zReader.Open() == false)
+            {
+                usleep(nIntervalMs * 1000);
+                continue;
+            }
+        }
+
+        // copy all values of one cycle, a real application would only read what it needs
+        vector<uint64_t> zValues(zReader.GetEntryCount());
+        uint64_t uCycle = 0;
+        uint32_t uValid = 0;
+        uint32_t uInputFresh = 0;
+        uint64_t uInputStaleCycles = 0;
+        uint64_t uInputAgeUs = 0;
+        bool bConsistent = zReader.Read([&](const unsigned char* pSegment)
+        {
+            // the state of the image is protected by the seqlock like the values
+            const PROCESSIMAGEHEADER* pHeader = (const PROCESSIMAGEHEADER*)pSegment;
+            uValid = pHeader->uValid;
+            uInputFresh = pHeader->uInputFresh;
+            uInputStaleCycles = pHeader->uInputStaleCycles;
+            uInputAgeUs = pHeader->uInputAgeUs;
+
+            for(size_t nIndex = 0; nIndex < zValues.size(); nIndex++)
+            {
+                const PROCESSIMAGEENTRY* pEntry = zReader.GetEntry(nIndex);
+                zValues[nIndex] = 0;
+                if(pEntry->uBitMask != 0)
+                {
+                    zValues[nIndex] = ((pSegment[pEntry->uOffset] & pEntry->uBitMask) != 0) ? 1 : 0;
+                }
+                else
+                {
+                    memcpy(&zValues[nIndex], pSegment + pEntry->uOffset, (pEntry->uSize < 8) ? pEntry->uSize : 8);
+                }
+            }
+        }, 1000, &uCycle);
+
+        if(bConsistent)
+        {
+            printf("cycle %" PRIu64 " (%s, inputs %s", uCycle, uValid ? "valid" : "not valid", uInputFresh ? "fresh" : "stale");
+            if(uInputFresh == 0)
+            {
+                if(uInputAgeUs == UINT64_MAX)
+                {
+                    printf(" since start");
+                }
+                else
+                {
+                    printf(" for %" PRIu64 " cycles, %" PRIu64 " us", uInputStaleCycles, uInputAgeUs);
+                }
+            }
+            printf(")\n");
+            for(size_t nIndex = 0; nIndex < zValues.size(); nIndex++)
+            {
+                const PROCESSIMAGEENTRY* pEntry = zReader.GetEntry(nIndex);
+                printf("  %-7s %-48s 0x%0*" PRIx64 "\n",
+                       (pEntry->uArea == PROCESSIMAGE_INPUTS) ? "input" : (pEntry->uArea == PROCESSIMAGE_OUTPUTS) ? "output" : "diag",
+                       pEntry->szID, (pEntry->uBitMask != 0) ? 1 : 2 * ((pEntry->uSize < 8) ? pEntry->uSize : 8), zValues[nIndex]);
+            }
+        }
+        else
+        {
+            printf("no consistent image\n");
+        }
+
+        if((nCount <= 0) || (nLoop + 1 < nCount))
+        {
+            usleep(nIntervalMs * 1000);
+        }
+    }
+
+    return(0);
+}
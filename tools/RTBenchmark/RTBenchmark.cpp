@@ -0,0 +1,629 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  RTBenchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+// Microbenchmarks for the hot path of the realtime thread: ReadValue, WriteValue, ReadInputData,
+// WriteOutputData and DoLogic of CSampleRTThread, measured on a Linux host with the GDS simulator
+// (see tools/GdsSimulator). Every function is measured for 10 to 100000 I/Os, for bool, byte,
+// word and mixed I/Os, and with dense offsets (packed frame) and sparse offsets (one I/O per
+// cache line). Build from the root of the repository:
+//
+//   cmake -S tools -B build-tools && cmake --build build-tools --target RTBenchmark
+//   ./build-tools/RTBenchmark [--quick] [--filter ReadValue] [--output current.jsonl] [--baseline baseline.jsonl] [--threshold-pct 10] [-v]
+//
+// The results are printed as a table and written as one JSON object per line to the output file.
+// With a baseline file, every result which is slower per I/O than the threshold allows is flagged
+// as a regression. Cache misses and references are counted with perf events, if the kernel allows
+// it (perf_event_paranoid), otherwise they are null. The exit code is 1 if there is at least one
+// regression, 2 on errors and 0 otherwise. Like the runtime, the benchmark creates the retain
+// file in retain/ of the current directory and the shared process image.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "GdsSimulator.h"
+#include "CSampleRTThread.h"
+
+using namespace std;
+
+#define RTBENCH_POINTS_PER_RUN	2000000		// I/Os per repetition, the number of calls is derived from it
+#define RTBENCH_QUICK_DIVIDER	20			// fewer I/Os per repetition with --quick
+#define RTBENCH_REPETITIONS		5			// the median of the repetitions is reported
+#define RTBENCH_SPARSE_STRIDE	64			// distance of two I/Os with sparse offsets in bytes
+#define RTBENCH_WORD_SIZE		2			// size of a word I/O in bytes
+#define RTBENCH_THRESHOLD_PCT	10			// default threshold for regressions in percent
+
+#define RTBENCH_IOSYSTEM		"Arp.Io.AxlC"
+#define RTBENCH_IN_BUFFER		"1:IN"
+#define RTBENCH_OUT_BUFFER		"1:OUT"
+
+static const uint32 g_uPointCounts[] = { 10, 100, 1000, 10000, 100000 };
+
+///	kind of the I/Os of one benchmark
+enum BENCHMIX
+{
+    BENCHMIX_BOOL = 0,
+    BENCHMIX_BYTE,
+    BENCHMIX_WORD,
+    BENCHMIX_MIXED,		// two bools, one byte and one word
+    BENCHMIX_COUNT
+};
+
+static const char* g_szMixNames[BENCHMIX_COUNT] = { "bool", "byte", "word", "mixed" };
+
+///	structure with the result of one measurement
+struct BENCHRESULT
+{
+    string strBenchmark;
+    uint32 uPoints = 0;
+    string strMix;
+    string strLayout;
+    uint64 uIterations = 0;			// calls per repetition
+    double dNsPerCall = 0;
+    double dNsPerPoint = 0;
+    bool bPerf = false;				// are the cache counters valid?
+    double dCacheMissesPerCall = 0;
+    double dCacheRefsPerCall = 0;
+};
+
+///	structure with the file descriptors of the perf events, -1 if not available
+struct PERFCOUNTERS
+{
+    int nMissesFd = -1;
+    int nRefsFd = -1;
+};
+
+/// @brief			open a hardware counter of the current thread, only user space is counted
+/// @param uConfig	PERF_COUNT_HW_...
+/// @return			file descriptor, -1 if perf events are not available
+static int OpenPerfCounter(uint64 uConfig)
+{
+    perf_event_attr zAttr;
+    memset(&zAttr, 0, sizeof(zAttr));
+    zAttr.type = PERF_TYPE_HARDWARE;
+    zAttr.size = sizeof(zAttr);
+    zAttr.config = uConfig;
+    zAttr.disabled = 1;
+    zAttr.exclude_kernel = 1;
+    zAttr.exclude_hv = 1;
+
+    return((int)syscall(__NR_perf_event_open, &zAttr, 0, -1, -1, 0));
+}
+
+/// @brief			read a counter
+/// @param nFd		file descriptor of counter
+/// @return			value
+static uint64 ReadPerfCounter(int nFd)
+{
+    uint64 uValue = 0;
+    if(read(nFd, &uValue, sizeof(uValue)) != sizeof(uValue))
+    {
+        uValue = 0;
+    }
+    return(uValue);
+}
+
+/// @brief	benchmark of the copy functions of one CSampleRTThread with a generated I/O layout.
+/// 		The realtime thread itself is not started, the functions are called directly
+class CRTBenchmark
+{
+public:
+    CRTBenchmark();
+    virtual ~CRTBenchmark();
+
+    bool Setup(uint32 uPoints, BENCHMIX zMix, bool bSparse);
+    void Teardown();
+    void Run(const char* szFilter, uint64 uPointsPerRun, vector<BENCHRESULT>& zResults);
+
+private:
+    CSampleRTThread* m_pRT;
+    CSetpointMailbox m_zSetpointMailbox;
+    CResultMailbox m_zResultMailbox;
+    RUNTIMEMETRICS m_zMetrics;
+    PERFCOUNTERS m_zPerf;
+
+    uint32 m_uPoints;
+    BENCHMIX m_zMix;
+    bool m_bSparse;
+
+    template<typename F>
+    BENCHRESULT Measure(const char* szName, size_t nPointsPerCall, uint64 uPointsPerRun, F fnCall);
+};
+
+CRTBenchmark::CRTBenchmark()
+          : m_pRT(NULL),
+            m_uPoints(0),
+            m_zMix(BENCHMIX_BOOL),
+            m_bSparse(false)
+{
+    m_zPerf.nMissesFd = OpenPerfCounter(PERF_COUNT_HW_CACHE_MISSES);
+    m_zPerf.nRefsFd = OpenPerfCounter(PERF_COUNT_HW_CACHE_REFERENCES);
+    if((m_zPerf.nMissesFd < 0) || (m_zPerf.nRefsFd < 0))
+    {
+        Log::Warning("perf events are not available, the cache counters are not measured");
+    }
+}
+
+CRTBenchmark::~CRTBenchmark()
+{
+    Teardown();
+
+    if(m_zPerf.nMissesFd >= 0)
+    {
+        close(m_zPerf.nMissesFd);
+    }
+    if(m_zPerf.nRefsFd >= 0)
+    {
+        close(m_zPerf.nRefsFd);
+    }
+}
+
+/// @brief			create the simulated buffers and compile the I/O plans of a new realtime object
+/// @param uPoints	number of inputs and of outputs
+/// @param zMix		kind of the I/Os
+/// @param bSparse	true: one I/O per cache line, false: packed frame
+/// @return			true: success, false: failure
+bool CRTBenchmark::Setup(uint32 uPoints, BENCHMIX zMix, bool bSparse)
+{
+    Teardown();
+
+    m_uPoints = uPoints;
+    m_zMix = zMix;
+    m_bSparse = bSparse;
+
+    // offsets of all I/Os, bools of a dense frame share their bytes
+    vector<size_t> zOffsets(uPoints);
+    vector<int> zBitOffsets(uPoints);
+    vector<size_t> zSizes(uPoints);
+    size_t nFrameSize = 0;
+    int nNextBit = 8;	// no partly used byte yet
+
+    for(uint32 uCount = 0; uCount < uPoints; uCount++)
+    {
+        BENCHMIX zKind = zMix;
+        if(zMix == BENCHMIX_MIXED)
+        {
+            static const BENCHMIX zPattern[4] = { BENCHMIX_BOOL, BENCHMIX_BOOL, BENCHMIX_BYTE, BENCHMIX_WORD };
+            zKind = zPattern[uCount % 4];
+        }
+        zSizes[uCount] = (zKind == BENCHMIX_WORD) ? RTBENCH_WORD_SIZE : 1;
+        zBitOffsets[uCount] = (zKind == BENCHMIX_BOOL) ? 0 : -1;
+
+        if(bSparse)
+        {
+            zOffsets[uCount] = (size_t)uCount * RTBENCH_SPARSE_STRIDE;
+            if(zKind == BENCHMIX_BOOL)
+            {
+                zBitOffsets[uCount] = uCount % 8;
+            }
+            nFrameSize = zOffsets[uCount] + RTBENCH_SPARSE_STRIDE;
+        }
+        else if(zKind == BENCHMIX_BOOL)
+        {
+            if(nNextBit == 8)
+            {
+                nFrameSize++;
+                nNextBit = 0;
+            }
+            zOffsets[uCount] = nFrameSize - 1;
+            zBitOffsets[uCount] = nNextBit++;
+        }
+        else
+        {
+            zOffsets[uCount] = nFrameSize;
+            nFrameSize += zSizes[uCount];
+            nNextBit = 8;
+        }
+    }
+
+    bool bRet = g_zGdsSimulator.AddBuffer(RTBENCH_IOSYSTEM, RTBENCH_IN_BUFFER, nFrameSize, GDSSIM_INPUT) &&
+                g_zGdsSimulator.AddBuffer(RTBENCH_IOSYSTEM, RTBENCH_OUT_BUFFER, nFrameSize, GDSSIM_OUTPUT);
+
+    // the names are sorted like the offsets, so the plans access the frames in ascending order
+    vector<string> zNames(uPoints);
+    for(uint32 uCount = 0; bRet && (uCount < uPoints); uCount++)
+    {
+        char szName[64];
+        snprintf(szName, sizeof(szName), "%s/0.P%06u", RTBENCH_IOSYSTEM, uCount);
+        zNames[uCount] = szName;
+        bRet = g_zGdsSimulator.AddVariable(RTBENCH_IOSYSTEM, RTBENCH_IN_BUFFER, szName, zOffsets[uCount], zBitOffsets[uCount]) &&
+               g_zGdsSimulator.AddVariable(RTBENCH_IOSYSTEM, RTBENCH_OUT_BUFFER, szName, zOffsets[uCount], zBitOffsets[uCount]);
+    }
+    if(bRet == false)
+    {
+        return(bRet);
+    }
+
+    // no bus thread, the frames keep the values of the benchmark
+    g_zGdsSimulator.MarkValid();
+
+    m_pRT = new CSampleRTThread();
+    m_pRT->m_pSetpointMailbox = &m_zSetpointMailbox;
+    m_pRT->m_pResultMailbox = &m_zResultMailbox;
+    m_pRT->m_pMetrics = &m_zMetrics;
+
+    if((ArpPlcIo_GetBufferPtrByBufferID(RTBENCH_IOSYSTEM, RTBENCH_IN_BUFFER, &m_pRT->m_pGdsInBuffer) == false) ||
+       (ArpPlcIo_GetBufferPtrByBufferID(RTBENCH_IOSYSTEM, RTBENCH_OUT_BUFFER, &m_pRT->m_pGdsOutBuffer) == false))
+    {
+        return(false);
+    }
+
+    for(uint32 uCount = 0; bRet && (uCount < uPoints); uCount++)
+    {
+        bool bIsBool = (zBitOffsets[uCount] >= 0);
+        bRet = m_pRT->AddInput(zNames[uCount], zSizes[uCount], bIsBool) &&
+               m_pRT->AddOutput(zNames[uCount], zSizes[uCount], bIsBool);
+    }
+
+    // the logic uses the first I/Os of the benchmark, there are at least 10
+    m_pRT->m_strIn04 = zNames[0];
+    m_pRT->m_strIn05 = zNames[1];
+    m_pRT->m_strOut04 = zNames[0];
+    m_pRT->m_strOut05 = zNames[1];
+    m_pRT->m_strOut06 = zNames[2];
+    m_pRT->m_strOut07 = zNames[3];
+
+    return(bRet && m_pRT->CompileIOPlans());
+}
+
+/// @brief	release the realtime object and the simulated buffers
+void CRTBenchmark::Teardown()
+{
+    if(m_pRT != NULL)
+    {
+        m_pRT->ReleaseResources();
+        delete m_pRT;
+        m_pRT = NULL;
+    }
+    g_zGdsSimulator.Clear();
+}
+
+/// @brief					measure the median time of one call
+/// @param szName			name of benchmark
+/// @param nPointsPerCall	I/Os processed by one call
+/// @param uPointsPerRun	I/Os per repetition
+/// @param fnCall			benchmarked call
+/// @return					result
+template<typename F>
+BENCHRESULT CRTBenchmark::Measure(const char* szName, size_t nPointsPerCall, uint64 uPointsPerRun, F fnCall)
+{
+    BENCHRESULT zResult;
+    zResult.strBenchmark = szName;
+    zResult.uPoints = m_uPoints;
+    zResult.strMix = g_szMixNames[m_zMix];
+    zResult.strLayout = m_bSparse ? "sparse" : "dense";
+    zResult.uIterations = max((uint64)1, uPointsPerRun / max((size_t)1, nPointsPerCall));
+
+    // warm up the caches and the branch predictors
+    for(uint64 uCount = 0; uCount < zResult.uIterations / 10 + 1; uCount++)
+    {
+        fnCall();
+    }
+
+    bool bPerf = (m_zPerf.nMissesFd >= 0) && (m_zPerf.nRefsFd >= 0);
+    if(bPerf)
+    {
+        ioctl(m_zPerf.nMissesFd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(m_zPerf.nRefsFd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(m_zPerf.nMissesFd, PERF_EVENT_IOC_ENABLE, 0);
+        ioctl(m_zPerf.nRefsFd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    vector<double> zTimes;
+    for(int nRepetition = 0; nRepetition < RTBENCH_REPETITIONS; nRepetition++)
+    {
+        uint64 uStartNs = GetMonotonicTimeNs();
+        for(uint64 uCount = 0; uCount < zResult.uIterations; uCount++)
+        {
+            fnCall();
+        }
+        zTimes.push_back((double)(GetMonotonicTimeNs() - uStartNs) / zResult.uIterations);
+    }
+
+    if(bPerf)
+    {
+        ioctl(m_zPerf.nMissesFd, PERF_EVENT_IOC_DISABLE, 0);
+        ioctl(m_zPerf.nRefsFd, PERF_EVENT_IOC_DISABLE, 0);
+        double dCalls = (double)zResult.uIterations * RTBENCH_REPETITIONS;
+        zResult.bPerf = true;
+        zResult.dCacheMissesPerCall = ReadPerfCounter(m_zPerf.nMissesFd) / dCalls;
+        zResult.dCacheRefsPerCall = ReadPerfCounter(m_zPerf.nRefsFd) / dCalls;
+    }
+
+    sort(zTimes.begin(), zTimes.end());
+    zResult.dNsPerCall = zTimes[zTimes.size() / 2];
+    zResult.dNsPerPoint = zResult.dNsPerCall / max((size_t)1, nPointsPerCall);
+
+    return(zResult);
+}
+
+/// @brief					run all benchmarks for the current layout
+/// @param szFilter			only benchmarks which contain this text, NULL for all
+/// @param uPointsPerRun	I/Os per repetition
+/// @param zResults			the results are appended
+void CRTBenchmark::Run(const char* szFilter, uint64 uPointsPerRun, vector<BENCHRESULT>& zResults)
+{
+    CSampleRTThread* pRT = m_pRT;
+    vector<RAWIO*>& zInputPlan = pRT->m_zInputPlan;
+    vector<RAWIO*>& zOutputPlan = pRT->m_zOutputPlan;
+
+    // the copy loops of ReadInputData and WriteOutputData without locking and process image
+    if((szFilter == NULL) || (strstr("ReadValue", szFilter) != NULL))
+    {
+        char* pFrame = NULL;
+        ArpPlcGds_BeginRead(pRT->m_pGdsInBuffer, &pFrame);
+        zResults.push_back(Measure("ReadValue", zInputPlan.size(), uPointsPerRun, [&]()
+        {
+            for(size_t nCount = 0; nCount < zInputPlan.size(); nCount++)
+            {
+                pRT->ReadValue(pFrame, *zInputPlan[nCount]);
+            }
+        }));
+        ArpPlcGds_EndRead(pRT->m_pGdsInBuffer);
+    }
+    if((szFilter == NULL) || (strstr("WriteValue", szFilter) != NULL))
+    {
+        char* pFrame = NULL;
+        ArpPlcGds_BeginWrite(pRT->m_pGdsOutBuffer, &pFrame);
+        zResults.push_back(Measure("WriteValue", zOutputPlan.size(), uPointsPerRun, [&]()
+        {
+            for(size_t nCount = 0; nCount < zOutputPlan.size(); nCount++)
+            {
+                pRT->WriteValue(pFrame, *zOutputPlan[nCount]);
+            }
+        }));
+        ArpPlcGds_EndWrite(pRT->m_pGdsOutBuffer);
+    }
+
+    // the complete functions of the cycle
+    if((szFilter == NULL) || (strstr("ReadInputData", szFilter) != NULL))
+    {
+        zResults.push_back(Measure("ReadInputData", zInputPlan.size(), uPointsPerRun, [&]() { pRT->ReadInputData(); }));
+    }
+    if((szFilter == NULL) || (strstr("WriteOutputData", szFilter) != NULL))
+    {
+        zResults.push_back(Measure("WriteOutputData", zOutputPlan.size(), uPointsPerRun, [&]() { pRT->WriteOutputData(); }));
+    }
+    if((szFilter == NULL) || (strstr("DoLogic", szFilter) != NULL))
+    {
+        // the logic uses 2 inputs and 4 outputs independent of the number of I/Os
+        zResults.push_back(Measure("DoLogic", 6, uPointsPerRun / 100, [&]() { pRT->DoLogic(); }));
+    }
+}
+
+/// @brief			key of a result to find it in the baseline
+/// @param zResult	result
+/// @return			key
+static string GetKey(const BENCHRESULT& zResult)
+{
+    return(zResult.strBenchmark + "/" + to_string(zResult.uPoints) + "/" + zResult.strMix + "/" + zResult.strLayout);
+}
+
+/// @brief			one result as a JSON object
+/// @param zResult	result
+/// @return			JSON object without line feed
+static string FormatResult(const BENCHRESULT& zResult)
+{
+    char szLine[512];
+    int nLength = snprintf(szLine, sizeof(szLine),
+                           "{\"benchmark\":\"%s\",\"points\":%u,\"mix\":\"%s\",\"layout\":\"%s\",\"iterations\":%llu,"
+                           "\"ns_per_call\":%.3f,\"ns_per_point\":%.4f,",
+                           zResult.strBenchmark.c_str(), zResult.uPoints, zResult.strMix.c_str(), zResult.strLayout.c_str(),
+                           (unsigned long long)zResult.uIterations, zResult.dNsPerCall, zResult.dNsPerPoint);
+    if(zResult.bPerf)
+    {
+        snprintf(szLine + nLength, sizeof(szLine) - nLength, "\"cache_misses_per_call\":%.3f,\"cache_refs_per_call\":%.3f}",
+                 zResult.dCacheMissesPerCall, zResult.dCacheRefsPerCall);
+    }
+    else
+    {
+        snprintf(szLine + nLength, sizeof(szLine) - nLength, "\"cache_misses_per_call\":null,\"cache_refs_per_call\":null}");
+    }
+    return(szLine);
+}
+
+/// @brief				text value after a key
+/// @param strLine		JSON object
+/// @param szKey		key including quotes and colon
+/// @return				value, empty if not found
+static string GetText(const string& strLine, const char* szKey)
+{
+    size_t nPos = strLine.find(szKey);
+    if(nPos == string::npos)
+    {
+        return("");
+    }
+    nPos += strlen(szKey) + 1;	// skip the opening quote
+    return(strLine.substr(nPos, strLine.find('"', nPos) - nPos));
+}
+
+/// @brief				number after a key
+/// @param strLine		JSON object
+/// @param szKey		key including quotes and colon
+/// @return				value, 0 if not found
+static double GetNumber(const string& strLine, const char* szKey)
+{
+    size_t nPos = strLine.find(szKey);
+    return((nPos != string::npos) ? strtod(strLine.c_str() + nPos + strlen(szKey), NULL) : 0);
+}
+
+/// @brief				read the results of an earlier run
+/// @param szFile		name of file
+/// @param zResults		results
+/// @return				true: success, false: failure
+static bool ReadResults(const char* szFile, vector<BENCHRESULT>& zResults)
+{
+    FILE* pFile = fopen(szFile, "r");
+    if(pFile == NULL)
+    {
+        fprintf(stderr, "%s: cannot open file\n", szFile);
+        return(false);
+    }
+
+    char szBuffer[1024];
+    while(fgets(szBuffer, sizeof(szBuffer), pFile) != NULL)
+    {
+        string strLine(szBuffer);
+        if(strLine.find("\"benchmark\":") == string::npos)
+        {
+            continue;
+        }
+
+        BENCHRESULT zResult;
+        zResult.strBenchmark = GetText(strLine, "\"benchmark\":");
+        zResult.uPoints = (uint32)GetNumber(strLine, "\"points\":");
+        zResult.strMix = GetText(strLine, "\"mix\":");
+        zResult.strLayout = GetText(strLine, "\"layout\":");
+        zResult.dNsPerCall = GetNumber(strLine, "\"ns_per_call\":");
+        zResult.dNsPerPoint = GetNumber(strLine, "\"ns_per_point\":");
+        zResults.push_back(zResult);
+    }
+    fclose(pFile);
+
+    return(zResults.empty() == false);
+}
+
+int main(int argc, char** argv)
+{
+    const char* szOutput = NULL;
+    const char* szBaseline = NULL;
+    const char* szFilter = NULL;
+    double dThresholdPct = RTBENCH_THRESHOLD_PCT;
+    uint64 uPointsPerRun = RTBENCH_POINTS_PER_RUN;
+
+    // only warnings and errors of the runtime code
+    g_nSimLogLevel = 2;
+
+    for(int nCount = 1; nCount < argc; nCount++)
+    {
+        if((strcmp(argv[nCount], "--output") == 0) && (nCount + 1 < argc))
+        {
+            szOutput = argv[++nCount];
+        }
+        else if((strcmp(argv[nCount], "--baseline") == 0) && (nCount + 1 < argc))
+        {
+            szBaseline = argv[++nCount];
+        }
+        else if((strcmp(argv[nCount], "--filter") == 0) && (nCount + 1 < argc))
+        {
+            szFilter = argv[++nCount];
+        }
+        else if((strcmp(argv[nCount], "--threshold-pct") == 0) && (nCount + 1 < argc))
+        {
+            dThresholdPct = atof(argv[++nCount]);
+        }
+        else if(strcmp(argv[nCount], "--quick") == 0)
+        {
+            uPointsPerRun = RTBENCH_POINTS_PER_RUN / RTBENCH_QUICK_DIVIDER;
+        }
+        else if(strcmp(argv[nCount], "-v") == 0)
+        {
+            g_nSimLogLevel = 1;
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--quick] [--filter name] [--output file] [--baseline file] [--threshold-pct P] [-v]\n", argv[0]);
+            return(2);
+        }
+    }
+
+    vector<BENCHRESULT> zBaseline;
+    if((szBaseline != NULL) && (ReadResults(szBaseline, zBaseline) == false))
+    {
+        fprintf(stderr, "%s: no results\n", szBaseline);
+        return(2);
+    }
+
+    FILE* pOutput = NULL;
+    if(szOutput != NULL)
+    {
+        pOutput = fopen(szOutput, "w");
+        if(pOutput == NULL)
+        {
+            fprintf(stderr, "%s: cannot create file\n", szOutput);
+            return(2);
+        }
+    }
+
+    printf("%-16s %7s %-5s %-6s %12s %10s %12s %10s\n", "benchmark", "points", "mix", "layout", "ns/call", "ns/point", "misses/call", "baseline");
+
+    CRTBenchmark zBenchmark;
+    int nRegressions = 0;
+
+    for(uint32 uPoints : g_uPointCounts)
+    {
+        for(int nMix = 0; nMix < BENCHMIX_COUNT; nMix++)
+        {
+            for(int nSparse = 0; nSparse < 2; nSparse++)
+            {
+                if(zBenchmark.Setup(uPoints, (BENCHMIX)nMix, nSparse != 0) == false)
+                {
+                    fprintf(stderr, "setup of %u %s I/Os failed\n", uPoints, g_szMixNames[nMix]);
+                    return(2);
+                }
+
+                vector<BENCHRESULT> zResults;
+                zBenchmark.Run(szFilter, uPointsPerRun, zResults);
+
+                for(const BENCHRESULT& zResult : zResults)
+                {
+                    char szMisses[32] = "-";
+                    if(zResult.bPerf)
+                    {
+                        snprintf(szMisses, sizeof(szMisses), "%.2f", zResult.dCacheMissesPerCall);
+                    }
+
+                    // compare per I/O, so the baseline may have been measured with --quick
+                    char szCompare[48] = "";
+                    for(const BENCHRESULT& zBase : zBaseline)
+                    {
+                        if(GetKey(zBase) == GetKey(zResult))
+                        {
+                            double dDiffPct = (zBase.dNsPerPoint > 0) ? (zResult.dNsPerPoint / zBase.dNsPerPoint - 1.0) * 100.0 : 0;
+                            bool bRegression = (dDiffPct > dThresholdPct);
+                            snprintf(szCompare, sizeof(szCompare), "%+9.1f%%%s", dDiffPct, bRegression ? "  REGRESSION" : "");
+                            if(bRegression)
+                            {
+                                nRegressions++;
+                            }
+                            break;
+                        }
+                    }
+
+                    printf("%-16s %7u %-5s %-6s %12.1f %10.3f %12s %s\n", zResult.strBenchmark.c_str(), zResult.uPoints,
+                           zResult.strMix.c_str(), zResult.strLayout.c_str(), zResult.dNsPerCall, zResult.dNsPerPoint,
+                           szMisses, szCompare);
+                    if(pOutput != NULL)
+                    {
+                        fprintf(pOutput, "%s\n", FormatResult(zResult).c_str());
+                    }
+                }
+                fflush(stdout);
+            }
+        }
+    }
+
+    zBenchmark.Teardown();
+
+    if(pOutput != NULL)
+    {
+        fclose(pOutput);
+    }
+
+    return((nRegressions > 0) ? 1 : 0);
+}
@@ -0,0 +1,706 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  RscBenchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+// Benchmark and regression test of CSampleSubscriptionThread on a Linux host with the RSC
+// simulator (see tools/RscSimulator). For 10 to 10000 subscribed variables of type bool,
+// int32, real64 or string or a mix of them, with static or changing values, it measures
+// CreateSubscription (via StartProcessing), ReadSubscription with the decoding of the values
+// into the value store, and ReadValues of the service with an empty delegate as a reference.
+// Build from the root of the repository:
+//
+//   cmake -S tools -B build-tools && cmake --build build-tools --target RscBenchmark
+//   ./build-tools/RscBenchmark [--quick] [--filter ReadSubscription] [--output current.jsonl] [--baseline baseline.jsonl] [--threshold-pct 10] [--kinds] [-v]
+//
+// The results are printed as a table and written as one JSON object per line to the output file.
+// Every call of operator new during a measurement is counted, so the allocations per call are
+// exact. With a baseline file, every result which is slower per variable than the threshold
+// allows, or which allocates more often per call, is flagged as a regression. After the
+// measurements of each set of variables, the decoded values of one more read are compared with
+// the values which the simulator returned. With --kinds, CSubscriptionBenchmark compares the
+// subscription kinds for 1000 mixed variables. The exit code is 1 if there is at least one
+// regression or wrong value, 2 on errors and 0 otherwise.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#include "RscSimulator.h"
+#include "CSampleSubscriptionThread.h"
+#include "CSubscriptionBenchmark.h"
+
+using namespace std;
+
+#define RSCBENCH_VALUES_PER_RUN		1000000		// decoded values per repetition, the number of calls is derived from it
+#define RSCBENCH_QUICK_DIVIDER		20			// fewer values per repetition with --quick
+#define RSCBENCH_REPETITIONS		5			// the median of the repetitions is reported
+#define RSCBENCH_SAMPLE_RATE		1000		// sample rate of the subscription in us
+#define RSCBENCH_CHANGE_INTERVAL	1000		// change interval of changing values in us
+#define RSCBENCH_THRESHOLD_PCT		10			// default threshold for regressions in percent
+#define RSCBENCH_ALLOC_THRESHOLD	0.5			// more allocations per call than the baseline are a regression
+#define RSCBENCH_KIND_VARIABLES		1000		// variables for the comparison of the subscription kinds
+#define RSCBENCH_KIND_READS			1000		// reads per subscription kind
+
+#define RSCBENCH_PREFIX				"Arp.Plc.Eclr/RscBenchInst."
+
+static const uint32 g_uVariableCounts[] = { 10, 100, 1000, 10000 };
+
+///	types of the variables of one benchmark
+enum BENCHMIX
+{
+    BENCHMIX_BOOL = 0,
+    BENCHMIX_INT32,
+    BENCHMIX_REAL64,
+    BENCHMIX_STRING,
+    BENCHMIX_MIXED,		// two bools, one int32, one real64 and one string
+    BENCHMIX_COUNT
+};
+
+static const char* g_szMixNames[BENCHMIX_COUNT] = { "bool", "int32", "real64", "string", "mixed" };
+
+///	structure with the result of one measurement
+struct BENCHRESULT
+{
+    string strBenchmark;
+    uint32 uVariables = 0;
+    string strMix;
+    string strValues;				// static or changing
+    uint64 uIterations = 0;			// calls per repetition
+    double dNsPerCall = 0;
+    double dNsPerVariable = 0;
+    double dAllocsPerCall = 0;
+};
+
+// every allocation of the process is counted, the measurements take the difference. All forms of
+// new and delete are replaced, so every block from malloc goes back to free. The functions must
+// not be inlined, otherwise the compiler sees free on a pointer of the builtin operator new
+static std::atomic<uint64> g_uAllocations(0);
+
+static void* CountedAlloc(size_t nSize)
+{
+    g_uAllocations.fetch_add(1, std::memory_order_relaxed);
+    void* p = malloc((nSize > 0) ? nSize : 1);
+    if(p == NULL)
+    {
+        throw std::bad_alloc();
+    }
+    return(p);
+}
+
+__attribute__((noinline)) void* operator new(size_t nSize)
+{
+    return(CountedAlloc(nSize));
+}
+
+__attribute__((noinline)) void* operator new[](size_t nSize)
+{
+    return(CountedAlloc(nSize));
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept
+{
+    free(p);
+}
+
+__attribute__((noinline)) void operator delete[](void* p) noexcept
+{
+    free(p);
+}
+
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept
+{
+    free(p);
+}
+
+__attribute__((noinline)) void operator delete[](void* p, size_t) noexcept
+{
+    free(p);
+}
+
+/// @brief	benchmark of one CSampleSubscriptionThread with a generated set of variables. The
+/// 		event loop does not run, the functions of the subscription cycle are called directly
+class CRscBenchmark
+{
+public:
+    CRscBenchmark();
+    virtual ~CRscBenchmark();
+
+    bool Init();
+    bool Setup(uint32 uVariables, BENCHMIX zMix, bool bChanging);
+    void Teardown();
+    bool Run(const char* szFilter, uint64 uValuesPerRun, vector<BENCHRESULT>& zResults);
+    size_t Verify(size_t& nChecked);
+    bool CompareKinds();
+
+private:
+    std::shared_ptr<CRscSimulator> m_pSimulator;
+    CSampleSubscriptionThread m_zThread;
+    CGdsWriter m_zGdsWriter;
+    CSetpointMailbox m_zSetpointMailbox;
+    CResultMailbox m_zResultMailbox;
+    DEVICESTATUS m_zDeviceStatus;
+    RUNTIMEMETRICS m_zMetrics;
+
+    vector<string> m_zNames;
+    uint32 m_uVariables;
+    BENCHMIX m_zMix;
+    bool m_bChanging;
+
+    bool Start(uint64& uTimeNs);
+    void WaitForSample();
+
+    template<typename F>
+    BENCHRESULT Measure(const char* szName, uint64 uIterations, F fnCall);
+};
+
+CRscBenchmark::CRscBenchmark()
+            : m_pSimulator(std::make_shared<CRscSimulator>()),
+              m_uVariables(0),
+              m_zMix(BENCHMIX_BOOL),
+              m_bChanging(false)
+{
+}
+
+CRscBenchmark::~CRscBenchmark()
+{
+    Teardown();
+}
+
+/// @brief	initialise the subscription cycle with the simulated services
+/// @return	true: success, false: failure
+bool CRscBenchmark::Init()
+{
+    // the timers are registered, but the loop does not run
+    return(g_zEventLoop.Init() &&
+           m_zGdsWriter.Init(m_pSimulator, &g_zEventLoop) &&
+           m_zThread.Init(m_pSimulator, m_pSimulator, &m_zSetpointMailbox, &m_zResultMailbox, &m_zGdsWriter,
+                          &m_zDeviceStatus, &m_zMetrics, &g_zEventLoop));
+}
+
+/// @brief				create the variables and one subscription group with all of them
+/// @param uVariables	number of variables
+/// @param zMix			types of the variables
+/// @param bChanging	true: the values change with every sample, false: constant values
+/// @return				true: success, false: failure
+bool CRscBenchmark::Setup(uint32 uVariables, BENCHMIX zMix, bool bChanging)
+{
+    Teardown();
+
+    m_uVariables = uVariables;
+    m_zMix = zMix;
+    m_bChanging = bChanging;
+
+    static const vector<RscType> zTypes[BENCHMIX_COUNT] =
+    {
+        { RscType::Bool },
+        { RscType::Int32 },
+        { RscType::Real64 },
+        { RscType::String },
+        { RscType::Bool, RscType::Bool, RscType::Int32, RscType::Real64, RscType::String }
+    };
+
+    m_zNames.clear();
+    if(m_pSimulator->AddVariables(RSCBENCH_PREFIX, uVariables, zTypes[zMix], bChanging ? RSCBENCH_CHANGE_INTERVAL : 0, &m_zNames) != uVariables)
+    {
+        return(false);
+    }
+
+    // one group instead of the configured ones
+    SUBSCRIPTIONGROUP zGroup;
+    zGroup.strName = "RscBenchmark";
+    zGroup.zKind = SubscriptionKind::HighPerformance;
+    zGroup.uSampleRate = RSCBENCH_SAMPLE_RATE;
+    zGroup.zVariables = m_zNames;
+    for(uint32 uCount = 0; uCount < uVariables; uCount++)
+    {
+        zGroup.zTypes.push_back(zTypes[zMix][uCount % zTypes[zMix].size()]);
+    }
+    m_zThread.m_zSubscriptionGroups.clear();
+    m_zThread.m_zSubscriptionGroups.push_back(zGroup);
+
+    uint64 uTimeNs = 0;
+    return(Start(uTimeNs));
+}
+
+/// @brief	delete the subscriptions and the variables
+void CRscBenchmark::Teardown()
+{
+    m_zThread.StopProcessing();
+    m_zThread.ReleaseSubscriptions();
+    m_zThread.m_zSubscriptionGroups.clear();
+    m_pSimulator->Clear();
+}
+
+/// @brief			create the subscriptions again, like a cold start of the runtime
+/// @param uTimeNs	reference to time of StartProcessing in ns
+/// @return			true: success, false: failure
+bool CRscBenchmark::Start(uint64& uTimeNs)
+{
+    m_zThread.StopProcessing();
+    m_zThread.ReleaseSubscriptions();
+
+    uint64 uStartNs = GetMonotonicTimeNs();
+    bool bRet = m_zThread.StartProcessing(false);
+    uTimeNs = GetMonotonicTimeNs() - uStartNs;
+
+    return(bRet);
+}
+
+/// @brief	wait until the subscription has sampled the values
+void CRscBenchmark::WaitForSample()
+{
+    usleep(2 * RSCBENCH_SAMPLE_RATE);
+}
+
+/// @brief				measure the median time of one call and the allocations per call
+/// @param szName		name of benchmark
+/// @param uIterations	calls per repetition
+/// @param fnCall		benchmarked call
+/// @return				result
+template<typename F>
+BENCHRESULT CRscBenchmark::Measure(const char* szName, uint64 uIterations, F fnCall)
+{
+    BENCHRESULT zResult;
+    zResult.strBenchmark = szName;
+    zResult.uVariables = m_uVariables;
+    zResult.strMix = g_szMixNames[m_zMix];
+    zResult.strValues = m_bChanging ? "changing" : "static";
+    zResult.uIterations = max((uint64)1, uIterations);
+
+    // warm up the caches and let the string arena grow to its size
+    for(uint64 uCount = 0; uCount < zResult.uIterations / 10 + 1; uCount++)
+    {
+        fnCall();
+    }
+
+    vector<double> zTimes;
+    zTimes.reserve(RSCBENCH_REPETITIONS);
+
+    uint64 uAllocations = g_uAllocations.load(std::memory_order_relaxed);
+    for(int nRepetition = 0; nRepetition < RSCBENCH_REPETITIONS; nRepetition++)
+    {
+        uint64 uStartNs = GetMonotonicTimeNs();
+        for(uint64 uCount = 0; uCount < zResult.uIterations; uCount++)
+        {
+            fnCall();
+        }
+        zTimes.push_back((double)(GetMonotonicTimeNs() - uStartNs) / zResult.uIterations);
+    }
+
+    uAllocations = g_uAllocations.load(std::memory_order_relaxed) - uAllocations;
+    zResult.dAllocsPerCall = (double)uAllocations / (zResult.uIterations * RSCBENCH_REPETITIONS);
+
+    sort(zTimes.begin(), zTimes.end());
+    zResult.dNsPerCall = zTimes[zTimes.size() / 2];
+    zResult.dNsPerVariable = zResult.dNsPerCall / max((uint32)1, m_uVariables);
+
+    return(zResult);
+}
+
+/// @brief					run all benchmarks for the current variables
+/// @param szFilter			only benchmarks which contain this text, NULL for all
+/// @param uValuesPerRun	decoded values per repetition
+/// @param zResults			the results are appended
+/// @return					true: success, false: the subscription could not be created or read
+bool CRscBenchmark::Run(const char* szFilter, uint64 uValuesPerRun, vector<BENCHRESULT>& zResults)
+{
+    bool bRet = true;
+
+    if((szFilter == NULL) || (strstr("CreateSubscription", szFilter) != NULL))
+    {
+        // StartProcessing creates the subscription, adds every variable, subscribes it and sizes the value store
+        zResults.push_back(Measure("CreateSubscription", 1, [&]()
+        {
+            uint64 uTimeNs = 0;
+            if(Start(uTimeNs) == false)
+            {
+                bRet = false;
+            }
+        }));
+    }
+
+    SUBSCRIPTIONGROUP& zGroup = m_zThread.m_zSubscriptionGroups[0];
+    WaitForSample();
+
+    uint64 uIterations = uValuesPerRun / max((uint32)1, m_uVariables);
+
+    if((szFilter == NULL) || (strstr("ReadSubscription", szFilter) != NULL))
+    {
+        zResults.push_back(Measure("ReadSubscription", uIterations, [&]()
+        {
+            if(m_zThread.ReadSubscription(zGroup) == false)
+            {
+                bRet = false;
+            }
+        }));
+    }
+
+    if((szFilter == NULL) || (strstr("ReadValues", szFilter) != NULL))
+    {
+        // the transfer of the values without decoding, the difference to ReadSubscription is
+        // the cost of the delegate and the value store of the runtime
+        RscVariant<512> current;
+        ISubscriptionService::ReadValuesValuesDelegate readValuesDelegate =
+            ISubscriptionService::ReadValuesValuesDelegate::create([&](IRscReadEnumerator<RscVariant<512>>& readEnumerator)
+        {
+            size_t valueCount = readEnumerator.BeginRead();
+            for (size_t i = 0; i < valueCount; i++)
+            {
+                readEnumerator.ReadNext(current);
+            }
+            readEnumerator.EndRead();
+        });
+
+        zResults.push_back(Measure("ReadValues", uIterations, [&]()
+        {
+            if(m_pSimulator->ReadValues(zGroup.uSubscriptionId, readValuesDelegate) != DataAccessError::None)
+            {
+                bRet = false;
+            }
+        }));
+    }
+
+    return(bRet);
+}
+
+/// @brief			read the subscription once more and compare the decoded values with the
+/// 				values which the simulator returned
+/// @param nChecked	reference to number of checked values
+/// @return			number of missing or wrong values
+size_t CRscBenchmark::Verify(size_t& nChecked)
+{
+    SUBSCRIPTIONGROUP& zGroup = m_zThread.m_zSubscriptionGroups[0];
+    if(m_zThread.ReadSubscription(zGroup) == false)
+    {
+        return(m_uVariables);
+    }
+
+    size_t nWrong = 0;
+    for(size_t nIndex = 0; nIndex < zGroup.zValues.GetCount(); nIndex++)
+    {
+        nChecked++;
+
+        RscVariant<512> zExpected;
+        bool bEqual = false;
+        if(m_pSimulator->GetExpected(zGroup.uSubscriptionId, nIndex, zExpected) && zGroup.zValues.IsValid(nIndex))
+        {
+            switch(zExpected.GetType())
+            {
+                case RscType::Bool:
+                {
+                    bool bExpected = false;
+                    bool bValue = false;
+                    zExpected.CopyTo(bExpected);
+                    bEqual = zGroup.zValues.GetValue(nIndex, bValue) && (bValue == bExpected);
+                    break;
+                }
+                case RscType::Int32:
+                {
+                    int32 i32Expected = 0;
+                    int32 i32Value = 0;
+                    zExpected.CopyTo(i32Expected);
+                    bEqual = zGroup.zValues.GetValue(nIndex, i32Value) && (i32Value == i32Expected);
+                    break;
+                }
+                case RscType::Real64:
+                {
+                    float64 f64Expected = 0;
+                    float64 f64Value = 0;
+                    zExpected.CopyTo(f64Expected);
+                    bEqual = zGroup.zValues.GetValue(nIndex, f64Value) && (f64Value == f64Expected);
+                    break;
+                }
+                case RscType::String:
+                {
+                    const char* szValue = zGroup.zValues.GetString(nIndex);
+                    bEqual = (szValue != NULL) && (strcmp(szValue, zExpected.GetChars()) == 0);
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+
+        if(bEqual == false)
+        {
+            if(nWrong == 0)
+            {
+                fprintf(stderr, "%s: decoded value does not match\n", zGroup.zInfos[nIndex].Name.CStr());
+            }
+            nWrong++;
+        }
+    }
+
+    return(nWrong);
+}
+
+/// @brief	compare the subscription kinds and direct reads with CSubscriptionBenchmark, the
+/// 		results are written to the log
+/// @return	true: all methods could be measured, false: at least one failed
+bool CRscBenchmark::CompareKinds()
+{
+    if(Setup(RSCBENCH_KIND_VARIABLES, BENCHMIX_MIXED, true) == false)
+    {
+        return(false);
+    }
+
+    // the coherence pair is not part of the subscription of the thread
+    if((m_pSimulator->AddVariable(RSCBENCH_PREFIX "Counter", RscType::Int32, RSCBENCH_CHANGE_INTERVAL) == false) ||
+       (m_pSimulator->AddMirror(RSCBENCH_PREFIX "Mirror", RSCBENCH_PREFIX "Counter") == false))
+    {
+        return(false);
+    }
+
+    int nLogLevel = g_nSimLogLevel;
+    g_nSimLogLevel = 1;
+    CSubscriptionBenchmark zBenchmark(m_pSimulator, m_pSimulator);
+    zBenchmark.SetCoherencePair(RSCBENCH_PREFIX "Counter", RSCBENCH_PREFIX "Mirror");
+    bool bRet = zBenchmark.Run("RscBenchmark", m_zNames, RSCBENCH_SAMPLE_RATE, RSCBENCH_KIND_READS);
+    g_nSimLogLevel = nLogLevel;
+
+    return(bRet);
+}
+
+/// @brief			key of a result to find it in the baseline
+/// @param zResult	result
+/// @return			key
+static string GetKey(const BENCHRESULT& zResult)
+{
+    return(zResult.strBenchmark + "/" + to_string(zResult.uVariables) + "/" + zResult.strMix + "/" + zResult.strValues);
+}
+
+/// @brief			one result as a JSON object
+/// @param zResult	result
+/// @return			JSON object without line feed
+static string FormatResult(const BENCHRESULT& zResult)
+{
+    char szLine[512];
+    snprintf(szLine, sizeof(szLine),
+             "{\"benchmark\":\"%s\",\"variables\":%u,\"mix\":\"%s\",\"values\":\"%s\",\"iterations\":%llu,"
+             "\"ns_per_call\":%.3f,\"ns_per_variable\":%.4f,\"allocs_per_call\":%.3f}",
+             zResult.strBenchmark.c_str(), zResult.uVariables, zResult.strMix.c_str(), zResult.strValues.c_str(),
+             (unsigned long long)zResult.uIterations, zResult.dNsPerCall, zResult.dNsPerVariable, zResult.dAllocsPerCall);
+    return(szLine);
+}
+
+/// @brief				text value after a key
+/// @param strLine		JSON object
+/// @param szKey		key including quotes and colon
+/// @return				value, empty if not found
+static string GetText(const string& strLine, const char* szKey)
+{
+    size_t nPos = strLine.find(szKey);
+    if(nPos == string::npos)
+    {
+        return("");
+    }
+    nPos += strlen(szKey) + 1;	// skip the opening quote
+    return(strLine.substr(nPos, strLine.find('"', nPos) - nPos));
+}
+
+/// @brief				number after a key
+/// @param strLine		JSON object
+/// @param szKey		key including quotes and colon
+/// @return				value, 0 if not found
+static double GetNumber(const string& strLine, const char* szKey)
+{
+    size_t nPos = strLine.find(szKey);
+    return((nPos != string::npos) ? strtod(strLine.c_str() + nPos + strlen(szKey), NULL) : 0);
+}
+
+/// @brief				read the results of an earlier run
+/// @param szFile		name of file
+/// @param zResults		results
+/// @return				true: success, false: failure
+static bool ReadResults(const char* szFile, vector<BENCHRESULT>& zResults)
+{
+    FILE* pFile = fopen(szFile, "r");
+    if(pFile == NULL)
+    {
+        fprintf(stderr, "%s: cannot open file\n", szFile);
+        return(false);
+    }
+
+    char szBuffer[1024];
+    while(fgets(szBuffer, sizeof(szBuffer), pFile) != NULL)
+    {
+        string strLine(szBuffer);
+        if(strLine.find("\"benchmark\":") == string::npos)
+        {
+            continue;
+        }
+
+        BENCHRESULT zResult;
+        zResult.strBenchmark = GetText(strLine, "\"benchmark\":");
+        zResult.uVariables = (uint32)GetNumber(strLine, "\"variables\":");
+        zResult.strMix = GetText(strLine, "\"mix\":");
+        zResult.strValues = GetText(strLine, "\"values\":");
+        zResult.dNsPerCall = GetNumber(strLine, "\"ns_per_call\":");
+        zResult.dNsPerVariable = GetNumber(strLine, "\"ns_per_variable\":");
+        zResult.dAllocsPerCall = GetNumber(strLine, "\"allocs_per_call\":");
+        zResults.push_back(zResult);
+    }
+    fclose(pFile);
+
+    return(zResults.empty() == false);
+}
+
+int main(int argc, char** argv)
+{
+    const char* szOutput = NULL;
+    const char* szBaseline = NULL;
+    const char* szFilter = NULL;
+    double dThresholdPct = RSCBENCH_THRESHOLD_PCT;
+    uint64 uValuesPerRun = RSCBENCH_VALUES_PER_RUN;
+    bool bKinds = false;
+
+    // only warnings and errors of the runtime code
+    g_nSimLogLevel = 2;
+
+    for(int nCount = 1; nCount < argc; nCount++)
+    {
+        if((strcmp(argv[nCount], "--output") == 0) && (nCount + 1 < argc))
+        {
+            szOutput = argv[++nCount];
+        }
+        else if((strcmp(argv[nCount], "--baseline") == 0) && (nCount + 1 < argc))
+        {
+            szBaseline = argv[++nCount];
+        }
+        else if((strcmp(argv[nCount], "--filter") == 0) && (nCount + 1 < argc))
+        {
+            szFilter = argv[++nCount];
+        }
+        else if((strcmp(argv[nCount], "--threshold-pct") == 0) && (nCount + 1 < argc))
+        {
+            dThresholdPct = atof(argv[++nCount]);
+        }
+        else if(strcmp(argv[nCount], "--quick") == 0)
+        {
+            uValuesPerRun = RSCBENCH_VALUES_PER_RUN / RSCBENCH_QUICK_DIVIDER;
+        }
+        else if(strcmp(argv[nCount], "--kinds") == 0)
+        {
+            bKinds = true;
+        }
+        else if(strcmp(argv[nCount], "-v") == 0)
+        {
+            g_nSimLogLevel = 1;
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--quick] [--filter name] [--output file] [--baseline file] [--threshold-pct P] [--kinds] [-v]\n", argv[0]);
+            return(2);
+        }
+    }
+
+    vector<BENCHRESULT> zBaseline;
+    if((szBaseline != NULL) && (ReadResults(szBaseline, zBaseline) == false))
+    {
+        fprintf(stderr, "%s: no results\n", szBaseline);
+        return(2);
+    }
+
+    FILE* pOutput = NULL;
+    if(szOutput != NULL)
+    {
+        pOutput = fopen(szOutput, "w");
+        if(pOutput == NULL)
+        {
+            fprintf(stderr, "%s: cannot create file\n", szOutput);
+            return(2);
+        }
+    }
+
+    CRscBenchmark zBenchmark;
+    if(zBenchmark.Init() == false)
+    {
+        fprintf(stderr, "initialisation of the subscription cycle failed\n");
+        return(2);
+    }
+
+    printf("%-18s %6s %-6s %-8s %12s %10s %11s %10s\n", "benchmark", "vars", "mix", "values", "ns/call", "ns/var", "allocs/call", "baseline");
+
+    int nRegressions = 0;
+    size_t nChecked = 0;
+    size_t nWrong = 0;
+
+    for(uint32 uVariables : g_uVariableCounts)
+    {
+        for(int nMix = 0; nMix < BENCHMIX_COUNT; nMix++)
+        {
+            for(int nChanging = 0; nChanging < 2; nChanging++)
+            {
+                vector<BENCHRESULT> zResults;
+                if((zBenchmark.Setup(uVariables, (BENCHMIX)nMix, nChanging != 0) == false) ||
+                   (zBenchmark.Run(szFilter, uValuesPerRun, zResults) == false))
+                {
+                    fprintf(stderr, "subscription of %u %s variables failed\n", uVariables, g_szMixNames[nMix]);
+                    return(2);
+                }
+                nWrong += zBenchmark.Verify(nChecked);
+
+                for(const BENCHRESULT& zResult : zResults)
+                {
+                    // compare per variable, so the baseline may have been measured with --quick
+                    char szCompare[64] = "";
+                    for(const BENCHRESULT& zBase : zBaseline)
+                    {
+                        if(GetKey(zBase) == GetKey(zResult))
+                        {
+                            double dDiffPct = (zBase.dNsPerVariable > 0) ? (zResult.dNsPerVariable / zBase.dNsPerVariable - 1.0) * 100.0 : 0;
+                            bool bSlower = (dDiffPct > dThresholdPct);
+                            bool bAllocs = (zResult.dAllocsPerCall > zBase.dAllocsPerCall + RSCBENCH_ALLOC_THRESHOLD);
+                            snprintf(szCompare, sizeof(szCompare), "%+9.1f%%%s%s", dDiffPct, bSlower ? "  REGRESSION" : "", bAllocs ? "  ALLOCATIONS" : "");
+                            if(bSlower || bAllocs)
+                            {
+                                nRegressions++;
+                            }
+                            break;
+                        }
+                    }
+
+                    printf("%-18s %6u %-6s %-8s %12.1f %10.3f %11.2f %s\n", zResult.strBenchmark.c_str(), zResult.uVariables,
+                           zResult.strMix.c_str(), zResult.strValues.c_str(), zResult.dNsPerCall, zResult.dNsPerVariable,
+                           zResult.dAllocsPerCall, szCompare);
+                    if(pOutput != NULL)
+                    {
+                        fprintf(pOutput, "%s\n", FormatResult(zResult).c_str());
+                    }
+                }
+                fflush(stdout);
+            }
+        }
+    }
+
+    printf("decoded values checked: %zu, wrong: %zu\n", nChecked, nWrong);
+
+    if(bKinds && (zBenchmark.CompareKinds() == false))
+    {
+        fprintf(stderr, "comparison of the subscription kinds failed\n");
+        nRegressions++;
+    }
+
+    zBenchmark.Teardown();
+
+    if(pOutput != NULL)
+    {
+        fclose(pOutput);
+    }
+
+    return(((nRegressions > 0) || (nWrong > 0)) ? 1 : 0);
+}
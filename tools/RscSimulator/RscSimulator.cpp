@@ -0,0 +1,809 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  RscSimulator.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include "RscSimulator.h"
+#include "Utility.h"
+
+#define RSCSIM_NO_VARIABLE	0xFFFFFFFF	// index of a port name which does not exist
+
+/// @brief			name of a type for generated variable names
+/// @param zType	type
+/// @return			name, NULL if the simulator does not generate values of this type
+static const char* GetTypeName(RscType zType)
+{
+    switch(zType)
+    {
+        case RscType::Bool:		return("Bool");
+        case RscType::Char:		return("Char");
+        case RscType::Int8:		return("Int8");
+        case RscType::Uint8:	return("Uint8");
+        case RscType::Int16:	return("Int16");
+        case RscType::Uint16:	return("Uint16");
+        case RscType::Int32:	return("Int32");
+        case RscType::Uint32:	return("Uint32");
+        case RscType::Int64:	return("Int64");
+        case RscType::Uint64:	return("Uint64");
+        case RscType::Real32:	return("Real32");
+        case RscType::Real64:	return("Real64");
+        case RscType::String:	return("String");
+        default:				return(NULL);
+    }
+}
+
+/// @brief		spread the bits of a number (splitmix64), so neighbouring variables and
+/// 			change intervals get unrelated values
+/// @param x	number
+/// @return		mixed number
+static uint64 MixBits(uint64 x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return(x ^ (x >> 31));
+}
+
+CRscSimulator::CRscSimulator()
+            : m_uStartTimeUs(GetTimeUs()),
+              m_nStringLength(RSCSIM_STRING_LENGTH),
+              m_uNextSubscriptionId(1)
+{
+    pthread_mutex_init(&m_zMutex, NULL);
+}
+
+CRscSimulator::~CRscSimulator()
+{
+    pthread_mutex_destroy(&m_zMutex);
+}
+
+/// @brief	remove all variables and subscriptions, the values start again with the first change interval
+void CRscSimulator::Clear()
+{
+    pthread_mutex_lock(&m_zMutex);
+    m_zVariables.clear();
+    m_zNames.clear();
+    m_zWritten.clear();
+    m_zSubscriptions.clear();
+    m_zStats = RSCSIMSTATS();
+    m_uStartTimeUs = GetTimeUs();
+    pthread_mutex_unlock(&m_zMutex);
+}
+
+/// @brief					add a GDS variable
+/// @param szName			port name, e.g. Arp.Plc.Eclr/MyProgramInst.VarA
+/// @param zType			type of variable, structures, arrays and Utf8String are not simulated
+/// @param uChangeIntervalUs	the value changes with this interval, 0 for a constant value
+/// @return					true: success, false: name already exists or type not simulated
+bool CRscSimulator::AddVariable(const char* szName, RscType zType, uint64 uChangeIntervalUs)
+{
+    bool bRet = false;
+
+    pthread_mutex_lock(&m_zMutex);
+    if((GetTypeName(zType) != NULL) && (m_zNames.find(szName) == m_zNames.end()))
+    {
+        VARIABLE zVariable;
+        zVariable.strName = szName;
+        zVariable.zType = zType;
+        zVariable.uChangeIntervalUs = uChangeIntervalUs;
+        zVariable.uValueIndex = (uint32)m_zVariables.size();
+        zVariable.bWritten = false;
+
+        m_zNames[zVariable.strName] = (uint32)m_zVariables.size();
+        m_zVariables.push_back(zVariable);
+        bRet = true;
+    }
+    pthread_mutex_unlock(&m_zMutex);
+
+    return(bRet);
+}
+
+/// @brief				add a GDS variable with the same type and generated value as another one
+/// @param szName		port name of the mirror
+/// @param szSource		port name of the source, must exist
+/// @return				true: success, false: name already exists or source not found
+bool CRscSimulator::AddMirror(const char* szName, const char* szSource)
+{
+    bool bRet = false;
+
+    pthread_mutex_lock(&m_zMutex);
+    uint32 uSource = 0;
+    if(FindVariable(szSource, uSource) && (m_zNames.find(szName) == m_zNames.end()))
+    {
+        VARIABLE zVariable = m_zVariables[uSource];
+        zVariable.strName = szName;
+        zVariable.bWritten = false;
+
+        m_zNames[zVariable.strName] = (uint32)m_zVariables.size();
+        m_zVariables.push_back(zVariable);
+        bRet = true;
+    }
+    pthread_mutex_unlock(&m_zMutex);
+
+    return(bRet);
+}
+
+/// @brief					add generated GDS variables named <prefix><type><number>
+/// @param szPrefix			start of the names, e.g. Arp.Plc.Eclr/SimInst.
+/// @param nCount			number of variables
+/// @param zTypes			types of the variables, repeated if there are more variables than types
+/// @param uChangeIntervalUs	the values change with this interval, 0 for constant values
+/// @param pNames			the names of the added variables are appended, may be NULL
+/// @return					number of added variables
+size_t CRscSimulator::AddVariables(const char* szPrefix, size_t nCount, const vector<RscType>& zTypes, uint64 uChangeIntervalUs, vector<string>* pNames)
+{
+    size_t nAdded = 0;
+
+    for(size_t nCounter = 0; (nCounter < nCount) && (zTypes.empty() == false); nCounter++)
+    {
+        RscType zType = zTypes[nCounter % zTypes.size()];
+        const char* szType = GetTypeName(zType);
+
+        char szName[512];
+        snprintf(szName, sizeof(szName), "%s%s%06zu", szPrefix, (szType != NULL) ? szType : "", nCounter);
+        if(AddVariable(szName, zType, uChangeIntervalUs))
+        {
+            if(pNames != NULL)
+            {
+                pNames->push_back(szName);
+            }
+            nAdded++;
+        }
+    }
+
+    return(nAdded);
+}
+
+/// @brief			length of generated string values
+/// @param nLength	number of characters, limited by the size of RscVariant<512>
+void CRscSimulator::SetStringLength(size_t nLength)
+{
+    pthread_mutex_lock(&m_zMutex);
+    m_nStringLength = min(nLength, (size_t)511);
+    pthread_mutex_unlock(&m_zMutex);
+}
+
+/// @brief	number of variables
+/// @return	number of variables
+size_t CRscSimulator::GetVariableCount()
+{
+    pthread_mutex_lock(&m_zMutex);
+    size_t nCount = m_zVariables.size();
+    pthread_mutex_unlock(&m_zMutex);
+
+    return(nCount);
+}
+
+/// @brief					value which the last ReadValues of a subscription returned for a variable,
+/// 						to check the decoding of the values
+/// @param uSubscriptionId	ID of subscription
+/// @param nIndex			index of variable in the subscription
+/// @param zValue			reference to value
+/// @return					true: success, false: no such variable or no value was returned
+bool CRscSimulator::GetExpected(uint32 uSubscriptionId, size_t nIndex, RscVariant<512>& zValue)
+{
+    bool bRet = false;
+
+    pthread_mutex_lock(&m_zMutex);
+    map<uint32, SUBSCRIPTION>::const_iterator it = m_zSubscriptions.find(uSubscriptionId);
+    if((it != m_zSubscriptions.end()) && (nIndex < it->second.zVariables.size()) && (it->second.uLastSampleUs != 0))
+    {
+        GetValue(it->second.zVariables[nIndex], it->second.uLastSampleUs, zValue);
+        bRet = true;
+    }
+    pthread_mutex_unlock(&m_zMutex);
+
+    return(bRet);
+}
+
+/// @brief	delete all subscriptions without telling the clients, like the firmware does on a
+/// 		restart of the PLC, so the next ReadValues of a client fails
+void CRscSimulator::DropSubscriptions()
+{
+    pthread_mutex_lock(&m_zMutex);
+    m_zSubscriptions.clear();
+    m_zStats.uSubscriptions = 0;
+    pthread_mutex_unlock(&m_zMutex);
+}
+
+/// @brief	statistics of the services
+/// @return	copy of the statistics
+RSCSIMSTATS CRscSimulator::GetStatistics()
+{
+    pthread_mutex_lock(&m_zMutex);
+    RSCSIMSTATS zStats = m_zStats;
+    pthread_mutex_unlock(&m_zMutex);
+
+    return(zStats);
+}
+
+/// @brief			create an empty subscription
+/// @param zKind	realtime class of the subscription, Recording is not simulated
+/// @return			ID of subscription, 0 on error
+uint32 CRscSimulator::CreateSubscription(SubscriptionKind zKind)
+{
+    uint32 uRet = 0;
+
+    pthread_mutex_lock(&m_zMutex);
+    m_zStats.uCalls++;
+    if((zKind == SubscriptionKind::DirectRead) || (zKind == SubscriptionKind::HighPerformance) || (zKind == SubscriptionKind::RealTime))
+    {
+        uRet = m_uNextSubscriptionId++;
+
+        SUBSCRIPTION& zSubscription = m_zSubscriptions[uRet];
+        zSubscription.zKind = zKind;
+        zSubscription.uSampleRateUs = 0;
+        zSubscription.uSubscribeTimeUs = 0;
+        zSubscription.uLastSampleUs = 0;
+        m_zStats.uSubscriptions = m_zSubscriptions.size();
+    }
+    else
+    {
+        m_zStats.uErrors++;
+    }
+    pthread_mutex_unlock(&m_zMutex);
+
+    return(uRet);
+}
+
+/// @brief					add a variable to a subscription
+/// @param uSubscriptionId	ID of subscription
+/// @param strName			port name
+/// @return					DataAccessError::None on success
+DataAccessError CRscSimulator::AddVariable(uint32 uSubscriptionId, const RscString<512>& strName)
+{
+    DataAccessError zRet = DataAccessError::NotExists;
+
+    pthread_mutex_lock(&m_zMutex);
+    m_zStats.uCalls++;
+    map<uint32, SUBSCRIPTION>::iterator it = m_zSubscriptions.find(uSubscriptionId);
+    uint32 uIndex = 0;
+    if((it != m_zSubscriptions.end()) && FindVariable(strName.CStr(), uIndex))
+    {
+        it->second.zVariables.push_back(uIndex);
+        zRet = DataAccessError::None;
+    }
+    else
+    {
+        m_zStats.uErrors++;
+    }
+    pthread_mutex_unlock(&m_zMutex);
+
+    return(zRet);
+}
+
+/// @brief					start sampling the variables of a subscription
+/// @param uSubscriptionId	ID of subscription
+/// @param uSampleRate		sample rate in us
+/// @return					DataAccessError::None on success
+DataAccessError CRscSimulator::Subscribe(uint32 uSubscriptionId, uint64 uSampleRate)
+{
+    DataAccessError zRet = DataAccessError::NotExists;
+
+    pthread_mutex_lock(&m_zMutex);
+    m_zStats.uCalls++;
+    map<uint32, SUBSCRIPTION>::iterator it = m_zSubscriptions.find(uSubscriptionId);
+    if(it != m_zSubscriptions.end())
+    {
+        it->second.uSampleRateUs = uSampleRate;
+        it->second.uSubscribeTimeUs = GetTimeUs();
+        it->second.uLastSampleUs = 0;
+        zRet = DataAccessError::None;
+    }
+    else
+    {
+        m_zStats.uErrors++;
+    }
+    pthread_mutex_unlock(&m_zMutex);
+
+    return(zRet);
+}
+
+/// @brief					change the sample rate of a subscription, the values are sampled again
+/// @param uSubscriptionId	ID of subscription
+/// @param uSampleRate		sample rate in us
+/// @return					DataAccessError::None on success
+DataAccessError CRscSimulator::Resubscribe(uint32 uSubscriptionId, uint64 uSampleRate)
+{
+    return(Subscribe(uSubscriptionId, uSampleRate));
+}
+
+/// @brief					stop sampling, the subscription and its variables are kept
+/// @param uSubscriptionId	ID of subscription
+/// @return					DataAccessError::None on success
+DataAccessError CRscSimulator::Unsubscribe(uint32 uSubscriptionId)
+{
+    DataAccessError zRet = DataAccessError::NotExists;
+
+    pthread_mutex_lock(&m_zMutex);
+    m_zStats.uCalls++;
+    map<uint32, SUBSCRIPTION>::iterator it = m_zSubscriptions.find(uSubscriptionId);
+    if(it != m_zSubscriptions.end())
+    {
+        it->second.uSubscribeTimeUs = 0;
+        it->second.uLastSampleUs = 0;
+        zRet = DataAccessError::None;
+    }
+    else
+    {
+        m_zStats.uErrors++;
+    }
+    pthread_mutex_unlock(&m_zMutex);
+
+    return(zRet);
+}
+
+/// @brief					delete a subscription
+/// @param uSubscriptionId	ID of subscription
+/// @return					DataAccessError::None on success
+DataAccessError CRscSimulator::DeleteSubscription(uint32 uSubscriptionId)
+{
+    DataAccessError zRet = DataAccessError::NotExists;
+
+    pthread_mutex_lock(&m_zMutex);
+    m_zStats.uCalls++;
+    if(m_zSubscriptions.erase(uSubscriptionId) > 0)
+    {
+        m_zStats.uSubscriptions = m_zSubscriptions.size();
+        zRet = DataAccessError::None;
+    }
+    else
+    {
+        m_zStats.uErrors++;
+    }
+    pthread_mutex_unlock(&m_zMutex);
+
+    return(zRet);
+}
+
+/// @brief					read the values of the last sample of a subscription. Like the firmware,
+/// 					the values are handed to the delegate one by one without a copy of the whole sample
+/// @param uSubscriptionId	ID of subscription
+/// @param valuesDelegate	delegate which reads the values
+/// @return					DataAccessError::None on success
+DataAccessError CRscSimulator::ReadValues(uint32 uSubscriptionId, ReadValuesValuesDelegate valuesDelegate)
+{
+    ///	enumerator over the values of one sample
+    class CValueEnumerator : public IRscReadEnumerator<RscVariant<512>>
+    {
+    public:
+        CValueEnumerator(const CRscSimulator& zSimulator, const SUBSCRIPTION& zSubscription, bool bSampled)
+                    : m_zSimulator(zSimulator), m_zSubscription(zSubscription), m_bSampled(bSampled), m_nNext(0) {}
+
+        size_t BeginRead() override { m_nNext = 0; return(m_zSubscription.zVariables.size()); }
+        void EndRead() override {}
+
+        bool ReadNext(RscVariant<512>& current) override
+        {
+            if(m_nNext >= m_zSubscription.zVariables.size())
+            {
+                return(false);
+            }
+            if(m_bSampled)
+            {
+                m_zSimulator.GetValue(m_zSubscription.zVariables[m_nNext], m_zSubscription.uLastSampleUs, current);
+            }
+            else
+            {
+                // not sampled yet
+                current = RscVariant<512>();
+            }
+            m_nNext++;
+            return(true);
+        }
+
+        size_t GetRead() const { return(m_nNext); }
+
+    private:
+        const CRscSimulator& m_zSimulator;
+        const SUBSCRIPTION& m_zSubscription;
+        bool m_bSampled;
+        size_t m_nNext;
+    };
+
+    DataAccessError zRet = DataAccessError::NotExists;
+
+    pthread_mutex_lock(&m_zMutex);
+    m_zStats.uCalls++;
+    map<uint32, SUBSCRIPTION>::iterator it = m_zSubscriptions.find(uSubscriptionId);
+    if((it != m_zSubscriptions.end()) && (it->second.uSubscribeTimeUs != 0))
+    {
+        SUBSCRIPTION& zSubscription = it->second;
+        bool bSampled = GetSampleTime(zSubscription, GetTimeUs(), zSubscription.uLastSampleUs);
+        if(bSampled == false)
+        {
+            zSubscription.uLastSampleUs = 0;
+        }
+
+        CValueEnumerator zEnumerator(*this, zSubscription, bSampled);
+        valuesDelegate(zEnumerator);
+
+        m_zStats.uReadValues++;
+        m_zStats.uValuesRead += zEnumerator.GetRead();
+        zRet = DataAccessError::None;
+    }
+    else
+    {
+        m_zStats.uErrors++;
+    }
+    pthread_mutex_unlock(&m_zMutex);
+
+    return(zRet);
+}
+
+/// @brief						read name and type of the variables of a subscription
+/// @param uSubscriptionId		ID of subscription
+/// @param variableInfoDelegate	delegate which reads the information
+/// @return						DataAccessError::None on success
+DataAccessError CRscSimulator::GetVariableInfos(uint32 uSubscriptionId, GetVariableInfosVariableInfoDelegate variableInfoDelegate)
+{
+    ///	enumerator over the variables of a subscription
+    class CInfoEnumerator : public IRscReadEnumerator<VariableInfo>
+    {
+    public:
+        CInfoEnumerator(const vector<VARIABLE>& zVariables, const vector<uint32>& zIndexes)
+                    : m_zVariables(zVariables), m_zIndexes(zIndexes), m_nNext(0) {}
+
+        size_t BeginRead() override { m_nNext = 0; return(m_zIndexes.size()); }
+        void EndRead() override {}
+
+        bool ReadNext(VariableInfo& current) override
+        {
+            if(m_nNext >= m_zIndexes.size())
+            {
+                return(false);
+            }
+            const VARIABLE& zVariable = m_zVariables[m_zIndexes[m_nNext++]];
+            current.Name = zVariable.strName.c_str();
+            current.Type = zVariable.zType;
+            return(true);
+        }
+
+    private:
+        const vector<VARIABLE>& m_zVariables;
+        const vector<uint32>& m_zIndexes;
+        size_t m_nNext;
+    };
+
+    DataAccessError zRet = DataAccessError::NotExists;
+
+    pthread_mutex_lock(&m_zMutex);
+    m_zStats.uCalls++;
+    map<uint32, SUBSCRIPTION>::const_iterator it = m_zSubscriptions.find(uSubscriptionId);
+    if(it != m_zSubscriptions.end())
+    {
+        CInfoEnumerator zEnumerator(m_zVariables, it->second.zVariables);
+        variableInfoDelegate(zEnumerator);
+        zRet = DataAccessError::None;
+    }
+    else
+    {
+        m_zStats.uErrors++;
+    }
+    pthread_mutex_unlock(&m_zMutex);
+
+    return(zRet);
+}
+
+/// @brief				read the current value of one variable
+/// @param strPortName	port name
+/// @return				value and result
+ReadItem CRscSimulator::ReadSingle(const RscString<512>& strPortName)
+{
+    ReadItem zItem;
+
+    pthread_mutex_lock(&m_zMutex);
+    m_zStats.uCalls++;
+    uint32 uIndex = 0;
+    if(FindVariable(strPortName.CStr(), uIndex))
+    {
+        GetValue(uIndex, GetTimeUs(), zItem.Value);
+        m_zStats.uValuesRead++;
+    }
+    else
+    {
+        zItem.Error = DataAccessError::NotExists;
+        m_zStats.uErrors++;
+    }
+    pthread_mutex_unlock(&m_zMutex);
+
+    return(zItem);
+}
+
+/// @brief						read the current values of several variables
+/// @param portNamesDelegate	delegate which writes the port names
+/// @param returnValueDelegate	delegate which reads the values, same order as the port names
+void CRscSimulator::Read(ReadPortNamesDelegate portNamesDelegate, ReadReturnValueDelegate returnValueDelegate)
+{
+    ///	enumerator which looks up the written port names
+    class CNameEnumerator : public IRscWriteEnumerator<RscString<512>>
+    {
+    public:
+        CNameEnumerator(const CRscSimulator& zSimulator) : m_zSimulator(zSimulator) {}
+
+        void BeginWrite(size_t nCount) override { zIndexes.reserve(nCount); }
+        void EndWrite() override {}
+
+        void WriteNext(const RscString<512>& current) override
+        {
+            uint32 uIndex = RSCSIM_NO_VARIABLE;
+            m_zSimulator.FindVariable(current.CStr(), uIndex);
+            zIndexes.push_back(uIndex);
+        }
+
+        vector<uint32> zIndexes;
+
+    private:
+        const CRscSimulator& m_zSimulator;
+    };
+
+    ///	enumerator over the values of the read variables
+    class CItemEnumerator : public IRscReadEnumerator<ReadItem>
+    {
+    public:
+        CItemEnumerator(const CRscSimulator& zSimulator, const vector<uint32>& zIndexes, uint64 uTimeUs)
+                    : m_zSimulator(zSimulator), m_zIndexes(zIndexes), m_uTimeUs(uTimeUs), m_nNext(0) {}
+
+        size_t BeginRead() override { m_nNext = 0; return(m_zIndexes.size()); }
+        void EndRead() override {}
+
+        bool ReadNext(ReadItem& current) override
+        {
+            if(m_nNext >= m_zIndexes.size())
+            {
+                return(false);
+            }
+            uint32 uIndex = m_zIndexes[m_nNext++];
+            if(uIndex != RSCSIM_NO_VARIABLE)
+            {
+                m_zSimulator.GetValue(uIndex, m_uTimeUs, current.Value);
+                current.Error = DataAccessError::None;
+            }
+            else
+            {
+                current.Value = RscVariant<512>();
+                current.Error = DataAccessError::NotExists;
+            }
+            return(true);
+        }
+
+    private:
+        const CRscSimulator& m_zSimulator;
+        const vector<uint32>& m_zIndexes;
+        uint64 m_uTimeUs;
+        size_t m_nNext;
+    };
+
+    pthread_mutex_lock(&m_zMutex);
+    m_zStats.uCalls++;
+
+    CNameEnumerator zNames(*this);
+    portNamesDelegate(zNames);
+
+    CItemEnumerator zItems(*this, zNames.zIndexes, GetTimeUs());
+    returnValueDelegate(zItems);
+
+    for(uint32 uIndex : zNames.zIndexes)
+    {
+        if(uIndex != RSCSIM_NO_VARIABLE)
+        {
+            m_zStats.uValuesRead++;
+        }
+        else
+        {
+            m_zStats.uErrors++;
+        }
+    }
+    pthread_mutex_unlock(&m_zMutex);
+}
+
+/// @brief			write the value of one variable
+/// @param zItem	port name and value
+/// @return			DataAccessError::None on success
+DataAccessError CRscSimulator::WriteSingle(const WriteItem& zItem)
+{
+    pthread_mutex_lock(&m_zMutex);
+    m_zStats.uCalls++;
+    DataAccessError zRet = WriteValue(zItem);
+    pthread_mutex_unlock(&m_zMutex);
+
+    return(zRet);
+}
+
+/// @brief						write the values of several variables
+/// @param dataDelegate			delegate which writes the port names and values
+/// @param returnValueDelegate	delegate which reads the results, same order as the values
+void CRscSimulator::Write(WriteDataDelegate dataDelegate, WriteReturnValueDelegate returnValueDelegate)
+{
+    ///	enumerator which writes the values, so the names do not have to be copied
+    class CDataEnumerator : public IRscWriteEnumerator<WriteItem>
+    {
+    public:
+        CDataEnumerator(CRscSimulator& zSimulator) : m_zSimulator(zSimulator) {}
+
+        void BeginWrite(size_t nCount) override { zResults.reserve(nCount); }
+        void EndWrite() override {}
+        void WriteNext(const WriteItem& current) override { zResults.push_back(m_zSimulator.WriteValue(current)); }
+
+        vector<DataAccessError> zResults;
+
+    private:
+        CRscSimulator& m_zSimulator;
+    };
+
+    ///	enumerator over the results
+    class CResultEnumerator : public IRscReadEnumerator<DataAccessError>
+    {
+    public:
+        CResultEnumerator(const vector<DataAccessError>& zResults) : m_zResults(zResults), m_nNext(0) {}
+
+        size_t BeginRead() override { m_nNext = 0; return(m_zResults.size()); }
+        void EndRead() override {}
+
+        bool ReadNext(DataAccessError& current) override
+        {
+            if(m_nNext >= m_zResults.size())
+            {
+                return(false);
+            }
+            current = m_zResults[m_nNext++];
+            return(true);
+        }
+
+    private:
+        const vector<DataAccessError>& m_zResults;
+        size_t m_nNext;
+    };
+
+    pthread_mutex_lock(&m_zMutex);
+    m_zStats.uCalls++;
+
+    CDataEnumerator zData(*this);
+    dataDelegate(zData);
+
+    CResultEnumerator zResults(zData.zResults);
+    returnValueDelegate(zResults);
+    pthread_mutex_unlock(&m_zMutex);
+}
+
+/// @brief	current time
+/// @return	CLOCK_MONOTONIC in us
+uint64 CRscSimulator::GetTimeUs()
+{
+    return(GetMonotonicTimeNs() / 1000);
+}
+
+/// @brief			find a variable by its port name, the simulator must be locked
+/// @param szName	port name
+/// @param uIndex	reference to index in m_zVariables
+/// @return			true: found, false: variable does not exist
+bool CRscSimulator::FindVariable(const char* szName, uint32& uIndex) const
+{
+    unordered_map<string, uint32>::const_iterator it = m_zNames.find(szName);
+    if(it == m_zNames.end())
+    {
+        return(false);
+    }
+
+    uIndex = it->second;
+    return(true);
+}
+
+/// @brief				time of the newest sample of a subscription
+/// @param zSubscription	subscription
+/// @param uNowUs		current time in us
+/// @param uSampleUs		reference to time of sample in us
+/// @return				true: success, false: there is no sample yet
+bool CRscSimulator::GetSampleTime(const SUBSCRIPTION& zSubscription, uint64 uNowUs, uint64& uSampleUs) const
+{
+    if(zSubscription.uSubscribeTimeUs == 0)
+    {
+        return(false);
+    }
+
+    // direct reads sample at the time of reading
+    if(zSubscription.zKind == SubscriptionKind::DirectRead)
+    {
+        uSampleUs = uNowUs;
+        return(true);
+    }
+
+    uint64 uRateUs = max(zSubscription.uSampleRateUs, (uint64)1);
+    if(uNowUs < zSubscription.uSubscribeTimeUs + uRateUs)
+    {
+        return(false);
+    }
+
+    uSampleUs = zSubscription.uSubscribeTimeUs + ((uNowUs - zSubscription.uSubscribeTimeUs) / uRateUs) * uRateUs;
+    return(true);
+}
+
+/// @brief			value of a variable at a point of time, the simulator must be locked
+/// @param uIndex	index in m_zVariables
+/// @param uTimeUs	time in us
+/// @param zValue	reference to value
+void CRscSimulator::GetValue(uint32 uIndex, uint64 uTimeUs, RscVariant<512>& zValue) const
+{
+    const VARIABLE& zVariable = m_zVariables[uIndex];
+    if(zVariable.bWritten)
+    {
+        zValue = m_zWritten.find(uIndex)->second;
+        return;
+    }
+
+    uint64 uInterval = 0;
+    if((zVariable.uChangeIntervalUs > 0) && (uTimeUs > m_uStartTimeUs))
+    {
+        uInterval = (uTimeUs - m_uStartTimeUs) / zVariable.uChangeIntervalUs;
+    }
+    uint64 uBits = MixBits(((uint64)zVariable.uValueIndex << 32) + uInterval);
+
+    switch(zVariable.zType)
+    {
+        case RscType::Bool:		zValue = (bool)(uBits & 1); break;
+        case RscType::Char:		zValue = (char)('A' + uBits % 26); break;
+        case RscType::Int8:		zValue = (int8)uBits; break;
+        case RscType::Uint8:	zValue = (uint8)uBits; break;
+        case RscType::Int16:	zValue = (int16)uBits; break;
+        case RscType::Uint16:	zValue = (uint16)uBits; break;
+        case RscType::Int32:	zValue = (int32)uBits; break;
+        case RscType::Uint32:	zValue = (uint32)uBits; break;
+        case RscType::Int64:	zValue = (int64)uBits; break;
+        case RscType::Uint64:	zValue = (uint64)uBits; break;
+        case RscType::Real32:	zValue = (float32)((int64)(uBits % 2000001) - 1000000) / 100.0f; break;
+        case RscType::Real64:	zValue = (float64)((int64)(uBits % 2000000001) - 1000000000) / 1000.0; break;
+        case RscType::String:
+        {
+            char szValue[512];
+            for(size_t nCount = 0; nCount < m_nStringLength; nCount++)
+            {
+                szValue[nCount] = 'a' + ((uBits >> ((nCount * 4) % 64)) & 0x0F);
+            }
+            szValue[m_nStringLength] = '\0';
+            zValue = szValue;
+            break;
+        }
+        default:
+            zValue = RscVariant<512>();
+            break;
+    }
+}
+
+/// @brief			write the value of one variable, the simulator must be locked
+/// @param zItem	port name and value
+/// @return			DataAccessError::None on success
+DataAccessError CRscSimulator::WriteValue(const WriteItem& zItem)
+{
+    DataAccessError zRet = DataAccessError::None;
+
+    uint32 uIndex = 0;
+    if(FindVariable(zItem.PortName.CStr(), uIndex) == false)
+    {
+        zRet = DataAccessError::NotExists;
+    }
+    else if(zItem.Value.GetType() != m_zVariables[uIndex].zType)
+    {
+        zRet = DataAccessError::TypeMismatch;
+    }
+    else
+    {
+        m_zWritten[uIndex] = zItem.Value;
+        m_zVariables[uIndex].bWritten = true;
+        m_zStats.uValuesWritten++;
+    }
+
+    if(zRet != DataAccessError::None)
+    {
+        m_zStats.uErrors++;
+    }
+
+    return(zRet);
+}
@@ -0,0 +1,131 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  RscSimulator.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+#ifndef RSCSIMULATOR_H_
+#define RSCSIMULATOR_H_
+
+#include <pthread.h>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Arp/System/Core/Arp.h"
+#include "Arp/Plc/Gds/Services/ISubscriptionService.hpp"
+#include "Arp/Plc/Gds/Services/IDataAccessService.hpp"
+
+using namespace std;
+using namespace Arp;
+using namespace Arp::Plc::Gds::Services;
+
+#define RSCSIM_STRING_LENGTH	16		// default length of generated string values
+
+///	structure with statistics of the simulated services
+struct RSCSIMSTATS
+{
+    uint64 uCalls = 0;				// calls of all service functions
+    uint64 uSubscriptions = 0;		// existing subscriptions
+    uint64 uReadValues = 0;			// calls of ReadValues
+    uint64 uValuesRead = 0;			// values returned by ReadValues, Read and ReadSingle
+    uint64 uValuesWritten = 0;		// values written by Write and WriteSingle
+    uint64 uErrors = 0;				// calls and items which returned an error
+};
+
+/// @brief	in-process stand-in for the subscription and the data access service of the PLCnext
+/// 		SDK, so CSampleSubscriptionThread, CSubscriptionBenchmark and CGdsWriter can run on a
+/// 		Linux host. The GDS variables are added by the program with a type and a change interval:
+///
+/// 		- the value of a variable is derived from its index and the number of change intervals
+/// 		  since the start of the simulator, so it is reproducible and can be checked with GetExpected
+/// 		- subscriptions of the kinds HighPerformance and RealTime sample the values with their
+/// 		  sample rate, the values are RscType::Void until the first sample after Subscribe
+/// 		- subscriptions of the kind DirectRead and IDataAccessService::Read return the current value
+/// 		- a mirror always has the generated value of its source, like a variable which the
+/// 		  program writes in the same cycle, so a read of both from different cycles is detected
+/// 		- a written value replaces the generated value of the variable from then on
+///
+/// 		All functions are thread-safe. The delegates are called while the simulator is locked, so
+/// 		they must not call the simulator again
+class CRscSimulator : public ISubscriptionService, public IDataAccessService
+{
+public:
+    CRscSimulator();
+    virtual ~CRscSimulator();
+
+    // variables, must not be changed while they are subscribed
+    void Clear();
+    bool AddVariable(const char* szName, RscType zType, uint64 uChangeIntervalUs);
+    bool AddMirror(const char* szName, const char* szSource);
+    size_t AddVariables(const char* szPrefix, size_t nCount, const vector<RscType>& zTypes, uint64 uChangeIntervalUs, vector<string>* pNames = NULL);
+    void SetStringLength(size_t nLength);
+    size_t GetVariableCount();
+
+    // test support
+    bool GetExpected(uint32 uSubscriptionId, size_t nIndex, RscVariant<512>& zValue);
+    void DropSubscriptions();
+    RSCSIMSTATS GetStatistics();
+
+    // ISubscriptionService
+    uint32 CreateSubscription(SubscriptionKind zKind) override;
+    DataAccessError AddVariable(uint32 uSubscriptionId, const RscString<512>& strName) override;
+    DataAccessError Subscribe(uint32 uSubscriptionId, uint64 uSampleRate) override;
+    DataAccessError Resubscribe(uint32 uSubscriptionId, uint64 uSampleRate) override;
+    DataAccessError Unsubscribe(uint32 uSubscriptionId) override;
+    DataAccessError DeleteSubscription(uint32 uSubscriptionId) override;
+    DataAccessError ReadValues(uint32 uSubscriptionId, ReadValuesValuesDelegate valuesDelegate) override;
+    DataAccessError GetVariableInfos(uint32 uSubscriptionId, GetVariableInfosVariableInfoDelegate variableInfoDelegate) override;
+
+    // IDataAccessService
+    ReadItem ReadSingle(const RscString<512>& strPortName) override;
+    void Read(ReadPortNamesDelegate portNamesDelegate, ReadReturnValueDelegate returnValueDelegate) override;
+    DataAccessError WriteSingle(const WriteItem& zItem) override;
+    void Write(WriteDataDelegate dataDelegate, WriteReturnValueDelegate returnValueDelegate) override;
+
+private:
+    ///	structure to handle one simulated GDS variable
+    struct VARIABLE
+    {
+        string strName;
+        RscType zType;
+        uint64 uChangeIntervalUs;	// 0: the value never changes
+        uint32 uValueIndex;			// index of the generated value, the source of a mirror
+        bool bWritten;				// value was written, it is kept in m_zWritten
+    };
+
+    ///	structure to handle one subscription
+    struct SUBSCRIPTION
+    {
+        SubscriptionKind zKind;
+        vector<uint32> zVariables;	// index in m_zVariables
+        uint64 uSampleRateUs;
+        uint64 uSubscribeTimeUs;	// 0 if not subscribed
+        uint64 uLastSampleUs;		// time of the values of the last ReadValues
+    };
+
+    pthread_mutex_t m_zMutex;		// protects all members
+    uint64 m_uStartTimeUs;			// time of the first change interval
+    size_t m_nStringLength;
+
+    vector<VARIABLE> m_zVariables;
+    unordered_map<string, uint32> m_zNames;		// index of each variable in m_zVariables
+    map<uint32, RscVariant<512>> m_zWritten;	// written values by index
+    map<uint32, SUBSCRIPTION> m_zSubscriptions;
+    uint32 m_uNextSubscriptionId;
+    RSCSIMSTATS m_zStats;
+
+    static uint64 GetTimeUs();
+    bool FindVariable(const char* szName, uint32& uIndex) const;
+    bool GetSampleTime(const SUBSCRIPTION& zSubscription, uint64 uNowUs, uint64& uSampleUs) const;
+    void GetValue(uint32 uIndex, uint64 uTimeUs, RscVariant<512>& zValue) const;
+    DataAccessError WriteValue(const WriteItem& zItem);
+};
+
+#endif /* RSCSIMULATOR_H_ */
@@ -0,0 +1,77 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  DataAccessError.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+// Host stand-in for the types of the GDS services of the PLCnext SDK, see tools/RscSimulator
+
+#ifndef ARP_SIM_DATAACCESSERROR_HPP_
+#define ARP_SIM_DATAACCESSERROR_HPP_
+
+#include "Arp/System/Rsc/Services/Rsc.h"
+
+namespace Arp { namespace Plc { namespace Gds { namespace Services
+{
+
+using namespace Arp::System::Rsc::Services;
+
+///	result of an access to a GDS variable
+enum class DataAccessError : uint32
+{
+    None = 0,
+    NotExists = 1,
+    NotAuthorized = 2,
+    TypeMismatch = 3,
+    PortNameSyntaxInvalid = 4,
+    ProviderNotExists = 5,
+    Unknown = 6,
+    NotSupported = 7
+};
+
+inline std::ostream& operator<<(std::ostream& zStream, DataAccessError zError)
+{
+    static const char* szNames[] = { "None", "NotExists", "NotAuthorized", "TypeMismatch", "PortNameSyntaxInvalid", "ProviderNotExists", "Unknown", "NotSupported" };
+    return(((uint32)zError < sizeof(szNames) / sizeof(szNames[0])) ? (zStream << szNames[(uint32)zError]) : (zStream << (uint32)zError));
+}
+
+///	realtime class of a subscription
+enum class SubscriptionKind : uint8
+{
+    None = 0,
+    DirectRead = 1,			// the values are read at the time of ReadValues
+    HighPerformance = 2,	// the values are sampled with the sample rate, not task consistent
+    RealTime = 3,			// the values are sampled with the sample rate, task consistent
+    Recording = 4			// the samples are kept in a ring buffer, read with ReadRecords
+};
+
+///	name and type of a subscribed variable
+struct VariableInfo
+{
+    RscString<512> Name;
+    RscType Type = RscType::None;
+};
+
+///	result of reading one variable
+struct ReadItem
+{
+    RscVariant<512> Value;
+    DataAccessError Error = DataAccessError::None;
+};
+
+///	value to write to one variable
+struct WriteItem
+{
+    RscString<512> PortName;
+    RscVariant<512> Value;
+};
+
+}}}}
+
+#endif /* ARP_SIM_DATAACCESSERROR_HPP_ */
@@ -0,0 +1,44 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  IDataAccessService.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+// Host stand-in for the data access service of the PLCnext SDK, implemented by CRscSimulator
+
+#ifndef ARP_SIM_IDATAACCESSSERVICE_HPP_
+#define ARP_SIM_IDATAACCESSSERVICE_HPP_
+
+#include <memory>
+#include "Arp/Plc/Gds/Services/DataAccessError.hpp"
+
+namespace Arp { namespace Plc { namespace Gds { namespace Services
+{
+
+class IDataAccessService
+{
+public:
+    typedef std::shared_ptr<IDataAccessService> Ptr;
+
+    typedef delegate<void(IRscWriteEnumerator<RscString<512>>&)> ReadPortNamesDelegate;
+    typedef delegate<void(IRscReadEnumerator<ReadItem>&)> ReadReturnValueDelegate;
+    typedef delegate<void(IRscWriteEnumerator<WriteItem>&)> WriteDataDelegate;
+    typedef delegate<void(IRscReadEnumerator<DataAccessError>&)> WriteReturnValueDelegate;
+
+    virtual ~IDataAccessService() {}
+
+    virtual ReadItem ReadSingle(const RscString<512>& portName) = 0;
+    virtual void Read(ReadPortNamesDelegate portNamesDelegate, ReadReturnValueDelegate returnValueDelegate) = 0;
+    virtual DataAccessError WriteSingle(const WriteItem& data) = 0;
+    virtual void Write(WriteDataDelegate dataDelegate, WriteReturnValueDelegate returnValueDelegate) = 0;
+};
+
+}}}}
+
+#endif /* ARP_SIM_IDATAACCESSSERVICE_HPP_ */
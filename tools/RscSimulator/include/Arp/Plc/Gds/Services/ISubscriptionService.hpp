@@ -0,0 +1,46 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  ISubscriptionService.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+// Host stand-in for the subscription service of the PLCnext SDK, implemented by CRscSimulator
+
+#ifndef ARP_SIM_ISUBSCRIPTIONSERVICE_HPP_
+#define ARP_SIM_ISUBSCRIPTIONSERVICE_HPP_
+
+#include <memory>
+#include "Arp/Plc/Gds/Services/DataAccessError.hpp"
+
+namespace Arp { namespace Plc { namespace Gds { namespace Services
+{
+
+class ISubscriptionService
+{
+public:
+    typedef std::shared_ptr<ISubscriptionService> Ptr;
+
+    typedef delegate<void(IRscReadEnumerator<RscVariant<512>>&)> ReadValuesValuesDelegate;
+    typedef delegate<void(IRscReadEnumerator<VariableInfo>&)> GetVariableInfosVariableInfoDelegate;
+
+    virtual ~ISubscriptionService() {}
+
+    virtual uint32 CreateSubscription(SubscriptionKind kind) = 0;
+    virtual DataAccessError AddVariable(uint32 subscriptionId, const RscString<512>& variableName) = 0;
+    virtual DataAccessError Subscribe(uint32 subscriptionId, uint64 sampleRate) = 0;
+    virtual DataAccessError Resubscribe(uint32 subscriptionId, uint64 sampleRate) = 0;
+    virtual DataAccessError Unsubscribe(uint32 subscriptionId) = 0;
+    virtual DataAccessError DeleteSubscription(uint32 subscriptionId) = 0;
+    virtual DataAccessError ReadValues(uint32 subscriptionId, ReadValuesValuesDelegate valuesDelegate) = 0;
+    virtual DataAccessError GetVariableInfos(uint32 subscriptionId, GetVariableInfosVariableInfoDelegate variableInfoDelegate) = 0;
+};
+
+}}}}
+
+#endif /* ARP_SIM_ISUBSCRIPTIONSERVICE_HPP_ */
@@ -0,0 +1,218 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  Rsc.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+// Host stand-in for the RSC types of the PLCnext SDK (RscType, RscString, RscVariant, the
+// enumerators and delegate), only the parts which are used by the subscription cycle and the
+// GDS writer of the sample runtime (see tools/RscSimulator). Like the SDK, a value or a string
+// is stored in the object itself, and a delegate keeps its callback without allocating memory
+
+#ifndef ARP_SIM_RSC_H_
+#define ARP_SIM_RSC_H_
+
+#include <new>
+#include <type_traits>
+#include "Arp/System/Core/Arp.h"
+
+#define RSCSIM_DELEGATE_STORAGE	64		// max. size of the callback of a delegate in bytes
+
+namespace Arp
+{
+
+/// @brief	callback of an RSC call. The callback is copied into the delegate, so it must be small
+/// 		and trivially copyable, like the lambdas with captures by reference of the runtime
+template<typename F> class delegate;
+
+template<typename R, typename... A>
+class delegate<R(A...)>
+{
+public:
+    delegate() : m_pfnInvoke(NULL) {}
+
+    template<typename F>
+    static delegate create(const F& fnCallback)
+    {
+        static_assert(sizeof(F) <= RSCSIM_DELEGATE_STORAGE, "callback is too large for a delegate");
+        static_assert(std::is_trivially_copyable<F>::value, "callback of a delegate must be trivially copyable");
+
+        delegate zDelegate;
+        new(zDelegate.m_zStorage) F(fnCallback);
+        zDelegate.m_pfnInvoke = [](const void* pCallback, A... args) -> R { return((*(const F*)pCallback)(args...)); };
+        return(zDelegate);
+    }
+
+    R operator()(A... args) const { return(m_pfnInvoke(m_zStorage, args...)); }
+    explicit operator bool() const { return(m_pfnInvoke != NULL); }
+
+private:
+    alignas(void*) unsigned char m_zStorage[RSCSIM_DELEGATE_STORAGE];
+    R (*m_pfnInvoke)(const void* pCallback, A... args);
+};
+
+namespace System { namespace Rsc { namespace Services
+{
+
+///	type of an RSC value
+enum class RscType : uint8
+{
+    None = 0,
+    Void = 1,		// no value, e.g. a subscribed value which is not sampled yet
+    Bool = 2,
+    Char = 3,
+    Int8 = 4,
+    Uint8 = 5,
+    Int16 = 6,
+    Uint16 = 7,
+    Int32 = 8,
+    Uint32 = 9,
+    Int64 = 10,
+    Uint64 = 11,
+    Real32 = 12,
+    Real64 = 13,
+    String = 19,
+    Utf8String = 20
+};
+
+/// @brief	RSC type of a C++ type
+/// @return	type, RscType::None if there is no RSC type
+template<typename T>
+constexpr RscType GetRscType()
+{
+    return(std::is_same<T, bool>::value ? RscType::Bool :
+           std::is_same<T, char>::value ? RscType::Char :
+           std::is_same<T, int8>::value ? RscType::Int8 :
+           std::is_same<T, uint8>::value ? RscType::Uint8 :
+           std::is_same<T, int16>::value ? RscType::Int16 :
+           std::is_same<T, uint16>::value ? RscType::Uint16 :
+           std::is_same<T, int32>::value ? RscType::Int32 :
+           std::is_same<T, uint32>::value ? RscType::Uint32 :
+           std::is_same<T, int64>::value ? RscType::Int64 :
+           std::is_same<T, uint64>::value ? RscType::Uint64 :
+           std::is_same<T, float32>::value ? RscType::Real32 :
+           std::is_same<T, float64>::value ? RscType::Real64 : RscType::None);
+}
+
+///	string with a fixed capacity of N characters including the terminating zero
+template<int N>
+class RscString
+{
+public:
+    RscString() { m_szChars[0] = '\0'; }
+    RscString(const char* sz) { Assign(sz); }
+    RscString(const String& str) { Assign(str.CStr()); }
+
+    const char* CStr() const { return(m_szChars); }
+    size_t Length() const { return(strlen(m_szChars)); }
+
+    friend std::ostream& operator<<(std::ostream& zStream, const RscString& str) { return(zStream << str.m_szChars); }
+
+private:
+    char m_szChars[N];
+
+    void Assign(const char* sz)
+    {
+        size_t nLength = (sz != NULL) ? strnlen(sz, N - 1) : 0;
+        memcpy(m_szChars, sz, nLength);
+        m_szChars[nLength] = '\0';
+    }
+};
+
+///	value of one of the RSC types, strings of up to N characters including the terminating zero
+template<int N>
+class RscVariant
+{
+public:
+    RscVariant() : m_zType(RscType::Void), m_uValue(0) { m_szChars[0] = '\0'; }
+
+    template<typename T, typename std::enable_if<GetRscType<T>() != RscType::None, int>::type = 0>
+    RscVariant(T value) : m_zType(GetRscType<T>()), m_uValue(0)
+    {
+        memcpy(&m_uValue, &value, sizeof(T));
+        m_szChars[0] = '\0';
+    }
+
+    RscVariant(const char* sz) : m_zType(RscType::String), m_uValue(0) { AssignChars(sz); }
+
+    template<int M>
+    RscVariant(const RscString<M>& str) : m_zType(RscType::String), m_uValue(0) { AssignChars(str.CStr()); }
+
+    // only the used part of the string is copied
+    RscVariant(const RscVariant& other) { *this = other; }
+    RscVariant& operator=(const RscVariant& other)
+    {
+        m_zType = other.m_zType;
+        m_uValue = other.m_uValue;
+        AssignChars(other.m_szChars);
+        return(*this);
+    }
+
+    RscType GetType() const { return(m_zType); }
+
+    /// @brief			copy the value, the type must match exactly like in the SDK
+    /// @param value	reference to value
+    template<typename T>
+    void CopyTo(T& value) const
+    {
+        static_assert(GetRscType<T>() != RscType::None, "no RSC type");
+        if(m_zType != GetRscType<T>())
+        {
+            throw Arp::Exception("RscVariant::CopyTo: type mismatch");
+        }
+        memcpy(&value, &m_uValue, sizeof(T));
+    }
+
+    /// @brief	characters of a string value
+    /// @return	zero terminated string, NULL if the value is not a string
+    const char* GetChars() const
+    {
+        return(((m_zType == RscType::String) || (m_zType == RscType::Utf8String)) ? m_szChars : NULL);
+    }
+
+private:
+    RscType m_zType;
+    uint64 m_uValue;	// value of a scalar type in the first bytes
+    char m_szChars[N];
+
+    void AssignChars(const char* sz)
+    {
+        size_t nLength = (sz != NULL) ? strnlen(sz, N - 1) : 0;
+        memcpy(m_szChars, sz, nLength);
+        m_szChars[nLength] = '\0';
+    }
+};
+
+///	enumerator for reading the values of an RSC call in a delegate
+template<typename T>
+class IRscReadEnumerator
+{
+public:
+    virtual ~IRscReadEnumerator() {}
+    virtual size_t BeginRead() = 0;
+    virtual bool ReadNext(T& current) = 0;
+    virtual void EndRead() = 0;
+};
+
+///	enumerator for writing the values of an RSC call in a delegate
+template<typename T>
+class IRscWriteEnumerator
+{
+public:
+    virtual ~IRscWriteEnumerator() {}
+    virtual void BeginWrite(size_t nCount) = 0;
+    virtual void WriteNext(const T& current) = 0;
+    virtual void EndWrite() = 0;
+};
+
+}}}
+
+}
+
+#endif /* ARP_SIM_RSC_H_ */
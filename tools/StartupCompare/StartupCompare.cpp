@@ -0,0 +1,252 @@
+ /******************************************************************************
+ *
+ *  Copyright (c) 2026 Phoenix Contact GmbH & Co. KG. All rights reserved.
+ *	Licensed under the MIT. See LICENSE file in the project root for full license information.
+ *
+ *  StartupCompare.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ ******************************************************************************/
+
+// Compares two startup reports of the sample runtime (see CStartupTimeline) and shows
+// the duration of every startup step of both builds. It runs on the host and does not
+// need the PLCnext SDK:
+//
+//   cmake -S tools -B build-tools && cmake --build build-tools --target StartupCompare
+//   ./build-tools/StartupCompare [--threshold-ms 50] [--threshold-pct 10] baseline.jsonl current.jsonl
+//
+// The report files contain one report per line, the last report of each file is used.
+// A step is a regression, if it takes longer than both thresholds allow. The exit code
+// is 1 if there is at least one regression, 2 on errors and 0 otherwise.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+///	structure to handle one milestone of a report
+struct MILESTONE
+{
+    string strName;
+    bool bReached = false;
+    double dTimeMs = 0;		// time since main()
+    double dDeltaMs = 0;	// time since the previous reached milestone
+};
+
+///	structure to handle one report
+struct REPORT
+{
+    string strBuild;
+    double dTotalMs = 0;
+    vector<MILESTONE> zMilestones;
+};
+
+/// @brief				read the last non-empty line of a file
+/// @param szFile		name of file
+/// @param strLine		last line
+/// @return				true: success, false: failure
+static bool ReadLastLine(const char* szFile, string& strLine)
+{
+    FILE* pFile = fopen(szFile, "r");
+    if(pFile == NULL)
+    {
+        fprintf(stderr, "%s: cannot open file\n", szFile);
+        return(false);
+    }
+
+    char szBuffer[8192];
+    while(fgets(szBuffer, sizeof(szBuffer), pFile) != NULL)
+    {
+        if(strchr(szBuffer, '{') != NULL)
+        {
+            strLine = szBuffer;
+        }
+    }
+    fclose(pFile);
+
+    return(strLine.empty() == false);
+}
+
+/// @brief				value of a number after a key
+/// @param strLine		report
+/// @param szKey		key including quotes and colon
+/// @param dValue		value
+/// @return				true: found, false: not found
+static bool GetNumber(const string& strLine, const char* szKey, double& dValue)
+{
+    size_t nPos = strLine.find(szKey);
+    if(nPos == string::npos)
+    {
+        return(false);
+    }
+    dValue = strtod(strLine.c_str() + nPos + strlen(szKey), NULL);
+    return(true);
+}
+
+/// @brief				parse the last report of a file
+/// @param szFile		name of file
+/// @param zReport		report
+/// @return				true: success, false: failure
+static bool ParseReport(const char* szFile, REPORT& zReport)
+{
+    string strLine;
+    if(ReadLastLine(szFile, strLine) == false)
+    {
+        fprintf(stderr, "%s: no startup report\n", szFile);
+        return(false);
+    }
+
+    size_t nPos = strLine.find("\"build\":\"");
+    if(nPos != string::npos)
+    {
+        nPos += strlen("\"build\":\"");
+        zReport.strBuild = strLine.substr(nPos, strLine.find('"', nPos) - nPos);
+    }
+    GetNumber(strLine, "\"total_ms\":", zReport.dTotalMs);
+
+    // "milestones":{"name":{"t_ms":1.0,"delta_ms":1.0},"name":null,...}
+    nPos = strLine.find("\"milestones\":{");
+    if(nPos == string::npos)
+    {
+        fprintf(stderr, "%s: no milestones in report\n", szFile);
+        return(false);
+    }
+    nPos += strlen("\"milestones\":{");
+
+    while((nPos < strLine.size()) && (strLine[nPos] == '"'))
+    {
+        size_t nEnd = strLine.find('"', nPos + 1);
+        if(nEnd == string::npos)
+        {
+            break;
+        }
+
+        MILESTONE zMilestone;
+        zMilestone.strName = strLine.substr(nPos + 1, nEnd - nPos - 1);
+
+        nPos = nEnd + 2;	// skip quote and colon
+        if(strLine.compare(nPos, 4, "null") == 0)
+        {
+            nPos += 4;
+        }
+        else
+        {
+            nEnd = strLine.find('}', nPos);
+            if(nEnd == string::npos)
+            {
+                break;
+            }
+            string strValue = strLine.substr(nPos, nEnd - nPos + 1);
+            zMilestone.bReached = GetNumber(strValue, "\"t_ms\":", zMilestone.dTimeMs) &&
+                                  GetNumber(strValue, "\"delta_ms\":", zMilestone.dDeltaMs);
+            nPos = nEnd + 1;
+        }
+        zReport.zMilestones.push_back(zMilestone);
+
+        if((nPos < strLine.size()) && (strLine[nPos] == ','))
+        {
+            nPos++;
+        }
+    }
+
+    return(zReport.zMilestones.empty() == false);
+}
+
+/// @brief				find a milestone by name
+/// @param zReport		report
+/// @param strName		name of milestone
+/// @return				milestone, NULL if it is not in the report
+static const MILESTONE* FindMilestone(const REPORT& zReport, const string& strName)
+{
+    for(const MILESTONE& zMilestone : zReport.zMilestones)
+    {
+        if(zMilestone.strName == strName)
+        {
+            return(&zMilestone);
+        }
+    }
+    return(NULL);
+}
+
+/// @brief				is the current value a regression compared to the baseline?
+static bool IsRegression(double dBase, double dCurrent, double dThresholdMs, double dThresholdPct)
+{
+    double dDiff = dCurrent - dBase;
+    return((dDiff > dThresholdMs) && (dDiff > (dBase * dThresholdPct / 100.0)));
+}
+
+int main(int argc, char** argv)
+{
+    double dThresholdMs = 50;
+    double dThresholdPct = 10;
+    vector<const char*> zFiles;
+
+    for(int nCount = 1; nCount < argc; nCount++)
+    {
+        if((strcmp(argv[nCount], "--threshold-ms") == 0) && (nCount + 1 < argc))
+        {
+            dThresholdMs = atof(argv[++nCount]);
+        }
+        else if((strcmp(argv[nCount], "--threshold-pct") == 0) && (nCount + 1 < argc))
+        {
+            dThresholdPct = atof(argv[++nCount]);
+        }
+        else
+        {
+            zFiles.push_back(argv[nCount]);
+        }
+    }
+
+    if(zFiles.size() != 2)
+    {
+        fprintf(stderr, "usage: %s [--threshold-ms N] [--threshold-pct P] <baseline.jsonl> <current.jsonl>\n", argv[0]);
+        return(2);
+    }
+
+    REPORT zBase;
+    REPORT zCurrent;
+    if((ParseReport(zFiles[0], zBase) == false) || (ParseReport(zFiles[1], zCurrent) == false))
+    {
+        return(2);
+    }
+
+    printf("baseline: %s\ncurrent:  %s\n\n", zBase.strBuild.c_str(), zCurrent.strBuild.c_str());
+    printf("%-24s %12s %12s %12s\n", "step (ms)", "baseline", "current", "diff");
+
+    int nRegressions = 0;
+    for(const MILESTONE& zMilestone : zCurrent.zMilestones)
+    {
+        const MILESTONE* pBase = FindMilestone(zBase, zMilestone.strName);
+        if((pBase == NULL) || (pBase->bReached == false) || (zMilestone.bReached == false))
+        {
+            printf("%-24s %12s %12s\n", zMilestone.strName.c_str(),
+                   ((pBase != NULL) && pBase->bReached) ? "reached" : "-",
+                   zMilestone.bReached ? "reached" : "-");
+            continue;
+        }
+
+        bool bRegression = IsRegression(pBase->dDeltaMs, zMilestone.dDeltaMs, dThresholdMs, dThresholdPct);
+        printf("%-24s %12.3f %12.3f %+12.3f%s\n", zMilestone.strName.c_str(),
+               pBase->dDeltaMs, zMilestone.dDeltaMs, zMilestone.dDeltaMs - pBase->dDeltaMs,
+               bRegression ? "  REGRESSION" : "");
+        if(bRegression)
+        {
+            nRegressions++;
+        }
+    }
+
+    bool bRegression = IsRegression(zBase.dTotalMs, zCurrent.dTotalMs, dThresholdMs, dThresholdPct);
+    printf("%-24s %12.3f %12.3f %+12.3f%s\n", "total", zBase.dTotalMs, zCurrent.dTotalMs,
+           zCurrent.dTotalMs - zBase.dTotalMs, bRegression ? "  REGRESSION" : "");
+    if(bRegression)
+    {
+        nRegressions++;
+    }
+
+    return((nRegressions > 0) ? 1 : 0);
+}